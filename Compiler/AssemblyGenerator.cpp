@@ -2,7 +2,8 @@
  * Contains definition of class responsible for converting TAC into assembly code.
  */
 
-#include <set>
+#include <algorithm>
+#include <cmath>
 #include <numeric>
 
 #include "AssemblyGenerator.h"
@@ -11,243 +12,326 @@
 using namespace Assembly;
 
 AssemblyGenerator::AssemblyGenerator(
-    const AssemblyGenerator::TacInstructions& tacInstructions
+    const AssemblyGenerator::TacInstructions& tacInstructions,
+    VariableTable::Ptr variableTable
 )
-: m_tacInstructions( tacInstructions )
+: m_tacInstructions( tacInstructions ),
+  m_variableTable( variableTable )
 {
+    if ( nullptr == m_variableTable )
+    {
+        LOG_ERROR_AND_THROW( "Assembly generator needs the table of the variables in the TAC.", std::invalid_argument );
+    }
 }
 
 /**
- * \brief  Calculates the boundaries of basic blocks in the TAC program, populating m_basicBlockStarts.
+ * \brief  Calculates the basic blocks of the TAC program and the control flow between them, populating
+ *         m_controlFlowGraph.
  */
 void
 AssemblyGenerator::CalculateBasicBlocks()
 {
-    // Initialise with 0, the start index.
-    m_basicBlockStarts = { 0u };
-
-    // Start from 0 because we are considering the next index to be the start of a new block - so there is a possibility
-    // that the 0th instruction is the end of a block, thus making 1 the start of the next. End at one less than the
-    // last index, because if the end of a block is the last index, there is no next block.
-    for ( size_t index = 0; index < m_tacInstructions.size() - 1; ++index )
-    {
-        TAC::ThreeAddrInstruction::Ptr instr = m_tacInstructions[index];
-
-        bool isBlockBoundary{ false };
-        // A basic block boundary occurs if there is a branch instruction, or an instruction with a label.
-        if ( "" != instr->m_label )
-        {
-            isBlockBoundary = true;
-        }
-        else if ( instr->IsOperation() )
-        {
-            TAC::Operation::Ptr operation = instr->GetOperation();
-            if ( TAC::ThreeAddrInstruction::IsOpcodeBranch( operation->opcode ) )
-            {
-                isBlockBoundary = true;
-            }
-        }
-
-        if ( isBlockBoundary )
-        {
-            // Store the next instruction index, as it is the start of the next block.
-            m_basicBlockStarts.push_back( index + 1 );
-        }
-    }
+    m_controlFlowGraph = std::make_shared< TAC::ControlFlowGraph >( m_tacInstructions );
+    LOG_INFO( "Found " + std::to_string( m_controlFlowGraph->GetNumBlocks() ) + " basic blocks, and "
+              + std::to_string( m_controlFlowGraph->GetLoops().size() ) + " loops." );
 }
 
 /**
- * \brief  Calculates the live intervals of all variables in the TAC program.
+ * \brief  Calculates the live ranges of all variables in the TAC program. Using the liveness analysis, a variable's
+ *         range covers every instruction from where it is written to (or from the start of a block it is live into)
+ *         to each read of that value (or to the end of a block it is live out of) - e.g. to the end of a loop, if its
+ *         value is carried around to the next iteration. Between a value's last read and the variable being written
+ *         again, the range has a hole. Requires the basic blocks.
  */
 void
 AssemblyGenerator::CalculateLiveIntervals()
 {
-    for ( size_t index = 0; index < m_tacInstructions.size(); ++index )
+    if ( nullptr == m_controlFlowGraph )
     {
-        TAC::ThreeAddrInstruction::Ptr instr = m_tacInstructions[index];
+        LOG_ERROR_AND_THROW( "Basic blocks must be calculated before live intervals.", std::runtime_error );
+    }
+    m_liveness = std::make_shared< TAC::LivenessAnalysis >(
+        m_tacInstructions, *m_controlFlowGraph, m_variableTable->GetNumVariables()
+    );
+    LOG_INFO( "Liveness analysis converged after " + std::to_string( m_liveness->GetNumIterations() )
+              + " iterations." );
 
-        // If instruction is storing an operation, consider the live interval of the target (as long as it is not a
-        // branch instruction), and any non-empty operands.
-        InstrStringArgs relevantVars = GetVarsFromInstruction( instr );
-        std::string target = std::get< 0 >( relevantVars );
-        std::string operand1 = std::get< 1 >( relevantVars );
-        std::string operand2 = std::get< 2 >( relevantVars );
+    m_liveRanges.clear();
+    m_registerAllocator.reset();
+    m_instructionVars.clear();
+    m_instructionVars.reserve( m_tacInstructions.size() );
+    for ( const TAC::ThreeAddrInstruction& instr : m_tacInstructions )
+    {
+        m_instructionVars.push_back( GetVarsFromInstruction( instr ) );
+    }
+
+    // Walk backwards through the program, so that segments are always added before (or merged into the start of) the
+    // earliest segment recorded so far. The segments are reversed into ascending order at the end.
+    for ( size_t blockIndex = m_controlFlowGraph->GetNumBlocks(); blockIndex-- > 0; )
+    {
+        const TAC::BasicBlock& block = m_controlFlowGraph->GetBlock( blockIndex );
+
+        // Assume variables live out of the block are live for all of it, until a write to them is found.
+        m_liveness->GetLiveOut( blockIndex ).ForEach(
+            [&]( size_t var ) { AddLiveSegment( static_cast< VarId >( var ), block.start, block.end - 1u ); }
+        );
+
+        for ( size_t index = block.end; index-- > block.start; )
+        {
+            const InstrVarIds& relevantVars = m_instructionVars[index];
+            // The target is written after the operands are read, so handle it first when walking backwards.
+            RecordVarDef( std::get< 0 >( relevantVars ), index );
+            AddLiveSegment( std::get< 1 >( relevantVars ), block.start, index );
+            AddLiveSegment( std::get< 2 >( relevantVars ), block.start, index );
+        }
+    }
 
-        RecordVarUse( target, index );
-        RecordVarUse( operand1, index );
-        RecordVarUse( operand2, index );
+    for ( auto& entry : m_liveRanges )
+    {
+        std::reverse( entry.second.segments.begin(), entry.second.segments.end() );
     }
 }
 
 /**
- * \brief  Where the value is relevant, extracts the target and both operands in string form from a TAC instruction.
- *         If the value isn't relevant for this instruction (e.g. a branch target, or an unused operand), an empty
- *         string is returned in its place.
+ * \brief  Where the value is relevant, extracts the variables of the target and both operands from a TAC instruction.
+ *         If the value isn't relevant for this instruction (e.g. a branch target, or an unused operand),
+ *         g_invalidVarId is returned in its place.
  *
- * \param[in]  instruction  The TAC instruction containing identifiers.
+ * \param[in]  instruction  The TAC instruction containing variables.
  *
- * \return  Tuple containing strings of the target and both operands.
+ * \return  Tuple containing IDs of the target and both operands.
  */
-AssemblyGenerator::InstrStringArgs
+AssemblyGenerator::InstrVarIds
 AssemblyGenerator::GetVarsFromInstruction(
-    TAC::ThreeAddrInstruction::Ptr instruction
+    const TAC::ThreeAddrInstruction& instruction
 )
 {
-    InstrStringArgs identifiers = std::make_tuple( "", "", "" );
+    // Branch instructions target a label, so have no target variable. Assignments of a literal have no operand
+    // variables, and never use operand 2.
+    return std::make_tuple( instruction.m_target, instruction.m_operand1, instruction.m_operand2 );
+}
 
-    if ( instruction->IsOperation() )
+/**
+ * \brief  Records a variable as live over a run of instructions, while building live ranges backwards. The run must
+ *         not end after the earliest segment recorded so far for the variable; if it overlaps or touches that segment,
+ *         the two are merged.
+ *
+ * \param[in]  var         The variable, or g_invalidVarId for an unused operand.
+ * \param[in]  firstIndex  The first instruction index at which it is live.
+ * \param[in]  lastIndex   The last instruction index at which it is live.
+ */
+void
+AssemblyGenerator::AddLiveSegment(
+    VarId var,
+    size_t firstIndex,
+    size_t lastIndex
+)
+{
+    // Ignore if the variable is invalid, as it refers to an operand not being used/holding zero.
+    if ( g_invalidVarId == var )
     {
-        TAC::Operation::Ptr operation = instruction->GetOperation();
-        if ( !TAC::ThreeAddrInstruction::IsOpcodeBranch( operation->opcode ) )
-        {
-            std::get< 0 >( identifiers ) = instruction->m_target;
-        }
-        std::get< 1 >( identifiers ) = operation->operand1;
-        std::get< 2 >( identifiers ) = operation->operand2;
+        return;
+    }
+
+    std::vector< LiveRange::Segment >& segments = m_liveRanges[var].segments;
+    if ( !segments.empty() && segments.back().first <= lastIndex + 1u )
+    {
+        segments.back().first = std::min( segments.back().first, firstIndex );
+        segments.back().second = std::max( segments.back().second, lastIndex );
     }
     else
     {
-        std::get< 0 >( identifiers ) = instruction->m_target;
-
-        TAC::Operand rhsOperand = std::get< TAC::Operand >( instruction->m_rhs );
-        if ( std::holds_alternative< std::string >( rhsOperand ) )
-        {
-            std::string rhsId = std::get< std::string >( rhsOperand );
-            std::get< 1 >( identifiers ) = rhsId;
-        }
+        segments.emplace_back( firstIndex, lastIndex );
     }
-
-    return identifiers;
 }
 
 /**
- * \brief  Records an instance of a variable being used, in the live interval records. If this is a new variable,
- *         creates a new live intervals entry. Otherwise, extends the end index to include this instance.
+ * \brief  Records a variable being written to, while building live ranges backwards. Its value before this point is
+ *         no longer needed, so the segment containing any later reads is cut short to start here. If the value is
+ *         never read, the variable is still live at this instruction, as it needs somewhere to be written to.
  *
- * \param[in]  identifier  The identifier of the variable that was referenced.
- * \param[in]  indexOfUse  The instruction index where the variable was referenced.
+ * \param[in]  var         The variable written to, or g_invalidVarId for a branch.
+ * \param[in]  indexOfDef  The instruction index of the write.
  */
 void
-AssemblyGenerator::RecordVarUse(
-    const std::string& identifier,
-    size_t indexOfUse
+AssemblyGenerator::RecordVarDef(
+    VarId var,
+    size_t indexOfDef
 )
 {
-    // Ignore if the variable is an empty string, as it refers to an operand not being used/holding zero.
-    if ( "" == identifier )
+    if ( g_invalidVarId == var )
     {
         return;
     }
 
-    // If an entry for this variable doesn't exist, make one.
-    if ( 0u == m_liveIntervals.count( identifier ) )
+    std::vector< LiveRange::Segment >& segments = m_liveRanges[var].segments;
+    if ( segments.empty() || segments.back().first > indexOfDef )
     {
-        m_liveIntervals.insert( { identifier, { indexOfUse, indexOfUse } } );
+        segments.emplace_back( indexOfDef, indexOfDef );
     }
     else
     {
-        m_liveIntervals[identifier].second = indexOfUse;
+        segments.back().first = indexOfDef;
     }
 }
 
 /**
- * \brief  Converts the stored TAC instructions into assembly instructions.
+ * \brief  Estimates the cost of spilling each variable with a live range, as the number of extra instructions that
+ *         would be run to load it before each read and save it after each write. Instructions in loops are weighted by
+ *         an estimate of how many times they run, so variables used in hot loops (e.g. loop counters) are kept in
+ *         registers in preference to those only used at the top level.
  *
- * \return  Collection of assembly instructions.
+ * \return  Spill cost of each variable.
  */
-Instructions
-AssemblyGenerator::GenerateAssemblyInstructions()
+RegisterAllocator::SpillCosts
+AssemblyGenerator::CalculateSpillCosts() const
 {
-    if ( !m_assemblyInstructions.empty() )
+    RegisterAllocator::SpillCosts spillCosts;
+    for ( const auto& entry : m_liveRanges )
     {
-        LOG_WARN( "This object already has stored assembly instructions - these will be wiped." );
+        spillCosts[entry.first] = 0.0;
     }
-    m_assemblyInstructions.clear();
-    // The number of assembly instructions will be >= the number of TAC instructions, so we can reserve this much in
-    // advance.
-    m_assemblyInstructions.reserve( m_tacInstructions.size() );
 
-    size_t numBlocks = m_basicBlockStarts.size();
-    for ( size_t index = 0; index < numBlocks; ++index )
+    for ( size_t blockIndex = 0; blockIndex < m_controlFlowGraph->GetNumBlocks(); ++blockIndex )
     {
-        size_t blockStart = m_basicBlockStarts[index];
-        size_t nextBlockStart = index < numBlocks - 1 ? m_basicBlockStarts[index + 1] : numBlocks;
-        GenerateAssemblyForBasicBlock( blockStart, nextBlockStart );
+        const TAC::BasicBlock& block = m_controlFlowGraph->GetBlock( blockIndex );
+        double frequency = std::pow( LOOP_ITERATIONS_ESTIMATE, m_controlFlowGraph->GetLoopDepth( blockIndex ) );
+        for ( size_t index = block.start; index < block.end; ++index )
+        {
+            // Each operand is loaded separately, even if both are the same variable.
+            const InstrVarIds& relevantVars = m_instructionVars[index];
+            VarId target = std::get< 0 >( relevantVars );
+            if ( g_invalidVarId != target )
+            {
+                spillCosts[target] += frequency * SPILL_STORE_COST;
+            }
+            for ( VarId operand : { std::get< 1 >( relevantVars ), std::get< 2 >( relevantVars ) } )
+            {
+                if ( g_invalidVarId != operand )
+                {
+                    spillCosts[operand] += frequency * SPILL_LOAD_COST;
+                }
+            }
+        }
     }
-    return m_assemblyInstructions;
+    return spillCosts;
 }
 
 /**
- * \brief  Converts TAC instructions from a specific basic block into assembly instructions, adding load and store
- *         instructions for any spilled variables (as well as documenting their memory locations).
+ * \brief  Allocates registers to the variables of the whole program from their live ranges, and memory locations to
+ *         any that have to be spilled. Requires the live intervals.
+ */
+void
+AssemblyGenerator::AllocateRegisters()
+{
+    if ( nullptr == m_liveness || m_instructionVars.size() != m_tacInstructions.size() )
+    {
+        LOG_ERROR_AND_THROW( "Live intervals must be calculated before allocating registers.", std::runtime_error );
+    }
+    RegisterAllocator::SpillCosts spillCosts = CalculateSpillCosts();
+    m_registerAllocator = std::make_shared< RegisterAllocator >( m_liveRanges, spillCosts, AVAILABLE_REG_OFFSET,
+                                                                 NUM_AVAILABLE_REGS );
+    AllocateMemoryLocations( spillCosts );
+
+    LOG_INFO( "Allocated " + std::to_string( m_registerAllocator->GetNumRegistersUsed() ) + " registers to "
+              + std::to_string( m_liveRanges.size() - m_memoryLocations.size() ) + " variables, and spilled "
+              + std::to_string( m_memoryLocations.size() ) + " variables to " + std::to_string( m_peakMemoryUsage )
+              + " memory locations." );
+}
+
+/**
+ * \brief  Allocates memory locations to the spilled variables. Variables whose live ranges don't overlap never need
+ *         to be in memory at the same time, so can share a location. This is the same problem as allocating registers,
+ *         so is solved the same way, with each memory address standing in for a register. Throws if there aren't
+ *         enough addresses.
  *
- * \param[in]   blockStart              The index of the instruction at the start of this block (inclusive).
- * \param[in]   blockEnd                The index of the end of the block (exclusive).
+ * \param[in]  spillCosts  Spill cost of each variable, needed by the allocator.
  */
 void
-AssemblyGenerator::GenerateAssemblyForBasicBlock(
-    size_t blockStart,
-    size_t blockEnd
+AssemblyGenerator::AllocateMemoryLocations(
+    const RegisterAllocator::SpillCosts& spillCosts
 )
 {
-    // Reset the active vars and available registers, as they are specific to this block.
-    m_currentActiveVars.clear();
-    m_availableRegs.clear();
-    for ( uint8_t i = 0; i < NUM_AVAILABLE_REGS; ++i )
+    m_memoryLocations.clear();
+    m_peakMemoryUsage = 0u;
+
+    RegisterAllocator::LiveRanges spilledRanges;
+    for ( VarId var : m_registerAllocator->GetSpilledVars() )
     {
-        m_availableRegs.insert( i + AVAILABLE_REG_OFFSET );
+        spilledRanges[var] = m_liveRanges.at( var );
     }
-
-    for ( size_t instrIndex = blockStart; instrIndex < blockEnd; ++instrIndex )
+    RegisterAllocator memoryAllocator( spilledRanges, spillCosts, MEM_ADDR_OFFSET, NUM_MEM_ADDRS );
+    if ( !memoryAllocator.GetSpilledVars().empty() )
     {
-        ExpireOldIntervals( instrIndex );
-
-        TAC::ThreeAddrInstruction::Ptr instr = m_tacInstructions[instrIndex];
-        GenerateAssemblyForInstr( instr );
+        LOG_ERROR_AND_THROW( "Program needs more than the " + std::to_string( NUM_MEM_ADDRS ) + " memory locations "
+                             "available to hold its spilled variables.", std::runtime_error );
     }
 
-    // Save any currently active vars that were edited.
-    for ( auto it = m_currentActiveVars.begin(); it != m_currentActiveVars.end(); ++it )
+    for ( const auto& entry : spilledRanges )
     {
-        ActiveVarInfo varInfo = it->second;
-        bool isEdited = varInfo.second;
-        if ( isEdited )
-        {
-            SaveActiveVar( it->first );
-        }
+        m_memoryLocations[entry.first] = memoryAllocator.GetRegister( entry.first );
     }
+    // The lowest free address is always allocated first, so the addresses used are contiguous from the first.
+    m_peakMemoryUsage = memoryAllocator.GetNumRegistersUsed();
 }
 
 /**
- * \brief  Saves variable to memory, using its allocated memory address (allocating a new one if it doesn't have one
- *         yet).
+ * \brief  Converts the stored TAC instructions into assembly instructions.
  *
- * \param[in]  identifier  The variable identifier.
+ * \return  Collection of assembly instructions.
  */
-void
-AssemblyGenerator::SaveActiveVar(
-    const std::string& identifier
-)
+Instructions
+AssemblyGenerator::GenerateAssemblyInstructions()
 {
-    if ( m_currentActiveVars.end() == m_currentActiveVars.find( identifier ) )
+    if ( !m_assemblyInstructions.empty() )
     {
-        LOG_ERROR_AND_THROW( "'" + identifier + "' not found in active variables.", std::invalid_argument );
+        LOG_WARN( "This object already has stored assembly instructions - these will be wiped." );
     }
-    ActiveVarInfo varInfo = m_currentActiveVars[identifier];
-    uint8_t varRegister = varInfo.first;
+    m_assemblyInstructions.clear();
+    if ( nullptr == m_controlFlowGraph )
+    {
+        LOG_ERROR_AND_THROW( "Basic blocks must be calculated before generating assembly instructions.",
+                             std::runtime_error );
+    }
+    if ( nullptr == m_registerAllocator )
+    {
+        LOG_ERROR_AND_THROW( "Registers must be allocated before generating assembly instructions.",
+                             std::runtime_error );
+    }
+    // The number of assembly instructions will be >= the number of TAC instructions, so we can reserve this much in
+    // advance.
+    m_assemblyInstructions.reserve( m_tacInstructions.size() );
 
-    uint8_t memAddr;
-    // If the variable already has an allocated memory location, use it.
-    if ( m_memoryLocations.end() != m_memoryLocations.find( identifier ) )
+    m_numLoadImmediatesSkipped = 0u;
+    for ( size_t index = 0; index < m_controlFlowGraph->GetNumBlocks(); ++index )
     {
-        memAddr = m_memoryLocations[identifier];
+        GenerateAssemblyForBasicBlock( index );
     }
-    else
+    LOG_INFO( "Generated " + std::to_string( m_assemblyInstructions.size() ) + " assembly instructions, skipping "
+              + std::to_string( m_numLoadImmediatesSkipped ) + " loads of values already in registers." );
+    return m_assemblyInstructions;
+}
+
+/**
+ * \brief  Converts TAC instructions from a specific basic block into assembly instructions, adding load and store
+ *         instructions around any references to spilled variables. As variables keep the same register or memory
+ *         location throughout the program, nothing needs saving or restoring at the block's boundaries.
+ *
+ * \param[in]  blockIndex  Index of the block in the control-flow graph.
+ */
+void
+AssemblyGenerator::GenerateAssemblyForBasicBlock(
+    size_t blockIndex
+)
+{
+    const TAC::BasicBlock& block = m_controlFlowGraph->GetBlock( blockIndex );
+
+    // The block may be entered from elsewhere, where the registers hold different values.
+    m_knownRegisterValues.clear();
+    for ( size_t instrIndex = block.start; instrIndex < block.end; ++instrIndex )
     {
-        memAddr = GetNextMemoryLocation();
-        m_memoryLocations.insert( { identifier, memAddr } );
+        GenerateAssemblyForInstr( instrIndex );
     }
-    SaveRegister( varRegister, memAddr );
 }
 
 /**
@@ -264,8 +348,8 @@ AssemblyGenerator::SaveRegister(
 )
 {
     // Load the desired memory address into a temporary register. No label since these are instructions being
-    // added at the end of a block, intended to stay within the block.
-    std::string label = "";
+    // added after an instruction, intended to stay within its block.
+    TAC::LabelId label = TAC::g_invalidLabelId;
 
     uint8_t memAddrRegister = MEM_ADDR_TEMP_REG;
     AddLoadImmediate( label, memAddrRegister, memoryAddress );
@@ -289,24 +373,35 @@ AssemblyGenerator::SplitImmediateOperand(
 }
 
 /**
- * \brief  Adds an LDI instruction, loading an immediate value into the desired register.
+ * \brief  Adds an LDI instruction, loading an immediate value into the desired register. If the register is already
+ *         known to hold the value (e.g. a memory address loaded for the previous spill), nothing is added - unless the
+ *         instruction is labelled, as it may be branched to.
  *
- * \param[in]  label           The instruction branch label, or an empty string for none.
+ * \param[in]  label           The instruction branch label, or g_invalidLabelId for none.
  * \param[in]  targetRegister  The register to load the value into.
  * \param[in]  immediateValue  The value to load into the register.
  */
 void
 AssemblyGenerator::AddLoadImmediate(
-    const std::string& label,
+    TAC::LabelId label,
     uint8_t targetRegister,
     uint8_t immediateValue
 )
 {
+    auto knownValue = m_knownRegisterValues.find( targetRegister );
+    if ( TAC::g_invalidLabelId == label && m_knownRegisterValues.end() != knownValue
+         && immediateValue == knownValue->second )
+    {
+        ++m_numLoadImmediatesSkipped;
+        return;
+    }
+
     // Split up the immediate value over 2 operands as each operand is 4 bits.
     std::pair< uint8_t, uint8_t > operands = SplitImmediateOperand( immediateValue );
 
     Instruction ldiInstr = std::make_tuple( label, Opcode::LDI, targetRegister, operands.first, operands.second );
-    m_assemblyInstructions.push_back( ldiInstr );
+    AddInstruction( ldiInstr );
+    m_knownRegisterValues[targetRegister] = immediateValue;
 }
 
 /**
@@ -323,96 +418,75 @@ AssemblyGenerator::AddStoreInstruction(
 {
     // No label, as a store instruction will only ever come after a TAC instruction, so will never be given the new
     // start of a block.
-    Instruction storeInstr = std::make_tuple( "", Opcode::STR, registerToStore, registerHoldingTarget, 0u );
-    m_assemblyInstructions.push_back( storeInstr );
-}
-
-/**
- * \brief  Gets the next available memory address, assuming that all memory addresses are allocated without skipping.
- *
- * \return  Next available memory address.
- */
-uint8_t
-AssemblyGenerator::GetNextMemoryLocation()
-{
-    size_t numAllocatedLocations = m_memoryLocations.size();
-    return MEM_ADDR_OFFSET + numAllocatedLocations;
+    Instruction storeInstr
+        = std::make_tuple( TAC::g_invalidLabelId, Opcode::STR, registerToStore, registerHoldingTarget, 0u );
+    AddInstruction( storeInstr );
 }
 
 /**
- * \brief  Checks the active variables are still active, expiring any that have passed the end of their live interval.
+ * \brief  Adds an assembly instruction. If it writes to a register, the value of that register is no longer known.
  *
- * \param[in]  currentInstrIndex  Index of the next instruction we are looking at. Variables are expired if their
- *                                end point is < current index.
+ * \param[in]  instruction  The instruction to add.
  */
 void
-AssemblyGenerator::ExpireOldIntervals(
-    size_t currentInstrIndex
+AssemblyGenerator::AddInstruction(
+    const Instruction& instruction
 )
 {
-    for ( auto it = m_currentActiveVars.begin(); it != m_currentActiveVars.end(); )
+    // Stores write to memory, and branches target a label rather than a register.
+    Opcode opcode = std::get< 1 >( instruction );
+    const InstructionTarget& target = std::get< 2 >( instruction );
+    if ( Opcode::STR != opcode && std::holds_alternative< uint8_t >( target ) )
     {
-        std::string identifier = it->first;
-        LiveInterval liveInterval = m_liveIntervals[identifier];
-        if ( currentInstrIndex > liveInterval.second )
-        {
-            uint8_t registerToRelease = it->second.first;
-            m_availableRegs.insert( registerToRelease );
-            m_currentActiveVars.erase( it++ );
-        }
-        else
-        {
-            ++it;
-        }
+        m_knownRegisterValues.erase( std::get< uint8_t >( target ) );
     }
+    m_assemblyInstructions.push_back( instruction );
 }
 
 /**
  * \brief  Generates assembly instruction(s) for a given TAC instruction.
  *
- * \param[in]  instruction  The string identifier of this variable.
+ * \param[in]  instrIndex  Index of the TAC instruction being converted.
  */
 void
 AssemblyGenerator::GenerateAssemblyForInstr(
-    TAC::ThreeAddrInstruction::Ptr instruction
+    size_t instrIndex
 )
 {
+    const TAC::ThreeAddrInstruction& instruction = m_tacInstructions[instrIndex];
+    // The variables referred to by the instruction, as calculated with the live intervals.
+    const InstrVarIds& relevantVars = m_instructionVars[instrIndex];
+
     // The current instruction will only have a label if it is the start of a new block - in which case we want the
     // label to be given to the next assembly instruction we add.
-    std::string label = instruction->m_label;
+    TAC::LabelId label = instruction.m_label;
     Opcode assemblyOpcode = GetAssemblyOpcode( instruction );
-    // Initialise operands to zeros, as they represent unused values aka empty strings.
+    // Initialise operands to zeros, as they represent unused values aka empty operands.
     InstructionTarget assemblyTarget{ 0u };
     uint8_t assemblyOperand1{ 0u };
     uint8_t assemblyOperand2{ 0u };
 
-
-    InstrStringArgs relevantVars = GetVarsFromInstruction( instruction );
-
     // Step 1: resolve the target (this has slightly different behaviour because a) it could be a branch label, and
-    // b) if it is spilled, it needs saving after this instruction.
+    // b) if it is spilled, it needs saving after this instruction rather than loading before it).
     constexpr size_t targetIndex = 0u;
-    std::string targetStr = std::get< targetIndex >( relevantVars );
-    if ( "" == targetStr )
+    VarId targetId = std::get< targetIndex >( relevantVars );
+    if ( g_invalidVarId == targetId )
     {
-        // If the 'relevant' target string is empty, this means it is a branch label, as it is not a var.
-        assemblyTarget = instruction->m_target;
+        // If the 'relevant' target is invalid, this means it is a branch label, as it is not a var.
+        assemblyTarget = instruction.m_branchTarget;
     }
     else
     {
-        assemblyTarget = GetOperandRegister( targetStr, targetIndex, label );
+        assemblyTarget = GetTargetRegister( targetId );
     }
 
-    // Step 2: resolve the operands
+    // Step 2: resolve the operands, and add the instruction.
 
-    // If the operation is an LDI, we need to split operand 1 (8 bits) over operand 1 and operand 2, as each
-    // assembly operand is intended to be 4 bits.
+    // If the operation is an LDI, the literal is split over both operands. This can be skipped if the target's
+    // register already holds the literal.
     if ( Opcode::LDI == assemblyOpcode )
     {
-        TAC::Literal immediateValue = std::get< TAC::Literal >( std::get< TAC::Operand >( instruction->m_rhs ) );
-        std::pair< uint8_t, uint8_t > operands = SplitImmediateOperand( immediateValue );
-        assemblyOperand1 = operands.first;
-        assemblyOperand2 = operands.second;
+        AddLoadImmediate( label, std::get< uint8_t >( assemblyTarget ), instruction.m_literal );
     }
     else
     {
@@ -420,26 +494,18 @@ AssemblyGenerator::GenerateAssemblyForInstr(
         constexpr size_t operand2Index = 2u;
         assemblyOperand1 = GetOperandRegister( std::get< operand1Index >( relevantVars ), operand1Index, label );
         assemblyOperand2 = GetOperandRegister( std::get< operand2Index >( relevantVars ), operand2Index, label );
-    }
 
-    // Create and add an instruction from the gathered arguments.
-    Instruction instr = std::make_tuple( label, assemblyOpcode, assemblyTarget, assemblyOperand1, assemblyOperand2 );
-    m_assemblyInstructions.push_back( instr );
+        Instruction instr
+            = std::make_tuple( label, assemblyOpcode, assemblyTarget, assemblyOperand1, assemblyOperand2 );
+        AddInstruction( instr );
+    }
 
-    // If the target is a spilled var, write it back to memory after the instruction was added.
-    if ( std::holds_alternative< uint8_t >( assemblyTarget ) )
+    // If the target is a spilled var, write it back to memory after the instruction was added - unless the value is
+    // never read, in which case its live range ends here.
+    if ( g_invalidVarId != targetId && m_registerAllocator->IsSpilled( targetId )
+         && m_liveRanges.at( targetId ).ContinuesAfter( instrIndex ) )
     {
-        // If target is not an active var
-        if ( m_currentActiveVars.end() == m_currentActiveVars.find( targetStr ) )
-        {
-            if ( m_memoryLocations.end() == m_memoryLocations.find( targetStr ) )
-            {
-                LOG_ERROR_AND_THROW( "Inactive var could not be found in memory: '" + targetStr + "'",
-                                     std::runtime_error );
-            }
-            uint8_t memAddr = m_memoryLocations[targetStr];
-            SaveRegister( std::get< uint8_t >( assemblyTarget ), memAddr );
-        }
+        SaveRegister( std::get< uint8_t >( assemblyTarget ), GetMemoryLocation( targetId ) );
     }
 }
 
@@ -452,13 +518,12 @@ AssemblyGenerator::GenerateAssemblyForInstr(
  */
 Opcode
 AssemblyGenerator::GetAssemblyOpcode(
-    TAC::ThreeAddrInstruction::Ptr instruction
+    const TAC::ThreeAddrInstruction& instruction
 )
 {
-    if ( instruction->IsOperation() )
+    if ( instruction.IsOperation() )
     {
-        TAC::Operation::Ptr operation = instruction->GetOperation();
-        switch ( operation->opcode )
+        switch ( instruction.m_opcode )
         {
         case TAC::Opcode::ADD:
             return ::Opcode::ADD;
@@ -477,227 +542,104 @@ AssemblyGenerator::GetAssemblyOpcode(
         case TAC::Opcode::BRLT:
             return ::Opcode::BRLT;
         default:
-            LOG_ERROR_AND_THROW( "Unknown/invalid TAC opcode: " + std::to_string( operation->opcode ),
+            LOG_ERROR_AND_THROW( "Unknown/invalid TAC opcode: " + std::to_string( instruction.m_opcode ),
                                  std::invalid_argument );
             break;
         }
     }
+    else if ( instruction.m_flags & TAC::ThreeAddrInstruction::FLAG_LITERAL_RHS )
+    {
+        return Opcode::LDI;
+    }
     else
     {
-        TAC::Operand rhsOperand = std::get< TAC::Operand >( instruction->m_rhs );
-        if ( std::holds_alternative< std::string >( rhsOperand ) )
-        {
-            return Opcode::LD;
-        }
-        else
-        {
-            return Opcode::LDI;
-        }
+        return Opcode::LD;
     }
 }
 
 /**
- * \brief  Allocates or retrieves register or memory location corresponding to an identifier. If necessary, adds load
- *         instructions to retrieve value from memory. Returns the register that is now holding the variable.
+ * \brief  Gets the register holding a variable read by an instruction. If the variable is spilled, adds instructions
+ *         to load it from memory into a temporary register first.
  *
  * \param[in]      operand             The operand being requested.
- * \param[in]      operandIndex        The index of the operand within the parent instruction (0 for target, 1 and 2
- *                                     for the respective arguments). Used to determine which temporary register to use
- *                                     if the variable is spilled.
+ * \param[in]      operandIndex        The index of the operand within the parent instruction (1 and 2 for the
+ *                                     respective arguments). Used to determine which temporary register to use if the
+ *                                     variable is spilled.
  * \param[in,out]  labelOfParentInstr  Label of the instruction the operand belongs to. If prerequisite loads are added,
  *                                     the first will inherit this label, before erasing the label value so that the
  *                                     parent instruction no longer has the label.
+ *
+ * \return  The register holding the variable, or 0 if the operand is unused.
  */
 uint8_t
 AssemblyGenerator::GetOperandRegister(
-    const std::string& operand,
+    VarId operand,
     size_t operandIndex,
-    std::string& labelOfParentInstr
+    TAC::LabelId& labelOfParentInstr
 )
 {
     // Ignore if operand is empty/unused
-    if ( "" == operand )
+    if ( g_invalidVarId == operand )
     {
         return 0u;
     }
-
-    // If active, return register mapping
-    if ( m_currentActiveVars.end() != m_currentActiveVars.find( operand ) )
+    if ( !m_registerAllocator->IsSpilled( operand ) )
     {
-        return m_currentActiveVars[operand].first;
+        return m_registerAllocator->GetRegister( operand );
     }
-    // If inactive and in memory, it is either spilled (if there are no more available registers) or it has been saved
-    // from a previous block and needs loading in.
-    // TODO: if this is a target operand, it is being written to, so we don't need to worry about loading its existing
-    // value. We only need to work out and return its allocated register.
-    if ( m_memoryLocations.end() != m_memoryLocations.find( operand ) )
-    {
-        uint8_t memAddr = m_memoryLocations[operand];
-        // First load the memory address into a temporary reg
-        uint8_t memAddrTempReg = MEM_ADDR_TEMP_REG;;
-        AddLoadImmediate( labelOfParentInstr, memAddrTempReg, memAddr );
-        // If parent instruction had a non-empty label, this has been transferred to the load instruction, so we
-        // can erase it for when the parent instruction is created.
-        if ( "" != labelOfParentInstr )
-        {
-            labelOfParentInstr = "";
-        }
-
-        uint8_t registerToLoadInto;
-
-        if ( m_availableRegs.empty() )
-        {
-            // If there are no more free registers, keep it as inactive, but add a load into a temporary register.
-            // The calling method will save it again after the using instruction has been added, as it is still marked
-            // as inactive.
-            registerToLoadInto = FIRST_VAR_TEMP_REG + operandIndex;
-        }
-        else
-        {
-            bool isLhs = operandIndex == 0;
-            registerToLoadInto = AllocateRegisterAndMakeActive( operand, isLhs );
-        }
-        // Load into allocated register
-        Instruction loadInstr = std::make_tuple( "", Opcode::LD, registerToLoadInto, memAddrTempReg, 0u );
-        m_assemblyInstructions.push_back( loadInstr );
-        return registerToLoadInto;
-    }
-
 
-    // Else if inactive and NOT in memory, this is a new variable. Either allocate a register and set as active, or
-    // trigger a spill and update statuses as appropriate/add any necessary saves.
+    // First load the memory address into a temporary reg
+    uint8_t memAddrTempReg = MEM_ADDR_TEMP_REG;
+    AddLoadImmediate( labelOfParentInstr, memAddrTempReg, GetMemoryLocation( operand ) );
+    // If parent instruction had a label, this has been transferred to the load instruction, so we can erase it for
+    // when the parent instruction is created.
+    labelOfParentInstr = TAC::g_invalidLabelId;
 
-    // Expect the operand to be a target, otherwise it doesn't make sense to be a new variable.
-    if ( 0u != operandIndex )
-    {
-        LOG_ERROR_AND_THROW( "Unexpected operand index " + std::to_string( operandIndex )
-                             + " for new variable '" + operand + "'", std::runtime_error );
-    }
-
-    if ( m_availableRegs.empty() )
-    {
-        // If there are no available registers, spill the live interval with the latest end point (as the active list is
-        // sorted, this is just the latest out of the current var, and the last element in active).
-        uint8_t endPointOfOperand = m_liveIntervals[operand].second;
-        uint8_t endPointOfLastActiveVar = m_currentActiveVars.rbegin()->second.second;
-
-        if ( endPointOfOperand >= endPointOfLastActiveVar )
-        {
-            // To 'spill' this variable, we just need to not mark it as active, and assign it to a temporary register
-            // for the sake of this access instance. We also need to assign a memory address for it.
-            uint8_t allocatedMemAddr = GetNextMemoryLocation();
-            m_memoryLocations[operand] = allocatedMemAddr;
-
-            // Use the target temporary register, as this is the target operand.
-            return FIRST_VAR_TEMP_REG;
-        }
-        else
-        {
-            // To spill the last active var, we need to mark it as inactive, and give its register to our current var.
-            // If the active var has been written to, it needs to be saved first.
-            auto lastActiveElement = m_currentActiveVars.rbegin();
-            std::string activeVarId = lastActiveElement->first;
-            ActiveVarInfo activeVarInfo = lastActiveElement->second;
-
-            bool isLastActiveWrittenTo = activeVarInfo.second;
-            if ( isLastActiveWrittenTo )
-            {
-                SaveActiveVar( activeVarId );
-            }
-            // We don't need to worry about allocating it a memory location, because if it hasn't been written to, then
-            // it has been declared in a previous block, and thus already has a memory location.
-
-            // Replace the active var with our operand.
-            m_currentActiveVars.erase( activeVarId );
-            // For our new entry, as this is a LHS operand, mark it has having been written to.
-            activeVarInfo.second = true;
-            m_currentActiveVars.insert( { operand, activeVarInfo } );
-        }
-    }
-    else
-    {
-        // If there are available registers, allocate one. Don't need any pre-loads as this is a new variable.
-        constexpr bool isLhs{ true };
-        uint8_t allocatedReg = AllocateRegisterAndMakeActive( operand, isLhs );
-        return allocatedReg;
-    }
+    uint8_t registerToLoadInto = FIRST_VAR_TEMP_REG + operandIndex;
+    Instruction loadInstr
+        = std::make_tuple( TAC::g_invalidLabelId, Opcode::LD, registerToLoadInto, memAddrTempReg, 0u );
+    AddInstruction( loadInstr );
+    return registerToLoadInto;
 }
 
 /**
- * \brief  Allocates an available register to the given variable, removing it from available, and adding a mapping
- *         to the collection of active vars. Throws if there are no available registers.
+ * \brief  Gets the register to write the result of an instruction to. If the target is spilled, this is a temporary
+ *         register, which the caller must then save to the target's memory location. Its old value is never loaded, as
+ *         it is about to be overwritten.
  *
- * \param[in]  identifier  The variable being allocated a register.
- * \param[in]  isLhs       Whether the variable is on the LHS of an instruction, i.e. it is being written to.
+ * \param[in]  target  The variable being written to.
  *
- * \return  The allocated register number.
+ * \return  The register to write to.
  */
 uint8_t
-AssemblyGenerator::AllocateRegisterAndMakeActive(
-    const std::string& identifier,
-    bool isLhs
+AssemblyGenerator::GetTargetRegister(
+    VarId target
 )
 {
-    if ( m_availableRegs.empty() )
+    if ( m_registerAllocator->IsSpilled( target ) )
     {
-        LOG_ERROR_AND_THROW( "Cannot allocate register - no available ones left.", std::runtime_error );
+        return FIRST_VAR_TEMP_REG;
     }
-
-    auto extractedElement = m_availableRegs.extract( m_availableRegs.begin() );
-    uint8_t allocatedReg = extractedElement.value();
-
-    // If the operand is the LHS (target), this means it is written to.
-    const bool isWrittenTo{ isLhs };
-    AddToActive( identifier, allocatedReg, isWrittenTo );
-    return allocatedReg;
+    return m_registerAllocator->GetRegister( target );
 }
 
 /**
- * \brief  Adds the identifier and its allocated register to the map of active variables, sorted in ascending live
- *         interval end points.
+ * \brief  Gets the memory location allocated to a spilled variable. Throws if it doesn't have one.
  *
- * \param[in]  identifier         The variable being set as active.
- * \param[in]  allocatedRegister  The register allocated to the variable.
- * \param[in]  isWrittenTo        Whether the variable has been written to. This determines if it needs to be saved at
- *                                the end of the block.
+ * \param[in]  var  The spilled variable.
  *
- * \return  The equivalent assembly opcode.
+ * \return  The memory address.
  */
-void
-AssemblyGenerator::AddToActive(
-    const std::string& identifier,
-    uint8_t allocatedRegister,
-    bool isWrittenTo
+uint8_t
+AssemblyGenerator::GetMemoryLocation(
+    VarId var
 )
 {
-    ActiveVarInfo varInfo = std::make_pair( allocatedRegister, isWrittenTo );
-
-    if ( m_liveIntervals.end() == m_liveIntervals.find( identifier ) )
-    {
-        LOG_ERROR_AND_THROW( "No live interval could be found for '" + identifier + "'", std::runtime_error );
-    }
-    size_t endPointOfVar = m_liveIntervals[identifier].second;
-
-    bool inserted{ false };
-    for ( auto it = m_currentActiveVars.begin(); it != m_currentActiveVars.end(); ++it )
+    auto memoryLocation = m_memoryLocations.find( var );
+    if ( m_memoryLocations.end() == memoryLocation )
     {
-        std::string currentId = it->first;
-        if ( m_liveIntervals.end() == m_liveIntervals.find( currentId ) )
-        {
-            LOG_ERROR_AND_THROW( "No live interval could be found for '" + currentId + "'", std::runtime_error );
-        }
-        size_t currentEndPoint = m_liveIntervals[currentId].second;
-
-        // Insert the variable before the entry with the higher end point.
-        if ( endPointOfVar <= currentEndPoint )
-        {
-            m_currentActiveVars.insert( it, { identifier, varInfo } );
-            inserted = true;
-            break;
-        }
+        LOG_ERROR_AND_THROW( "Spilled var could not be found in memory: '" + m_variableTable->GetDebugName( var ) + "'",
+                             std::runtime_error );
     }
-    if ( !inserted )
-    {
-        m_currentActiveVars.insert( m_currentActiveVars.end(), {identifier, varInfo});
-    }
-}
\ No newline at end of file
+    return memoryLocation->second;
+}
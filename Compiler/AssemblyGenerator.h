@@ -4,9 +4,13 @@
 
 #pragma once
 
-#include <map>
+#include <unordered_map>
 
+#include "ControlFlowGraph.h"
+#include "LivenessAnalysis.h"
+#include "RegisterAllocator.h"
 #include "ThreeAddrInstruction.h"
+#include "VariableTable.h"
 
 namespace Assembly
 {
@@ -27,9 +31,9 @@ namespace Assembly
         BRLT
     };
 
-    using InstructionTarget = std::variant< uint8_t, std::string >;
+    using InstructionTarget = std::variant< uint8_t, TAC::LabelId >;
     // Label, opcode, target, operand1, operand2
-    using Instruction = std::tuple< std::string, Opcode, InstructionTarget, uint8_t, uint8_t >;
+    using Instruction = std::tuple< TAC::LabelId, Opcode, InstructionTarget, uint8_t, uint8_t >;
     using Instructions = std::vector< Instruction >;
 
     // There are 15 available registers in the target architecture - addressing is 4 bits, and address 0 is reserved as
@@ -50,50 +54,60 @@ namespace Assembly
 
     // Memory addresses should also start at 1, as 0 is considered invalid.
     constexpr size_t MEM_ADDR_OFFSET = 1u;
+    // Data memory is addressed by 8 bits, so this is the number of valid addresses.
+    constexpr size_t NUM_MEM_ADDRS = 256u - MEM_ADDR_OFFSET;
+
+    // Number of instructions needed to read a spilled variable: an LDI of its address (split over both operands), then
+    // an LD into a temporary register.
+    constexpr size_t SPILL_LOAD_COST = 2u;
+    // Number of instructions needed to write a spilled variable: an LDI of its address, then an STR.
+    constexpr size_t SPILL_STORE_COST = 2u;
+    // When estimating how often an instruction runs, assume each loop it is nested in runs this many times.
+    constexpr double LOOP_ITERATIONS_ESTIMATE = 10.0;
 
     class AssemblyGenerator
     {
     public:
         using Ptr = std::shared_ptr< AssemblyGenerator >;
-        using TacInstructions = std::vector< TAC::ThreeAddrInstruction::Ptr >;
+        using TacInstructions = std::vector< TAC::ThreeAddrInstruction >;
 
-        AssemblyGenerator( const TacInstructions& tacInstructions );
+        AssemblyGenerator( const TacInstructions& tacInstructions, VariableTable::Ptr variableTable );
 
         void CalculateBasicBlocks();
         void CalculateLiveIntervals();
+        void AllocateRegisters();
+
+        const TAC::ControlFlowGraph::Ptr& GetControlFlowGraph() const { return m_controlFlowGraph; }
+        const TAC::LivenessAnalysis::Ptr& GetLiveness() const { return m_liveness; }
+        const RegisterAllocator::Ptr& GetRegisterAllocator() const { return m_registerAllocator; }
+        size_t GetPeakMemoryUsage() const { return m_peakMemoryUsage; }
 
         Instructions GenerateAssemblyInstructions();
 
     protected:
-        using LiveInterval = std::pair< size_t, size_t >;
-
-        using InstrStringArgs = std::tuple< std::string, std::string, std::string >;
-        InstrStringArgs GetVarsFromInstruction( TAC::ThreeAddrInstruction::Ptr instruction );
-        void RecordVarUse( const std::string& identifier, size_t indexOfUse );
+        // Variables of the target and both operands of an instruction.
+        using InstrVarIds = std::tuple< VarId, VarId, VarId >;
+        InstrVarIds GetVarsFromInstruction( const TAC::ThreeAddrInstruction& instruction );
+        void AddLiveSegment( VarId var, size_t firstIndex, size_t lastIndex );
+        void RecordVarDef( VarId var, size_t indexOfDef );
 
-        void GenerateAssemblyForBasicBlock( size_t blockStart, size_t blockEnd );
+        RegisterAllocator::SpillCosts CalculateSpillCosts() const;
+        void AllocateMemoryLocations( const RegisterAllocator::SpillCosts& spillCosts );
 
-        // Stores the register number and whether a variable has been edited.
-        using ActiveVarInfo = std::pair< uint8_t, bool >;
-        // Stores mapping of active vars to information about them.
-        using ActiveVars = std::map< std::string, ActiveVarInfo >;
-        using AvailableRegs = std::set< uint8_t >;
+        void GenerateAssemblyForBasicBlock( size_t blockIndex );
 
-        void SaveActiveVar( const std::string& identifier );
         void SaveRegister( uint8_t registerToSave, uint8_t memoryAddress );
         std::pair< uint8_t, uint8_t > SplitImmediateOperand( uint8_t immediateValue );
-        void AddLoadImmediate( const std::string& label, uint8_t targetRegister, uint8_t immediateValue );
+        void AddLoadImmediate( TAC::LabelId label, uint8_t targetRegister, uint8_t immediateValue );
         void AddStoreInstruction( uint8_t registerToStore, uint8_t registerHoldingTarget );
-        uint8_t GetNextMemoryLocation();
+        void AddInstruction( const Instruction& instruction );
 
-        void ExpireOldIntervals( size_t currentInstrIndex );
+        void GenerateAssemblyForInstr( size_t instrIndex );
+        Opcode GetAssemblyOpcode( const TAC::ThreeAddrInstruction& instruction );
 
-        void GenerateAssemblyForInstr( TAC::ThreeAddrInstruction::Ptr instruction );
-        Opcode GetAssemblyOpcode( TAC::ThreeAddrInstruction::Ptr instruction );
-
-        uint8_t GetOperandRegister( const std::string& operand, size_t operandIndex, std::string& labelOfParentInstr );
-        uint8_t AllocateRegisterAndMakeActive( const std::string& identifier, bool isLhs );
-        void AddToActive( const std::string& identifier, uint8_t allocatedRegister, bool isWrittenTo );
+        uint8_t GetOperandRegister( VarId operand, size_t operandIndex, TAC::LabelId& labelOfParentInstr );
+        uint8_t GetTargetRegister( VarId target );
+        uint8_t GetMemoryLocation( VarId var );
 
         // The TAC instructions this class is responsible for converting. All indexes used in this class refer to the
         // index of instructions in this vector, as it is const.
@@ -101,20 +115,28 @@ namespace Assembly
 
         // Collection of assembly instructions as they are generated.
         Instructions m_assemblyInstructions;
-
-        // A collection of indexes of the start of basic blocks in the given program. If the program only consists of
-        // one block, it will contain {0}.
-        std::vector< size_t > m_basicBlockStarts;
-        // For each variable, store its live interval, i.e. the start and end index of when it is referred to.
-        std::map< std::string, LiveInterval > m_liveIntervals;
-        // Mapping between variable and its memory location, if it is either spilled or saved between blocks.
-        std::unordered_map< std::string, uint8_t > m_memoryLocations;
-
-        // The variables that are active for the current basic block.
-        // Stored in the format: identifier, register number, is edited?
-        ActiveVars m_currentActiveVars;
-        // The registers that are available for the current basic block.
-        AvailableRegs m_availableRegs;
+        // Registers known to hold a constant at the current point in the current basic block, and their values. Used to
+        // skip loading a value into a register that already holds it.
+        std::unordered_map< uint8_t, uint8_t > m_knownRegisterValues;
+        // Number of LDI instructions skipped because the register already held the value.
+        size_t m_numLoadImmediatesSkipped{ 0u };
+
+        // The basic blocks of the given program and the control flow between them. Null until calculated.
+        TAC::ControlFlowGraph::Ptr m_controlFlowGraph;
+        // Table of the variables referred to by the TAC, used for their names when logging.
+        VariableTable::Ptr m_variableTable;
+        // For each instruction, the variables it refers to. Calculated alongside the live intervals.
+        std::vector< InstrVarIds > m_instructionVars;
+        // Which variables are live at the boundaries of each basic block. Null until the live intervals are calculated.
+        TAC::LivenessAnalysis::Ptr m_liveness;
+        // For each variable, the instructions at which it holds a value that may still be read.
+        RegisterAllocator::LiveRanges m_liveRanges;
+        // Which register each variable is kept in, or whether it is spilled. Null until registers are allocated.
+        RegisterAllocator::Ptr m_registerAllocator;
+        // Mapping between each spilled variable and its memory location.
+        std::unordered_map< VarId, uint8_t > m_memoryLocations;
+        // The number of memory locations used to hold spilled variables.
+        size_t m_peakMemoryUsage{ 0u };
     };
 
 } // namespace Assembly
\ No newline at end of file
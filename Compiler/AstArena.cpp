@@ -0,0 +1,120 @@
+/**
+ * Contains definition of class which stores the nodes of Abstract Syntax Trees.
+ */
+
+#include "AstArena.h"
+#include "Logger.h"
+
+#include <stdexcept>
+
+/**
+ * \brief  Creates a node storing child nodes.
+ *
+ * \param[in]  nodeLabel  Label of the node, i.e. how its children relate to each other.
+ * \param[in]  children   The child nodes, in order. Must all be stored in this arena. If empty, the node's storage is
+ *                        not in use.
+ *
+ * \return  View of the created node.
+ */
+AstNode
+AstArena::CreateNode(
+    GrammarSymbols::Symbol nodeLabel,
+    const AstNode::Children& children
+)
+{
+    NodeRecord record{ nodeLabel, static_cast< uint32_t >( m_childIndices.size() ),
+                       static_cast< uint32_t >( children.size() ), false };
+    if ( m_childIndices.size() + children.size() > std::numeric_limits< uint32_t >::max() )
+    {
+        LOG_ERROR_AND_THROW( "Too many AST child nodes to store in the arena.", std::runtime_error );
+    }
+
+    for ( const AstNode& child : children )
+    {
+        if ( this != child.GetArena() )
+        {
+            LOG_ERROR_AND_THROW( "Child node of " + GrammarSymbols::ConvertSymbolToString( nodeLabel )
+                                 + " is null or belongs to a different arena.", std::invalid_argument );
+        }
+    }
+    for ( const AstNode& child : children )
+    {
+        m_childIndices.push_back( child.GetIndex() );
+    }
+    return AstNode( this, AddNodeRecord( record ) );
+}
+
+/**
+ * \brief  Creates a node wrapping a token.
+ *
+ * \param[in]  nodeLabel  Label of the node.
+ * \param[in]  token      The token to store.
+ *
+ * \return  View of the created node.
+ */
+AstNode
+AstArena::CreateNode(
+    GrammarSymbols::Symbol nodeLabel,
+    const Token& token
+)
+{
+    NodeRecord record{ nodeLabel, static_cast< uint32_t >( m_tokens.size() ), 0u, true };
+    if ( m_tokens.size() >= std::numeric_limits< uint32_t >::max() )
+    {
+        LOG_ERROR_AND_THROW( "Too many AST tokens to store in the arena.", std::runtime_error );
+    }
+
+    m_tokens.push_back( token );
+    return AstNode( this, AddNodeRecord( record ) );
+}
+
+/**
+ * \brief  Assigns a symbol table to a node. This is the only modification that can be made to a node once it has been
+ *         created.
+ *
+ * \param[in]  node         The scope-defining node. Must be stored in this arena.
+ * \param[in]  symbolTable  The symbol table of the scope the node defines.
+ */
+void
+AstArena::SetSymbolTable(
+    AstNode node,
+    SymbolTable::Ptr symbolTable
+)
+{
+    if ( this != node.GetArena() )
+    {
+        LOG_ERROR_AND_THROW( "Cannot assign symbol table: node is null or belongs to a different arena.",
+                             std::invalid_argument );
+    }
+    m_symbolTables[node.GetIndex()] = std::move( symbolTable );
+}
+
+/**
+ * \brief  Gets the number of nodes created in the arena, including any which are no longer part of a tree.
+ */
+size_t
+AstArena::GetNumNodes() const
+{
+    return m_nodes.size();
+}
+
+/**
+ * \brief  Stores a node.
+ *
+ * \param[in]  record  Storage for the node.
+ *
+ * \return  Index of the stored node.
+ */
+AstNodeIndex
+AstArena::AddNodeRecord(
+    const NodeRecord& record
+)
+{
+    if ( m_nodes.size() >= g_invalidAstNodeIndex )
+    {
+        LOG_ERROR_AND_THROW( "Too many AST nodes to store in the arena.", std::runtime_error );
+    }
+
+    m_nodes.push_back( record );
+    return static_cast< AstNodeIndex >( m_nodes.size() - 1u );
+}
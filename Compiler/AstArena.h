@@ -0,0 +1,62 @@
+/**
+ * Contains declaration of class which stores the nodes of Abstract Syntax Trees.
+ */
+
+#pragma once
+#include "AstNode.h"
+
+#include <unordered_map>
+
+/**
+ * \brief  Stores every node of the Abstract Syntax Trees created during a compilation. Nodes are held in flat arrays
+ *         and refer to each other by 32-bit index, with the children of each node stored contiguously. Nodes are never
+ *         freed individually: they are all freed together when the arena is destroyed, at the end of the compilation.
+ *
+ *         Nodes are accessed through AstNode views, which must not outlive the arena.
+ */
+class AstArena
+{
+public:
+    using UPtr = std::unique_ptr< AstArena >;
+    using Ptr = std::shared_ptr< AstArena >;
+
+    AstArena() = default;
+
+    // Views refer to the arena by address, so it can't be copied or moved.
+    AstArena( const AstArena& ) = delete;
+    AstArena& operator=( const AstArena& ) = delete;
+
+    AstNode CreateNode( GrammarSymbols::Symbol nodeLabel, const AstNode::Children& children );
+    AstNode CreateNode( GrammarSymbols::Symbol nodeLabel, const Token& token );
+
+    void SetSymbolTable( AstNode node, SymbolTable::Ptr symbolTable );
+
+    size_t GetNumNodes() const;
+
+private:
+    friend class AstNode;
+
+    /**
+     * \brief  Storage for one node. A node either stores a token, in which case first is the token's index in
+     *         m_tokens, or a range of children, in which case first is the position of its first child in
+     *         m_childIndices.
+     */
+    struct NodeRecord
+    {
+        GrammarSymbols::Symbol nodeLabel;
+        uint32_t first;
+        uint32_t numChildren;
+        bool isStoringToken;
+    };
+
+    AstNodeIndex AddNodeRecord( const NodeRecord& record );
+
+    std::vector< NodeRecord > m_nodes;
+    // Indices of the children of every node, each node's children stored contiguously and in order.
+    std::vector< AstNodeIndex > m_childIndices;
+    std::vector< Token > m_tokens;
+
+    // Symbol tables of the scope-defining nodes, assigned after the tree is created. Few nodes have one, so they are
+    // stored separately rather than in every node.
+    std::unordered_map< AstNodeIndex, SymbolTable::Ptr > m_symbolTables;
+};
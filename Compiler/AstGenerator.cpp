@@ -4,23 +4,47 @@
 
 #include "AstGenerator.h"
 #include "Logger.h"
+#include "PredictionTable.h"
+#include <algorithm>
 #include <stdexcept>
 
+// Opening and closing bracket tokens, which the token index pairs up.
+static const std::vector< std::pair< TokenType, TokenType > > g_bracketPairs{
+    { TokenType::PAREN_OPEN, TokenType::PAREN_CLOSE },
+    { TokenType::BRACE_OPEN, TokenType::BRACE_CLOSE },
+};
+
+/**
+ * Constructor for AstGenerator.
+ *
+ * \param[in]  tokens                The tokens to parse. Must outlive this object.
+ * \param[in]  startingNt            Non-terminal symbol from which to start parsing the program.
+ * \param[in]  arena                 Arena in which to create the AST nodes. Must outlive the generated AST.
+ * \param[in]  symbolTableGenerator  If given, the symbol tables for the AST are generated while it is parsed, rather
+ *                                   than needing a separate pass afterwards.
+ */
 AstGenerator::AstGenerator(
     const Tokens& tokens,
-    GrammarSymbols::NT startingNt
+    GrammarSymbols::NT startingNt,
+    AstArena& arena,
+    SymbolTableGenerator::Ptr symbolTableGenerator
 )
 : m_tokens( tokens ),
-  m_startingNonTerminal( startingNt )
+  m_arena( arena ),
+  m_startingNonTerminal( startingNt ),
+  m_expressionParser( tokens, arena ),
+  m_symbolTableGenerator( symbolTableGenerator )
 {
+    BuildTokenIndex();
 }
 
 /**
- * \brief Generates an Abstract Syntax tree from the class's stored set of tokens.
+ * \brief Generates an Abstract Syntax tree from the class's stored set of tokens. If a symbol table generator was given,
+ *        also generates the symbol tables for the tree, throwing if the program uses identifiers incorrectly.
  *
- * \return  Pointer to the root of the generated tree. Nullptr if tokens are invalid.
+ * \return  The root of the generated tree. Null if tokens are invalid.
  */
-AstNode::Ptr
+AstNode
 AstGenerator::GenerateAst()
 {
     if ( m_tokens.empty() )
@@ -36,12 +60,54 @@ AstGenerator::GenerateAst()
 
     size_t currentTokenIndex{ 0u };
     constexpr bool allowLeftoverTokens{ false };
-    return GenerateAstFromNt( currentTokenIndex, m_startingNonTerminal, allowLeftoverTokens );
+    m_rootSymbolTable = nullptr;
+    AstNode root = GenerateAstFromNt( currentTokenIndex, m_startingNonTerminal, allowLeftoverTokens );
+
+    if ( nullptr != m_symbolTableGenerator && nullptr != root )
+    {
+        if ( nullptr != m_rootSymbolTable )
+        {
+            m_arena.SetSymbolTable( root, m_rootSymbolTable );
+        }
+        // If the root isn't a list of statements, its symbols haven't been added yet.
+        else
+        {
+            m_symbolTableGenerator->GenerateSymbolTableForAst( root );
+        }
+    }
+
+    // The memo table is only needed while parsing. Sub-trees from failed attempts stay in the arena until the end of
+    // the compilation, when the whole arena is freed.
+    m_memoisedParses.clear();
+    return root;
+}
+
+/**
+ * \brief  Packs the inputs that determine the result of parsing a non-terminal into a key for the memo table.
+ *
+ * \param[in]  nt                   The non-terminal being parsed.
+ * \param[in]  startTokenIndex      Index of the first token to parse.
+ * \param[in]  allowLeftoverTokens  Whether leftover tokens are allowed after the non-terminal.
+ *
+ * \return  Key unique to the combination of inputs.
+ */
+uint64_t
+AstGenerator::GetMemoKey(
+    GrammarSymbols::NT nt,
+    size_t startTokenIndex,
+    bool allowLeftoverTokens
+)
+{
+    // Non-terminals are numbered from SymbolType::NonTerminal, so the low byte identifies them.
+    uint64_t ntIndex = static_cast< uint64_t >( nt ) & ~static_cast< uint64_t >( SymbolType::BITMASK );
+    return ( static_cast< uint64_t >( startTokenIndex ) << 9u ) | ( ntIndex << 1u )
+           | static_cast< uint64_t >( allowLeftoverTokens );
 }
 
 /**
  * \brief Generates an Abstract Syntax tree from the class's stored set of tokens. If the syntax of the tokens
- *        is invalid, it returns nullptr.
+ *        is invalid, it returns nullptr. Results are memoised, so each non-terminal is only parsed once from a given
+ *        token index.
  *
  * \param[in,out]  currentTokenIndex    Index of the next token to parse. Is only modified upon successful AST creation.
  * \param[in]      nt                   Non-terminal symbol identifying the rule to start the tree generation from.
@@ -49,17 +115,16 @@ AstGenerator::GenerateAst()
  *                                      resolving the rule. Can be used for root node of AST, as well as ending NTs in
  *                                      a rule.
  *
- * \return  Pointer to the root of the generated tree. Nullptr if tokens are invalid.
+ * \return  The root of the generated tree. Null if tokens are invalid.
  */
-AstNode::Ptr
+AstNode
 AstGenerator::GenerateAstFromNt(
     size_t& currentTokenIndex,
     GrammarSymbols::NT nt,
     bool allowLeftoverTokens
 )
 {
-    std::string startingNtString = GrammarSymbols::ConvertSymbolToString( nt );
-    LOG_INFO_MEDIUM_LEVEL( "Generating AST for starting symbol " + startingNtString );
+    LOG_INFO_MEDIUM_LEVEL( "Generating AST for starting symbol " + GrammarSymbols::ConvertSymbolToString( nt ) );
 
     if ( m_tokens.empty() )
     {
@@ -70,29 +135,80 @@ AstGenerator::GenerateAstFromNt(
 
     if ( 0u == g_nonTerminalRuleSets.count( nt ) )
     {
-        LOG_ERROR_AND_THROW( "Starting symbol " + startingNtString + " has no associated rules.", std::runtime_error );
+        LOG_ERROR_AND_THROW( "Starting symbol " + GrammarSymbols::ConvertSymbolToString( nt )
+                             + " has no associated rules.", std::runtime_error );
+    }
+
+    const uint64_t memoKey = GetMemoKey( nt, currentTokenIndex, allowLeftoverTokens );
+    auto memoised = m_memoisedParses.find( memoKey );
+    if ( m_memoisedParses.end() != memoised )
+    {
+        LOG_INFO_MEDIUM_LEVEL( "Reusing previous result for " + GrammarSymbols::ConvertSymbolToString( nt ) );
+        if ( nullptr != memoised->second.first )
+        {
+            currentTokenIndex = memoised->second.second;
+        }
+        return memoised->second.first;
+    }
+
+    if ( ExpressionParser::IsExpressionNt( nt ) )
+    {
+        size_t tokenIndexCopy = currentTokenIndex;
+        AstNode node = m_expressionParser.ParseExpression( tokenIndexCopy, nt );
+        if ( nullptr != node && !allowLeftoverTokens && tokenIndexCopy < m_tokens.size() )
+        {
+            LOG_INFO_MEDIUM_LEVEL( "Leftover tokens (" + Token::ConvertTokensToString( m_tokens, tokenIndexCopy, 3 )
+                                   + "...) after expression: rejecting it." );
+            node = nullptr;
+        }
+        m_memoisedParses.emplace( memoKey, MemoisedParse( node, tokenIndexCopy ) );
+
+        if ( nullptr != node )
+        {
+            currentTokenIndex = tokenIndexCopy;
+        }
+        return node;
+    }
+
+    GrammarSymbols::NT elementNt;
+    if ( IsListNt( nt, elementNt ) )
+    {
+        size_t tokenIndexCopy = currentTokenIndex;
+        AstNode node = GenerateListFromNt( tokenIndexCopy, nt, elementNt, allowLeftoverTokens );
+        m_memoisedParses.emplace( memoKey, MemoisedParse( node, tokenIndexCopy ) );
+
+        if ( nullptr != node )
+        {
+            currentTokenIndex = tokenIndexCopy;
+        }
+        return node;
     }
 
     // Deque used to store symbols that have already been parsed correctly. This is to allow backtracking on a rule,
     // to try another that branches off from a certain point.
     std::deque< ParsedSymbolInfo > parsedStack{};
 
-    // Try each rule belonging to the starting NT symbol
-    Rules rules =  g_nonTerminalRuleSets.find( nt )->second;
-    for ( Rule currentRule : rules )
+    // Try each rule belonging to the starting NT symbol that could start with the next token
+    const Rules& rules = g_nonTerminalRuleSets.find( nt )->second;
+    const TokenType nextToken = currentTokenIndex < m_tokens.size() ? m_tokens[currentTokenIndex].m_type
+                                                                     : TokenType::INVALID_TOKEN;
+    for ( size_t ruleIndex : PredictionTable::GetInstance().GetCandidateRules( nt, nextToken ) )
     {
+        const Rule& currentRule = rules[ruleIndex];
+
         // Child elements of the node we are building
         AstNode::Elements elements;
 
         // Make copy of token index to try this rule with
         size_t tokenIndexCopy = currentTokenIndex;
 
-        std::string ruleString = GrammarRules::ConvertRuleToString( currentRule );
-        LOG_INFO_MEDIUM_LEVEL( "Inside " + startingNtString + ": trying rule: " + ruleString );
+        LOG_INFO_MEDIUM_LEVEL( "Inside " + GrammarSymbols::ConvertSymbolToString( nt ) + ": trying rule: "
+                               + GrammarRules::ConvertRuleToString( currentRule ) );
         // If rule doesn't match tokens list, ignore and continue
         if ( !TryRule( tokenIndexCopy, currentRule, allowLeftoverTokens, elements, parsedStack ) )
         {
-            LOG_INFO_MEDIUM_LEVEL( "Inside " + startingNtString +  ": no match for rule '" + ruleString + "'" );
+            LOG_INFO_MEDIUM_LEVEL( "Inside " + GrammarSymbols::ConvertSymbolToString( nt ) +  ": no match for rule '"
+                                   + GrammarRules::ConvertRuleToString( currentRule ) + "'" );
             continue;
         }
 
@@ -105,31 +221,158 @@ AstGenerator::GenerateAstFromNt(
             if ( tokenIndexCopy < m_tokens.size() )
             {
                 LOG_INFO_MEDIUM_LEVEL( "Leftover tokens (" + Token::ConvertTokensToString( m_tokens, tokenIndexCopy, 3 )
-                                       + "...) at the end: rejecting rule '" + ruleString );
+                                       + "...) at the end: rejecting rule '"
+                                       + GrammarRules::ConvertRuleToString( currentRule ) );
                 continue;
             }
         }
 
         if ( elements.empty() )
         {
-            LOG_ERROR_AND_THROW( "Rule match found for '" + ruleString + "' but no child nodes or tokens created.",
+            LOG_ERROR_AND_THROW( "Rule match found for '" + GrammarRules::ConvertRuleToString( currentRule )
+                                 + "' but no child nodes or tokens created.",
                                  std::runtime_error );
         }
 
+        LOG_INFO_MEDIUM_LEVEL( "Found match for '" + GrammarRules::ConvertRuleToString( currentRule )
+                               + "', creating AST node from children..." );
+        // Construct an AST node from children
+        AstNode node = AstNode::GetNodeFromRuleElements( m_arena, elements, nt );
+        m_memoisedParses.emplace( memoKey, MemoisedParse( node, tokenIndexCopy ) );
+
         // Modify the output parameter to reflect the new token index, as the rule match was a success
         currentTokenIndex = tokenIndexCopy;
-
-        LOG_INFO_MEDIUM_LEVEL( "Found match for '" + ruleString + "', creating AST node from children..." );
-        // Construct an AST node from children
-        return AstNode::GetNodeFromRuleElements( elements, nt );
+        return node;
     }
 
     // If the loop is exited and no rule match has been found
-    std::string errMsg = "No matching rule could be found for start symbol " + startingNtString + ": returning nullptr.";
-    LOG_INFO_MEDIUM_LEVEL( errMsg );
+    LOG_INFO_MEDIUM_LEVEL( "No matching rule could be found for start symbol "
+                           + GrammarSymbols::ConvertSymbolToString( nt ) + ": returning nullptr." );
+    m_memoisedParses.emplace( memoKey, MemoisedParse( nullptr, currentTokenIndex ) );
     return nullptr;
 }
 
+/**
+ * \brief  Queries whether a non-terminal is a right-recursive list of another non-terminal, i.e. its rules are exactly
+ *         { Element, List } and { Element }, as for Block.
+ *
+ * \param[in]   nt         The non-terminal to check.
+ * \param[out]  elementNt  The non-terminal of each list element. Only set if the non-terminal is a list.
+ *
+ * \return  True if the non-terminal is a list, false otherwise.
+ */
+bool
+AstGenerator::IsListNt(
+    GrammarSymbols::NT nt,
+    GrammarSymbols::NT& elementNt
+)
+{
+    const Rules& rules = g_nonTerminalRuleSets.find( nt )->second;
+    if ( 2u != rules.size() || 2u != rules[0].size() || 1u != rules[1].size() || nt != rules[0][1]
+         || rules[0][0] != rules[1][0] || SymbolType::NonTerminal != GrammarSymbols::GetSymbolType( rules[1][0] ) )
+    {
+        return false;
+    }
+    elementNt = static_cast< GrammarSymbols::NT >( rules[1][0] );
+    return true;
+}
+
+/**
+ * \brief  Parses a list non-terminal (see IsListNt) by parsing as many elements as possible in a loop, rather than
+ *         recursing once per element. Produces a single node holding every element as a child, so a program of N
+ *         sections is one Block node with N children rather than a chain of N nested Block nodes. As with any other
+ *         rule, a list of one element is replaced by the element itself.
+ *
+ * \param[in,out]  currentTokenIndex    Index of the next token to parse. Is only modified upon successful AST creation.
+ * \param[in]      nt                   The list non-terminal.
+ * \param[in]      elementNt            The non-terminal of each list element.
+ * \param[in]      allowLeftoverTokens  If set to false, will return nullptr if there are leftover tokens after the
+ *                                      last element that can be parsed.
+ *
+ * \return  The generated node. Null if not even one element could be parsed.
+ *
+ *         If this is the root list of the program and symbol tables are being generated while parsing, each element is
+ *         added to the root symbol table as soon as it has been parsed.
+ */
+AstNode
+AstGenerator::GenerateListFromNt(
+    size_t& currentTokenIndex,
+    GrammarSymbols::NT nt,
+    GrammarSymbols::NT elementNt,
+    bool allowLeftoverTokens
+)
+{
+    // The root list is the only one parsed from the first token with no leftover tokens allowed.
+    const bool isRootList = nullptr != m_symbolTableGenerator && m_startingNonTerminal == nt
+                            && 0u == currentTokenIndex && !allowLeftoverTokens;
+
+    AstNode::Elements elements;
+    size_t tokenIndexCopy = currentTokenIndex;
+    while ( tokenIndexCopy < m_tokens.size() )
+    {
+        constexpr bool allowLeftoverTokensOnElement{ true };
+        AstNode element = GenerateAstFromNt( tokenIndexCopy, elementNt, allowLeftoverTokensOnElement );
+        if ( nullptr == element )
+        {
+            break;
+        }
+        elements.push_back( element );
+
+        if ( isRootList )
+        {
+            AddToRootSymbolTable( elements );
+        }
+    }
+
+    if ( elements.empty() )
+    {
+        LOG_INFO_MEDIUM_LEVEL( "No " + GrammarSymbols::ConvertSymbolToString( elementNt ) + " found for "
+                               + GrammarSymbols::ConvertSymbolToString( nt ) + ": returning nullptr." );
+        return nullptr;
+    }
+    if ( !allowLeftoverTokens && tokenIndexCopy < m_tokens.size() )
+    {
+        LOG_INFO_MEDIUM_LEVEL( "Leftover tokens (" + Token::ConvertTokensToString( m_tokens, tokenIndexCopy, 3 )
+                               + "...) after " + GrammarSymbols::ConvertSymbolToString( nt ) + ": rejecting it." );
+        return nullptr;
+    }
+
+    LOG_INFO_MEDIUM_LEVEL( "Found " + std::to_string( elements.size() ) + " "
+                           + GrammarSymbols::ConvertSymbolToString( elementNt ) + " for "
+                           + GrammarSymbols::ConvertSymbolToString( nt ) + ", creating AST node from children..." );
+    AstNode node = AstNode::GetNodeFromRuleElements( m_arena, elements, nt );
+    currentTokenIndex = tokenIndexCopy;
+    return node;
+}
+
+/**
+ * \brief  Adds the latest element of the program's root list to the root symbol table, while its nodes are still in
+ *         cache. Any identifier errors are thrown as soon as the element is parsed, as they would be by the separate
+ *         symbol table pass. The element's sub-tree is still walked to find its symbols: symbols aren't added as each
+ *         rule is reduced, as the parser backtracks, so a reduction may later be discarded.
+ *
+ *         A list of one element is replaced by the element itself, which then defines the root scope rather than being
+ *         in it, so nothing is added until the second element has been parsed.
+ *
+ * \param[in]  rootListElements  The elements of the root list parsed so far.
+ */
+void
+AstGenerator::AddToRootSymbolTable(
+    const AstNode::Elements& rootListElements
+)
+{
+    if ( 2u > rootListElements.size() )
+    {
+        return;
+    }
+    if ( 2u == rootListElements.size() )
+    {
+        m_rootSymbolTable = std::make_shared< SymbolTable >( nullptr );
+        m_symbolTableGenerator->PopulateTableFromNode( m_rootSymbolTable, std::get< AstNode >( rootListElements[0] ) );
+    }
+    m_symbolTableGenerator->PopulateTableFromNode( m_rootSymbolTable, std::get< AstNode >( rootListElements.back() ) );
+}
+
 /**
  * \brief  Tries to resolve a given rule (collection of symbols) from the stored list of tokens. Increments the token
  *         index as it consumes rule symbols. Populates the container of AST elements with gathered nodes/tokens from
@@ -158,43 +401,43 @@ AstGenerator::TryRule(
     std::deque< ParsedSymbolInfo >& currentParsedDeque
 )
 {
-    std::string ruleString = GrammarRules::ConvertRuleToString( rule );
-    LOG_INFO_MEDIUM_LEVEL( "Trying rule " + ruleString + " with tokens: "
+    LOG_INFO_MEDIUM_LEVEL( "Trying rule " + GrammarRules::ConvertRuleToString( rule ) + " with tokens: "
                            + Token::ConvertTokensToString( m_tokens, currentTokenIndex, 3 )
                            + "..." );
 
-    Rule ruleWorkingCopy = rule;
     // If there are parsed symbols from a previous rule check, check for an overlap with the start of this rule
-    ReusePreviouslyParsedSymbols( currentTokenIndex, ruleWorkingCopy, elementsToPopulate, currentParsedDeque );
+    size_t numReusedSymbols = ReusePreviouslyParsedSymbols( currentTokenIndex, rule, elementsToPopulate,
+                                                            currentParsedDeque );
 
     // If there are still symbols to parse
-    if ( !ruleWorkingCopy.empty() )
+    if ( numReusedSymbols < rule.size() )
     {
         // Perform look-ahead, and check that any terminal symbols in the rule are present, and in order.
         // This allows early-stopping without generating further sub-trees.
-        if ( !PerformLookAhead( currentTokenIndex, rule ) )
+        if ( !PerformLookAhead( currentTokenIndex, rule, numReusedSymbols ) )
             {
             // Failure reason already logged
                     return false;
         }
 
         // Check each symbol in the rule for a match
-        for ( size_t i = 0; i < ruleWorkingCopy.size(); ++i )
+        for ( size_t i = numReusedSymbols; i < rule.size(); ++i )
         {
-            Symbol symbol = ruleWorkingCopy[i];
+            Symbol symbol = rule[i];
 
-            std::string symbolString = GrammarSymbols::ConvertSymbolToString( symbol );
-            LOG_INFO_MEDIUM_LEVEL( "Trying symbol '" + symbolString + "' in rule '" + ruleString + "'" );
+            LOG_INFO_MEDIUM_LEVEL( "Trying symbol '" + GrammarSymbols::ConvertSymbolToString( symbol ) + "' in rule '"
+                                   + GrammarRules::ConvertRuleToString( rule ) + "'" );
 
             bool allowLeftoverTokensOnSymbol{ true };
-            if ( !allowLeftoverTokensOnLastSymbol && ruleWorkingCopy.size() - 1 == i )
+            if ( !allowLeftoverTokensOnLastSymbol && rule.size() - 1 == i )
             {
                 allowLeftoverTokensOnSymbol = false;
             }
             if ( !TrySymbol( currentTokenIndex, symbol, allowLeftoverTokensOnSymbol, elementsToPopulate, currentParsedDeque ) )
             {
-                LOG_INFO_MEDIUM_LEVEL( "Symbol check '" + symbolString + "' failed, rejecting rule '"
-                                       + ruleString + "'" );
+                LOG_INFO_MEDIUM_LEVEL( "Symbol check '" + GrammarSymbols::ConvertSymbolToString( symbol )
+                                       + "' failed, rejecting rule '" + GrammarRules::ConvertRuleToString( rule )
+                                       + "'" );
                 return false;
             }
         }
@@ -202,7 +445,8 @@ AstGenerator::TryRule(
     }
 
     // If no symbols have been rejected, the rule matches.
-    LOG_INFO_LOW_LEVEL( "No symbols rejected, returning true for rule '" + ruleString + "'" );
+    LOG_INFO_LOW_LEVEL( "No symbols rejected, returning true for rule '" + GrammarRules::ConvertRuleToString( rule )
+                        + "'" );
     return true;
 }
 
@@ -215,7 +459,6 @@ AstGenerator::TrySymbol(
     std::deque< ParsedSymbolInfo >& currentParsedDeque
 )
 {
-    std::string symbolString = GrammarSymbols::ConvertSymbolToString( symbol );
             // Reject if we've run out of tokens to consume
             if ( currentTokenIndex >= m_tokens.size() )
             {
@@ -232,29 +475,30 @@ AstGenerator::TrySymbol(
             // If symbol is terminal
             if ( SymbolType::Terminal == symbolType )
             {
-                LOG_INFO_LOW_LEVEL( "Symbol is terminal: '" + symbolString + "'" );
+                LOG_INFO_LOW_LEVEL( "Symbol is terminal: '" + GrammarSymbols::ConvertSymbolToString( symbol ) + "'" );
                 TokenType terminalSymbol = static_cast< TokenType >( symbol );
-                Token::Ptr currentToken = m_tokens[currentTokenIndex];
+                const Token& currentToken = m_tokens[currentTokenIndex];
 
                 // Check rule symbol matches the token currently being pointed at
-                if ( terminalSymbol != currentToken->m_type )
+                if ( terminalSymbol != currentToken.m_type )
                 {
-                    LOG_INFO_MEDIUM_LEVEL( "Symbol doesn't match current token " + currentToken->ToString() + ", rejecting rule." );
+                    LOG_INFO_MEDIUM_LEVEL( "Symbol doesn't match current token " + currentToken.ToString() + ", rejecting rule." );
                     return false;
                 }
-                LOG_INFO_MEDIUM_LEVEL( "Symbol matches current token " + currentToken->ToString() + "." );
+                LOG_INFO_MEDIUM_LEVEL( "Symbol matches current token " + currentToken.ToString() + "." );
 
                 // If token type not to be skipped (e.g. {}, (), ;), add to elements and continue through the rest of the rule.
                 if ( GrammarSymbols::g_skipForAstTerminals.end() == GrammarSymbols::g_skipForAstTerminals.find( terminalSymbol ) )
                 {
                     elementToStore = currentToken;
                     foundElementToStore = true;
-                    LOG_INFO_LOW_LEVEL( "Adding '" + symbolString + "' to elements." );
+                    LOG_INFO_LOW_LEVEL( "Adding '" + GrammarSymbols::ConvertSymbolToString( symbol )
+                                        + "' to elements." );
                 }
                 else
                 {
                     // If token type is to be skipped, pop off the front without doing anything else
-                    LOG_INFO_LOW_LEVEL( "Skipping token " + currentToken->ToString() );
+                    LOG_INFO_LOW_LEVEL( "Skipping token " + currentToken.ToString() );
                 }
                 currentTokenIndex++;
             }
@@ -262,7 +506,8 @@ AstGenerator::TrySymbol(
             // Else if symbol non terminal, call get AST node on that rule name
             else if ( SymbolType::NonTerminal == symbolType )
             {
-                LOG_INFO_LOW_LEVEL( "Symbol is non-terminal: '" + symbolString + "'" );
+                LOG_INFO_LOW_LEVEL( "Symbol is non-terminal: '" + GrammarSymbols::ConvertSymbolToString( symbol )
+                                    + "'" );
                 GrammarSymbols::NT nonTerminalSymbol = static_cast< NT >( symbol );
 
                 // If not allowed leftover tokens AND this is the last symbol in the rule,
@@ -270,10 +515,10 @@ AstGenerator::TrySymbol(
         bool callWithAllowLeftoverTokens{ allowLeftoverTokens };
 
                 // Generate sub-tree from the non-terminal symbol and add to elements.
-                LOG_INFO_LOW_LEVEL( "Generating AST for '" + symbolString + "'" );
+                LOG_INFO_LOW_LEVEL( "Generating AST for '" + GrammarSymbols::ConvertSymbolToString( symbol ) + "'" );
 
                 size_t tokenIndexCopy = currentTokenIndex;
-                AstNode::Ptr astNode = GenerateAstFromNt( tokenIndexCopy, nonTerminalSymbol, callWithAllowLeftoverTokens );
+                AstNode astNode = GenerateAstFromNt( tokenIndexCopy, nonTerminalSymbol, callWithAllowLeftoverTokens );
 
                 if ( nullptr == astNode )
                 {
@@ -281,7 +526,8 @@ AstGenerator::TrySymbol(
                     return false;
                 }
 
-                LOG_INFO_MEDIUM_LEVEL( "Successfully generated AST for '" + symbolString + "': adding to elements." );
+                LOG_INFO_MEDIUM_LEVEL( "Successfully generated AST for '"
+                                       + GrammarSymbols::ConvertSymbolToString( symbol ) + "': adding to elements." );
                 elementToStore = astNode;
                 foundElementToStore = true;
 
@@ -310,105 +556,277 @@ AstGenerator::TrySymbol(
 
 /**
  * \brief  Checks the deque of already parsed symbols, and compares them to the beginning of this rule. If the start
- *         of this rule has already been parsed, pop it off the front of the rule, and add it to the elements vector.
+ *         of this rule has already been parsed, skip past it, and add it to the elements vector.
  *
  * \param[in,out]  currentTokenIndex   Index of the next token to parse, i.e. from which to start the check. If symbols
  *                                     are skipped, this is updated.
- * \param[in,out]  ruleWorkingCopy     The current rule that is being tested. If symbols are skipped, they are popped
- *                                     off the front.
+ * \param[in]      rule                The current rule that is being tested.
  * \param[out]     elementsToPopulate  Child nodes or tokens belonging to the rule being tested. Is populated with
  *                                     elements belonging to previously parsed symbols.
  * \param[in,out]  currentParsedDeque  Deque of already verified symbols for the current set of rules. Any symbols that
  *                                     do not overlap with the current rule are removed from the end.
+ *
+ * \return  Number of symbols at the start of the rule that were skipped.
  */
-void
+size_t
 AstGenerator::ReusePreviouslyParsedSymbols(
     size_t& currentTokenIndex,
-    Rule& ruleWorkingCopy,
+    const Rule& rule,
     AstNode::Elements& elementsToPopulate,
     std::deque< ParsedSymbolInfo >& currentParsedDeque
 )
 {
-    if ( 0u < currentParsedDeque.size() )
+    // If the front symbol of the rule matches the bottom of the stack, it can be skipped.
+    size_t dequeIndex{ 0u };
+    while ( dequeIndex < rule.size()
+            && dequeIndex < currentParsedDeque.size()
+            && rule[dequeIndex] == std::get< Symbol >( currentParsedDeque[dequeIndex] ) )
     {
-        // If the front symbol of the rule matches the bottom of the stack, it can be skipped.
-        size_t dequeIndex{ 0u };
-        while ( !ruleWorkingCopy.empty()
-                && dequeIndex < currentParsedDeque.size()
-                && ruleWorkingCopy[0] == std::get< Symbol >( currentParsedDeque[dequeIndex] ) )
+        LOG_INFO_MEDIUM_LEVEL( "Skipping symbol '" + GrammarSymbols::ConvertSymbolToString( rule[dequeIndex] )
+                               + "' as it was parsed by a previous attempt." );
+        // Update index to skip past the token(s) for the already verified element
+        currentTokenIndex = std::get< size_t >( currentParsedDeque[dequeIndex] );
+        // Add the previously created AST element to elements
+        const std::shared_ptr< AstNode::Element >& storedElement
+            = std::get< std::shared_ptr< AstNode::Element > >( currentParsedDeque[dequeIndex] );
+        if ( storedElement != nullptr )
         {
-            std::string symbolString = GrammarSymbols::ConvertSymbolToString( ruleWorkingCopy[0] );
-            LOG_INFO_MEDIUM_LEVEL( "Skipping symbol '" + symbolString + "' as it was parsed by a previous attempt.");
-            ruleWorkingCopy.erase( ruleWorkingCopy.begin() );
-            // Update index to skip past the token(s) for the already verified element
-            currentTokenIndex = std::get< size_t >( currentParsedDeque[dequeIndex] );
-            // Add the previously created AST element to elements
-            std::shared_ptr< AstNode::Element > storedElement
-                = std::get< std::shared_ptr< AstNode::Element > >( currentParsedDeque[dequeIndex] );
-            if ( storedElement != nullptr )
+            elementsToPopulate.push_back( *storedElement.get() );
+        }
+        // Increment deque index, as this symbol has now been skipped
+        dequeIndex++;
+    }
+
+    // Pop the remaining non-reusable symbols off the back of the deque - the back will match the first
+    // rule element again once the excess symbols have been popped.
+    if ( dequeIndex < rule.size() )
+    {
+        // Deque index currently describes how many entries to keep
+        currentParsedDeque.resize( dequeIndex );
+    }
+    return dequeIndex;
+}
+
+/**
+ * \brief  Checks whether the symbol is an opening bracket, and if so gets its closing bracket.
+ *
+ * \param[in]   symbol        The symbol to check.
+ * \param[out]  closingSymbol  Set to the closing bracket, if the symbol is an opening bracket.
+ *
+ * \return  True if the symbol is an opening bracket, false otherwise.
+ */
+static bool
+IsOpeningBracket(
+    Symbol symbol,
+    Symbol& closingSymbol
+)
+{
+    for ( const std::pair< TokenType, TokenType >& bracketPair : g_bracketPairs )
+    {
+        if ( bracketPair.first == symbol )
+        {
+            closingSymbol = bracketPair.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * \brief  Checks that every rule in the grammar closes each bracket it opens. If so, every non-terminal produces
+ *         balanced brackets, so a bracket opened by a rule is closed by the bracket token that matches it.
+ *
+ * \return  True if all rules have balanced brackets, false otherwise.
+ */
+static bool
+AreGrammarBracketsBalanced()
+{
+    for ( const auto& ruleSet : g_nonTerminalRuleSets )
+    {
+        for ( const Rule& rule : ruleSet.second )
+        {
+            std::vector< Symbol > expectedClosingSymbols;
+            for ( Symbol symbol : rule )
             {
-                elementsToPopulate.push_back( *storedElement.get() );
+                Symbol closingSymbol;
+                if ( IsOpeningBracket( symbol, closingSymbol ) )
+                {
+                    expectedClosingSymbols.push_back( closingSymbol );
+                    continue;
+                }
+                for ( const std::pair< TokenType, TokenType >& bracketPair : g_bracketPairs )
+                {
+                    if ( bracketPair.second == symbol )
+                    {
+                        if ( expectedClosingSymbols.empty() || symbol != expectedClosingSymbols.back() )
+                        {
+                            return false;
+                        }
+                        expectedClosingSymbols.pop_back();
+                    }
+                }
+            }
+            if ( !expectedClosingSymbols.empty() )
+            {
+                return false;
             }
-            // Increment deque index, as this symbol has now been skipped
-            dequeIndex++;
         }
+    }
+    return true;
+}
 
-        // Pop the remaining non-reusable symbols off the back of the deque - the back will match the first
-        // rule element again once the excess symbols have been popped.
-        if ( !ruleWorkingCopy.empty() )
+/**
+ * \brief  Indexes the tokens, so that look-ahead doesn't need to scan them. Records the positions of each token type,
+ *         and pairs up each opening bracket with its closing bracket.
+ */
+void
+AstGenerator::BuildTokenIndex()
+{
+    m_tokenTypePositions.clear();
+    m_matchingBrackets.assign( m_tokens.size(), g_noMatchingBracket );
+
+    // Positions of the opening brackets not yet closed, for each kind of bracket.
+    std::vector< std::vector< size_t > > openBrackets( g_bracketPairs.size() );
+    for ( size_t tokenIndex = 0u; tokenIndex < m_tokens.size(); ++tokenIndex )
+    {
+        TokenType type = m_tokens[tokenIndex].m_type;
+        size_t typeIndex = static_cast< size_t >( type & ~SymbolType::BITMASK );
+        if ( typeIndex >= m_tokenTypePositions.size() )
         {
-            // Deque index currently describes how many entries to keep
-            currentParsedDeque.resize( dequeIndex );
+            m_tokenTypePositions.resize( typeIndex + 1u );
+        }
+        m_tokenTypePositions[typeIndex].push_back( tokenIndex );
+
+        for ( size_t pairIndex = 0u; pairIndex < g_bracketPairs.size(); ++pairIndex )
+        {
+            if ( g_bracketPairs[pairIndex].first == type )
+            {
+                openBrackets[pairIndex].push_back( tokenIndex );
+            }
+            else if ( g_bracketPairs[pairIndex].second == type && !openBrackets[pairIndex].empty() )
+            {
+                m_matchingBrackets[tokenIndex] = openBrackets[pairIndex].back();
+                m_matchingBrackets[openBrackets[pairIndex].back()] = tokenIndex;
+                openBrackets[pairIndex].pop_back();
+            }
         }
     }
 }
 
+/**
+ * \brief  Finds the first token of a given type, at or after a given position.
+ *
+ * \param[in]  type        The token type to search for.
+ * \param[in]  startIndex  Index of the first token to consider.
+ *
+ * \return  Index of the token, or m_tokens.size() if there is no such token.
+ */
+size_t
+AstGenerator::FindNextTokenOfType(
+    Symbol type,
+    size_t startIndex
+) const
+{
+    size_t typeIndex = static_cast< size_t >( type & ~SymbolType::BITMASK );
+    if ( typeIndex >= m_tokenTypePositions.size() )
+    {
+        return m_tokens.size();
+    }
+    const std::vector< size_t >& positions = m_tokenTypePositions[typeIndex];
+    auto position = std::lower_bound( positions.begin(), positions.end(), startIndex );
+    return positions.end() == position ? m_tokens.size() : *position;
+}
+
 /**
  * \brief  Performs a look-ahead check for the given rule, by checking that each of its terminals are in the
  *         collection of tokens being checked, and that they are in order. This allows for early stopping on an
  *         incompatible rule, without going into the non-terminal recursive searches.
  *
+ *         Each terminal is found by binary search of the token index. If the rule starts with an opening bracket, its
+ *         closing bracket must be the token matching the bracket at the current position, so it is jumped to directly.
+ *
  * \param[in,out]  currentTokenIndex  Index of the next token to parse, i.e. from which to start the lookahead.
  * \param[in]      rule               The current rule that is being tested. Consists of symbols, either terminal
  *                                    or non-terminal.
+ * \param[in]      firstSymbolIndex   Index of the first symbol of the rule still to be parsed, i.e. the symbol that
+ *                                    must start at the current token.
  *
  * \return  True if the look-ahead check succeeds, false if a match is not found.
  */
 bool
 AstGenerator::PerformLookAhead(
     size_t& currentTokenIndex,
-    const Rule& rule
+    const Rule& rule,
+    size_t firstSymbolIndex
 )
 {
-    std::string ruleString = GrammarRules::ConvertRuleToString( rule );
+    static const bool s_grammarBracketsBalanced = AreGrammarBracketsBalanced();
+
+    // Index in the rule of the bracket closing the one the rule starts with, and the token it must match.
+    size_t closingBracketSymbolIndex = rule.size();
+    size_t closingBracketTokenIndex = g_noMatchingBracket;
+    Symbol closingSymbol;
+    if ( s_grammarBracketsBalanced && firstSymbolIndex < rule.size()
+         && IsOpeningBracket( rule[firstSymbolIndex], closingSymbol ) )
+    {
+        if ( currentTokenIndex >= m_tokens.size() || rule[firstSymbolIndex] != m_tokens[currentTokenIndex].m_type )
+        {
+            LOG_INFO_MEDIUM_LEVEL( "Lookahead: rule " + GrammarRules::ConvertRuleToString( rule )
+                                   + " doesn't start with the current token. Rejecting rule." );
+            return false;
+        }
+        closingBracketTokenIndex = m_matchingBrackets[currentTokenIndex];
+
+        size_t depth{ 0u };
+        for ( size_t symbolIndex = firstSymbolIndex + 1u; symbolIndex < rule.size(); ++symbolIndex )
+        {
+            if ( rule[firstSymbolIndex] == rule[symbolIndex] )
+            {
+                ++depth;
+            }
+            else if ( closingSymbol == rule[symbolIndex] )
+            {
+                if ( 0u == depth )
+                {
+                    closingBracketSymbolIndex = symbolIndex;
+                    break;
+                }
+                --depth;
+            }
+        }
+    }
+
     size_t indexToStartLookahead{ currentTokenIndex };
-    for ( Symbol symbol : rule )
+    for ( size_t symbolIndex = firstSymbolIndex; symbolIndex < rule.size(); ++symbolIndex )
     {
+        Symbol symbol = rule[symbolIndex];
         if ( SymbolType::Terminal == GrammarSymbols::GetSymbolType( symbol ) )
         {
-            // Check through tokens, from the position of the last found terminal, to see if the current
-            // terminal symbol exists.
-            bool foundSymbol{ false };
-            for ( size_t tokenIndex = indexToStartLookahead; tokenIndex < m_tokens.size(); ++tokenIndex )
+            // Find the terminal symbol, after the position of the last found terminal.
+            size_t foundIndex = m_tokens.size();
+            if ( closingBracketSymbolIndex == symbolIndex )
             {
-                Token::Ptr token = m_tokens[tokenIndex];
-                if ( symbol == token->m_type )
+                if ( g_noMatchingBracket != closingBracketTokenIndex && closingBracketTokenIndex >= indexToStartLookahead )
                 {
-                    indexToStartLookahead = tokenIndex;
-                    foundSymbol = true;
-                    break;
+                    foundIndex = closingBracketTokenIndex;
                 }
             }
-            if ( !foundSymbol )
+            else
             {
-                std::string symbolString = GrammarSymbols::ConvertSymbolToString( symbol );
-                LOG_INFO_MEDIUM_LEVEL( "Lookahead: symbol " + symbolString + " could not be found. Rejecting rule "
-                                       + ruleString );
+                foundIndex = FindNextTokenOfType( symbol, indexToStartLookahead );
+            }
+
+            if ( foundIndex >= m_tokens.size() )
+            {
+                LOG_INFO_MEDIUM_LEVEL( "Lookahead: symbol " + GrammarSymbols::ConvertSymbolToString( symbol )
+                                       + " could not be found. Rejecting rule "
+                                       + GrammarRules::ConvertRuleToString( rule ) );
                 return false;
             }
+            // Each terminal in the rule consumes its own token.
+            indexToStartLookahead = foundIndex + 1u;
         }
     }
 
     return true;
-
-}
\ No newline at end of file
+}
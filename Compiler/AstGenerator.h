@@ -4,29 +4,55 @@
 
 #pragma once
 #include "Grammar.h"
-#include "AstNode.h"
+#include "AstArena.h"
+#include "ExpressionParser.h"
+#include "SymbolTableGenerator.h"
+#include <cstdint>
 #include <deque>
+#include <limits>
+#include <unordered_map>
 #include <utility>
 
 using namespace GrammarRules;
 
+// Value in the matching bracket index for tokens which aren't brackets, or aren't matched.
+constexpr size_t g_noMatchingBracket = std::numeric_limits< size_t >::max();
+
 class AstGenerator
 {
 public:
     using UPtr = std::unique_ptr< AstGenerator >;
-    AstGenerator( const Tokens& tokens, GrammarSymbols::NT startingNt );
+    AstGenerator( const Tokens& tokens,
+                  GrammarSymbols::NT startingNt,
+                  AstArena& arena,
+                  SymbolTableGenerator::Ptr symbolTableGenerator = nullptr );
 
-    AstNode::Ptr GenerateAst();
+    AstNode GenerateAst();
 
 protected:
     // Used to populate a parsed deque. Stores a given symbol, its resolved AST element, and the index of the next token
     // after it.
     using ParsedSymbolInfo = std::tuple< Symbol, std::shared_ptr< AstNode::Element >, size_t >;
 
-    AstNode::Ptr GenerateAstFromNt( size_t& currentTokenIndex,
+    // Result of parsing a non-terminal from a given token index: the generated node (nullptr if it could not be parsed)
+    // and the index of the next token after it.
+    using MemoisedParse = std::pair< AstNode, size_t >;
+
+    static uint64_t GetMemoKey( GrammarSymbols::NT nt, size_t startTokenIndex, bool allowLeftoverTokens );
+
+    AstNode GenerateAstFromNt( size_t& currentTokenIndex,
                                     GrammarSymbols::NT nt,
                                     bool allowLeftoverTokens );
 
+    static bool IsListNt( GrammarSymbols::NT nt, GrammarSymbols::NT& elementNt );
+
+    AstNode GenerateListFromNt( size_t& currentTokenIndex,
+                                     GrammarSymbols::NT nt,
+                                     GrammarSymbols::NT elementNt,
+                                     bool allowLeftoverTokens );
+
+    void AddToRootSymbolTable( const AstNode::Elements& rootListElements );
+
     bool TryRule( size_t& currentTokenIndex,
                   const Rule& rule,
                   bool allowLeftoverTokens,
@@ -39,17 +65,45 @@ protected:
                     AstNode::Elements& elementsToPopulate,
                     std::deque< ParsedSymbolInfo >& currentParsedDeque );
 
-    void ReusePreviouslyParsedSymbols( size_t& currentTokenIndex,
-                                       Rule& ruleWorkingCopy,
-                                       AstNode::Elements& elementsToPopulate,
-                                       std::deque< ParsedSymbolInfo >& currentParsedDeque );
+    size_t ReusePreviouslyParsedSymbols( size_t& currentTokenIndex,
+                                         const Rule& rule,
+                                         AstNode::Elements& elementsToPopulate,
+                                         std::deque< ParsedSymbolInfo >& currentParsedDeque );
 
     bool PerformLookAhead( size_t& currentTokenIndex,
-                           const Rule& rule );
+                           const Rule& rule,
+                           size_t firstSymbolIndex );
 
-    // Stores the collection of tokens being parsed for this AST
-    Tokens m_tokens;
+    void BuildTokenIndex();
+    size_t FindNextTokenOfType( Symbol type, size_t startIndex ) const;
+
+    // The collection of tokens being parsed for this AST. Not owned by this class, so must outlive it.
+    const Tokens& m_tokens;
+
+    // Arena in which the AST nodes are created. Not owned by this class, so must outlive the generated AST.
+    AstArena& m_arena;
+
+    // Positions of each token type in m_tokens, in ascending order. Indexed by the token type's offset from
+    // SymbolType::Terminal.
+    std::vector< std::vector< size_t > > m_tokenTypePositions;
+    // For each bracket token, the index of the bracket token it pairs with. g_noMatchingBracket for other tokens.
+    std::vector< size_t > m_matchingBrackets;
 
     // Non-terminal symbol from which to start parsing the program.
     GrammarSymbols::NT m_startingNonTerminal;
+
+    // Parses the expression non-terminals, which make up most of a program, without going through the rule engine.
+    ExpressionParser m_expressionParser;
+
+    // If not null, used to generate the symbol tables for the AST while it is being parsed, rather than in a separate
+    // pass afterwards. The sub-tree of each statement of the root list is walked as soon as it has been parsed.
+    SymbolTableGenerator::Ptr m_symbolTableGenerator;
+    // Symbol table of the root scope, populated as the statements of the root list are parsed. Null until there are
+    // enough statements to know the root will be a list node.
+    SymbolTable::Ptr m_rootSymbolTable;
+
+    // Results of every non-terminal parse attempted so far, keyed by non-terminal, start token index and whether
+    // leftover tokens were allowed. Parsing a non-terminal only depends on these, so backtracking can reuse the results
+    // rather than parsing the same tokens again.
+    std::unordered_map< uint64_t, MemoisedParse > m_memoisedParses;
 };
\ No newline at end of file
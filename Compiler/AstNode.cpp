@@ -3,6 +3,7 @@
  */
 
 #include "AstNode.h"
+#include "AstArena.h"
 
 #include <stdexcept>
 
@@ -12,21 +13,22 @@
  *         are in the elements container. If the given elements contains only 1 child AST node, this node will be
  *         returned instead of a new one being created.
  *
+ * \param[in]  arena     The arena in which to create the node. Any child nodes must already be stored in it.
  * \param[in]  elements  Child nodes or tokens belonging to the node being created. Any token is either skipped,
  *                       selected as node label, or made into a child node.
  * \param[in]  nodeNt    The NT symbol to which this node's rule belongs. If an operator cannot be decided, this is
  *                       used as the node label.
  *
- * \return  Ptr to the created AST node.
+ * \return  View of the created AST node.
  */
-AstNode::Ptr
+AstNode
 AstNode::GetNodeFromRuleElements(
+    AstArena& arena,
     const Elements& elements,
     GrammarSymbols::NT nodeNt
 )
 {
-    std::string ntString = GrammarSymbols::ConvertSymbolToString( nodeNt );
-    LOG_INFO_MEDIUM_LEVEL( "Creating node for " + ntString + " with " + std::to_string( elements.size() )
+    LOG_INFO_MEDIUM_LEVEL( "Creating node for " + GrammarSymbols::ConvertSymbolToString( nodeNt ) + " with " + std::to_string( elements.size() )
                            + " elements." );
 
     if ( elements.empty() )
@@ -43,12 +45,12 @@ AstNode::GetNodeFromRuleElements(
     // Search through elements for node label if exists - throws if more than 1 is found.
     for ( size_t i = 0; i < elements.size(); ++i )
     {
-        Element element = elements[i];
+        const Element& element = elements[i];
         // If child is a token
-        if ( std::holds_alternative< Token::Ptr >( element ) )
+        if ( std::holds_alternative< Token >( element ) )
         {
-            Token::Ptr token = std::get< Token::Ptr >( element );
-            TokenType tokenType = token->m_type;
+            const Token& token = std::get< Token >( element );
+            TokenType tokenType = token.m_type;
             // If token is node label type, mark it as such.
             if ( g_nodeLabelTerminals.end() != g_nodeLabelTerminals.find( tokenType ) )
             {
@@ -72,20 +74,17 @@ AstNode::GetNodeFromRuleElements(
             // Otherwise, create new wrapper node and add to children
             else
             {
-                AstNode::Ptr wrapperNode = std::make_shared< AstNode >( tokenType, token );
-                nodeChildren.push_back( wrapperNode );
+                nodeChildren.push_back( arena.CreateNode( tokenType, token ) );
             }
         }
 
         // Else if element is an AST node, add to children
         else
         {
-            AstNode::Ptr node = std::get< AstNode::Ptr >( element );
-            nodeChildren.push_back( node );
+            nodeChildren.push_back( std::get< AstNode >( element ) );
         }
     }
 
-    std::string nodeLabelString = TokenTypes::ConvertTokenTypeToString( static_cast< TokenType >( nodeLabel ) );
     // If a terminal node label was not found, use non-terminal argument instead
     if ( T::INVALID_TOKEN == nodeLabel )
     {
@@ -103,41 +102,81 @@ AstNode::GetNodeFromRuleElements(
             return nodeChildren[0];
         }
         nodeLabel = nodeNt;
-        nodeLabelString = ntString;
     }
 
-    LOG_INFO_MEDIUM_LEVEL( "Creating node with label: " + nodeLabelString );
-    return std::make_shared< AstNode >( nodeLabel, nodeChildren );
+    LOG_INFO_MEDIUM_LEVEL( "Creating node with label: " + GrammarSymbols::ConvertSymbolToString( nodeLabel ) );
+    return arena.CreateNode( nodeLabel, nodeChildren );
 }
 
 /**
- * \brief  Indicates whether node is storing anything, i.e. a token or child nodes.
+ * \brief  Gets a child node.
  *
- * \return  True if storage is in use, false otherwise.
+ * \param[in]  i  Position of the child, from 0.
+ *
+ * \return  View of the child node.
  */
-bool
-AstNode::IsStorageInUse()
+AstNode
+AstNode::ChildRange::operator[](
+    size_t i
+) const
 {
-    if ( std::holds_alternative< Token::Ptr >( m_storage ) )
+    if ( i >= m_numChildren )
     {
-        return nullptr != std::get< Token::Ptr >( m_storage );
+        LOG_ERROR_AND_THROW( "Child index " + std::to_string( i ) + " out of range for node with "
+                             + std::to_string( m_numChildren ) + " children.", std::out_of_range );
     }
-    else
+    return AstNode( m_arena, m_arena->m_childIndices[m_firstChildPosition + i] );
+}
+
+/**
+ * \brief  Throws if this view doesn't refer to a node.
+ */
+void
+AstNode::CheckNotNull() const
+{
+    if ( nullptr == m_arena )
     {
-        return !std::get< Children >( m_storage ).empty();
+        LOG_ERROR_AND_THROW( "Cannot access a null AST node.", std::runtime_error );
     }
 }
 
+/**
+ * \brief  Gets the label of the node.
+ *
+ * \return  The token type or non-terminal symbol labelling the node.
+ */
+GrammarSymbols::Symbol
+AstNode::GetNodeLabel() const
+{
+    CheckNotNull();
+    return m_arena->m_nodes[m_index].nodeLabel;
+}
+
+/**
+ * \brief  Indicates whether node is storing anything, i.e. a token or child nodes.
+ *
+ * \return  True if storage is in use, false otherwise.
+ */
+bool
+AstNode::IsStorageInUse() const
+{
+    CheckNotNull();
+    // Tokens are held by value, so a token node is always storing something.
+    const AstArena::NodeRecord& record = m_arena->m_nodes[m_index];
+    return record.isStoringToken || 0u != record.numChildren;
+}
+
 /**
  * \brief  Indicates whether node is storing token. Note: this does not check if a value is actually being
- *         held, only if the variant type is token.
+ *         held, only if the node was created from a token.
  *
  * \return  True if storing token, false if storing children.
  */
 bool
-AstNode::IsStoringToken()
+AstNode::IsStoringToken() const
 {
-    return std::holds_alternative< Token::Ptr >( m_storage );
+    CheckNotNull();
+    return m_arena->m_nodes[m_index].isStoringToken;
 }
 
 /**
@@ -147,7 +186,7 @@ AstNode::IsStoringToken()
  * \return  True if node is a scope-definer, false otherwise.
  */
 bool
-AstNode::IsScopeDefiningNode()
+AstNode::IsScopeDefiningNode() const
 {
     // If not storing anything, or storing token, this is not a scope-defining node.
     if ( IsStoringToken() ||!IsStorageInUse() )
@@ -157,7 +196,7 @@ AstNode::IsScopeDefiningNode()
 
     // Return true if node represents a scope-defining operation. Note that NT rule symbols are not considered here
     // as they will either be optimised out during AST generation or do not count e.g. Block.
-    if ( g_scopeDefiningSymbols.end() != g_scopeDefiningSymbols.find( m_nodeLabel ) )
+    if ( g_scopeDefiningSymbols.end() != g_scopeDefiningSymbols.find( GetNodeLabel() ) )
     {
         return true;
     }
@@ -168,41 +207,49 @@ AstNode::IsScopeDefiningNode()
 /**
  * \brief  Returns stored child nodes. Throws if this node is not storing children.
  *
- * \return  Children container.
+ * \return  View of the children.
  */
-AstNode::Children
-AstNode::GetChildren()
+AstNode::ChildRange
+AstNode::GetChildren() const
 {
     if ( IsStoringToken() )
     {
         LOG_ERROR_AND_THROW( "Cannot get children for node that is storing token.", std::invalid_argument );
     }
 
-    AstNode::Children children = std::get< Children >( m_storage );
-    if ( children.empty() )
+    const AstArena::NodeRecord& record = m_arena->m_nodes[m_index];
+    if ( 0u == record.numChildren )
     {
         LOG_ERROR_AND_THROW( "Children not in use.", std::runtime_error );
     }
-    return children;
+    return ChildRange( m_arena, record.first, record.numChildren );
 }
 
 /**
  * \brief  Returns stored token. Throws if this node is not storing a token.
  *
- * \return  Stored token pointer.
+ * \return  Stored token.
  */
-Token::Ptr
-AstNode::GetToken()
+const Token&
+AstNode::GetToken() const
 {
     if ( !IsStoringToken() )
     {
         LOG_ERROR_AND_THROW( "Cannot get token for node that is storing children.", std::invalid_argument );
     }
 
-    Token::Ptr token = std::get< Token::Ptr >( m_storage );
-    if ( nullptr == token )
-    {
-        LOG_ERROR_AND_THROW( "Token not in use.", std::runtime_error );
-    }
-    return token;
-}
\ No newline at end of file
+    return m_arena->m_tokens[m_arena->m_nodes[m_index].first];
+}
+
+/**
+ * \brief  Gets the symbol table assigned to this node.
+ *
+ * \return  The symbol table, or nullptr if none has been assigned.
+ */
+SymbolTable::Ptr
+AstNode::GetSymbolTable() const
+{
+    CheckNotNull();
+    auto symbolTable = m_arena->m_symbolTables.find( m_index );
+    return m_arena->m_symbolTables.end() == symbolTable ? nullptr : symbolTable->second;
+}
@@ -7,53 +7,129 @@
 #include "Token.h"
 #include "SymbolTable.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
 #include <vector>
 #include <memory>
 #include <variant>
 
+class AstArena;
+
+// Index of a node within the AstArena storing it.
+using AstNodeIndex = uint32_t;
+
+// Index of no node, held by a null AstNode.
+constexpr AstNodeIndex g_invalidAstNodeIndex = std::numeric_limits< AstNodeIndex >::max();
+
+/**
+ * \brief  Read-only view of a node in an Abstract Syntax Tree. The node itself is stored in an AstArena, so a view is
+ *         just the arena and the node's index: it is cheap to copy, and should be passed by value. A view is only
+ *         valid for as long as its arena is alive.
+ *
+ *         A default-constructed view, or one constructed from nullptr, refers to no node and compares equal to nullptr.
+ */
 class AstNode
 {
 public:
-    using Ptr = std::shared_ptr< AstNode >;
-
     /**
      * \brief  Represents the information held by an AST node: can either be the node itself or a token, which is
      *         either skipped during tree creation, or incorporated as a child node or as the node label.
      */
-    using Element = std::variant< AstNode::Ptr, Token::Ptr >;
+    using Element = std::variant< AstNode, Token >;
     using Elements = std::vector< Element >;
 
-    using Children = std::vector< Ptr >;
+    // Child nodes from which to create a node in an arena.
+    using Children = std::vector< AstNode >;
 
-    AstNode( GrammarSymbols::Symbol nodeLabel, const Children& children )
-    : m_nodeLabel( nodeLabel ),
-      m_storage( children )
-    {}
-    AstNode( GrammarSymbols::Symbol nodeLabel, Token::Ptr token )
-    : m_nodeLabel( nodeLabel ),
-      m_storage ( token )
-    {}
+    /**
+     * \brief  View of the children of a node, in order. Refers to the children by their position in the arena, so
+     *         remains valid if more nodes are added to the arena.
+     */
+    class ChildRange
+    {
+    public:
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = AstNode;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const AstNode*;
+            using reference = AstNode;
+
+            Iterator( const ChildRange* range, size_t position ) : m_range( range ), m_position( position ) {}
 
-    static AstNode::Ptr GetNodeFromRuleElements( const Elements& elements,
-                                                 GrammarSymbols::NT nodeNt );
+            AstNode operator*() const { return ( *m_range )[m_position]; }
+            Iterator& operator++() { ++m_position; return *this; }
+            bool operator==( const Iterator& other ) const { return m_position == other.m_position; }
+            bool operator!=( const Iterator& other ) const { return m_position != other.m_position; }
 
-    bool IsStorageInUse();
-    bool IsStoringToken();
+        private:
+            const ChildRange* m_range;
+            size_t m_position;
+        };
 
-    AstNode::Children GetChildren();
-    Token::Ptr GetToken();
+        ChildRange( AstArena* arena, size_t firstChildPosition, size_t numChildren )
+        : m_arena( arena ),
+          m_firstChildPosition( firstChildPosition ),
+          m_numChildren( numChildren )
+        {}
 
-    bool IsScopeDefiningNode();
+        AstNode operator[]( size_t i ) const;
+
+        size_t size() const { return m_numChildren; }
+        bool empty() const { return 0u == m_numChildren; }
+        Iterator begin() const { return Iterator( this, 0u ); }
+        Iterator end() const { return Iterator( this, m_numChildren ); }
+
+    private:
+        AstArena* m_arena;
+        size_t m_firstChildPosition;
+        size_t m_numChildren;
+    };
+
+    AstNode() = default;
+    AstNode( std::nullptr_t ) {}
+    AstNode( AstArena* arena, AstNodeIndex index )
+    : m_arena( arena ),
+      m_index( index )
+    {}
+
+    static AstNode GetNodeFromRuleElements( AstArena& arena,
+                                            const Elements& elements,
+                                            GrammarSymbols::NT nodeNt );
 
     // Describes the relationship of the node, i.e. how its children relate to each other.
     // This can be a token type e.g. PLUS, or a non-terminal symbol label (e.g. For_init).
-    GrammarSymbols::Symbol m_nodeLabel;
+    GrammarSymbols::Symbol GetNodeLabel() const;
+
+    bool IsStorageInUse() const;
+    bool IsStoringToken() const;
+
+    ChildRange GetChildren() const;
+    const Token& GetToken() const;
+
+    bool IsScopeDefiningNode() const;
+
+    // If this node is a scope-defining node (e.g. FOR), the generated symbol table corresponding with this scope.
+    SymbolTable::Ptr GetSymbolTable() const;
+
+    AstArena* GetArena() const { return m_arena; }
+    AstNodeIndex GetIndex() const { return m_index; }
+
+    bool operator==( const AstNode& other ) const { return m_arena == other.m_arena && m_index == other.m_index; }
+    bool operator!=( const AstNode& other ) const { return !( *this == other ); }
+    bool operator==( std::nullptr_t ) const { return nullptr == m_arena; }
+    bool operator!=( std::nullptr_t ) const { return nullptr != m_arena; }
+    friend bool operator==( std::nullptr_t, const AstNode& node ) { return nullptr == node.m_arena; }
+    friend bool operator!=( std::nullptr_t, const AstNode& node ) { return nullptr != node.m_arena; }
 
-    // The element stored by this node: A node can only store a token or a set of child nodes, not both.
-    // A node acts as a wrapper around a token, or as a more complex sub-tree.
-    std::variant< Token::Ptr, Children > m_storage;
+private:
+    void CheckNotNull() const;
 
-    // If this node is a scope-defining node (e.g. FOR), this is used to store the generated symbol table
-    // corresponding with this scope.
-    SymbolTable::Ptr m_symbolTable;
-};
\ No newline at end of file
+    // Arena storing the node. Nullptr if this view refers to no node.
+    AstArena* m_arena{ nullptr };
+    AstNodeIndex m_index{ g_invalidAstNodeIndex };
+};
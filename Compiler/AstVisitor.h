@@ -0,0 +1,189 @@
+/**
+ * Contains declaration and definition of the base class for passes which traverse an Abstract Syntax Tree.
+ */
+
+#pragma once
+
+#include "AstNode.h"
+#include "Logger.h"
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+/**
+ * \brief  Tag type identifying a node label at compile time, used to select the handler for that label.
+ */
+template< GrammarSymbols::Symbol Label >
+struct AstLabel
+{
+    static constexpr GrammarSymbols::Symbol value = Label;
+};
+
+/**
+ * \brief  List of the node labels handled by a pass.
+ */
+template< GrammarSymbols::Symbol... Labels >
+struct AstLabelList
+{
+};
+
+/**
+ * \brief  Base class for passes over an AST, which dispatches each node to the pass's handler for the node's label.
+ *
+ *         The derived pass declares the labels it handles as a type member HandledLabels, an AstLabelList, and a
+ *         handler for each of them with the signature Result VisitNode( AstLabel< Label >, AstNode, Args... ). Nodes
+ *         with any other label are passed to VisitUnhandled, which throws unless the pass declares its own.
+ *
+ *         The handler for each label is looked up in a table of function pointers built at compile time, indexed by
+ *         the label's symbol type and value, so dispatching a node doesn't need to check its symbol type or switch on
+ *         its label. Handlers are private to the pass as long as it is a friend of this class.
+ *
+ * \tparam  Derived  The pass class deriving from this one.
+ * \tparam  Result   Type returned by the handlers.
+ * \tparam  Args     Types of any extra arguments passed through to the handlers, e.g. the current symbol table.
+ */
+template< class Derived, class Result = void, class... Args >
+class AstVisitor
+{
+public:
+    Result Visit( AstNode node, Args... args );
+
+protected:
+    Result VisitUnhandled( AstNode node, Args... args );
+
+private:
+    using Handler = Result ( * )( Derived&, AstNode, Args... );
+
+    // Each symbol type holds values up to the size of its low byte, see GrammarSymbols::SymbolType.
+    static constexpr size_t s_numSymbolsPerType = 0x100u;
+    using HandlerTable = std::array< Handler, 2u * s_numSymbolsPerType >;
+
+    static constexpr size_t GetTableIndex( GrammarSymbols::Symbol symbol );
+
+    template< GrammarSymbols::Symbol... Labels >
+    static constexpr HandlerTable BuildHandlerTable( AstLabelList< Labels... > );
+
+    template< GrammarSymbols::Symbol Label >
+    static Result CallHandler( Derived& pass, AstNode node, Args... args );
+    static Result CallUnhandled( Derived& pass, AstNode node, Args... args );
+};
+
+/**
+ * \brief  Passes a node to the handler for its label.
+ *
+ * \param[in]  node  The node to visit.
+ * \param[in]  args  Any extra arguments to pass to the handler.
+ *
+ * \return  The result of the handler.
+ */
+template< class Derived, class Result, class... Args >
+Result
+AstVisitor< Derived, Result, Args... >::Visit(
+    AstNode node,
+    Args... args
+)
+{
+    // Built on first use rather than as a static member, as the derived class is incomplete while this one is.
+    static constexpr HandlerTable handlers = BuildHandlerTable( typename Derived::HandledLabels{} );
+
+    const GrammarSymbols::Symbol label = node.GetNodeLabel();
+    const size_t index = GetTableIndex( label );
+    if ( index >= handlers.size() )
+    {
+        LOG_ERROR_AND_THROW( "Unrecognised symbol: " + std::to_string( label ), std::runtime_error );
+    }
+    return handlers[index]( static_cast< Derived& >( *this ), node, args... );
+}
+
+/**
+ * \brief  Default handler for nodes whose label the pass doesn't handle. Throws.
+ *
+ * \param[in]  node  The node being visited.
+ */
+template< class Derived, class Result, class... Args >
+Result
+AstVisitor< Derived, Result, Args... >::VisitUnhandled(
+    AstNode node,
+    Args...
+)
+{
+    LOG_ERROR_AND_THROW( "Node label not handled by this pass: "
+                         + GrammarSymbols::ConvertSymbolToString( node.GetNodeLabel() ), std::invalid_argument );
+}
+
+/**
+ * \brief  Gets the position of a symbol's handler in the handler table. Terminals come first, then non-terminals.
+ *
+ * \param[in]  symbol  The node label.
+ *
+ * \return  Position in the table. Past the end of the table if the symbol is of neither type.
+ */
+template< class Derived, class Result, class... Args >
+constexpr size_t
+AstVisitor< Derived, Result, Args... >::GetTableIndex(
+    GrammarSymbols::Symbol symbol
+)
+{
+    const size_t value = symbol & ~GrammarSymbols::SymbolType::BITMASK;
+    switch ( symbol & GrammarSymbols::SymbolType::BITMASK )
+    {
+    case GrammarSymbols::SymbolType::Terminal:
+        return value;
+    case GrammarSymbols::SymbolType::NonTerminal:
+        return s_numSymbolsPerType + value;
+    default:
+        return 2u * s_numSymbolsPerType;
+    }
+}
+
+/**
+ * \brief  Builds the table of handlers, pointing the given labels to their handlers and all others to VisitUnhandled.
+ *
+ * \return  The handler table.
+ */
+template< class Derived, class Result, class... Args >
+template< GrammarSymbols::Symbol... Labels >
+constexpr typename AstVisitor< Derived, Result, Args... >::HandlerTable
+AstVisitor< Derived, Result, Args... >::BuildHandlerTable(
+    AstLabelList< Labels... >
+)
+{
+    HandlerTable handlers{};
+    for ( size_t i = 0u; i < handlers.size(); ++i )
+    {
+        handlers[i] = &CallUnhandled;
+    }
+    ( ( handlers[GetTableIndex( Labels )] = &CallHandler< Labels > ), ... );
+    return handlers;
+}
+
+/**
+ * \brief  Calls the pass's handler for a label.
+ */
+template< class Derived, class Result, class... Args >
+template< GrammarSymbols::Symbol Label >
+Result
+AstVisitor< Derived, Result, Args... >::CallHandler(
+    Derived& pass,
+    AstNode node,
+    Args... args
+)
+{
+    return pass.VisitNode( AstLabel< Label >{}, node, args... );
+}
+
+/**
+ * \brief  Calls the pass's handler for labels it doesn't handle.
+ */
+template< class Derived, class Result, class... Args >
+Result
+AstVisitor< Derived, Result, Args... >::CallUnhandled(
+    Derived& pass,
+    AstNode node,
+    Args... args
+)
+{
+    return pass.VisitUnhandled( node, args... );
+}
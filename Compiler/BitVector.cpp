@@ -0,0 +1,155 @@
+/**
+ * Contains definition of a fixed-size set of small integers, stored as bits.
+ */
+
+#include <algorithm>
+#include <string>
+
+#include "BitVector.h"
+#include "Logger.h"
+
+BitVector::BitVector(
+    size_t size
+)
+: m_size( size ),
+  m_words( ( size + BITS_PER_WORD - 1u ) / BITS_PER_WORD, 0u )
+{
+}
+
+/**
+ * \brief  Adds all integers in another set to this one.
+ *
+ * \param[in]  other  The set to add. Must be the same size as this one.
+ *
+ * \return  True if this set gained any integers, false if it already contained them all.
+ */
+bool
+BitVector::UnionWith(
+    const BitVector& other
+)
+{
+    CheckSameSize( other );
+
+    bool changed{ false };
+    for ( size_t index = 0; index < m_words.size(); ++index )
+    {
+        Word combined = m_words[index] | other.m_words[index];
+        changed = changed || combined != m_words[index];
+        m_words[index] = combined;
+    }
+    return changed;
+}
+
+/**
+ * \brief  Removes all integers in another set from this one.
+ *
+ * \param[in]  other  The set to remove. Must be the same size as this one.
+ */
+void
+BitVector::Subtract(
+    const BitVector& other
+)
+{
+    CheckSameSize( other );
+
+    for ( size_t index = 0; index < m_words.size(); ++index )
+    {
+        m_words[index] &= ~other.m_words[index];
+    }
+}
+
+/**
+ * \brief  Removes all integers from the set.
+ */
+void
+BitVector::Clear()
+{
+    std::fill( m_words.begin(), m_words.end(), Word{ 0u } );
+}
+
+/**
+ * \brief  Counts the integers in the set.
+ *
+ * \return  Number of set bits.
+ */
+size_t
+BitVector::Count() const
+{
+    size_t count{ 0u };
+    for ( Word word : m_words )
+    {
+        for ( ; 0u != word; word &= word - 1u )
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/**
+ * \brief  Checks whether the set is empty.
+ *
+ * \return  True if no bits are set, false otherwise.
+ */
+bool
+BitVector::None() const
+{
+    for ( Word word : m_words )
+    {
+        if ( 0u != word )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+BitVector::operator==(
+    const BitVector& other
+) const
+{
+    return m_size == other.m_size && m_words == other.m_words;
+}
+
+bool
+BitVector::operator!=(
+    const BitVector& other
+) const
+{
+    return !( *this == other );
+}
+
+/**
+ * \brief  Throws if an integer is outside the range the set can hold.
+ *
+ * \param[in]  index  The integer.
+ */
+void
+BitVector::CheckIndex(
+    size_t index
+) const
+{
+    if ( index >= m_size )
+    {
+        LOG_ERROR_AND_THROW( "Index " + std::to_string( index ) + " is out of range for bit vector of size "
+                             + std::to_string( m_size ), std::out_of_range );
+    }
+}
+
+/**
+ * \brief  Throws if another set is a different size to this one, as set operations need the same range.
+ *
+ * \param[in]  other  The other set.
+ */
+void
+BitVector::CheckSameSize(
+    const BitVector& other
+) const
+{
+    if ( m_size != other.m_size )
+    {
+        LOG_ERROR_AND_THROW( "Bit vectors must be the same size: " + std::to_string( m_size ) + " and "
+                             + std::to_string( other.m_size ), std::invalid_argument );
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * Contains declaration of a fixed-size set of small integers, stored as bits.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief  Set of the integers in [0, size), stored as one bit each. Set operations work a word at a time, so this is
+ *         suited to dataflow analyses over dense IDs, e.g. the set of variables live at a point in the program.
+ */
+class BitVector
+{
+public:
+    BitVector( size_t size = 0u );
+
+    size_t
+    GetSize() const
+    {
+        return m_size;
+    }
+
+    void
+    Set( size_t index )
+    {
+        CheckIndex( index );
+        m_words[index / BITS_PER_WORD] |= Word{ 1u } << ( index % BITS_PER_WORD );
+    }
+
+    void
+    Reset( size_t index )
+    {
+        CheckIndex( index );
+        m_words[index / BITS_PER_WORD] &= ~( Word{ 1u } << ( index % BITS_PER_WORD ) );
+    }
+
+    bool
+    Test( size_t index ) const
+    {
+        CheckIndex( index );
+        return 0u != ( m_words[index / BITS_PER_WORD] & ( Word{ 1u } << ( index % BITS_PER_WORD ) ) );
+    }
+
+    bool UnionWith( const BitVector& other );
+    void Subtract( const BitVector& other );
+    void Clear();
+
+    size_t Count() const;
+    bool None() const;
+
+    /**
+     * \brief  Calls a function with each integer in the set, in ascending order.
+     *
+     * \param[in]  function  Function taking the integer as a size_t.
+     */
+    template< class Function >
+    void
+    ForEach( Function function ) const
+    {
+        for ( size_t wordIndex = 0; wordIndex < m_words.size(); ++wordIndex )
+        {
+            Word word = m_words[wordIndex];
+            while ( 0u != word )
+            {
+                size_t bit = 0u;
+                while ( 0u == ( word & ( Word{ 1u } << bit ) ) )
+                {
+                    ++bit;
+                }
+                function( wordIndex * BITS_PER_WORD + bit );
+                // Clear the lowest set bit.
+                word &= word - 1u;
+            }
+        }
+    }
+
+    bool operator==( const BitVector& other ) const;
+    bool operator!=( const BitVector& other ) const;
+
+private:
+    using Word = uint64_t;
+    static constexpr size_t BITS_PER_WORD = 64u;
+
+    void CheckIndex( size_t index ) const;
+    void CheckSameSize( const BitVector& other ) const;
+
+    size_t m_size;
+    // Bits beyond m_size in the last word are always zero, so words can be compared and counted directly.
+    std::vector< Word > m_words;
+};
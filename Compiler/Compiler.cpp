@@ -1,8 +1,9 @@
 #include <iostream>
 #include <string>
+#include <thread>
 
 #include "Tokeniser.h"
-#include "FileIO.h"
+#include "MappedSourceFile.h"
 #include "AstGenerator.h"
 #include "Logger.h"
 #include "SymbolTableGenerator.h"
@@ -12,24 +13,27 @@
 /**
  * \brief  Runs compiler steps to produce generated assembly language.
  *
- * \param[in]  inputFile   Input file path, containing high-level code.
- * \param[in]  outputFile  Output file path, containing generated assembly.
+ * \param[in]  inputFile         Input file path, containing high-level code.
+ * \param[in]  outputFile        Output file path, containing generated assembly.
+ * \param[in]  fuseSymbolTables  Whether to generate the symbol tables while parsing, rather than in a separate pass.
  *
  * \return  True if successful, false otherwise.
  */
 bool
 RunCompiler(
     const std::string& inputFile,
-    const std::string& outputFile
+    const std::string& outputFile,
+    bool fuseSymbolTables
 )
 {
     Tokens tokens;
     try
     {
         LOG_INFO_AND_COUT( "Converting program file into tokens..." );
-        std::string inputFileString = FileIO::ReadFileToString( inputFile );
+        MappedSourceFile::UPtr sourceFile = std::make_unique< MappedSourceFile >( inputFile );
         Tokeniser::UPtr tokeniser = std::make_unique< Tokeniser >();
-        tokens = tokeniser->ConvertStringToTokens( inputFileString );
+        tokens = tokeniser->ConvertStringToTokensParallel( sourceFile->GetContents(),
+                                                           std::thread::hardware_concurrency() );
 
         if ( tokens.empty() )
         {
@@ -45,12 +49,17 @@ RunCompiler(
     LOG_INFO_AND_COUT( "Successfully converted into tokens!" );
 
 
-    AstNode::Ptr abstractSyntaxTree;
+    // Holds every AST node created during this compilation, freeing them all together when it goes out of scope.
+    AstArena astArena;
+    AstNode abstractSyntaxTree;
+    SymbolTableGenerator::Ptr symbolTableGenerator = std::make_shared< SymbolTableGenerator >();
     try
     {
         LOG_INFO_AND_COUT( "Converting tokens into an abstract syntax tree..." );
         constexpr NT startingNonTerminal{ NT::Block };
-        AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNonTerminal );
+        AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >(
+            tokens, startingNonTerminal, astArena, fuseSymbolTables ? symbolTableGenerator : nullptr
+        );
         abstractSyntaxTree = astGenerator->GenerateAst();
 
         if ( nullptr == abstractSyntaxTree )
@@ -70,11 +79,14 @@ RunCompiler(
     SymbolTable::Ptr symbolTable;
     try
     {
-        LOG_INFO_AND_COUT( "Generating symbol table from abstract syntax tree..." );
-        SymbolTableGenerator::UPtr symbolTableGenerator = std::make_unique< SymbolTableGenerator >();
-        symbolTableGenerator->GenerateSymbolTableForAst( abstractSyntaxTree );
+        // If fused, the tables were generated along with the tree.
+        if ( !fuseSymbolTables )
+        {
+            LOG_INFO_AND_COUT( "Generating symbol table from abstract syntax tree..." );
+            symbolTableGenerator->GenerateSymbolTableForAst( abstractSyntaxTree );
+        }
 
-        symbolTable = abstractSyntaxTree->m_symbolTable;
+        symbolTable = abstractSyntaxTree.GetSymbolTable();
 
         if ( nullptr == symbolTable )
         {
@@ -90,17 +102,20 @@ RunCompiler(
     LOG_INFO_AND_COUT( "Successfully created symbol table!" );
 
 
-    TacInstructionFactory::Ptr tacInstrFactory = std::make_shared< TacInstructionFactory >();
+    // Temporaries are added to the same table as the program's variables, so they are all numbered together.
+    TacInstructionFactory::Ptr tacInstrFactory
+        = std::make_shared< TacInstructionFactory >( symbolTable->GetVariableTable() );
     TacExpressionGenerator::Ptr tacExprGenerator = std::make_shared< TacExpressionGenerator >( tacInstrFactory );
     IntermediateCode::UPtr intermediateCodeGenerator
         = std::make_unique< IntermediateCode >( tacInstrFactory, tacExprGenerator );
 
-    TacInstructionFactory::Instructions tacInstructions;
+    // Points into the factory's storage, rather than copying the instructions out.
+    const TacInstructionFactory::Instructions* tacInstructions = nullptr;
     try
     {
         LOG_INFO_AND_COUT( "Converting abstract syntax tree to intermediate code..." );
         intermediateCodeGenerator->GenerateIntermediateCode( abstractSyntaxTree );
-        tacInstructions = tacInstrFactory->GetInstructions();
+        tacInstructions = &tacInstrFactory->GetInstructions();
     }
     catch ( std::exception& e )
     {
@@ -111,13 +126,14 @@ RunCompiler(
 
 
     Assembly::AssemblyGenerator::Ptr assemblyGenerator
-        = std::make_shared< Assembly::AssemblyGenerator >( tacInstructions );
+        = std::make_shared< Assembly::AssemblyGenerator >( *tacInstructions, symbolTable->GetVariableTable() );
     Assembly::Instructions assemblyInstructions;
     try
     {
         LOG_INFO_AND_COUT( "Converting intermediate code to assembly..." );
         assemblyGenerator->CalculateBasicBlocks();
         assemblyGenerator->CalculateLiveIntervals();
+        assemblyGenerator->AllocateRegisters();
         assemblyInstructions = assemblyGenerator->GenerateAssemblyInstructions();
     }
     catch ( std::exception& e )
@@ -143,6 +159,8 @@ PrintHelpMessage()
     helpMsg += "-i (--input)\tPath to input file containing code to be compiled.\n";
     helpMsg += "-o (--output)\tPath to output file containing generated assembly language."
                " If left blank will default to ./output.txt\n";
+    helpMsg += "-s (--fuseSymbolTables)\tGenerate symbol tables while parsing, rather than in a separate pass over"
+               " the whole tree. Each top-level statement's sub-tree is still walked once it has been parsed.\n";
     helpMsg += "-l (--logLevel)\tLogging level:\n"
                "\t\t- 0: NONE\n\t\t- 1: ERROR\n\t\t- 2: WARN\n\t\t- 3: INFO\n\t\t"
                "- 4: INFO_MEDIUM_LEVEL\n\t\t- 5: INFO_LOW_LEVEL\n";
@@ -157,6 +175,8 @@ main(
 {
     // Set to true if help argument is called - in this case do not run the compiler.
     bool helpCalled{ false };
+    // Set to true to generate symbol tables while parsing.
+    bool fuseSymbolTables{ false };
     std::string inputFile, outputFile;
 
     size_t index = 1u;
@@ -192,6 +212,10 @@ main(
                 return -1;
             }
         }
+        else if ( "--fuseSymbolTables" == currentArg || "-s" == currentArg )
+        {
+            fuseSymbolTables = true;
+        }
         else if ( "--logLevel" == currentArg || "-l" == currentArg )
         {
             ++index;
@@ -254,7 +278,7 @@ main(
             outputFile = "output.txt";
         }
 
-        if ( !RunCompiler( inputFile, outputFile ) )
+        if ( !RunCompiler( inputFile, outputFile, fuseSymbolTables ) )
         {
             LOG_ERROR( "RunCompiler() returned false: exception raised during runtime." );
             std::cout << "Compilation failed. See log for more details.\n";
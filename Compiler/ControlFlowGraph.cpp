@@ -0,0 +1,529 @@
+/**
+ * Contains definition of the control-flow graph of a three-address code program.
+ */
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "ControlFlowGraph.h"
+#include "Logger.h"
+
+using namespace TAC;
+
+ControlFlowGraph::ControlFlowGraph(
+    const Instructions& instructions
+)
+{
+    CalculateBlocks( instructions );
+    CalculateEdges( instructions );
+    CalculateReversePostOrder();
+    CalculateDominators();
+    CalculateLoops();
+}
+
+/**
+ * \brief  Gets the number of basic blocks in the program.
+ *
+ * \return  Number of blocks - zero if there are no instructions.
+ */
+size_t
+ControlFlowGraph::GetNumBlocks() const
+{
+    return m_blocks.size();
+}
+
+/**
+ * \brief  Gets a basic block by its index.
+ *
+ * \param[in]  blockIndex  Index of the block.
+ *
+ * \return  The block.
+ */
+const BasicBlock&
+ControlFlowGraph::GetBlock(
+    size_t blockIndex
+) const
+{
+    CheckBlockIndex( blockIndex );
+    return m_blocks[blockIndex];
+}
+
+/**
+ * \brief  Gets the block an instruction belongs to.
+ *
+ * \param[in]  instructionIndex  Index of the instruction.
+ *
+ * \return  Index of the block containing the instruction.
+ */
+size_t
+ControlFlowGraph::GetBlockOfInstruction(
+    size_t instructionIndex
+) const
+{
+    if ( instructionIndex >= m_instructionBlocks.size() )
+    {
+        LOG_ERROR_AND_THROW( "Instruction index " + std::to_string( instructionIndex ) + " is out of range.",
+                             std::out_of_range );
+    }
+    return m_instructionBlocks[instructionIndex];
+}
+
+/**
+ * \brief  Gets the blocks reachable from the entry block, in reverse post-order. Forward dataflow analyses converge
+ *         fastest visiting blocks in this order, and backward analyses in its reverse.
+ *
+ * \return  Indexes of the reachable blocks, in reverse post-order.
+ */
+const std::vector< size_t >&
+ControlFlowGraph::GetReversePostOrder() const
+{
+    return m_reversePostOrder;
+}
+
+/**
+ * \brief  Checks whether a block can be reached from the entry block.
+ *
+ * \param[in]  blockIndex  Index of the block.
+ *
+ * \return  True if the block is reachable, false otherwise.
+ */
+bool
+ControlFlowGraph::IsReachable(
+    size_t blockIndex
+) const
+{
+    CheckBlockIndex( blockIndex );
+    return INVALID_INDEX != m_reversePostOrderNumbers[blockIndex];
+}
+
+/**
+ * \brief  Gets the immediate dominator of a block, i.e. the closest block that every path from the entry to this
+ *         block must pass through.
+ *
+ * \param[in]  blockIndex  Index of the block.
+ *
+ * \return  Index of the immediate dominator, or INVALID_INDEX for the entry block and unreachable blocks.
+ */
+size_t
+ControlFlowGraph::GetImmediateDominator(
+    size_t blockIndex
+) const
+{
+    CheckBlockIndex( blockIndex );
+    return m_immediateDominators[blockIndex];
+}
+
+/**
+ * \brief  Checks whether one block dominates another, i.e. every path from the entry to the block passes through the
+ *         dominator. Every reachable block dominates itself.
+ *
+ * \param[in]  dominator   Index of the potential dominator.
+ * \param[in]  blockIndex  Index of the block being dominated.
+ *
+ * \return  True if dominator dominates the block, false otherwise. Always false if either block is unreachable.
+ */
+bool
+ControlFlowGraph::Dominates(
+    size_t dominator,
+    size_t blockIndex
+) const
+{
+    if ( !IsReachable( dominator ) || !IsReachable( blockIndex ) )
+    {
+        return false;
+    }
+
+    // Walk up the dominator tree from the block, until either the dominator or the entry block is found.
+    for ( size_t current = blockIndex; INVALID_INDEX != current; current = m_immediateDominators[current] )
+    {
+        if ( dominator == current )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * \brief  Gets the natural loops of the program. A loop always comes after any loops it is nested in.
+ *
+ * \return  The loops.
+ */
+const std::vector< Loop >&
+ControlFlowGraph::GetLoops() const
+{
+    return m_loops;
+}
+
+/**
+ * \brief  Gets the innermost loop a block belongs to.
+ *
+ * \param[in]  blockIndex  Index of the block.
+ *
+ * \return  Index of the loop in GetLoops(), or INVALID_INDEX if the block is not in a loop.
+ */
+size_t
+ControlFlowGraph::GetInnermostLoop(
+    size_t blockIndex
+) const
+{
+    CheckBlockIndex( blockIndex );
+    return m_innermostLoops[blockIndex];
+}
+
+/**
+ * \brief  Gets the number of loops a block is nested within.
+ *
+ * \param[in]  blockIndex  Index of the block.
+ *
+ * \return  The loop depth of the block, 0 if it is not in a loop.
+ */
+size_t
+ControlFlowGraph::GetLoopDepth(
+    size_t blockIndex
+) const
+{
+    size_t loopIndex = GetInnermostLoop( blockIndex );
+    return INVALID_INDEX == loopIndex ? 0u : m_loops[loopIndex].depth;
+}
+
+/**
+ * \brief  Checks whether an instruction is a branch that is always taken, so control never falls through it. The
+ *         intermediate code expresses these as a comparison of a variable (or empty operand) with itself.
+ *
+ * \param[in]  instruction  The instruction to check.
+ *
+ * \return  True if the instruction always branches, false otherwise.
+ */
+bool
+ControlFlowGraph::IsUnconditionalBranch(
+    const ThreeAddrInstruction& instruction
+)
+{
+    return Opcode::BRE == instruction.m_opcode && instruction.m_operand1 == instruction.m_operand2;
+}
+
+/**
+ * \brief  Splits the instructions into basic blocks. A block starts at the first instruction, any instruction with a
+ *         label (as it may be branched to), and any instruction following a branch.
+ *
+ * \param[in]  instructions  The instructions of the program.
+ */
+void
+ControlFlowGraph::CalculateBlocks(
+    const Instructions& instructions
+)
+{
+    m_instructionBlocks.resize( instructions.size() );
+
+    for ( size_t index = 0; index < instructions.size(); ++index )
+    {
+        const ThreeAddrInstruction& instr = instructions[index];
+
+        bool isBlockStart = m_blocks.empty() || g_invalidLabelId != instr.m_label
+                            || ThreeAddrInstruction::IsOpcodeBranch( instructions[index - 1].m_opcode );
+        if ( isBlockStart )
+        {
+            if ( !m_blocks.empty() )
+            {
+                m_blocks.back().end = index;
+            }
+            m_blocks.push_back( BasicBlock{ index, instructions.size(), {}, {} } );
+        }
+        m_instructionBlocks[index] = m_blocks.size() - 1;
+    }
+}
+
+/**
+ * \brief  Adds the edges between blocks, resolving the targets of branch instructions from their labels. Each block
+ *         falls through to the next one, unless it ends with an unconditional branch or is the last block.
+ *
+ * \param[in]  instructions  The instructions of the program.
+ */
+void
+ControlFlowGraph::CalculateEdges(
+    const Instructions& instructions
+)
+{
+    std::unordered_map< LabelId, size_t > labelledBlocks;
+    for ( size_t blockIndex = 0; blockIndex < m_blocks.size(); ++blockIndex )
+    {
+        LabelId label = instructions[m_blocks[blockIndex].start].m_label;
+        if ( g_invalidLabelId != label )
+        {
+            labelledBlocks[label] = blockIndex;
+        }
+    }
+
+    for ( size_t blockIndex = 0; blockIndex < m_blocks.size(); ++blockIndex )
+    {
+        const ThreeAddrInstruction& lastInstr = instructions[m_blocks[blockIndex].end - 1];
+
+        bool fallsThrough = true;
+        if ( ThreeAddrInstruction::IsOpcodeBranch( lastInstr.m_opcode ) )
+        {
+            auto target = labelledBlocks.find( lastInstr.m_branchTarget );
+            if ( labelledBlocks.end() == target )
+            {
+                LOG_ERROR_AND_THROW( "Branch at instruction " + std::to_string( m_blocks[blockIndex].end - 1 )
+                                     + " targets a label that isn't attached to any instruction.", std::runtime_error );
+            }
+            fallsThrough = !IsUnconditionalBranch( lastInstr );
+            if ( fallsThrough && blockIndex + 1 < m_blocks.size() )
+            {
+                AddEdge( blockIndex, blockIndex + 1 );
+            }
+            AddEdge( blockIndex, target->second );
+        }
+        else if ( blockIndex + 1 < m_blocks.size() )
+        {
+            AddEdge( blockIndex, blockIndex + 1 );
+        }
+    }
+}
+
+/**
+ * \brief  Adds an edge between two blocks, ignoring duplicates (e.g. a branch to the block it would fall through to).
+ *
+ * \param[in]  from  Index of the block control passes from.
+ * \param[in]  to    Index of the block control passes to.
+ */
+void
+ControlFlowGraph::AddEdge(
+    size_t from,
+    size_t to
+)
+{
+    std::vector< size_t >& successors = m_blocks[from].successors;
+    if ( successors.end() == std::find( successors.begin(), successors.end(), to ) )
+    {
+        successors.push_back( to );
+        m_blocks[to].predecessors.push_back( from );
+    }
+}
+
+/**
+ * \brief  Calculates the reverse post-order of the blocks reachable from the entry block, with an iterative
+ *         depth-first search.
+ */
+void
+ControlFlowGraph::CalculateReversePostOrder()
+{
+    m_reversePostOrderNumbers.assign( m_blocks.size(), INVALID_INDEX );
+    if ( m_blocks.empty() )
+    {
+        return;
+    }
+
+    std::vector< bool > visited( m_blocks.size(), false );
+    // Each stack entry stores a block, and the index of the next of its successors to visit.
+    std::vector< std::pair< size_t, size_t > > stack{ { 0u, 0u } };
+    visited[0] = true;
+    while ( !stack.empty() )
+    {
+        size_t block = stack.back().first;
+        size_t& nextSuccessor = stack.back().second;
+        if ( nextSuccessor < m_blocks[block].successors.size() )
+        {
+            size_t successor = m_blocks[block].successors[nextSuccessor++];
+            if ( !visited[successor] )
+            {
+                visited[successor] = true;
+                stack.emplace_back( successor, 0u );
+            }
+        }
+        else
+        {
+            // All successors have been visited, so this block is finished.
+            m_reversePostOrder.push_back( block );
+            stack.pop_back();
+        }
+    }
+    std::reverse( m_reversePostOrder.begin(), m_reversePostOrder.end() );
+
+    for ( size_t position = 0; position < m_reversePostOrder.size(); ++position )
+    {
+        m_reversePostOrderNumbers[m_reversePostOrder[position]] = position;
+    }
+}
+
+/**
+ * \brief  Calculates the immediate dominator of each reachable block, using the iterative algorithm of Cooper, Harvey
+ *         and Kennedy. This converges in a couple of passes over the reverse post-order for typical programs.
+ */
+void
+ControlFlowGraph::CalculateDominators()
+{
+    m_immediateDominators.assign( m_blocks.size(), INVALID_INDEX );
+    if ( m_blocks.empty() )
+    {
+        return;
+    }
+
+    // While calculating, the entry block is treated as its own dominator so that the intersection terminates.
+    constexpr size_t entryBlock = 0u;
+    m_immediateDominators[entryBlock] = entryBlock;
+
+    bool changed = true;
+    while ( changed )
+    {
+        changed = false;
+        for ( size_t block : m_reversePostOrder )
+        {
+            if ( entryBlock == block )
+            {
+                continue;
+            }
+
+            // Intersect the dominators of all predecessors that have been processed so far.
+            size_t newDominator = INVALID_INDEX;
+            for ( size_t predecessor : m_blocks[block].predecessors )
+            {
+                if ( INVALID_INDEX == m_immediateDominators[predecessor] )
+                {
+                    continue;
+                }
+                newDominator = INVALID_INDEX == newDominator ? predecessor
+                                                             : IntersectDominators( predecessor, newDominator );
+            }
+            if ( newDominator != m_immediateDominators[block] )
+            {
+                m_immediateDominators[block] = newDominator;
+                changed = true;
+            }
+        }
+    }
+
+    m_immediateDominators[entryBlock] = INVALID_INDEX;
+}
+
+/**
+ * \brief  Finds the closest common dominator of two blocks, by walking up the dominator tree calculated so far.
+ *
+ * \param[in]  blockA  Index of the first block.
+ * \param[in]  blockB  Index of the second block.
+ *
+ * \return  Index of the common dominator.
+ */
+size_t
+ControlFlowGraph::IntersectDominators(
+    size_t blockA,
+    size_t blockB
+) const
+{
+    // A block's dominators always come before it in the reverse post-order, so move up from whichever block is later.
+    while ( blockA != blockB )
+    {
+        while ( m_reversePostOrderNumbers[blockA] > m_reversePostOrderNumbers[blockB] )
+        {
+            blockA = m_immediateDominators[blockA];
+        }
+        while ( m_reversePostOrderNumbers[blockB] > m_reversePostOrderNumbers[blockA] )
+        {
+            blockB = m_immediateDominators[blockB];
+        }
+    }
+    return blockA;
+}
+
+/**
+ * \brief  Finds the natural loops of the program from its back edges (edges to a block that dominates their source),
+ *         and works out how they are nested. Cycles without a dominating header, i.e. irreducible control flow, are
+ *         not considered loops - the intermediate code generator never produces these.
+ */
+void
+ControlFlowGraph::CalculateLoops()
+{
+    m_innermostLoops.assign( m_blocks.size(), INVALID_INDEX );
+
+    // A back edge's target is never after its source in reverse post-order, so only those edges (which are rare) need
+    // the dominance check. Collect them first, so the loop bodies are only searched for blocks that head a loop.
+    std::vector< std::pair< size_t, size_t > > backEdges;
+    for ( size_t source : m_reversePostOrder )
+    {
+        for ( size_t target : m_blocks[source].successors )
+        {
+            if ( m_reversePostOrderNumbers[target] <= m_reversePostOrderNumbers[source] && Dominates( target, source ) )
+            {
+                backEdges.emplace_back( target, source );
+            }
+        }
+    }
+    // Visit headers in reverse post-order, so that outer loops are found before the loops nested in them.
+    std::stable_sort( backEdges.begin(), backEdges.end(),
+                      [&]( const std::pair< size_t, size_t >& lhs, const std::pair< size_t, size_t >& rhs )
+                      {
+                          return m_reversePostOrderNumbers[lhs.first] < m_reversePostOrderNumbers[rhs.first];
+                      } );
+
+    // Shared between loops, and reset after each one by clearing only the blocks in it.
+    std::vector< bool > inLoop( m_blocks.size(), false );
+    std::vector< size_t > worklist;
+    for ( auto edge = backEdges.begin(); backEdges.end() != edge; )
+    {
+        size_t header = edge->first;
+        Loop loop{ header, { header }, INVALID_INDEX, 1u };
+        inLoop[header] = true;
+        for ( ; backEdges.end() != edge && header == edge->first; ++edge )
+        {
+            if ( !inLoop[edge->second] )
+            {
+                inLoop[edge->second] = true;
+                loop.blocks.push_back( edge->second );
+                worklist.push_back( edge->second );
+            }
+        }
+
+        // The loop body is every block that can reach a back edge without passing through the header.
+        while ( !worklist.empty() )
+        {
+            size_t block = worklist.back();
+            worklist.pop_back();
+            for ( size_t predecessor : m_blocks[block].predecessors )
+            {
+                if ( !inLoop[predecessor] && IsReachable( predecessor ) )
+                {
+                    inLoop[predecessor] = true;
+                    loop.blocks.push_back( predecessor );
+                    worklist.push_back( predecessor );
+                }
+            }
+        }
+        for ( size_t block : loop.blocks )
+        {
+            inLoop[block] = false;
+        }
+        std::sort( loop.blocks.begin(), loop.blocks.end() );
+
+        // Enclosing loops were found earlier, and the most recent loop containing the header is the innermost.
+        size_t parent = m_innermostLoops[header];
+        if ( INVALID_INDEX != parent )
+        {
+            loop.parent = parent;
+            loop.depth = m_loops[parent].depth + 1u;
+        }
+
+        size_t loopIndex = m_loops.size();
+        for ( size_t block : loop.blocks )
+        {
+            m_innermostLoops[block] = loopIndex;
+        }
+        m_loops.push_back( std::move( loop ) );
+    }
+}
+
+/**
+ * \brief  Throws if a block index is out of range.
+ *
+ * \param[in]  blockIndex  Index of the block.
+ */
+void
+ControlFlowGraph::CheckBlockIndex(
+    size_t blockIndex
+) const
+{
+    if ( blockIndex >= m_blocks.size() )
+    {
+        LOG_ERROR_AND_THROW( "Block index " + std::to_string( blockIndex ) + " is out of range.", std::out_of_range );
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * Contains declaration of the control-flow graph of a three-address code program.
+ */
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "ThreeAddrInstruction.h"
+
+namespace TAC
+{
+    /**
+     * \brief  A maximal run of instructions with a single entry point (its first instruction) and a single exit point
+     *         (its last instruction). Blocks are referred to by their index in the graph, which is also their order
+     *         in the program.
+     */
+    struct BasicBlock
+    {
+        // Index of the first instruction in the block (inclusive).
+        size_t start;
+        // Index of the end of the block (exclusive), i.e. the start of the next block.
+        size_t end;
+
+        // Blocks control can pass to from the end of this block, and blocks that can pass control to this block.
+        std::vector< size_t > successors;
+        std::vector< size_t > predecessors;
+    };
+
+    /**
+     * \brief  A natural loop: the blocks that can reach a back edge without passing through its header, which
+     *         dominates them all. Back edges into the same header are merged into one loop.
+     */
+    struct Loop
+    {
+        // The single entry block of the loop, i.e. the target of its back edges.
+        size_t header;
+        // All blocks in the loop (including the header and those of nested loops), in ascending order.
+        std::vector< size_t > blocks;
+        // Index of the innermost loop this one is nested in, or ControlFlowGraph::INVALID_INDEX if it is outermost.
+        size_t parent;
+        // Number of loops this loop is nested within, plus 1 - i.e. 1 for an outermost loop.
+        size_t depth;
+    };
+
+    /**
+     * \brief  The basic blocks of a TAC program and the edges between them, along with the orders and relationships
+     *         derived from these which back-end passes need to query: reverse post-order, dominators, and loop nesting.
+     *
+     *         The graph is calculated once, on construction, and is immutable afterwards. Blocks are only calculated
+     *         from the instructions, so the graph must be rebuilt if these are changed.
+     */
+    class ControlFlowGraph
+    {
+    public:
+        using Ptr = std::shared_ptr< ControlFlowGraph >;
+        using Instructions = std::vector< ThreeAddrInstruction >;
+
+        // Represents the absence of a block or loop, e.g. the immediate dominator of the entry block.
+        static constexpr size_t INVALID_INDEX = std::numeric_limits< size_t >::max();
+
+        ControlFlowGraph( const Instructions& instructions );
+
+        size_t GetNumBlocks() const;
+        const BasicBlock& GetBlock( size_t blockIndex ) const;
+        size_t GetBlockOfInstruction( size_t instructionIndex ) const;
+
+        const std::vector< size_t >& GetReversePostOrder() const;
+        bool IsReachable( size_t blockIndex ) const;
+
+        size_t GetImmediateDominator( size_t blockIndex ) const;
+        bool Dominates( size_t dominator, size_t blockIndex ) const;
+
+        const std::vector< Loop >& GetLoops() const;
+        size_t GetInnermostLoop( size_t blockIndex ) const;
+        size_t GetLoopDepth( size_t blockIndex ) const;
+
+        static bool IsUnconditionalBranch( const ThreeAddrInstruction& instruction );
+
+    protected:
+        void CalculateBlocks( const Instructions& instructions );
+        void CalculateEdges( const Instructions& instructions );
+        void AddEdge( size_t from, size_t to );
+        void CalculateReversePostOrder();
+        void CalculateDominators();
+        size_t IntersectDominators( size_t blockA, size_t blockB ) const;
+        void CalculateLoops();
+
+        void CheckBlockIndex( size_t blockIndex ) const;
+
+        // The blocks of the program, in program order. The entry block, if there are any instructions, is block 0.
+        std::vector< BasicBlock > m_blocks;
+        // For each instruction, the index of the block containing it.
+        std::vector< size_t > m_instructionBlocks;
+
+        // The blocks reachable from the entry block, in reverse post-order: every block comes before its successors,
+        // except along back edges.
+        std::vector< size_t > m_reversePostOrder;
+        // For each block, its position in the reverse post-order, or INVALID_INDEX if it is unreachable.
+        std::vector< size_t > m_reversePostOrderNumbers;
+
+        // For each block, the index of its immediate dominator. INVALID_INDEX for the entry and unreachable blocks.
+        std::vector< size_t > m_immediateDominators;
+
+        // The natural loops of the program. Ordered so that a loop always comes after any loops it is nested in.
+        std::vector< Loop > m_loops;
+        // For each block, the index of the innermost loop containing it, or INVALID_INDEX if it is not in a loop.
+        std::vector< size_t > m_innermostLoops;
+    };
+
+} // namespace TAC
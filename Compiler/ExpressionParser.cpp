@@ -0,0 +1,342 @@
+/**
+ * Contains definition of class responsible for parsing expressions by operator precedence.
+ */
+
+#include "ExpressionParser.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+// The loosest-binding expression non-terminal. Every non-terminal reachable from it through single-operand rules is
+// parsed by precedence.
+static constexpr GrammarSymbols::NT g_expressionRootNt = Logical;
+
+ExpressionParser::ExpressionParser(
+    const Tokens& tokens,
+    AstArena& arena
+)
+: m_tokens( tokens ),
+  m_arena( arena )
+{
+}
+
+/**
+ * \brief  Checks whether a non-terminal is one of the expression levels parsed by this class.
+ *
+ * \param[in]  nt  The non-terminal to check.
+ *
+ * \return  True if the non-terminal is an expression level, false otherwise.
+ */
+bool
+ExpressionParser::IsExpressionNt(
+    GrammarSymbols::NT nt
+)
+{
+    const BindingPowerTable& table = GetBindingPowerTable();
+    return table.ntBindingPowers.end() != table.ntBindingPowers.find( nt );
+}
+
+/**
+ * \brief  Parses an expression non-terminal, consuming as many tokens as its rules allow.
+ *
+ * \param[in,out]  currentTokenIndex  Index of the next token to parse. Is only modified upon successful parsing.
+ * \param[in]      nt                 The expression non-terminal to parse.
+ *
+ * \return  Root of the parsed expression. Null if the tokens don't start with a valid expression.
+ */
+AstNode
+ExpressionParser::ParseExpression(
+    size_t& currentTokenIndex,
+    GrammarSymbols::NT nt
+)
+{
+    const BindingPowerTable& table = GetBindingPowerTable();
+    auto ntBindingPower = table.ntBindingPowers.find( nt );
+    if ( table.ntBindingPowers.end() == ntBindingPower )
+    {
+        LOG_ERROR_AND_THROW( GrammarSymbols::ConvertSymbolToString( nt ) + " is not an expression non-terminal.",
+                             std::invalid_argument );
+    }
+
+    LOG_INFO_MEDIUM_LEVEL( "Parsing expression for " + GrammarSymbols::ConvertSymbolToString( nt ) + " from tokens "
+                           + Token::ConvertTokensToString( m_tokens, currentTokenIndex, 3 ) + "..." );
+    return ParseFromBindingPower( currentTokenIndex, ntBindingPower->second );
+}
+
+/**
+ * \brief  Gets the binding power table, deriving it from the grammar on first use.
+ *
+ * \return  The shared binding power table.
+ */
+const ExpressionParser::BindingPowerTable&
+ExpressionParser::GetBindingPowerTable()
+{
+    static const BindingPowerTable table = DeriveBindingPowerTable();
+    return table;
+}
+
+/**
+ * \brief  Walks the expression non-terminals from the root down, assigning each one a binding power and recording the
+ *         operators its rules introduce. Throws if a rule doesn't have one of the shapes this parser understands, as
+ *         it would otherwise parse the grammar differently to the rule engine.
+ *
+ * \return  The derived binding power table.
+ */
+ExpressionParser::BindingPowerTable
+ExpressionParser::DeriveBindingPowerTable()
+{
+    BindingPowerTable table{};
+    table.groupOpenToken = TokenType::INVALID_TOKEN;
+    table.groupCloseToken = TokenType::INVALID_TOKEN;
+
+    auto isNonTerminal = []( Symbol symbol ) { return SymbolType::NonTerminal == GrammarSymbols::GetSymbolType( symbol ); };
+    auto isTerminal = []( Symbol symbol ) { return SymbolType::Terminal == GrammarSymbols::GetSymbolType( symbol ); };
+
+    GrammarSymbols::NT currentNt = g_expressionRootNt;
+    for ( size_t bindingPower = 0u; ; ++bindingPower )
+    {
+        const std::string ntString = GrammarSymbols::ConvertSymbolToString( currentNt );
+        auto ruleSet = g_nonTerminalRuleSets.find( currentNt );
+        if ( g_nonTerminalRuleSets.end() == ruleSet || !table.ntBindingPowers.emplace( currentNt, bindingPower ).second )
+        {
+            LOG_ERROR_AND_THROW( "Expression non-terminal " + ntString + " has no rules, or is reached twice.",
+                                 std::runtime_error );
+        }
+
+        // The non-terminal on the next level down, named by this level's operand rule.
+        Symbol operandSymbol = T::INVALID_TOKEN;
+        std::vector< TokenType > infixOperators;
+        std::vector< TokenType > prefixOperators;
+        bool isPrimaryLevel{ false };
+
+        for ( const Rule& rule : ruleSet->second )
+        {
+            if ( 1u == rule.size() && isNonTerminal( rule[0] ) )
+            {
+                // { Operand }
+                operandSymbol = rule[0];
+            }
+            else if ( 3u == rule.size() && isNonTerminal( rule[0] ) && isTerminal( rule[1] ) && rule[0] == rule[2] )
+            {
+                // { Operand, op, Operand }
+                operandSymbol = rule[0];
+                infixOperators.push_back( static_cast< TokenType >( rule[1] ) );
+            }
+            else if ( 2u == rule.size() && isTerminal( rule[0] ) && isNonTerminal( rule[1] ) )
+            {
+                // { op, Operand }
+                operandSymbol = rule[1];
+                prefixOperators.push_back( static_cast< TokenType >( rule[0] ) );
+            }
+            else if ( 1u == rule.size() && isTerminal( rule[0] ) )
+            {
+                // { leaf }
+                isPrimaryLevel = true;
+                table.leafTokens.insert( static_cast< TokenType >( rule[0] ) );
+            }
+            else if ( 3u == rule.size() && isTerminal( rule[0] ) && g_expressionRootNt == rule[1] && isTerminal( rule[2] )
+                      && g_skipForAstTerminals.end() != g_skipForAstTerminals.find( static_cast< T >( rule[0] ) )
+                      && g_skipForAstTerminals.end() != g_skipForAstTerminals.find( static_cast< T >( rule[2] ) ) )
+            {
+                // { open, Root, close }, where the brackets are left out of the AST.
+                isPrimaryLevel = true;
+                table.groupOpenToken = static_cast< TokenType >( rule[0] );
+                table.groupCloseToken = static_cast< TokenType >( rule[2] );
+            }
+            else
+            {
+                LOG_ERROR_AND_THROW( "Expression rule '" + GrammarRules::ConvertRuleToString( rule ) + "' of " + ntString
+                                     + " can't be parsed by precedence.", std::runtime_error );
+            }
+        }
+
+        if ( isPrimaryLevel )
+        {
+            if ( T::INVALID_TOKEN != operandSymbol )
+            {
+                LOG_ERROR_AND_THROW( "Expression non-terminal " + ntString + " mixes operand and operator rules.",
+                                     std::runtime_error );
+            }
+            table.primaryBindingPower = bindingPower;
+            return table;
+        }
+
+        // Every rule on an operator level must share the same operand, which must be the next level down. Prefix
+        // operators take the next level down as their operand too, so they bind more tightly than this level's infix
+        // operators.
+        for ( const Rule& rule : ruleSet->second )
+        {
+            if ( rule.end() == std::find( rule.begin(), rule.end(), operandSymbol ) )
+            {
+                LOG_ERROR_AND_THROW( "Expression rules of " + ntString + " don't share an operand.", std::runtime_error );
+            }
+        }
+        for ( TokenType op : infixOperators )
+        {
+            table.infixBindingPowers.emplace( op, bindingPower );
+        }
+        for ( TokenType op : prefixOperators )
+        {
+            table.prefixBindingPowers.emplace( op, bindingPower );
+        }
+
+        currentNt = static_cast< GrammarSymbols::NT >( operandSymbol );
+    }
+}
+
+/**
+ * \brief  Parses an expression whose operators all bind at least as tightly as the given binding power. Applies each
+ *         following operator that binds loosely enough, until one binds too tightly or too loosely to be applied.
+ *
+ *         After applying an operator, only operators on looser levels may follow, as each level's rule only allows
+ *         one operator. If the operand after an operator can't be parsed, the operator is left unconsumed, matching
+ *         the rule engine falling back to the level's single-operand rule.
+ *
+ * \param[in,out]  currentTokenIndex  Index of the next token to parse. Is only modified upon successful parsing.
+ * \param[in]      minBindingPower    Binding power of the level being parsed. Operators on looser levels are left
+ *                                    for the caller.
+ *
+ * \return  Root of the parsed expression. Null if the tokens don't start with a valid expression.
+ */
+AstNode
+ExpressionParser::ParseFromBindingPower(
+    size_t& currentTokenIndex,
+    size_t minBindingPower
+)
+{
+    const BindingPowerTable& table = GetBindingPowerTable();
+
+    size_t tokenIndexCopy = currentTokenIndex;
+    size_t maxInfixBindingPower;
+    AstNode left = ParseOperand( tokenIndexCopy, minBindingPower, maxInfixBindingPower );
+    if ( nullptr == left )
+    {
+        return nullptr;
+    }
+
+    while ( tokenIndexCopy < m_tokens.size() )
+    {
+        const TokenType operatorType = m_tokens[tokenIndexCopy].m_type;
+        auto infixBindingPower = table.infixBindingPowers.find( operatorType );
+        if ( table.infixBindingPowers.end() == infixBindingPower
+             || infixBindingPower->second < minBindingPower
+             || infixBindingPower->second >= maxInfixBindingPower )
+        {
+            break;
+        }
+
+        // The right operand is the next level down, so must bind more tightly than this operator.
+        size_t rightTokenIndex = tokenIndexCopy + 1u;
+        AstNode right = ParseFromBindingPower( rightTokenIndex, infixBindingPower->second + 1u );
+        if ( nullptr == right )
+        {
+            LOG_INFO_MEDIUM_LEVEL( "No operand after " + TokenTypes::ConvertTokenTypeToString( operatorType )
+                                   + ": leaving it unparsed." );
+            break;
+        }
+
+        left = m_arena.CreateNode( operatorType, AstNode::Children{ left, right } );
+        tokenIndexCopy = rightTokenIndex;
+        maxInfixBindingPower = infixBindingPower->second;
+    }
+
+    currentTokenIndex = tokenIndexCopy;
+    return left;
+}
+
+/**
+ * \brief  Parses the operand at the start of an expression: either a prefix operator applied to an expression, or a
+ *         primary operand.
+ *
+ * \param[in,out]  currentTokenIndex     Index of the next token to parse. Is only modified upon successful parsing.
+ * \param[in]      minBindingPower       Binding power of the level being parsed. A prefix operator on a looser level
+ *                                       is rejected.
+ * \param[out]     maxInfixBindingPower  Set to the binding power that infix operators after the operand must be looser
+ *                                       than.
+ *
+ * \return  The parsed operand. Null if the tokens don't start with a valid operand.
+ */
+AstNode
+ExpressionParser::ParseOperand(
+    size_t& currentTokenIndex,
+    size_t minBindingPower,
+    size_t& maxInfixBindingPower
+)
+{
+    const BindingPowerTable& table = GetBindingPowerTable();
+    if ( currentTokenIndex >= m_tokens.size() )
+    {
+        LOG_INFO_MEDIUM_LEVEL( "Run out of tokens to consume." );
+        return nullptr;
+    }
+
+    const TokenType operatorType = m_tokens[currentTokenIndex].m_type;
+    auto prefixBindingPower = table.prefixBindingPowers.find( operatorType );
+    if ( table.prefixBindingPowers.end() == prefixBindingPower )
+    {
+        // Tighter than every infix operator, so any of them may follow.
+        maxInfixBindingPower = table.primaryBindingPower;
+        return ParsePrimary( currentTokenIndex );
+    }
+
+    if ( prefixBindingPower->second < minBindingPower )
+    {
+        LOG_INFO_MEDIUM_LEVEL( "Operator " + TokenTypes::ConvertTokenTypeToString( operatorType )
+                               + " binds too loosely to be used here." );
+        return nullptr;
+    }
+
+    size_t operandTokenIndex = currentTokenIndex + 1u;
+    AstNode operand = ParseFromBindingPower( operandTokenIndex, prefixBindingPower->second + 1u );
+    if ( nullptr == operand )
+    {
+        return nullptr;
+    }
+
+    // The operand has already consumed every operator on tighter levels than the prefix operator, and its own level
+    // only allows the one operator.
+    maxInfixBindingPower = prefixBindingPower->second;
+    currentTokenIndex = operandTokenIndex;
+    return m_arena.CreateNode( operatorType, AstNode::Children{ operand } );
+}
+
+/**
+ * \brief  Parses a primary operand: a leaf token such as an identifier, or a bracketed expression.
+ *
+ * \param[in,out]  currentTokenIndex  Index of the next token to parse. Is only modified upon successful parsing.
+ *
+ * \return  The parsed operand. Null if the tokens don't start with a valid operand.
+ */
+AstNode
+ExpressionParser::ParsePrimary(
+    size_t& currentTokenIndex
+)
+{
+    const BindingPowerTable& table = GetBindingPowerTable();
+    const Token& token = m_tokens[currentTokenIndex];
+
+    if ( table.leafTokens.end() != table.leafTokens.find( token.m_type ) )
+    {
+        ++currentTokenIndex;
+        return m_arena.CreateNode( token.m_type, token );
+    }
+
+    if ( table.groupOpenToken == token.m_type )
+    {
+        size_t tokenIndexCopy = currentTokenIndex + 1u;
+        AstNode nested = ParseFromBindingPower( tokenIndexCopy, 0u );
+        if ( nullptr == nested || tokenIndexCopy >= m_tokens.size()
+             || table.groupCloseToken != m_tokens[tokenIndexCopy].m_type )
+        {
+            LOG_INFO_MEDIUM_LEVEL( "Bracketed expression isn't valid or isn't closed." );
+            return nullptr;
+        }
+        // The brackets aren't kept in the AST, so the nested expression stands in for them.
+        currentTokenIndex = tokenIndexCopy + 1u;
+        return nested;
+    }
+
+    LOG_INFO_MEDIUM_LEVEL( "Token " + token.ToString() + " can't start an expression." );
+    return nullptr;
+}
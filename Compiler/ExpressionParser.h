@@ -0,0 +1,65 @@
+/**
+ * Contains declaration of class responsible for parsing expressions by operator precedence.
+ */
+
+#pragma once
+#include "Grammar.h"
+#include "AstArena.h"
+
+#include <unordered_map>
+
+using namespace GrammarRules;
+
+/**
+ * \brief  Parses the expression non-terminals (Logical down to Factor) by precedence climbing, rather than by trying
+ *         each grammar rule of each level in turn. Operators are looked up in a binding-power table derived from the
+ *         expression rules in g_nonTerminalRuleSets, so the grammar remains the single definition of the language.
+ *
+ *         Produces the same AST nodes, and accepts the same token sequences, as parsing the expression rules with
+ *         AstGenerator's rule engine. In particular, each precedence level only allows one binary operator, so
+ *         operators on the same level must be separated by parentheses.
+ */
+class ExpressionParser
+{
+public:
+    ExpressionParser( const Tokens& tokens, AstArena& arena );
+
+    static bool IsExpressionNt( GrammarSymbols::NT nt );
+
+    AstNode ParseExpression( size_t& currentTokenIndex, GrammarSymbols::NT nt );
+
+protected:
+    /**
+     * \brief  Binding powers of the expression operators, derived from the expression rules. Each non-terminal from
+     *         the root expression non-terminal down is one precedence level, with binding power equal to its depth,
+     *         so operators on deeper levels bind more tightly.
+     */
+    struct BindingPowerTable
+    {
+        // Binding power of each expression non-terminal.
+        std::unordered_map< GrammarSymbols::NT, size_t > ntBindingPowers;
+        // Binary operators, from rules of the form { Operand, op, Operand }.
+        std::unordered_map< TokenType, size_t > infixBindingPowers;
+        // Unary operators, from rules of the form { op, Operand }.
+        std::unordered_map< TokenType, size_t > prefixBindingPowers;
+        // Binding power of the bottom level, which holds the operands themselves.
+        size_t primaryBindingPower;
+        // Tokens which form a whole operand, e.g. identifiers.
+        std::unordered_set< TokenType > leafTokens;
+        // Tokens surrounding a nested expression, from a rule of the form { open, root NT, close }.
+        TokenType groupOpenToken;
+        TokenType groupCloseToken;
+    };
+
+    static const BindingPowerTable& GetBindingPowerTable();
+    static BindingPowerTable DeriveBindingPowerTable();
+
+    AstNode ParseFromBindingPower( size_t& currentTokenIndex, size_t minBindingPower );
+    AstNode ParseOperand( size_t& currentTokenIndex, size_t minBindingPower, size_t& maxInfixBindingPower );
+    AstNode ParsePrimary( size_t& currentTokenIndex );
+
+    // The collection of tokens being parsed. Not owned by this class, so must outlive it.
+    const Tokens& m_tokens;
+    // Arena in which the AST nodes are created. Not owned by this class.
+    AstArena& m_arena;
+};
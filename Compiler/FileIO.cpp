@@ -6,35 +6,6 @@
 #include "Logger.h"
 #include <fstream>
 
-/**
- * \brief  Reads entire file into string.
- *
- * \param[in]  filePath  Path to file.
- *
- * \return  String containing the contents of the file.
- */
-std::string
-FileIO::ReadFileToString(
-    const std::string& filePath
-)
-{
-    std::ifstream file( filePath );
-    if ( !file.is_open() )
-    {
-        LOG_ERROR_AND_THROW( "Failed to open file " + filePath, std::invalid_argument );
-    }
-
-    std::string fileString;
-
-    std::string line;
-    while ( std::getline( file, line ) )
-    {
-        fileString += line + "\n";
-    }
-
-    return fileString;
-}
-
 /**
  * \brief  Appends line to the end of given file.
  *
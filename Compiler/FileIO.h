@@ -6,7 +6,5 @@
 
 namespace FileIO
 {
-    std::string ReadFileToString( const std::string& filePath );
-
     void AppendLineToFile( const std::string& line, const std::string& filePath );
 }
\ No newline at end of file
@@ -0,0 +1,215 @@
+/**
+ * Definition of the flat symbol table, which stores the symbols of every scope in a program.
+ */
+
+#include "FlatSymbolTable.h"
+#include "Logger.h"
+
+#include <stdexcept>
+#include <string>
+
+FlatSymbolTable::FlatSymbolTable()
+: m_variables( std::make_shared< VariableTable >() )
+{
+}
+
+/**
+ * \brief  Adds a new scope to the table.
+ *
+ * \param[in]  parentScope  The scope enclosing the new one. g_noScope if the new scope is a root scope.
+ *
+ * \return  ID of the new scope.
+ */
+ScopeId
+FlatSymbolTable::AddScope(
+    ScopeId parentScope
+)
+{
+    if ( g_noScope != parentScope )
+    {
+        CheckScope( parentScope );
+    }
+    if ( m_scopes.size() >= g_noScope )
+    {
+        LOG_ERROR_AND_THROW( "Too many scopes to store in the symbol table.", std::runtime_error );
+    }
+
+    const ScopeId newScope = static_cast< ScopeId >( m_scopes.size() );
+
+    // Any open scopes which don't enclose the new one are finished with: the last scope inside them is the latest one.
+    while ( !m_openScopes.empty() && parentScope != m_openScopes.back() )
+    {
+        m_scopes[m_openScopes.back()].lastDescendant = newScope - 1u;
+        m_openScopes.pop_back();
+    }
+    // If the parent was already finished with, scopes are no longer being added in traversal order.
+    if ( g_noScope != parentScope && m_openScopes.empty() )
+    {
+        m_scopesInTraversalOrder = false;
+    }
+    m_openScopes.push_back( newScope );
+
+    m_scopes.push_back( { parentScope, g_noScope, 0u } );
+    return newScope;
+}
+
+/**
+ * \brief  Searches for the entry of an identifier visible from a scope, i.e. declared in the scope or an enclosing one.
+ *
+ * \param[in]  scope       The scope the identifier is used in.
+ * \param[in]  identifier  The interned identifier of the symbol.
+ *
+ * \return  Pointer to the entry, or nullptr if one couldn't be found. Remains valid for the lifetime of the table.
+ */
+SymbolTableEntry*
+FlatSymbolTable::GetEntryIfExists(
+    ScopeId scope,
+    IdentifierId identifier
+)
+{
+    CheckScope( scope );
+    DeclarationIndex declaration = FindVisibleDeclaration( scope, identifier );
+    return s_noDeclaration == declaration ? nullptr : &m_declarations[declaration].entry;
+}
+
+/**
+ * \brief  Declares an identifier in a scope, shadowing any declarations of it in enclosing scopes.
+ *
+ * \param[in]  scope       The scope the identifier is declared in.
+ * \param[in]  identifier  The interned identifier of the symbol.
+ * \param[in]  entry       Information about the symbol. Its variable ID is allocated by the table.
+ *
+ * \return  The stored entry. Remains valid for the lifetime of the table.
+ */
+SymbolTableEntry&
+FlatSymbolTable::AddEntry(
+    ScopeId scope,
+    IdentifierId identifier,
+    const SymbolTableEntry& entry
+)
+{
+    CheckScope( scope );
+    if ( g_invalidIdentifierId == identifier )
+    {
+        LOG_ERROR_AND_THROW( "Could not add symbol table entry: invalid identifier.", std::invalid_argument );
+    }
+
+    // If the scope already declares this identifier, throw error
+    DeclarationIndex visibleDeclaration = FindVisibleDeclaration( scope, identifier );
+    if ( s_noDeclaration != visibleDeclaration && scope == m_declarations[visibleDeclaration].scope )
+    {
+        const std::string& name = IdentifierTable::GetInstance()->GetName( identifier );
+        LOG_ERROR_AND_THROW( "Could not add symbol table entry for '" + name + "': entry already exists",
+                             std::runtime_error );
+    }
+    if ( m_declarations.size() >= s_noDeclaration )
+    {
+        LOG_ERROR_AND_THROW( "Too many declarations to store in the symbol table.", std::runtime_error );
+    }
+
+    const size_t identifierIndex = static_cast< size_t >( identifier );
+    if ( identifierIndex >= m_latestDeclarations.size() )
+    {
+        m_latestDeclarations.resize( identifierIndex + 1u, s_noDeclaration );
+    }
+
+    m_declarations.push_back( { entry, scope, m_latestDeclarations[identifierIndex] } );
+    const std::string& name = IdentifierTable::GetInstance()->GetName( identifier );
+    m_declarations.back().entry.varId = m_variables->AddVariable( name );
+    m_latestDeclarations[identifierIndex] = static_cast< DeclarationIndex >( m_declarations.size() - 1u );
+    ++m_scopes[scope].numEntries;
+    return m_declarations.back().entry;
+}
+
+/**
+ * \brief  Gets the number of identifiers declared in a scope, not including enclosing scopes.
+ *
+ * \param[in]  scope  The scope.
+ *
+ * \return  Number of entries in the scope.
+ */
+size_t
+FlatSymbolTable::GetNumEntries(
+    ScopeId scope
+) const
+{
+    CheckScope( scope );
+    return m_scopes[scope].numEntries;
+}
+
+/**
+ * \brief  Throws if a scope doesn't belong to this table.
+ */
+void
+FlatSymbolTable::CheckScope(
+    ScopeId scope
+) const
+{
+    if ( scope >= m_scopes.size() )
+    {
+        LOG_ERROR_AND_THROW( "Scope " + std::to_string( scope ) + " does not exist in the symbol table.",
+                             std::out_of_range );
+    }
+}
+
+/**
+ * \brief  Queries whether a scope is, or encloses, another scope.
+ *
+ * \param[in]  enclosingScope  The potentially enclosing scope.
+ * \param[in]  scope           The scope to check.
+ *
+ * \return  True if the scope is, or is inside, the enclosing scope.
+ */
+bool
+FlatSymbolTable::IsEnclosingScope(
+    ScopeId enclosingScope,
+    ScopeId scope
+) const
+{
+    // Enclosing scopes are always added before the scopes inside them.
+    if ( scope < enclosingScope )
+    {
+        return false;
+    }
+    if ( m_scopesInTraversalOrder )
+    {
+        return scope <= m_scopes[enclosingScope].lastDescendant;
+    }
+
+    while ( g_noScope != scope && scope > enclosingScope )
+    {
+        scope = m_scopes[scope].parent;
+    }
+    return scope == enclosingScope;
+}
+
+/**
+ * \brief  Finds the declaration of an identifier visible from a scope, by searching down the identifier's stack of
+ *         declarations for the first made in the scope or an enclosing one.
+ *
+ * \param[in]  scope       The scope the identifier is used in.
+ * \param[in]  identifier  The interned identifier of the symbol.
+ *
+ * \return  Index of the declaration, or s_noDeclaration if there is none.
+ */
+FlatSymbolTable::DeclarationIndex
+FlatSymbolTable::FindVisibleDeclaration(
+    ScopeId scope,
+    IdentifierId identifier
+) const
+{
+    const size_t identifierIndex = static_cast< size_t >( identifier );
+    if ( identifierIndex >= m_latestDeclarations.size() )
+    {
+        return s_noDeclaration;
+    }
+
+    // Declarations above the visible one on the stack were made in scopes which don't enclose this one, e.g. a later
+    // loop declaring a variable with the same name.
+    DeclarationIndex declaration = m_latestDeclarations[identifierIndex];
+    while ( s_noDeclaration != declaration && !IsEnclosingScope( m_declarations[declaration].scope, scope ) )
+    {
+        declaration = m_declarations[declaration].previous;
+    }
+    return declaration;
+}
@@ -0,0 +1,95 @@
+/**
+ * Declaration of the flat symbol table, which stores the symbols of every scope in a program.
+ */
+
+#pragma once
+
+#include "SymbolTableEntry.h"
+#include "IdentifierTable.h"
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// Index of a scope within a FlatSymbolTable.
+using ScopeId = uint32_t;
+
+// Represents the absence of a scope, e.g. the parent of a root scope.
+constexpr ScopeId g_noScope = std::numeric_limits< ScopeId >::max();
+
+/**
+ * \brief  Stores the symbols of every scope in a program in one table, rather than a table per scope. Each identifier
+ *         has a stack of its declarations, most recent first, each stamped with the scope it was declared in. Looking
+ *         up an identifier from a scope returns the first declaration on its stack made in that scope or an
+ *         enclosing one, so a declaration in an inner scope shadows those in enclosing scopes.
+ *
+ *         The stacks are indexed by interned identifier ID, which are dense, and whether a scope encloses another is
+ *         checked in constant time, so the cost of a lookup doesn't depend on how deeply the scope is nested. Lookups
+ *         allocate nothing.
+ *
+ *         Each entry is allocated a variable ID as it is added, so the IDs of a program's symbols are numbered in the
+ *         order they are declared.
+ */
+class FlatSymbolTable
+{
+public:
+    using Ptr = std::shared_ptr< FlatSymbolTable >;
+
+    FlatSymbolTable();
+
+    ScopeId AddScope( ScopeId parentScope );
+
+    SymbolTableEntry* GetEntryIfExists( ScopeId scope, IdentifierId identifier );
+    SymbolTableEntry& AddEntry( ScopeId scope, IdentifierId identifier, const SymbolTableEntry& entry );
+
+    size_t GetNumEntries( ScopeId scope ) const;
+
+    const VariableTable::Ptr& GetVariableTable() const { return m_variables; }
+
+private:
+    // Index of a declaration within the table.
+    using DeclarationIndex = uint32_t;
+    static constexpr DeclarationIndex s_noDeclaration = std::numeric_limits< DeclarationIndex >::max();
+
+    struct Scope
+    {
+        ScopeId parent;
+        // The last scope added inside this one, or this scope if there are none. g_noScope while scopes may still be
+        // added inside it.
+        ScopeId lastDescendant;
+        uint32_t numEntries;
+    };
+
+    struct Declaration
+    {
+        SymbolTableEntry entry;
+        ScopeId scope;
+        // The previous declaration of the same identifier, i.e. the next one down its stack.
+        DeclarationIndex previous;
+    };
+
+    void CheckScope( ScopeId scope ) const;
+    bool IsEnclosingScope( ScopeId enclosingScope, ScopeId scope ) const;
+    DeclarationIndex FindVisibleDeclaration( ScopeId scope, IdentifierId identifier ) const;
+
+    std::vector< Scope > m_scopes;
+
+    // Every declaration, in the order they were added. Deque elements are never moved, so entries returned by lookups
+    // remain valid as more are added.
+    std::deque< Declaration > m_declarations;
+
+    // The most recent declaration of each identifier, i.e. the top of its stack, indexed by identifier ID.
+    std::vector< DeclarationIndex > m_latestDeclarations;
+
+    // Scopes are numbered in the order they are added. While they are added in the order a depth-first traversal
+    // reaches them, the scopes inside a scope are numbered contiguously after it, and can be checked by range.
+    // Otherwise the parent chain has to be walked.
+    bool m_scopesInTraversalOrder{ true };
+    // The latest scope added and the scopes enclosing it, outermost first, while in traversal order.
+    std::vector< ScopeId > m_openScopes;
+
+    // Allocates the variable ID of each entry as it is added.
+    VariableTable::Ptr m_variables;
+};
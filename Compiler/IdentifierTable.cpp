@@ -0,0 +1,88 @@
+/**
+ * Contains definition of the table used to intern identifier strings.
+ */
+
+#include "IdentifierTable.h"
+#include "Logger.h"
+
+#include <stdexcept>
+
+/**
+ * \brief  Gets the ID of an identifier string, adding it to the table if it hasn't been seen before.
+ *
+ * \param[in]  name  The identifier string.
+ *
+ * \return  The ID representing the identifier.
+ */
+IdentifierId
+IdentifierTable::Intern(
+    std::string_view name
+)
+{
+    auto existingId = m_ids.find( name );
+    if ( m_ids.end() != existingId )
+    {
+        return existingId->second;
+    }
+
+    if ( static_cast< size_t >( g_invalidIdentifierId ) <= m_names.size() )
+    {
+        LOG_ERROR_AND_THROW( "Too many identifiers to intern '" + std::string( name ) + "'.", std::runtime_error );
+    }
+
+    IdentifierId newId = static_cast< IdentifierId >( m_names.size() );
+    m_names.emplace_back( name );
+    m_ids.emplace( m_names.back(), newId );
+    return newId;
+}
+
+/**
+ * \brief  Gets the ID of an identifier string without adding it to the table.
+ *
+ * \param[in]  name  The identifier string.
+ *
+ * \return  The ID representing the identifier, or g_invalidIdentifierId if it has not been interned.
+ */
+IdentifierId
+IdentifierTable::GetIdIfExists(
+    std::string_view name
+) const
+{
+    auto existingId = m_ids.find( name );
+    if ( m_ids.end() != existingId )
+    {
+        return existingId->second;
+    }
+    return g_invalidIdentifierId;
+}
+
+/**
+ * \brief  Gets the identifier string represented by an ID. Throws if the ID was not allocated by this table.
+ *
+ * \param[in]  id  The ID of the identifier.
+ *
+ * \return  The identifier string.
+ */
+const std::string&
+IdentifierTable::GetName(
+    IdentifierId id
+) const
+{
+    size_t index = static_cast< size_t >( id );
+    if ( index >= m_names.size() )
+    {
+        LOG_ERROR_AND_THROW( "Unknown identifier ID " + std::to_string( index ), std::out_of_range );
+    }
+    return m_names[index];
+}
+
+/**
+ * \brief  Gets the number of distinct identifiers that have been interned.
+ *
+ * \return  Number of identifiers in the table.
+ */
+size_t
+IdentifierTable::GetNumIdentifiers() const
+{
+    return m_names.size();
+}
@@ -0,0 +1,53 @@
+/**
+ * Contains declaration of the table used to intern identifier strings.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Dense ID representing an interned identifier string. IDs are allocated in order from 0, so can be used to index
+// arrays. Scoped so that it can't be implicitly confused with a numeric value.
+enum class IdentifierId : uint32_t {};
+
+// Represents the absence of an identifier, e.g. an unused operand.
+constexpr IdentifierId g_invalidIdentifierId{ std::numeric_limits< uint32_t >::max() };
+
+/**
+ * \brief  Maps each distinct identifier string to a dense ID, so that later stages can hash and compare IDs rather than
+ *         strings. Each string is stored once, and IDs are never invalidated.
+ *
+ *         The shared instance is used by every stage of the compiler. Separate instances can be created for work that
+ *         needs to be done independently, e.g. on another thread. This class is not thread-safe.
+ */
+class IdentifierTable
+{
+public:
+    using Ptr = std::shared_ptr< IdentifierTable >;
+
+    IdentifierTable() = default;
+    static Ptr GetInstance() {
+        static Ptr instance = std::make_shared< IdentifierTable >();
+        return instance;
+    }
+
+    IdentifierId Intern( std::string_view name );
+    IdentifierId GetIdIfExists( std::string_view name ) const;
+
+    const std::string& GetName( IdentifierId id ) const;
+
+    size_t GetNumIdentifiers() const;
+
+private:
+    // The interned strings, indexed by ID. Deque elements are never moved, so the views used as keys in m_ids remain
+    // valid as more strings are added.
+    std::deque< std::string > m_names;
+    // Maps each interned string to its ID.
+    std::unordered_map< std::string_view, IdentifierId > m_ids;
+};
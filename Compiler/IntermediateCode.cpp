@@ -20,32 +20,33 @@ IntermediateCode::IntermediateCode(
   */
 void
 IntermediateCode::GenerateIntermediateCode(
-    AstNode::Ptr astNode
+    AstNode astNode
 )
 {
     if ( nullptr == astNode )
     {
         LOG_ERROR_AND_THROW( "Cannot generate intermediate code from a nullptr AST.", std::invalid_argument );
     }
-    if ( nullptr == astNode->m_symbolTable )
+    if ( nullptr == astNode.GetSymbolTable() )
     {
         LOG_ERROR_AND_THROW( "Can't generate intermediate code for an AST that doesn't have a symbol table.",
                              std::invalid_argument );
     }
 
     // Call internal method - this will handle error checking.
-    ConvertAstToInstructions( astNode, astNode->m_symbolTable );
+    ConvertAstToInstructions( astNode, astNode.GetSymbolTable() );
 }
 
 /**
- * \brief  Converts the given AST sub-tree to three-address-code instructions.
+ * \brief  Converts the given AST sub-tree to three-address-code instructions. The root node is passed to the handler for
+ *         its label, which must be a statement or a block.
  *
  * \param[in]   astNode       The root node of the AST being converted to TAC.
  * \param[in]   currentSt     Current symbol table being used by the parent of this AST node.
  */
 void
 IntermediateCode::ConvertAstToInstructions(
-    AstNode::Ptr astNode,
+    AstNode astNode,
     SymbolTable::Ptr currentSt
 )
 {
@@ -54,67 +55,132 @@ IntermediateCode::ConvertAstToInstructions(
     {
         LOG_ERROR_AND_THROW( "Cannot generate intermediate code from a nullptr AST.", std::invalid_argument );
     }
-    if ( astNode->IsStoringToken() )
+    if ( astNode.IsStoringToken() )
     {
         LOG_ERROR_AND_THROW( "AST must be storing a valid program, not a token.", std::invalid_argument );
     }
-    if ( !astNode->IsStorageInUse() )
+    if ( !astNode.IsStorageInUse() )
     {
         LOG_ERROR_AND_THROW( "AST node storage not in use.", std::invalid_argument );
     }
 
-    GrammarSymbols::Symbol nodeLabel = astNode->m_nodeLabel;
-    std::string nodeLabelString = GrammarSymbols::ConvertSymbolToString( nodeLabel );
+    Visit( astNode, currentSt );
+}
 
-    // If node label is a terminal
-    if ( SymbolType::Terminal == GrammarSymbols::GetSymbolType( nodeLabel ) )
-    {
-        // If AST is representing an operation, we can stop and convert this into instruction(s)
-        switch ( nodeLabel )
-        {
-        case T::ASSIGN:
-            ConvertAssign( astNode, currentSt );
-            break;
-        case T::IF:
-            ConvertIfElse( astNode, currentSt );
-            break;
-        case T::FOR:
-            ConvertForLoop( astNode, currentSt );
-            break;
-        case T::WHILE:
-            ConvertWhileLoop( astNode, currentSt );
-            break;
-        default:
-            LOG_ERROR_AND_THROW( "Node label not suitable for an instruction: " + nodeLabelString,
-                                 std::invalid_argument );
-        }
-    }
+/**
+ * \brief  Converts an assignment statement node to TAC instruction(s).
+ */
+void
+IntermediateCode::VisitNode(
+    AstLabel< T::ASSIGN >,
+    AstNode astNode,
+    const SymbolTable::Ptr& currentSt
+)
+{
+    ConvertAssign( astNode, currentSt );
+}
 
-    // Else if node label is non-terminal, it represents a further sub-tree
-    else if ( SymbolType::NonTerminal == GrammarSymbols::GetSymbolType( nodeLabel ) )
-    {
-        // "Block" is the only acceptable NT rule to call this method with, as all other NTs are unused in the AST, or
-        // belong to a specific statement/loop that should be handled within the code regarding that specific operation.
-        if ( NT::Block == nodeLabel )
+/**
+ * \brief  Converts an if/else statement node to TAC instruction(s).
+ */
+void
+IntermediateCode::VisitNode(
+    AstLabel< T::IF >,
+    AstNode astNode,
+    const SymbolTable::Ptr& currentSt
+)
+{
+    ConvertIfElse( astNode, currentSt );
+}
+
+/**
+ * \brief  Converts a for loop node to TAC instruction(s).
+ */
+void
+IntermediateCode::VisitNode(
+    AstLabel< T::FOR >,
+    AstNode astNode,
+    const SymbolTable::Ptr& currentSt
+)
+{
+    ConvertForLoop( astNode, currentSt );
+}
+
+/**
+ * \brief  Converts a while loop node to TAC instruction(s).
+ */
+void
+IntermediateCode::VisitNode(
+    AstLabel< T::WHILE >,
+    AstNode astNode,
+    const SymbolTable::Ptr& currentSt
+)
+{
+    ConvertWhileLoop( astNode, currentSt );
+}
+
+/**
+ * \brief  Converts each statement in a block to TAC instruction(s). "Block" is the only non-terminal a statement node
+ *         can have, as all other NTs are unused in the AST, or belong to a specific statement/loop that is handled by
+ *         the code converting that statement.
+ *
+ * \param[in]   astNode       The block node.
+ * \param[in]   currentSt     Current symbol table being used by the parent of this AST node.
+ */
+void
+IntermediateCode::VisitNode(
+    AstLabel< NT::Block >,
+    AstNode astNode,
+    const SymbolTable::Ptr& currentSt
+)
+{
+    // Blocks nested directly inside this one are expanded in place using an explicit stack, so a long chain of blocks
+    // doesn't need a call per block. Nodes are popped from the back, so push children in reverse.
+    std::vector< AstNode > pendingNodes;
+    auto pushChildrenInReverse = [ &pendingNodes ]( AstNode parent ) {
+        AstNode::ChildRange children = parent.GetChildren();
+        for ( size_t i = children.size(); i > 0u; --i )
         {
-            for ( auto child : astNode->GetChildren() )
-            {
-                // No need to check symbol table here as any new scope should be introduced as part of a specific
-                // operation, as described above - and should therefore be handled there.
-                ConvertAstToInstructions( child, currentSt );
-            }
+            pendingNodes.push_back( children[i - 1u] );
         }
-        else
+    };
+    pushChildrenInReverse( astNode );
+    while ( !pendingNodes.empty() )
+    {
+        AstNode child = pendingNodes.back();
+        pendingNodes.pop_back();
+
+        if ( nullptr != child && child.IsStorageInUse() && !child.IsStoringToken()
+             && NT::Block == child.GetNodeLabel() )
         {
-            LOG_ERROR_AND_THROW( "AST node has non-terminal label that is not valid for this operation: "
-                                 + nodeLabelString, std::invalid_argument );
+            pushChildrenInReverse( child );
+            continue;
         }
+
+        // No need to check symbol table here as any new scope should be introduced as part of a specific
+        // operation, as described above - and should therefore be handled there.
+        ConvertAstToInstructions( child, currentSt );
     }
+}
 
-    else
+/**
+ * \brief  Throws for a node which doesn't represent a statement.
+ *
+ * \param[in]   astNode       The node being converted.
+ */
+void
+IntermediateCode::VisitUnhandled(
+    AstNode astNode,
+    const SymbolTable::Ptr&
+)
+{
+    std::string nodeLabelString = GrammarSymbols::ConvertSymbolToString( astNode.GetNodeLabel() );
+    if ( SymbolType::Terminal == GrammarSymbols::GetSymbolType( astNode.GetNodeLabel() ) )
     {
-        LOG_ERROR_AND_THROW( "Unrecognised symbol: " + nodeLabelString, std::runtime_error );
+        LOG_ERROR_AND_THROW( "Node label not suitable for an instruction: " + nodeLabelString, std::invalid_argument );
     }
+    LOG_ERROR_AND_THROW( "AST node has non-terminal label that is not valid for this operation: " + nodeLabelString,
+                         std::invalid_argument );
 }
 
 /**
@@ -125,16 +191,16 @@ IntermediateCode::ConvertAstToInstructions(
  */
 void
 IntermediateCode::ConvertAssign(
-    AstNode::Ptr astNode,
+    AstNode astNode,
     SymbolTable::Ptr currentSt
 )
 {
-    if ( T::ASSIGN != astNode->m_nodeLabel )
+    if ( T::ASSIGN != astNode.GetNodeLabel() )
     {
         LOG_ERROR_AND_THROW( "AST node has wrong label. Expected ASSIGN, got: "
-                             + GrammarSymbols::ConvertSymbolToString( astNode->m_nodeLabel ), std::invalid_argument );
+                             + GrammarSymbols::ConvertSymbolToString( astNode.GetNodeLabel() ), std::invalid_argument );
     }
-    AstNode::Children children = astNode->GetChildren();
+    AstNode::ChildRange children = astNode.GetChildren();
     // Expect there to be 2 children, a LHS and RHS
     if ( 2u != children.size() )
     {
@@ -143,13 +209,13 @@ IntermediateCode::ConvertAssign(
     }
 
     // LHS should be an identifier or a declaration of an identifier.
-    AstNode::Ptr lhsNode = children[0];
-    std::string identifier = GetIdentifierFromLhsNode( lhsNode );
-    // Calculate unique identifier using the symbol table, to get 'result' attribute.
-    std::string uniqueLhsId = CalculateUniqueIdentifier( identifier, currentSt );
+    AstNode lhsNode = children[0];
+    IdentifierId identifier = GetIdentifierFromLhsNode( lhsNode );
+    // Get the variable of the identifier in this scope from the symbol table, to get 'result' attribute.
+    VarId lhsVar = GetVarId( identifier, currentSt );
 
     // RHS should either be a literal, an ID, or an expression (which may need breaking down further).
-    AstNode::Ptr rhsNode = children[1];
+    AstNode rhsNode = children[1];
     ExpressionInfo expressionInfo = GetExpressionInfo( rhsNode, currentSt );
 
 
@@ -161,89 +227,87 @@ IntermediateCode::ConvertAssign(
     // If opcode is invalid, expect there to be a single RHS operand.
     if ( Opcode::INVALID == opcode )
     {
+        const std::string& lhsName = IdentifierTable::GetInstance()->GetName( identifier );
         if ( ThreeAddrInstruction::IsOperandEmpty( operand1 ) )
         {
-            LOG_ERROR_AND_THROW( "For assignment to '" + uniqueLhsId + "': operand1 must be non-empty",
+            LOG_ERROR_AND_THROW( "For assignment to '" + lhsName + "': operand1 must be non-empty",
                                  std::runtime_error );
         }
         if ( !ThreeAddrInstruction::IsOperandEmpty( operand2 ) )
         {
-            LOG_ERROR_AND_THROW( "For assignment to '" + uniqueLhsId + "': expected operand2 to be empty.",
+            LOG_ERROR_AND_THROW( "For assignment to '" + lhsName + "': expected operand2 to be empty.",
                                  std::runtime_error );
         }
-        m_instructionFactory->AddAssignmentInstruction( uniqueLhsId, operand1 );
+        m_instructionFactory->AddAssignmentInstruction( lhsVar, operand1 );
     }
     else
     {
-        m_instructionFactory->AddInstruction( uniqueLhsId, opcode, operand1, operand2 );
+        m_instructionFactory->AddInstruction( lhsVar, opcode, operand1, operand2 );
     }
 }
 
 /**
- * \brief  Gets the identifier string from a LHS assignment node (i.e. an identifier node OR a variable sub-tree).
+ * \brief  Gets the identifier from a LHS assignment node (i.e. an identifier node OR a variable sub-tree).
  *
  * \param[in]  lhsNode  The LHS node from which to retrieve the identifier.
  *
- * \return  The identifier string being stored by this node.
+ * \return  The interned identifier being stored by this node.
  */
-std::string
+IdentifierId
 IntermediateCode::GetIdentifierFromLhsNode(
-    AstNode::Ptr lhsNode
+    AstNode lhsNode
 )
 {
-    if ( T::IDENTIFIER == lhsNode->m_nodeLabel )
+    if ( T::IDENTIFIER == lhsNode.GetNodeLabel() )
     {
-        return lhsNode->GetToken()->m_value->m_value.stringValue;
+        return lhsNode.GetToken().m_value.GetIdentifierId();
     }
-    else if ( NT::Variable == lhsNode->m_nodeLabel )
+    else if ( NT::Variable == lhsNode.GetNodeLabel() )
     {
-        AstNode::Children varChildren = lhsNode->GetChildren();
+        AstNode::ChildRange varChildren = lhsNode.GetChildren();
         if ( 2u != varChildren.size() )
         {
             LOG_ERROR_AND_THROW( "Unexpected number of children for variable node: "
                                  + std::to_string( varChildren.size() ), std::invalid_argument );
         }
-        if ( T::IDENTIFIER != varChildren[1]->m_nodeLabel )
+        if ( T::IDENTIFIER != varChildren[1].GetNodeLabel() )
         {
             LOG_ERROR_AND_THROW( "Expected an identifier node in variable sub-tree, got: "
-                                 + GrammarSymbols::ConvertSymbolToString( varChildren[1]->m_nodeLabel ),
+                                 + GrammarSymbols::ConvertSymbolToString( varChildren[1].GetNodeLabel() ),
                                  std::invalid_argument );
         }
-        return varChildren[1]->GetToken()->m_value->m_value.stringValue;
+        return varChildren[1].GetToken().m_value.GetIdentifierId();
     }
     LOG_ERROR_AND_THROW( "Unrecognised LHS node label: "
-                         + GrammarSymbols::ConvertSymbolToString( lhsNode->m_nodeLabel ),
+                         + GrammarSymbols::ConvertSymbolToString( lhsNode.GetNodeLabel() ),
                          std::invalid_argument );
-    return ""; // Added to satisfy compiler, will never be reached due to exception
+    return g_invalidIdentifierId; // Added to satisfy compiler, will never be reached due to exception
 }
 
 /**
- * \brief  Generates a unique global identifier for a given identifier in a specific symbol table, that can be used to
- *         identify it regardless of scope. Combines the two to produce a string.
+ * \brief  Gets the variable a given identifier refers to in a specific symbol table, that can be used to identify it
+ *         regardless of scope. This is the variable allocated to the identifier's symbol table entry.
  *
- * \param[in]  currentIdentifier  The original identifier, as represented in the AST.
+ * \param[in]  currentIdentifier  The original interned identifier, as represented in the AST.
  * \param[in]  symbolTable        Pointer to the symbol table corresponding to this instance of the identifier.
  *
- * \return  The unique identifier string calculated.
+ * \return  The ID of the variable.
  */
-std::string
-IntermediateCode::CalculateUniqueIdentifier(
-    const std::string& currentIdentifier,
+VarId
+IntermediateCode::GetVarId(
+    IdentifierId currentIdentifier,
     SymbolTable::Ptr symbolTable
 )
 {
-    // Use the pointer of the specific symbol table entry - if we use the table itself then a child scope of a variable
-    // will produce a different unique ID.
-    SymbolTableEntry::Ptr entry = symbolTable->GetEntryIfExists( currentIdentifier );
+    // Use the specific symbol table entry - if we use the table itself then a child scope of a variable would refer to
+    // a different variable.
+    SymbolTableEntry* entry = symbolTable->GetEntryIfExists( currentIdentifier );
     if ( nullptr == entry )
     {
-        LOG_ERROR_AND_THROW( "Could not find entry for '" + currentIdentifier + "'.", std::runtime_error );
+        const std::string& identifierName = IdentifierTable::GetInstance()->GetName( currentIdentifier );
+        LOG_ERROR_AND_THROW( "Could not find entry for '" + identifierName + "'.", std::runtime_error );
     }
-    void* voidEntryPtr = static_cast< void* >( entry.get() );
-    char stPointerBytes[17u]; // Size of pointer + 1 for terminating char
-    sprintf_s( stPointerBytes, "%p", voidEntryPtr );
-    std::string outputStr = currentIdentifier + std::string( stPointerBytes );
-    return outputStr;
+    return entry->varId;
 }
 
 /**
@@ -258,120 +322,167 @@ IntermediateCode::CalculateUniqueIdentifier(
  */
 IntermediateCode::ExpressionInfo
 IntermediateCode::GetExpressionInfo(
-    AstNode::Ptr expressionNode,
+    AstNode expressionNode,
     SymbolTable::Ptr currentSt
 )
+{
+    return ExpressionVisitor( *this ).Visit( expressionNode, currentSt );
+}
+
+/**
+ * \brief  Gets the expression info of a literal value.
+ */
+IntermediateCode::ExpressionInfo
+IntermediateCode::ExpressionVisitor::VisitNode(
+    AstLabel< T::BYTE >,
+    AstNode expressionNode,
+    const SymbolTable::Ptr&
+)
+{
+    Operand operand1 = expressionNode.GetToken().m_value.m_value.numericValue;
+    return std::make_tuple( Opcode::INVALID, operand1, Operand{ g_invalidVarId } );
+}
+
+/**
+ * \brief  Gets the expression info of an identifier, using the variable it refers to in the current scope.
+ */
+IntermediateCode::ExpressionInfo
+IntermediateCode::ExpressionVisitor::VisitNode(
+    AstLabel< T::IDENTIFIER >,
+    AstNode expressionNode,
+    const SymbolTable::Ptr& currentSt
+)
+{
+    IdentifierId identifier = expressionNode.GetToken().m_value.GetIdentifierId();
+    Operand operand1 = m_codeGenerator.GetVarId( identifier, currentSt );
+    return std::make_tuple( Opcode::INVALID, operand1, Operand{ g_invalidVarId } );
+}
+
+/**
+ * \brief  Gets the expression info of an operation. The operands are resolved first, generating instructions for
+ *         any sub-expressions.
+ *
+ * \tparam  Label  The operator.
+ */
+template< GrammarSymbols::Symbol Label >
+IntermediateCode::ExpressionInfo
+IntermediateCode::ExpressionVisitor::VisitNode(
+    AstLabel< Label >,
+    AstNode expressionNode,
+    const SymbolTable::Ptr& currentSt
+)
 {
     Opcode opcode{ Opcode::INVALID };
-    Operand operand1{};
-    Operand operand2{};
+    Operand operand1{ g_invalidVarId };
+    Operand operand2{ g_invalidVarId };
 
-    GrammarSymbols::Symbol nodeLabel = expressionNode->m_nodeLabel;
+    // First resolve the operands themselves, as they may need prerequisite instructions
+    AstNode::ChildRange children = expressionNode.GetChildren();
+    ExpressionInfo lhsInfo = Visit( children[0], currentSt );
+    Operand lhs = m_codeGenerator.GetOperandFromExpressionInfo( lhsInfo );
 
-    if ( T::BYTE == nodeLabel )
+    Operand rhs{ g_invalidVarId };
+    if ( 2u == children.size() )
     {
-        operand1 = expressionNode->GetToken()->m_value->m_value.numericValue;
+        ExpressionInfo rhsInfo = Visit( children[1], currentSt );
+        rhs = m_codeGenerator.GetOperandFromExpressionInfo( rhsInfo );
     }
-    else if ( T::IDENTIFIER == nodeLabel )
-    {
-        std::string identifier = expressionNode->GetToken()->m_value->m_value.stringValue;
-        std::string uniqueId = CalculateUniqueIdentifier( identifier, currentSt );
-        operand1 = uniqueId;
-    }
-    // If node is expression, fetch opcode and operands - if any child is a sub-expression, call recursively.
-    else
+
+    // For opcodes that directly map e.g. ADD, this is more simple
+    if ( g_symbolsToOpcodesMap.end() != g_symbolsToOpcodesMap.find( Label ) )
     {
-        // First resolve the operands themselves, as they may need prerequisite instructions
-        AstNode::Children children = expressionNode->GetChildren();
-        ExpressionInfo lhsInfo = GetExpressionInfo( children[0], currentSt );
-        Operand lhs = GetOperandFromExpressionInfo( lhsInfo );
+        opcode = g_symbolsToOpcodesMap.find( Label )->second;
 
-        Operand rhs;
-        if ( 2u == children.size() )
+        // If both operands are literal, resolve the expression at compile time, e.g. a + b
+        if ( std::holds_alternative< Literal >( lhs )
+             && ( std::holds_alternative< Literal >( rhs ) || ThreeAddrInstruction::IsOperandEmpty( rhs ) )
+           )
         {
-            ExpressionInfo rhsInfo = GetExpressionInfo( children[1], currentSt );
-            rhs = GetOperandFromExpressionInfo( rhsInfo );
+            operand1 = m_codeGenerator.ApplyOpcodeToLiterals( opcode, std::get< Literal >( lhs ),
+                                                              std::get< Literal >( rhs ) );
+            opcode = INVALID;
+            operand2 = g_invalidVarId;
         }
-
-        // For opcodes that directly map e.g. ADD, this is more simple
-        if ( g_symbolsToOpcodesMap.end() != g_symbolsToOpcodesMap.find( nodeLabel ) )
+        else
         {
-            opcode = g_symbolsToOpcodesMap.find( nodeLabel )->second;
-
-            // If both operands are literal, resolve the expression at compile time, e.g. a + b
-            if ( std::holds_alternative< Literal >( lhs )
-                 && ( std::holds_alternative< Literal >( rhs ) || ThreeAddrInstruction::IsOperandEmpty( rhs ) )
-               )
-            {
-                operand1 = ApplyOpcodeToLiterals( opcode, std::get< Literal >( lhs ), std::get< Literal >( rhs ) );
-                opcode = INVALID;
-                operand2 = "";
-            }
-            else
-            {
-                operand1 = lhs;
-                operand2 = rhs;
-            }
+            operand1 = lhs;
+            operand2 = rhs;
         }
-        // For more complex cases like divide, will need to generate pre-instructions
-        else
+    }
+    // For more complex cases like divide, will need to generate pre-instructions
+    else
+    {
+        // Call on the TAC generator to create pre-instructions, and return an operand pointing to where the result
+        // is being stored. Use this returned operand to return an assignment expression from this method.
+        ITacExpressionGenerator::Ptr tacExpressionGenerator = m_codeGenerator.m_tacExpressionGenerator;
+        switch ( Label )
         {
-            // Call on the TAC generator to create pre-instructions, and return an operand pointing to where the result
-            // is being stored. Use this returned operand to return an assignment expression from this method.
-            switch ( nodeLabel )
+        case T::MULTIPLY:
+            operand1 = tacExpressionGenerator->Multiply( lhs, rhs );
+            break;
+        case T::DIVIDE:
+            operand1 = tacExpressionGenerator->Divide( lhs, rhs );
+            break;
+        case T::MOD:
+            operand1 = tacExpressionGenerator->Modulo( lhs, rhs );
+            break;
+        case T::EQ:
+            operand1 = tacExpressionGenerator->Equals( lhs, rhs );
+            break;
+        case T::NEQ:
+            operand1 = tacExpressionGenerator->NotEquals( lhs, rhs );
+            break;
+        case T::LEQ:
+            operand1 = tacExpressionGenerator->Leq( lhs, rhs );
+            break;
+        case T::GEQ:
+            operand1 = tacExpressionGenerator->Geq( lhs, rhs );
+            break;
+        case T::LT:
+            operand1 = tacExpressionGenerator->LessThan( lhs, rhs );
+            break;
+        case T::GT:
+            operand1 = tacExpressionGenerator->GreaterThan( lhs, rhs );
+            break;
+        case T::NOT: // Logical NOT
+            if ( !ThreeAddrInstruction::IsOperandEmpty( rhs ) )
             {
-            case T::MULTIPLY:
-                operand1 = m_tacExpressionGenerator->Multiply( lhs, rhs );
-                break;
-            case T::DIVIDE:
-                operand1 = m_tacExpressionGenerator->Divide( lhs, rhs );
-                break;
-            case T::MOD:
-                operand1 = m_tacExpressionGenerator->Modulo( lhs, rhs );
-                break;
-            case T::EQ:
-                operand1 = m_tacExpressionGenerator->Equals( lhs, rhs );
-                break;
-            case T::NEQ:
-                operand1 = m_tacExpressionGenerator->NotEquals( lhs, rhs );
-                break;
-            case T::LEQ:
-                operand1 = m_tacExpressionGenerator->Leq( lhs, rhs );
-                break;
-            case T::GEQ:
-                operand1 = m_tacExpressionGenerator->Geq( lhs, rhs );
-                break;
-            case T::LT:
-                operand1 = m_tacExpressionGenerator->LessThan( lhs, rhs );
-                break;
-            case T::GT:
-                operand1 = m_tacExpressionGenerator->GreaterThan( lhs, rhs );
-                break;
-            case T::NOT: // Logical NOT
-                if ( !ThreeAddrInstruction::IsOperandEmpty( rhs ) )
-                {
-                    LOG_ERROR_AND_THROW( "Cannot generate intermediate code for NOT operation with 2 operands.",
-                                         std::invalid_argument );
-                }
-                operand1 = m_tacExpressionGenerator->LogicalNot( lhs );
-                break;
-            case T::OR:  // Logical OR
-                operand1 = m_tacExpressionGenerator->LogicalOr( lhs, rhs );
-                break;
-            case T::AND: // Logical AND
-                operand1 = m_tacExpressionGenerator->LogicalAnd( lhs, rhs );
-                break;
-            default:
-                LOG_ERROR_AND_THROW( "Invalid or unrecognised node label for expression: "
-                                     + GrammarSymbols::ConvertSymbolToString( nodeLabel ), std::invalid_argument );
-                break;
+                LOG_ERROR_AND_THROW( "Cannot generate intermediate code for NOT operation with 2 operands.",
+                                     std::invalid_argument );
             }
+            operand1 = tacExpressionGenerator->LogicalNot( lhs );
+            break;
+        case T::OR:  // Logical OR
+            operand1 = tacExpressionGenerator->LogicalOr( lhs, rhs );
+            break;
+        case T::AND: // Logical AND
+            operand1 = tacExpressionGenerator->LogicalAnd( lhs, rhs );
+            break;
+        default:
+            return VisitUnhandled( expressionNode, currentSt );
         }
     }
 
     return std::make_tuple( opcode, operand1, operand2 );
 }
 
+/**
+ * \brief  Throws for a node which doesn't represent an expression.
+ *
+ * \param[in]   expressionNode  The node being converted.
+ */
+IntermediateCode::ExpressionInfo
+IntermediateCode::ExpressionVisitor::VisitUnhandled(
+    AstNode expressionNode,
+    const SymbolTable::Ptr&
+)
+{
+    LOG_ERROR_AND_THROW( "Invalid or unrecognised node label for expression: "
+                         + GrammarSymbols::ConvertSymbolToString( expressionNode.GetNodeLabel() ),
+                         std::invalid_argument );
+    return {}; // Added to satisfy compiler, will never be reached due to exception
+}
+
 /**
  * \brief  Takes information gathered about an expression and returns an operand value (either the direct single value,
  *         or a temporary variable through creating an assignment statement.
@@ -401,9 +512,9 @@ IntermediateCode::GetOperandFromExpressionInfo(
 
     // If opcode is being used, we need to create an instruction to be stored in a temporary variable, which will then
     // become the returned operand.
-    std::string tempVarId = m_instructionFactory->GetNewTempVar();
-    m_instructionFactory->AddInstruction( tempVarId, opcode, operand1, operand2 );
-    return tempVarId;
+    VarId tempVar = m_instructionFactory->GetNewTempVar();
+    m_instructionFactory->AddInstruction( tempVar, opcode, operand1, operand2 );
+    return tempVar;
 }
 
 /**
@@ -455,17 +566,17 @@ IntermediateCode::ApplyOpcodeToLiterals(
  */
 void
 IntermediateCode::ConvertIfElse(
-    AstNode::Ptr astNode,
+    AstNode astNode,
     SymbolTable::Ptr currentSt
 )
 {
-    if ( T::IF != astNode->m_nodeLabel )
+    if ( T::IF != astNode.GetNodeLabel() )
     {
         LOG_ERROR_AND_THROW( "AST node has wrong label. Expected IF, got: "
-                             + GrammarSymbols::ConvertSymbolToString( astNode->m_nodeLabel ), std::invalid_argument );
+                             + GrammarSymbols::ConvertSymbolToString( astNode.GetNodeLabel() ), std::invalid_argument );
     }
 
-    AstNode::Children children = astNode->GetChildren();
+    AstNode::ChildRange children = astNode.GetChildren();
     // If there are 2 children, this means there is a condition and a block
     // If there are 3 children, there is an addition else, which contains a block
     if ( 2u > children.size() || 3u < children.size() )
@@ -474,8 +585,8 @@ IntermediateCode::ConvertIfElse(
                              + std::to_string( children.size() ), std::invalid_argument );
     }
 
-    SymbolTable::Ptr ifSymbolTable = astNode->m_symbolTable;
-    if ( !astNode->IsScopeDefiningNode() || nullptr == ifSymbolTable )
+    SymbolTable::Ptr ifSymbolTable = astNode.GetSymbolTable();
+    if ( !astNode.IsScopeDefiningNode() || nullptr == ifSymbolTable )
     {
         LOG_ERROR_AND_THROW( "'If' AST node has no symbol table.", std::invalid_argument );
     }
@@ -483,11 +594,11 @@ IntermediateCode::ConvertIfElse(
     bool hasElseBlock{ false };
     if ( 3u == children.size() )
     {
-        AstNode::Ptr elseNode = children[2];
-        if ( T::ELSE != elseNode->m_nodeLabel )
+        AstNode elseNode = children[2];
+        if ( T::ELSE != elseNode.GetNodeLabel() )
         {
             LOG_ERROR_AND_THROW( "AST node has wrong label. Expected ELSE, got: "
-                                 + GrammarSymbols::ConvertSymbolToString( elseNode->m_nodeLabel ),
+                                 + GrammarSymbols::ConvertSymbolToString( elseNode.GetNodeLabel() ),
                                  std::invalid_argument );
         }
         hasElseBlock = true;
@@ -495,35 +606,35 @@ IntermediateCode::ConvertIfElse(
 
 
     // Get the condition
-    AstNode::Ptr conditionNode = children[0];
+    AstNode conditionNode = children[0];
     ExpressionInfo conditionExpressionInfo = GetExpressionInfo( conditionNode, ifSymbolTable );
     Operand conditionOperand = GetOperandFromExpressionInfo( conditionExpressionInfo );
 
 
     // Branch if NOT condition (i.e. if condition == 0)
-    m_instructionFactory->AddInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRE, conditionOperand, 0u );
-    ThreeAddrInstruction::Ptr branchToElse = m_instructionFactory->GetLatestInstruction();
+    m_instructionFactory->AddBranchInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRE, conditionOperand, 0u );
+    size_t branchToElse = m_instructionFactory->GetLatestInstructionIndex();
 
     // Add the if block instructions
-    AstNode::Ptr ifBlockNode = children[1];
+    AstNode ifBlockNode = children[1];
     ConvertAstToInstructions( ifBlockNode, ifSymbolTable );
 
 
     // If there is an else, add that block and attach the else label
     if ( hasElseBlock )
     {
-        AstNode::Ptr elseNode = children[2];
+        AstNode elseNode = children[2];
 
         // Add unconditional jump to after the else block, in the case that the main if condition was true.
-        m_instructionFactory->AddInstruction(
+        m_instructionFactory->AddBranchInstruction(
             TacInstructionFactory::PLACEHOLDER, Opcode::BRE, conditionOperand, conditionOperand
         );
-        ThreeAddrInstruction::Ptr branchToEnd = m_instructionFactory->GetLatestInstruction();
+        size_t branchToEnd = m_instructionFactory->GetLatestInstructionIndex();
 
         // Set the else label to be the next instruction - this will point to the soon-to-be-added else block.
         m_instructionFactory->SetInstructionBranchToNextLabel( branchToElse, "else" );
 
-        AstNode::Children elseChildren = elseNode->GetChildren();
+        AstNode::ChildRange elseChildren = elseNode.GetChildren();
         for ( auto child : elseChildren )
         {
             ConvertAstToInstructions( child, ifSymbolTable );
@@ -546,39 +657,39 @@ IntermediateCode::ConvertIfElse(
  */
 void
 IntermediateCode::ConvertForLoop(
-    AstNode::Ptr astNode,
+    AstNode astNode,
     SymbolTable::Ptr currentSt
 )
 {
-    if ( T::FOR != astNode->m_nodeLabel )
+    if ( T::FOR != astNode.GetNodeLabel() )
     {
         LOG_ERROR_AND_THROW( "AST node has wrong label. Expected FOR, got: "
-                             + GrammarSymbols::ConvertSymbolToString( astNode->m_nodeLabel ), std::invalid_argument );
+                             + GrammarSymbols::ConvertSymbolToString( astNode.GetNodeLabel() ), std::invalid_argument );
     }
 
     // Expect for loop node to have 2 children: the initialising section, and the actual block.
-    AstNode::Children children = astNode->GetChildren();
+    AstNode::ChildRange children = astNode.GetChildren();
     if ( 2u != children.size() )
     {
         LOG_ERROR_AND_THROW( "Trying to convert for loop: expected 2 children, got: "
                              + std::to_string( children.size() ), std::invalid_argument );
     }
 
-    AstNode::Ptr initNode = children[0];
-    AstNode::Ptr blockNode = children[1];
+    AstNode initNode = children[0];
+    AstNode blockNode = children[1];
     // The for init section should have 3 children: a statement (1), a comparison, and another statement (2).
-    AstNode::Children initChildren = initNode->GetChildren();
+    AstNode::ChildRange initChildren = initNode.GetChildren();
     if ( 3u != initChildren.size() )
     {
         LOG_ERROR_AND_THROW( "Trying to convert for loop initialisation section: expected 3 children, got: "
                              + std::to_string( initChildren.size() ), std::invalid_argument );
     }
-    AstNode::Ptr statement1 = initChildren[0];
-    AstNode::Ptr comparison = initChildren[1];
-    AstNode::Ptr statement2 = initChildren[2];
+    AstNode statement1 = initChildren[0];
+    AstNode comparison = initChildren[1];
+    AstNode statement2 = initChildren[2];
 
-    SymbolTable::Ptr forSymbolTable = astNode->m_symbolTable;
-    if ( !astNode->IsScopeDefiningNode() || nullptr == forSymbolTable )
+    SymbolTable::Ptr forSymbolTable = astNode.GetSymbolTable();
+    if ( !astNode.IsScopeDefiningNode() || nullptr == forSymbolTable )
     {
         LOG_ERROR_AND_THROW( "'For' AST node has no symbol table.", std::invalid_argument );
     }
@@ -594,20 +705,21 @@ IntermediateCode::ConvertForLoop(
 
     ConvertAssign( statement1, forSymbolTable );
 
-    std::string conditionLabel = m_instructionFactory->GetNewLabel( "forCondition" );
+    LabelId conditionLabel = m_instructionFactory->GetNewLabel( "forCondition" );
     m_instructionFactory->SetNextInstructionLabel( conditionLabel );
     // Evaluate comparison expression
     ExpressionInfo comparisonInfo = GetExpressionInfo( comparison, forSymbolTable );
     Operand comparisonOperand = GetOperandFromExpressionInfo( comparisonInfo );
     // If comparison == 0 aka comparison is false, branch to end
-    m_instructionFactory->AddInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRE, comparisonOperand, 0u );
-    ThreeAddrInstruction::Ptr branchToEnd = m_instructionFactory->GetLatestInstruction();
+    m_instructionFactory->AddBranchInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRE, comparisonOperand,
+                                                0u );
+    size_t branchToEnd = m_instructionFactory->GetLatestInstructionIndex();
 
     ConvertAstToInstructions( blockNode, forSymbolTable );
     ConvertAssign( statement2, forSymbolTable );
 
     // Unconditional branch using an operand we have access to, i.e. if x == x
-    m_instructionFactory->AddInstruction( conditionLabel, Opcode::BRE, comparisonOperand, comparisonOperand );
+    m_instructionFactory->AddBranchInstruction( conditionLabel, Opcode::BRE, comparisonOperand, comparisonOperand );
 
     m_instructionFactory->SetInstructionBranchToNextLabel( branchToEnd, "end" );
 }
@@ -620,28 +732,28 @@ IntermediateCode::ConvertForLoop(
  */
 void
 IntermediateCode::ConvertWhileLoop(
-    AstNode::Ptr astNode,
+    AstNode astNode,
     SymbolTable::Ptr currentSt
 )
 {
-    if ( T::WHILE != astNode->m_nodeLabel )
+    if ( T::WHILE != astNode.GetNodeLabel() )
     {
         LOG_ERROR_AND_THROW( "AST node has wrong label. Expected WHILE, got: "
-                             + GrammarSymbols::ConvertSymbolToString( astNode->m_nodeLabel ), std::invalid_argument );
+                             + GrammarSymbols::ConvertSymbolToString( astNode.GetNodeLabel() ), std::invalid_argument );
     }
 
     // Expect to hold 2 children: an expression, and a block.
-    AstNode::Children children = astNode->GetChildren();
+    AstNode::ChildRange children = astNode.GetChildren();
     if ( 2u != children.size() )
     {
         LOG_ERROR_AND_THROW( "Trying to convert while loop: expected 2 children, got: "
                              + std::to_string( children.size() ), std::invalid_argument );
     }
-    AstNode::Ptr expressionNode = children[0];
-    AstNode::Ptr blockNode = children[1];
+    AstNode expressionNode = children[0];
+    AstNode blockNode = children[1];
 
-    SymbolTable::Ptr whileSymbolTable = astNode->m_symbolTable;
-    if ( !astNode->IsScopeDefiningNode() || nullptr == whileSymbolTable )
+    SymbolTable::Ptr whileSymbolTable = astNode.GetSymbolTable();
+    if ( !astNode.IsScopeDefiningNode() || nullptr == whileSymbolTable )
     {
         LOG_ERROR_AND_THROW( "'While' AST node has no symbol table.", std::invalid_argument );
     }
@@ -653,19 +765,20 @@ IntermediateCode::ConvertWhileLoop(
     // jump to condition
     // end:
 
-    std::string conditionLabel = m_instructionFactory->GetNewLabel( "whileCondition" );
+    LabelId conditionLabel = m_instructionFactory->GetNewLabel( "whileCondition" );
     m_instructionFactory->SetNextInstructionLabel( conditionLabel );
     // Evaluate expression
     ExpressionInfo expressionInfo = GetExpressionInfo( expressionNode, whileSymbolTable );
     Operand expressionOperand = GetOperandFromExpressionInfo( expressionInfo );
     // If expression == 0 aka is false, branch to end
-    m_instructionFactory->AddInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRE, expressionOperand, 0u );
-    ThreeAddrInstruction::Ptr branchToEnd = m_instructionFactory->GetLatestInstruction();
+    m_instructionFactory->AddBranchInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRE, expressionOperand,
+                                                0u );
+    size_t branchToEnd = m_instructionFactory->GetLatestInstructionIndex();
 
     ConvertAstToInstructions( blockNode, whileSymbolTable );
 
     // Unconditional branch using an operand we have access to, i.e. if x == x
-    m_instructionFactory->AddInstruction( conditionLabel, Opcode::BRE, expressionOperand, expressionOperand );
+    m_instructionFactory->AddBranchInstruction( conditionLabel, Opcode::BRE, expressionOperand, expressionOperand );
 
     m_instructionFactory->SetInstructionBranchToNextLabel( branchToEnd, "end" );
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "TacExpressionGenerator.h"
+#include "AstVisitor.h"
 
 #include <tuple>
 
@@ -15,7 +16,7 @@ using namespace TAC;
  *         instructions. This is a higher level organisation class, and delegates any complex cases that need new
  *         instructions generating to its TAC expression generator member.
  */
-class IntermediateCode
+class IntermediateCode : private AstVisitor< IntermediateCode, void, const SymbolTable::Ptr& >
 {
 public:
     using UPtr = std::unique_ptr< IntermediateCode >;
@@ -23,22 +24,62 @@ public:
 
     IntermediateCode( TacInstructionFactory::Ptr instrFactory, ITacExpressionGenerator::Ptr tacExprGenerator );
 
-    void GenerateIntermediateCode( AstNode::Ptr astNode );
+    void GenerateIntermediateCode( AstNode astNode );
 
 private:
-    void ConvertAstToInstructions( AstNode::Ptr astNode, SymbolTable::Ptr currentSt );
+    friend class AstVisitor< IntermediateCode, void, const SymbolTable::Ptr& >;
 
-    void ConvertAssign( AstNode::Ptr astNode, SymbolTable::Ptr currentSt );
-    std::string GetIdentifierFromLhsNode( AstNode::Ptr lhsNode );
+    // Labels of the statement nodes that can be converted into instructions.
+    using HandledLabels = AstLabelList< T::ASSIGN, T::IF, T::FOR, T::WHILE, NT::Block >;
 
-    void ConvertIfElse( AstNode::Ptr astNode, SymbolTable::Ptr currentSt );
-    void ConvertForLoop( AstNode::Ptr astNode, SymbolTable::Ptr currentSt );
-    void ConvertWhileLoop( AstNode::Ptr astNode, SymbolTable::Ptr currentSt );
+    void ConvertAstToInstructions( AstNode astNode, SymbolTable::Ptr currentSt );
 
-    std::string CalculateUniqueIdentifier( const std::string& currentIdentifier, SymbolTable::Ptr symbolTable );
+    void VisitNode( AstLabel< T::ASSIGN >, AstNode astNode, const SymbolTable::Ptr& currentSt );
+    void VisitNode( AstLabel< T::IF >, AstNode astNode, const SymbolTable::Ptr& currentSt );
+    void VisitNode( AstLabel< T::FOR >, AstNode astNode, const SymbolTable::Ptr& currentSt );
+    void VisitNode( AstLabel< T::WHILE >, AstNode astNode, const SymbolTable::Ptr& currentSt );
+    void VisitNode( AstLabel< NT::Block >, AstNode astNode, const SymbolTable::Ptr& currentSt );
+    void VisitUnhandled( AstNode astNode, const SymbolTable::Ptr& currentSt );
+
+    void ConvertAssign( AstNode astNode, SymbolTable::Ptr currentSt );
+    IdentifierId GetIdentifierFromLhsNode( AstNode lhsNode );
+
+    void ConvertIfElse( AstNode astNode, SymbolTable::Ptr currentSt );
+    void ConvertForLoop( AstNode astNode, SymbolTable::Ptr currentSt );
+    void ConvertWhileLoop( AstNode astNode, SymbolTable::Ptr currentSt );
+
+    VarId GetVarId( IdentifierId currentIdentifier, SymbolTable::Ptr symbolTable );
 
     using ExpressionInfo = std::tuple< Opcode, Operand, Operand >;
-    ExpressionInfo GetExpressionInfo( AstNode::Ptr expressionNode, SymbolTable::Ptr currentSt );
+
+    /**
+     * \brief  Pass over an expression sub-tree, which gets the opcode and operand(s) of each node, generating
+     *         instructions for any sub-expressions along the way.
+     */
+    class ExpressionVisitor : public AstVisitor< ExpressionVisitor, ExpressionInfo, const SymbolTable::Ptr& >
+    {
+    public:
+        ExpressionVisitor( IntermediateCode& codeGenerator ) : m_codeGenerator( codeGenerator ) {}
+
+    private:
+        friend class AstVisitor< ExpressionVisitor, ExpressionInfo, const SymbolTable::Ptr& >;
+
+        using HandledLabels = AstLabelList< T::BYTE, T::IDENTIFIER, T::PLUS, T::MINUS, T::BITWISE_AND, T::BITWISE_OR,
+                                            T::LSHIFT, T::RSHIFT, T::MULTIPLY, T::DIVIDE, T::MOD, T::EQ, T::NEQ,
+                                            T::LEQ, T::GEQ, T::LT, T::GT, T::NOT, T::OR, T::AND >;
+
+        ExpressionInfo VisitNode( AstLabel< T::BYTE >, AstNode expressionNode, const SymbolTable::Ptr& currentSt );
+        ExpressionInfo VisitNode( AstLabel< T::IDENTIFIER >, AstNode expressionNode,
+                                  const SymbolTable::Ptr& currentSt );
+        template< GrammarSymbols::Symbol Label >
+        ExpressionInfo VisitNode( AstLabel< Label >, AstNode expressionNode, const SymbolTable::Ptr& currentSt );
+        ExpressionInfo VisitUnhandled( AstNode expressionNode, const SymbolTable::Ptr& currentSt );
+
+        // The code generator to add instructions to.
+        IntermediateCode& m_codeGenerator;
+    };
+
+    ExpressionInfo GetExpressionInfo( AstNode expressionNode, SymbolTable::Ptr currentSt );
     Operand GetOperandFromExpressionInfo( ExpressionInfo info );
 
     Literal ApplyOpcodeToLiterals( Opcode opcode, Literal literal1, Literal literal2 );
@@ -0,0 +1,119 @@
+/**
+ * Contains definition of the deterministic finite automaton used by the tokeniser.
+ */
+
+#include "LexerDfa.h"
+#include "Logger.h"
+
+#include <limits>
+#include <stdexcept>
+
+/**
+ * Gets the shared instance of the DFA. The transition table only depends on the token type definitions, so it is built
+ * once on first use.
+ *
+ * \return  The DFA instance.
+ */
+const LexerDfa&
+LexerDfa::GetInstance()
+{
+    static const LexerDfa instance{};
+    return instance;
+}
+
+/**
+ * Constructor for LexerDfa. Builds the transition table from the token type definitions.
+ *
+ * Identifiers and numeric literals each get a single looping state. Exact matches made up of symbols (e.g. "<=") are
+ * added as a trie of states hanging off the start state, so the longest such match is found by following transitions.
+ * Exact matches made up of word characters (keywords such as "if") are left to the identifier state, and resolved
+ * once the full token string is known.
+ */
+LexerDfa::LexerDfa()
+{
+    AddState( TokenType::INVALID_TOKEN ); // REJECT_STATE
+    AddState( TokenType::INVALID_TOKEN ); // START_STATE
+
+    State identifierState = AddState( TokenType::IDENTIFIER );
+    State numericState = AddState( TokenType::BYTE );
+
+    for ( size_t character = 0u; character < 256u; ++character )
+    {
+        const char asChar = static_cast< char >( character );
+        if ( IsWordCharacter( asChar ) )
+        {
+            // Identifiers can contain digits after the first character, but numeric literals can only contain digits.
+            m_transitions[identifierState][character] = identifierState;
+            if ( '0' <= asChar && '9' >= asChar )
+            {
+                m_transitions[START_STATE][character] = numericState;
+                m_transitions[numericState][character] = numericState;
+            }
+            else
+            {
+                m_transitions[START_STATE][character] = identifierState;
+            }
+        }
+    }
+
+    for ( const auto& exactMatch : g_tokenTypesExactMatches )
+    {
+        if ( !IsWordCharacter( exactMatch.first[0] ) )
+        {
+            AddExactMatch( exactMatch.first, exactMatch.second );
+        }
+    }
+}
+
+/**
+ * Adds a new state to the DFA, in which every transition leads to the reject state.
+ *
+ * \param[in]  acceptedType  The token type accepted in this state, INVALID_TOKEN if it is not an accepting state.
+ *
+ * \return  The new state.
+ */
+LexerDfa::State
+LexerDfa::AddState(
+    TokenType acceptedType
+)
+{
+    if ( std::numeric_limits< State >::max() < m_transitions.size() )
+    {
+        LOG_ERROR_AND_THROW( "Too many states in lexer DFA.", std::runtime_error );
+    }
+
+    TransitionRow row;
+    row.fill( REJECT_STATE );
+    m_transitions.push_back( row );
+    m_acceptedTypes.push_back( acceptedType );
+
+    return static_cast< State >( m_transitions.size() - 1u );
+}
+
+/**
+ * Adds the path of states that recognises an exact match string, reusing any states shared with a common prefix.
+ *
+ * \param[in]  tokenString  The string that exactly matches the token type.
+ * \param[in]  type         The token type to accept at the end of the string.
+ */
+void
+LexerDfa::AddExactMatch(
+    std::string_view tokenString,
+    TokenType type
+)
+{
+    State currentState = START_STATE;
+    for ( const char character : tokenString )
+    {
+        const unsigned char index = static_cast< unsigned char >( character );
+        if ( REJECT_STATE == m_transitions[currentState][index] )
+        {
+            // Can't take a reference to the row beforehand, as adding a state may reallocate the table.
+            State newState = AddState( TokenType::INVALID_TOKEN );
+            m_transitions[currentState][index] = newState;
+        }
+        currentState = m_transitions[currentState][index];
+    }
+
+    m_acceptedTypes[currentState] = type;
+}
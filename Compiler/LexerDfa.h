@@ -0,0 +1,64 @@
+/**
+ * Contains declaration of the deterministic finite automaton used by the tokeniser.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include "TokenTypes.h"
+
+using namespace TokenTypes;
+
+// Table-driven DFA which recognises the longest token starting at a given position in a string.
+// Each state is a row in the transition table, indexed by the next input byte, so every character is classified with a
+// single table lookup. Each state also records the token type it accepts, or INVALID_TOKEN if it is not accepting.
+class LexerDfa
+{
+public:
+    using State = uint8_t;
+
+    // The state that means no token can be formed by consuming any more characters.
+    static constexpr State REJECT_STATE = 0u;
+    static constexpr State START_STATE = 1u;
+
+    static const LexerDfa& GetInstance();
+
+    LexerDfa();
+
+    /**
+     * Gets the state reached by consuming a character in the given state.
+     */
+    State GetNextState( State state, char character ) const noexcept
+    {
+        return m_transitions[state][static_cast< unsigned char >( character )];
+    }
+
+    /**
+     * Gets the token type accepted in the given state, INVALID_TOKEN if the state is not accepting.
+     */
+    TokenType GetAcceptedType( State state ) const noexcept
+    {
+        return m_acceptedTypes[state];
+    }
+
+    /**
+     * Queries whether a character can form part of an identifier or numeric literal.
+     */
+    static bool IsWordCharacter( char character ) noexcept
+    {
+        return ( 'a' <= character && 'z' >= character ) || ( 'A' <= character && 'Z' >= character )
+               || ( '0' <= character && '9' >= character ) || '_' == character;
+    }
+
+protected:
+    using TransitionRow = std::array< State, 256u >;
+
+    State AddState( TokenType acceptedType );
+    void AddExactMatch( std::string_view tokenString, TokenType type );
+
+    std::vector< TransitionRow > m_transitions;
+    std::vector< TokenType > m_acceptedTypes;
+};
@@ -0,0 +1,225 @@
+/**
+ * Contains definition of the analysis of which variables are live at the boundaries of each basic block.
+ */
+
+#include "LivenessAnalysis.h"
+#include "Logger.h"
+
+using namespace TAC;
+
+LivenessAnalysis::LivenessAnalysis(
+    const ControlFlowGraph::Instructions& instructions,
+    const ControlFlowGraph& controlFlowGraph,
+    size_t numVariables
+)
+: m_numVariables( numVariables )
+{
+    size_t numBlocks = controlFlowGraph.GetNumBlocks();
+    m_uses.assign( numBlocks, BitVector( numVariables ) );
+    m_defs.assign( numBlocks, BitVector( numVariables ) );
+    m_liveIn.assign( numBlocks, BitVector( numVariables ) );
+    m_liveOut.assign( numBlocks, BitVector( numVariables ) );
+
+    CalculateUsesAndDefs( instructions, controlFlowGraph );
+    SolveDataflow( controlFlowGraph );
+}
+
+/**
+ * \brief  Gets the variables live on entry to a block.
+ *
+ * \param[in]  blockIndex  Index of the block in the control-flow graph.
+ *
+ * \return  Set of live variable IDs.
+ */
+const BitVector&
+LivenessAnalysis::GetLiveIn(
+    size_t blockIndex
+) const
+{
+    CheckBlockIndex( blockIndex );
+    return m_liveIn[blockIndex];
+}
+
+/**
+ * \brief  Gets the variables live on exit from a block.
+ *
+ * \param[in]  blockIndex  Index of the block in the control-flow graph.
+ *
+ * \return  Set of live variable IDs.
+ */
+const BitVector&
+LivenessAnalysis::GetLiveOut(
+    size_t blockIndex
+) const
+{
+    CheckBlockIndex( blockIndex );
+    return m_liveOut[blockIndex];
+}
+
+/**
+ * \brief  Checks whether a variable is live on entry to a block.
+ *
+ * \param[in]  blockIndex  Index of the block in the control-flow graph.
+ * \param[in]  var         The variable.
+ *
+ * \return  True if the variable's value on entry may be read, false otherwise.
+ */
+bool
+LivenessAnalysis::IsLiveIn(
+    size_t blockIndex,
+    VarId var
+) const
+{
+    return GetLiveIn( blockIndex ).Test( static_cast< size_t >( var ) );
+}
+
+/**
+ * \brief  Checks whether a variable is live on exit from a block.
+ *
+ * \param[in]  blockIndex  Index of the block in the control-flow graph.
+ * \param[in]  var         The variable.
+ *
+ * \return  True if the variable's value on exit may be read later, false otherwise.
+ */
+bool
+LivenessAnalysis::IsLiveOut(
+    size_t blockIndex,
+    VarId var
+) const
+{
+    return GetLiveOut( blockIndex ).Test( static_cast< size_t >( var ) );
+}
+
+/**
+ * \brief  Calculates the variables each block uses before writing to, and the variables each block writes to.
+ *
+ * \param[in]  instructions      The instructions of the program.
+ * \param[in]  controlFlowGraph  The control-flow graph of the instructions.
+ */
+void
+LivenessAnalysis::CalculateUsesAndDefs(
+    const ControlFlowGraph::Instructions& instructions,
+    const ControlFlowGraph& controlFlowGraph
+)
+{
+    for ( size_t blockIndex = 0; blockIndex < controlFlowGraph.GetNumBlocks(); ++blockIndex )
+    {
+        const BasicBlock& block = controlFlowGraph.GetBlock( blockIndex );
+        for ( size_t index = block.start; index < block.end; ++index )
+        {
+            const ThreeAddrInstruction& instr = instructions[index];
+            // Operands are read before the target is written, so an instruction can use the old value of its target.
+            AddUse( blockIndex, instr.m_operand1 );
+            AddUse( blockIndex, instr.m_operand2 );
+            AddDef( blockIndex, instr.m_target );
+        }
+    }
+}
+
+/**
+ * \brief  Records a variable being read in a block. This is only a use of its value on entry if it hasn't already
+ *         been written to in the block.
+ *
+ * \param[in]  blockIndex  Index of the block.
+ * \param[in]  var         The variable read, or g_invalidVarId for an unused operand.
+ */
+void
+LivenessAnalysis::AddUse(
+    size_t blockIndex,
+    VarId var
+)
+{
+    if ( g_invalidVarId == var )
+    {
+        return;
+    }
+    size_t varIndex = static_cast< size_t >( var );
+    if ( !m_defs[blockIndex].Test( varIndex ) )
+    {
+        m_uses[blockIndex].Set( varIndex );
+    }
+}
+
+/**
+ * \brief  Records a variable being written to in a block.
+ *
+ * \param[in]  blockIndex  Index of the block.
+ * \param[in]  var         The variable written to, or g_invalidVarId for a branch.
+ */
+void
+LivenessAnalysis::AddDef(
+    size_t blockIndex,
+    VarId var
+)
+{
+    if ( g_invalidVarId == var )
+    {
+        return;
+    }
+    m_defs[blockIndex].Set( static_cast< size_t >( var ) );
+}
+
+/**
+ * \brief  Iterates the liveness equations until no set changes. Liveness flows backwards, so blocks are visited in
+ *         post-order (successors before predecessors where possible), which usually converges in a few passes. Blocks
+ *         unreachable from the entry are visited last, as they may still be converted.
+ *
+ * \param[in]  controlFlowGraph  The control-flow graph of the instructions.
+ */
+void
+LivenessAnalysis::SolveDataflow(
+    const ControlFlowGraph& controlFlowGraph
+)
+{
+    const std::vector< size_t >& reversePostOrder = controlFlowGraph.GetReversePostOrder();
+    std::vector< size_t > visitOrder( reversePostOrder.rbegin(), reversePostOrder.rend() );
+    for ( size_t blockIndex = 0; blockIndex < controlFlowGraph.GetNumBlocks(); ++blockIndex )
+    {
+        if ( !controlFlowGraph.IsReachable( blockIndex ) )
+        {
+            visitOrder.push_back( blockIndex );
+        }
+    }
+
+    BitVector newLiveIn( m_numVariables );
+    bool changed{ true };
+    while ( changed )
+    {
+        changed = false;
+        ++m_numIterations;
+        for ( size_t blockIndex : visitOrder )
+        {
+            BitVector& liveOut = m_liveOut[blockIndex];
+            for ( size_t successor : controlFlowGraph.GetBlock( blockIndex ).successors )
+            {
+                liveOut.UnionWith( m_liveIn[successor] );
+            }
+
+            newLiveIn = liveOut;
+            newLiveIn.Subtract( m_defs[blockIndex] );
+            newLiveIn.UnionWith( m_uses[blockIndex] );
+            if ( newLiveIn != m_liveIn[blockIndex] )
+            {
+                // Live sets only ever grow, which guarantees this terminates.
+                std::swap( newLiveIn, m_liveIn[blockIndex] );
+                changed = true;
+            }
+        }
+    }
+}
+
+/**
+ * \brief  Throws if a block index is out of range.
+ *
+ * \param[in]  blockIndex  Index of the block.
+ */
+void
+LivenessAnalysis::CheckBlockIndex(
+    size_t blockIndex
+) const
+{
+    if ( blockIndex >= m_liveIn.size() )
+    {
+        LOG_ERROR_AND_THROW( "Block index " + std::to_string( blockIndex ) + " is out of range.", std::out_of_range );
+    }
+}
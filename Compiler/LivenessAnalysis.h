@@ -0,0 +1,70 @@
+/**
+ * Contains declaration of the analysis of which variables are live at the boundaries of each basic block.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "BitVector.h"
+#include "ControlFlowGraph.h"
+
+namespace TAC
+{
+    /**
+     * \brief  Global liveness analysis of a TAC program. A variable is live at a point if its current value may be read
+     *         later on some path from that point, i.e. before it is next written to. Unlike the first and last textual
+     *         references to a variable, this accounts for values carried around loops by their back edges.
+     *
+     *         Sets of variables are bit vectors indexed by variable ID. They are calculated on construction, by
+     *         iterating the dataflow equations over the control-flow graph until they reach a fixed point:
+     *             liveOut(block) = union of liveIn(successor) for each successor
+     *             liveIn(block)  = uses(block) + ( liveOut(block) - defs(block) )
+     */
+    class LivenessAnalysis
+    {
+    public:
+        using Ptr = std::shared_ptr< LivenessAnalysis >;
+
+        LivenessAnalysis(
+            const ControlFlowGraph::Instructions& instructions,
+            const ControlFlowGraph& controlFlowGraph,
+            size_t numVariables
+        );
+
+        const BitVector& GetLiveIn( size_t blockIndex ) const;
+        const BitVector& GetLiveOut( size_t blockIndex ) const;
+        bool IsLiveIn( size_t blockIndex, VarId var ) const;
+        bool IsLiveOut( size_t blockIndex, VarId var ) const;
+
+        size_t GetNumIterations() const { return m_numIterations; }
+
+    protected:
+        void CalculateUsesAndDefs(
+            const ControlFlowGraph::Instructions& instructions,
+            const ControlFlowGraph& controlFlowGraph
+        );
+        void AddUse( size_t blockIndex, VarId var );
+        void AddDef( size_t blockIndex, VarId var );
+
+        void SolveDataflow( const ControlFlowGraph& controlFlowGraph );
+
+        void CheckBlockIndex( size_t blockIndex ) const;
+
+        size_t m_numVariables;
+
+        // For each block, the variables read before being written to in the block, i.e. whose value on entry is used.
+        std::vector< BitVector > m_uses;
+        // For each block, the variables written to in the block.
+        std::vector< BitVector > m_defs;
+
+        // For each block, the variables live on entry to and exit from the block.
+        std::vector< BitVector > m_liveIn;
+        std::vector< BitVector > m_liveOut;
+
+        // Number of passes over the blocks taken to reach the fixed point, including the final pass with no changes.
+        size_t m_numIterations{ 0u };
+    };
+
+} // namespace TAC
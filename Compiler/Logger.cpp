@@ -3,56 +3,219 @@
  */
 
 #include "Logger.h"
-#include "FileIO.h"
-#include <ctime>
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <type_traits>
 
-Logger::Logger( LogLevel logLevel )
-: m_logLevel( logLevel )
+// The writer is woken each time this many messages have been queued, so that it keeps ahead of the logging threads.
+static constexpr uint64_t g_writerWakeInterval = g_logBufferCapacity / 4u;
+
+/**
+ * Constructor for Logger. Starts the writer thread.
+ *
+ * \param[in]  logLevel     Most verbose level of message that is logged.
+ * \param[in]  logFilePath  Path of the file to write to. If empty, a file named after the current time is created in
+ *                          the Logs directory.
+ */
+Logger::Logger(
+    LogLevel logLevel,
+    const std::string& logFilePath
+)
+: m_logLevel( logLevel ),
+  m_logFilePath( logFilePath ),
+  m_pendingRecords( g_logBufferCapacity ),
+  m_numRecordsPushed( 0u ),
+  m_cachedTimestamp( -1 ),
+  m_numRecordsWritten( 0u ),
+  m_flushTarget( 0u ),
+  m_stopWriter( false )
 {
-    std::time_t timestamp = time( NULL );
-    struct tm datetime;
-    localtime_s( &datetime, &timestamp );
+    if ( m_logFilePath.empty() )
+    {
+        std::time_t timestamp = time( NULL );
+        struct tm datetime;
+        localtime_s( &datetime, &timestamp );
 
-    char datetimeStr[128];
-    std::string conversionFormat = "%m_%d_%y__%H_%M_%S";
-    std::strftime( datetimeStr, sizeof( datetimeStr ), conversionFormat.c_str(), &datetime );
+        char datetimeStr[128];
+        std::string conversionFormat = "%m_%d_%y__%H_%M_%S";
+        std::strftime( datetimeStr, sizeof( datetimeStr ), conversionFormat.c_str(), &datetime );
 
-    const std::string logDir = "./Logs";
+        const std::string logDir = "./Logs";
 
-    if ( !std::filesystem::exists( logDir ) )
-    {
-        if ( !std::filesystem::create_directories( logDir ) )
+        if ( !std::filesystem::exists( logDir ) )
         {
-            throw std::runtime_error( "Failed to create log dir: " + logDir );
+            if ( !std::filesystem::create_directories( logDir ) )
+            {
+                throw std::runtime_error( "Failed to create log dir: " + logDir );
+            }
         }
+
+        m_logFilePath = logDir + "/Compiler__" + std::string( datetimeStr ) + ".txt";
     }
 
-    m_logFilePath = logDir + "/Compiler__" + std::string( datetimeStr ) + ".txt";
+    m_writerThread = std::thread( &Logger::RunWriter, this );
+}
+
+/**
+ * Destructor for Logger. Writes any queued messages, then stops the writer thread.
+ */
+Logger::~Logger()
+{
+    {
+        std::lock_guard< std::mutex > lock( m_writerMutex );
+        m_stopWriter = true;
+    }
+    m_writerCondition.notify_one();
+    if ( m_writerThread.joinable() )
+    {
+        m_writerThread.join();
+    }
 }
 
 /**
- * \brief  Prints message to log file.
+ * \brief  Queues message to be written to the log file.
  *
  * \param[in]  logLevel   Level of message. Is only logged if is <= m_logLevel.
  * \param[in]  message    The message to be logged.
- * \param[in]  codeFile   Name of the calling program file.
- * \param[in]  codeFunc   Name of the calling function.
+ * \param[in]  codeFile   Name of the calling program file. Must outlive the logger, e.g. be a string literal.
+ * \param[in]  codeFunc   Name of the calling function. Must outlive the logger, e.g. be a string literal.
  * \param[in]  lineNum    Line number in the calling program file.
  */
 void
 Logger::LogMessage(
     LogLevel logLevel,
-    const std::string message,
+    const std::string& message,
     const char* codeFile,
     const char* codeFunc,
     int lineNum
 )
 {
-    if ( logLevel <= m_logLevel )
+    if ( IsLevelEnabled( logLevel ) )
+    {
+        LogRecord record{ logLevel, time( NULL ), codeFile, codeFunc, lineNum, message };
+
+        // If the buffer is full, wake the writer and wait for it to make space rather than dropping the message.
+        while ( !m_pendingRecords.TryPush( record ) )
+        {
+            m_writerCondition.notify_one();
+            std::this_thread::yield();
+        }
+
+        uint64_t numPushed = m_numRecordsPushed.fetch_add( 1u, std::memory_order_release ) + 1u;
+        if ( 0u == numPushed % g_writerWakeInterval )
+        {
+            // Taking the mutex means the writer is either waiting, so gets the notification, or hasn't yet checked
+            // whether there are messages to write, so will see this one.
+            {
+                std::lock_guard< std::mutex > lock( m_writerMutex );
+            }
+            m_writerCondition.notify_one();
+        }
+    }
+}
+
+/**
+ * \brief  Blocks until every message logged before the call has been written to the log file.
+ */
+void
+Logger::Flush()
+{
+    uint64_t target = m_numRecordsPushed.load( std::memory_order_acquire );
+
+    std::unique_lock< std::mutex > lock( m_writerMutex );
+    if ( m_numRecordsWritten >= target )
+    {
+        return;
+    }
+    m_flushTarget = std::max( m_flushTarget, target );
+    m_writerCondition.notify_one();
+    m_recordsWrittenCondition.wait( lock, [ this, target ] { return m_numRecordsWritten >= target; } );
+}
+
+/**
+ * \brief  Body of the writer thread. Writes queued messages whenever it is woken, or the poll interval passes, until the
+ *         logger is destroyed.
+ */
+void
+Logger::RunWriter()
+{
+    std::unique_lock< std::mutex > lock( m_writerMutex );
+    while ( true )
+    {
+        // Wait until woken with messages to write, rather than only when flushing or stopping, so that logging threads
+        // waiting on a full buffer don't have to wait for the poll interval to pass.
+        m_writerCondition.wait_for( lock, g_writerPollInterval, [ this ] {
+            return m_stopWriter || m_numRecordsWritten < m_flushTarget
+                   || m_numRecordsWritten < m_numRecordsPushed.load( std::memory_order_acquire );
+        } );
+        bool stopping = m_stopWriter;
+
+        // Logging threads never take the mutex, so it doesn't need to be held while writing.
+        lock.unlock();
+        uint64_t numWritten = 0u;
+        LogRecord record;
+        while ( m_pendingRecords.TryPop( record ) )
+        {
+            WriteRecord( record );
+            ++numWritten;
+        }
+        if ( 0u != numWritten )
+        {
+            m_logFile.flush();
+        }
+        lock.lock();
+
+        m_numRecordsWritten += numWritten;
+        m_recordsWrittenCondition.notify_all();
+
+        if ( stopping )
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * \brief  Formats a message and writes it to the log file, opening the file if this is the first message.
+ *
+ * \param[in]  record  The message to write.
+ */
+void
+Logger::WriteRecord(
+    const LogRecord& record
+)
+{
+    if ( !m_logFile.is_open() )
+    {
+        m_logFile.open( m_logFilePath, std::ios_base::app );
+        if ( !m_logFile.is_open() )
+        {
+            // Nowhere to report the failure to, so give up on this message and try again with the next one.
+            return;
+        }
+    }
+
+    m_logFile << GetTimestampString( record.timestamp ) << LogLevelToString( record.logLevel ) << ": "
+              << record.codeFile << ", " << record.codeFunc << ", line " << record.lineNum << ": "
+              << record.message << "\n";
+}
+
+/**
+ * \brief  Gets the timestamp prefix for a message. The formatted string only changes once per second, so it is cached
+ *         and only reformatted when the second changes.
+ *
+ * \param[in]  timestamp  Time the message was logged.
+ *
+ * \return  Time of day in the form used at the start of each log line.
+ */
+const std::string&
+Logger::GetTimestampString(
+    std::time_t timestamp
+)
+{
+    if ( timestamp != m_cachedTimestamp )
     {
-        std::time_t timestamp = time( NULL );
         struct tm datetime;
         localtime_s( &datetime, &timestamp );
 
@@ -60,13 +223,10 @@ Logger::LogMessage(
         std::string conversionFormat = "%T: ";
         std::strftime( datetimeStr, sizeof( datetimeStr ), conversionFormat.c_str(), &datetime );
 
-        std::string logMessage = datetimeStr;
-        logMessage += LogLevelToString( logLevel ) + ": ";
-        logMessage += std::string( codeFile ) + ", " + std::string( codeFunc );
-        logMessage += ", line " + std::to_string( lineNum ) + ": ";
-        logMessage += message;
-        FileIO::AppendLineToFile( logMessage, m_logFilePath );
+        m_cachedTimestamp = timestamp;
+        m_cachedTimestampString = datetimeStr;
     }
+    return m_cachedTimestampString;
 }
 
 /**
@@ -110,5 +270,5 @@ Logger::SetLogLevel(
     LogLevel level
 )
 {
-    m_logLevel = level;
+    m_logLevel.store( level, std::memory_order_relaxed );
 }
\ No newline at end of file
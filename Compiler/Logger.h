@@ -7,6 +7,15 @@
 #include <string>
 #include <memory>
 #include <iostream>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <fstream>
+#include <thread>
+
+#include "RingBuffer.h"
 
 enum LogLevel
 {
@@ -18,22 +27,79 @@ enum LogLevel
     INFO_LOW_LEVEL
 };
 
+// The most verbose log level that is compiled in. Logging calls above this level are removed at compile time, so
+// cost nothing even if the runtime log level is raised. Defaults to INFO in release builds, and can be overridden by
+// defining MAX_COMPILED_LOG_LEVEL as a LogLevel name.
+#ifndef MAX_COMPILED_LOG_LEVEL
+#ifdef NDEBUG
+#define MAX_COMPILED_LOG_LEVEL INFO
+#else
+#define MAX_COMPILED_LOG_LEVEL INFO_LOW_LEVEL
+#endif
+#endif
+constexpr LogLevel g_maxCompiledLogLevel = LogLevel::MAX_COMPILED_LOG_LEVEL;
+
+// Number of messages that can be queued before logging threads have to wait for the writer. Must be a power of 2.
+constexpr size_t g_logBufferCapacity = 8192u;
+// Longest time a queued message waits before the writer wakes up to write it, if it isn't woken sooner.
+constexpr std::chrono::milliseconds g_writerPollInterval( 50 );
+
+/**
+ * \brief  Writes log messages to a file. Logging a message only queues it in a lock-free ring buffer; a background
+ *         thread formats queued messages and writes them through a single long-lived file stream, so logging threads
+ *         never wait on file I/O. Queued messages are written on Flush(), on logging an error and on destruction.
+ */
 class Logger
 {
 public:
     using Ptr = std::shared_ptr< Logger >;
 
-    Logger( LogLevel logLevel );
-    static Ptr GetInstance() {
+    Logger( LogLevel logLevel, const std::string& logFilePath = "" );
+    static const Ptr& GetInstance() {
         // Default to log level INFO
         static Ptr instance = std::make_shared< Logger >( LogLevel::INFO );
         return instance;
     }
-    ~Logger() = default;
+    ~Logger();
 
-    void LogMessage( LogLevel logLevel, const std::string message, const char* codeFile, const char* codeFunc, int lineNum );
+    // Owns the writer thread, so can't be copied.
+    Logger( const Logger& ) = delete;
+    Logger& operator=( const Logger& ) = delete;
 
-    #define LOG( logLevel, message ) Logger::GetInstance()->LogMessage( logLevel, message, __FILE__, __FUNCTION__, __LINE__ )
+    void LogMessage( LogLevel logLevel, const std::string& message, const char* codeFile, const char* codeFunc, int lineNum );
+    void Flush();
+
+    /**
+     * Gets the path of the file messages are written to.
+     */
+    const std::string&
+    GetLogFilePath() const
+    {
+        return m_logFilePath;
+    }
+
+    /**
+     * Queries whether messages of the given level are currently being logged.
+     */
+    bool
+    IsLevelEnabled( LogLevel logLevel ) const
+    {
+        return logLevel <= m_logLevel.load( std::memory_order_relaxed );
+    }
+
+    // The message is only evaluated if its level is compiled in and enabled, so building it costs nothing otherwise.
+    #define LOG( logLevel, message ) \
+        do \
+        { \
+            if constexpr ( ( logLevel ) <= g_maxCompiledLogLevel ) \
+            { \
+                const Logger::Ptr& logger = Logger::GetInstance(); \
+                if ( logger->IsLevelEnabled( logLevel ) ) \
+                { \
+                    logger->LogMessage( logLevel, message, __FILE__, __FUNCTION__, __LINE__ ); \
+                } \
+            } \
+        } while ( false )
     #define LOG_ERROR( message ) LOG( LogLevel::ERROR, message )
     #define LOG_WARN( message ) LOG( LogLevel::WARN, message )
     #define LOG_INFO( message ) LOG( LogLevel::INFO, message )
@@ -43,19 +109,24 @@ public:
     template< class E >
     void LogAndThrow(
         LogLevel logLevel,
-        const std::string message,
+        const std::string& message,
         const char* codeFile,
         const char* codeFunc,
         int lineNum )
     {
         static_assert( std::is_base_of<std::exception, E>{} );
         LogMessage( logLevel, message, codeFile, codeFunc, lineNum );
+        // The exception may end the program, so make sure the error and everything leading up to it reach the file.
+        if ( LogLevel::ERROR == logLevel )
+        {
+            Flush();
+        }
         throw E( message );
     }
 
     static void LogAndCout(
         LogLevel logLevel,
-        const std::string message,
+        const std::string& message,
         const char* codeFile,
         const char* codeFunc,
         int lineNum
@@ -74,8 +145,48 @@ public:
     void SetLogLevel( LogLevel level );
 
 private:
+    /**
+     * \brief  A message waiting to be written. Formatting is left to the writer thread, so the file and function names
+     *         are kept as pointers to the string literals passed in by the logging macros.
+     */
+    struct LogRecord
+    {
+        LogLevel logLevel;
+        std::time_t timestamp;
+        const char* codeFile;
+        const char* codeFunc;
+        int lineNum;
+        std::string message;
+    };
+
+    void RunWriter();
+    void WriteRecord( const LogRecord& record );
+    const std::string& GetTimestampString( std::time_t timestamp );
+
     std::string LogLevelToString( LogLevel logLevel );
 
-    LogLevel m_logLevel;
+    // Atomic as the level may be checked from multiple threads, e.g. when lexing in parallel.
+    std::atomic< LogLevel > m_logLevel;
     std::string m_logFilePath;
+
+    // Messages logged but not yet written.
+    RingBuffer< LogRecord > m_pendingRecords;
+    // Number of messages pushed to m_pendingRecords, used to tell when a flush has caught up.
+    std::atomic< uint64_t > m_numRecordsPushed;
+
+    // Only accessed by the writer thread. The file is opened when the first message is written.
+    std::ofstream m_logFile;
+    std::time_t m_cachedTimestamp;
+    std::string m_cachedTimestampString;
+
+    // Guards the writer state below, and is used to wake the writer and the threads waiting on it.
+    std::mutex m_writerMutex;
+    std::condition_variable m_writerCondition;
+    std::condition_variable m_recordsWrittenCondition;
+    uint64_t m_numRecordsWritten;
+    uint64_t m_flushTarget;
+    bool m_stopWriter;
+
+    // Declared last, so the thread is started once everything it uses has been initialised.
+    std::thread m_writerThread;
 };
\ No newline at end of file
@@ -0,0 +1,172 @@
+/**
+ * Contains definition of class providing read-only access to the contents of a source file.
+ */
+
+#include "MappedSourceFile.h"
+#include "Logger.h"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#ifdef _WIN32
+// Exclude GDI, as it defines an ERROR macro which clashes with the log levels.
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define NOGDI
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Constructor for MappedSourceFile. Maps the file, falling back to reading it into a buffer if that fails. Throws if
+ * the file can't be opened.
+ *
+ * \param[in]  filePath  Path to the file.
+ */
+MappedSourceFile::MappedSourceFile(
+    const std::string& filePath
+)
+: m_filePath( filePath ),
+  m_data( nullptr ),
+  m_size( 0u ),
+  m_isMapped( false )
+{
+    if ( !MapFile() )
+    {
+        LOG_INFO( "Could not map file " + m_filePath + " - reading into buffer instead." );
+        ReadFileToBuffer();
+    }
+}
+
+/**
+ * Destructor for MappedSourceFile. Unmaps the file contents, if they were mapped.
+ */
+MappedSourceFile::~MappedSourceFile()
+{
+    if ( m_isMapped )
+    {
+#ifdef _WIN32
+        UnmapViewOfFile( m_data );
+#else
+        munmap( const_cast< char* >( m_data ), m_size );
+#endif
+    }
+}
+
+/**
+ * \brief  Maps the file into memory read-only. An empty file has nothing to map, so is given an empty view.
+ *
+ * \return  True if the contents are now available, false if the file could not be mapped.
+ */
+bool
+MappedSourceFile::MapFile()
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA( m_filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+    if ( INVALID_HANDLE_VALUE == file )
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if ( !GetFileSizeEx( file, &fileSize ) || FILE_TYPE_DISK != GetFileType( file ) )
+    {
+        CloseHandle( file );
+        return false;
+    }
+    if ( 0 == fileSize.QuadPart )
+    {
+        CloseHandle( file );
+        return true;
+    }
+
+    // The view keeps the mapping and file open, so both handles can be closed once it has been created.
+    HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    CloseHandle( file );
+    if ( nullptr == mapping )
+    {
+        return false;
+    }
+    void* view = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+    CloseHandle( mapping );
+    if ( nullptr == view )
+    {
+        return false;
+    }
+
+    m_size = static_cast< size_t >( fileSize.QuadPart );
+#else
+    int fileDescriptor = open( m_filePath.c_str(), O_RDONLY );
+    if ( 0 > fileDescriptor )
+    {
+        return false;
+    }
+
+    struct stat fileStatus;
+    if ( 0 != fstat( fileDescriptor, &fileStatus ) || !S_ISREG( fileStatus.st_mode ) )
+    {
+        close( fileDescriptor );
+        return false;
+    }
+    if ( 0 == fileStatus.st_size )
+    {
+        close( fileDescriptor );
+        return true;
+    }
+
+    // The mapping keeps the file open, so the descriptor can be closed once it has been created.
+    size_t fileSize = static_cast< size_t >( fileStatus.st_size );
+    void* view = mmap( nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+    close( fileDescriptor );
+    if ( MAP_FAILED == view )
+    {
+        return false;
+    }
+    // The lexer reads the file from start to end, so let the kernel read ahead.
+    madvise( view, fileSize, MADV_SEQUENTIAL );
+
+    m_size = fileSize;
+#endif
+
+    m_data = static_cast< const char* >( view );
+    m_isMapped = true;
+    return true;
+}
+
+/**
+ * \brief  Reads the whole file into the buffer member, in a single read if its size is known up front.
+ */
+void
+MappedSourceFile::ReadFileToBuffer()
+{
+    std::ifstream file( m_filePath, std::ios::binary );
+    if ( !file.is_open() )
+    {
+        LOG_ERROR_AND_THROW( "Failed to open file " + m_filePath, std::invalid_argument );
+    }
+
+    file.seekg( 0, std::ios::end );
+    std::streamoff fileSize = file.tellg();
+    if ( 0 <= fileSize )
+    {
+        m_buffer.resize( static_cast< size_t >( fileSize ) );
+        file.seekg( 0, std::ios::beg );
+        file.read( m_buffer.data(), fileSize );
+        m_buffer.resize( static_cast< size_t >( file.gcount() ) );
+    }
+    else
+    {
+        // Not seekable, e.g. a pipe, so read until the end of the stream.
+        file.clear();
+        m_buffer.assign( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >() );
+    }
+
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+}
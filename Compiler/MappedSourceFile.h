@@ -0,0 +1,64 @@
+/**
+ * Contains declaration of class providing read-only access to the contents of a source file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * \brief  Read-only view of the contents of a source file. Where possible the file is memory-mapped, so its contents are
+ *         paged in as they are read rather than copied. If the file can't be mapped (e.g. it is not a regular file),
+ *         it is read into a buffer instead.
+ *
+ *         The contents are exactly the bytes of the file: line endings are not converted.
+ */
+class MappedSourceFile
+{
+public:
+    using Ptr = std::shared_ptr< MappedSourceFile >;
+    using UPtr = std::unique_ptr< MappedSourceFile >;
+
+    MappedSourceFile( const std::string& filePath );
+    ~MappedSourceFile();
+
+    // Owns the mapping, so can't be copied.
+    MappedSourceFile( const MappedSourceFile& ) = delete;
+    MappedSourceFile& operator=( const MappedSourceFile& ) = delete;
+
+    /**
+     * Gets a view of the whole file. Only valid for as long as this object is alive.
+     */
+    std::string_view
+    GetContents() const
+    {
+        return std::string_view( m_data, m_size );
+    }
+
+    /**
+     * Queries whether the contents are memory-mapped, rather than read into a buffer.
+     */
+    bool
+    IsMapped() const
+    {
+        return m_isMapped;
+    }
+
+protected:
+    bool MapFile();
+    void ReadFileToBuffer();
+
+    const std::string m_filePath;
+
+    // Start and size of the file contents, whether mapped or buffered.
+    const char* m_data;
+    size_t m_size;
+
+    // Whether m_data points to a mapped view that must be unmapped on destruction.
+    bool m_isMapped;
+
+    // Holds the file contents if it couldn't be mapped.
+    std::string m_buffer;
+};
@@ -0,0 +1,379 @@
+/**
+ * Contains definition of class which predicts which grammar rules can match the next token.
+ */
+
+#include "PredictionTable.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// Shared empty set, returned for non-terminals with no rules.
+static const PredictionTable::TerminalSet g_emptyTerminalSet{};
+
+/**
+ * Constructor for PredictionTable. Calculates the FIRST and FOLLOW sets of the grammar, then builds the table.
+ *
+ * \param[in]  ruleSets  The grammar rules of each non-terminal. Must outlive the table.
+ */
+PredictionTable::PredictionTable(
+    const std::unordered_map< NT, Rules >& ruleSets
+)
+: m_ruleSets( ruleSets ),
+  m_numTerminalColumns( 0u )
+{
+    CalculateNullable();
+    CalculateFirstSets();
+    CalculateFollowSets();
+    BuildTable();
+}
+
+/**
+ * \brief  Gets the table for the language grammar, building it on first use.
+ *
+ * \return  The shared prediction table.
+ */
+const PredictionTable&
+PredictionTable::GetInstance()
+{
+    static const PredictionTable instance( g_nonTerminalRuleSets );
+    return instance;
+}
+
+/**
+ * \brief  Gets the rules of a non-terminal that could match, given the next token.
+ *
+ * \param[in]  nt         The non-terminal being parsed.
+ * \param[in]  nextToken  Type of the next token, or T::INVALID_TOKEN if there are no tokens left.
+ *
+ * \return  Indices of the candidate rules in the non-terminal's rule set, in grammar order. Empty if no rule can match.
+ */
+PredictionTable::Candidates
+PredictionTable::GetCandidateRules(
+    NT nt,
+    TokenType nextToken
+) const
+{
+    size_t entryIndex = GetNtIndex( nt ) * m_numTerminalColumns + GetTerminalIndex( nextToken );
+    if ( GetTerminalIndex( nextToken ) >= m_numTerminalColumns || entryIndex >= m_entries.size() )
+    {
+        // Beyond any symbol used by the grammar, so nothing can match.
+        return Candidates( nullptr, nullptr );
+    }
+    const std::pair< size_t, size_t >& entry = m_entries[entryIndex];
+    const size_t* candidates = m_candidateRuleIndices.data();
+    return Candidates( candidates + entry.first, candidates + entry.second );
+}
+
+/**
+ * \brief  Queries whether a non-terminal can expand to nothing.
+ *
+ * \param[in]  nt  The non-terminal.
+ *
+ * \return  True if the non-terminal is nullable, false otherwise.
+ */
+bool
+PredictionTable::IsNullable(
+    NT nt
+) const
+{
+    auto nullable = m_nullable.find( nt );
+    return m_nullable.end() != nullable && nullable->second;
+}
+
+/**
+ * \brief  Gets the FIRST set of a non-terminal: the terminals that can start it.
+ *
+ * \param[in]  nt  The non-terminal.
+ *
+ * \return  The set of terminals.
+ */
+const PredictionTable::TerminalSet&
+PredictionTable::GetFirstSet(
+    NT nt
+) const
+{
+    auto firstSet = m_firstSets.find( nt );
+    return m_firstSets.end() == firstSet ? g_emptyTerminalSet : firstSet->second;
+}
+
+/**
+ * \brief  Gets the FOLLOW set of a non-terminal: the terminals that can come straight after it, including
+ *         T::INVALID_TOKEN for the end of the tokens.
+ *
+ * \param[in]  nt  The non-terminal.
+ *
+ * \return  The set of terminals.
+ */
+const PredictionTable::TerminalSet&
+PredictionTable::GetFollowSet(
+    NT nt
+) const
+{
+    auto followSet = m_followSets.find( nt );
+    return m_followSets.end() == followSet ? g_emptyTerminalSet : followSet->second;
+}
+
+/**
+ * \brief  Gets the row of a non-terminal in the table.
+ */
+size_t
+PredictionTable::GetNtIndex(
+    Symbol nt
+)
+{
+    return nt & ~static_cast< Symbol >( SymbolType::BITMASK );
+}
+
+/**
+ * \brief  Gets the column of a terminal in the table.
+ */
+size_t
+PredictionTable::GetTerminalIndex(
+    Symbol terminal
+)
+{
+    return terminal & ~static_cast< Symbol >( SymbolType::BITMASK );
+}
+
+/**
+ * \brief  Finds the nullable non-terminals, by repeatedly marking non-terminals with a rule made only of nullable
+ *         non-terminals until nothing changes.
+ */
+void
+PredictionTable::CalculateNullable()
+{
+    for ( const auto& ruleSet : m_ruleSets )
+    {
+        m_nullable[ruleSet.first] = false;
+    }
+
+    bool changed{ true };
+    while ( changed )
+    {
+        changed = false;
+        for ( const auto& ruleSet : m_ruleSets )
+        {
+            if ( m_nullable[ruleSet.first] )
+            {
+                continue;
+            }
+            for ( const Rule& rule : ruleSet.second )
+            {
+                bool ruleIsNullable = std::all_of( rule.begin(), rule.end(), [ this ]( Symbol symbol ) {
+                    return SymbolType::NonTerminal == GrammarSymbols::GetSymbolType( symbol )
+                           && IsNullable( static_cast< NT >( symbol ) );
+                } );
+                if ( ruleIsNullable )
+                {
+                    m_nullable[ruleSet.first] = true;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \brief  Adds the terminals that can start a sequence of symbols to a set.
+ *
+ * \param[in]      begin     Start of the sequence.
+ * \param[in]      end       End of the sequence.
+ * \param[in,out]  firstSet  Set to add the terminals to.
+ *
+ * \return  True if the whole sequence is nullable, false otherwise.
+ */
+bool
+PredictionTable::AddFirstSetOfSequence(
+    Rule::const_iterator begin,
+    Rule::const_iterator end,
+    TerminalSet& firstSet
+) const
+{
+    for ( auto symbol = begin; symbol != end; ++symbol )
+    {
+        if ( SymbolType::Terminal == GrammarSymbols::GetSymbolType( *symbol ) )
+        {
+            firstSet.insert( static_cast< TokenType >( *symbol ) );
+            return false;
+        }
+
+        NT nt = static_cast< NT >( *symbol );
+        const TerminalSet& ntFirstSet = GetFirstSet( nt );
+        firstSet.insert( ntFirstSet.begin(), ntFirstSet.end() );
+        if ( !IsNullable( nt ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief  Calculates the FIRST set of each non-terminal, by repeatedly adding the FIRST sets of its rules until nothing
+ *         changes.
+ */
+void
+PredictionTable::CalculateFirstSets()
+{
+    bool changed{ true };
+    while ( changed )
+    {
+        changed = false;
+        for ( const auto& ruleSet : m_ruleSets )
+        {
+            TerminalSet firstSet = GetFirstSet( ruleSet.first );
+            for ( const Rule& rule : ruleSet.second )
+            {
+                AddFirstSetOfSequence( rule.begin(), rule.end(), firstSet );
+            }
+            if ( firstSet.size() != GetFirstSet( ruleSet.first ).size() )
+            {
+                m_firstSets[ruleSet.first] = std::move( firstSet );
+                changed = true;
+            }
+        }
+    }
+}
+
+/**
+ * \brief  Calculates the FOLLOW set of each non-terminal, by repeatedly adding what can follow each of its uses in a
+ *         rule until nothing changes.
+ */
+void
+PredictionTable::CalculateFollowSets()
+{
+    for ( const auto& ruleSet : m_ruleSets )
+    {
+        m_followSets[ruleSet.first].insert( T::INVALID_TOKEN );
+    }
+
+    bool changed{ true };
+    while ( changed )
+    {
+        changed = false;
+        for ( const auto& ruleSet : m_ruleSets )
+        {
+            for ( const Rule& rule : ruleSet.second )
+            {
+                for ( auto symbol = rule.begin(); symbol != rule.end(); ++symbol )
+                {
+                    if ( SymbolType::NonTerminal != GrammarSymbols::GetSymbolType( *symbol ) )
+                    {
+                        continue;
+                    }
+
+                    // Whatever can start the rest of the rule can follow the symbol. If the rest of the rule can be
+                    // empty, so can whatever follows the rule's own non-terminal.
+                    TerminalSet followSet = GetFollowSet( static_cast< NT >( *symbol ) );
+                    size_t previousSize = followSet.size();
+                    if ( AddFirstSetOfSequence( symbol + 1, rule.end(), followSet ) )
+                    {
+                        const TerminalSet& ruleFollowSet = GetFollowSet( ruleSet.first );
+                        followSet.insert( ruleFollowSet.begin(), ruleFollowSet.end() );
+                    }
+                    if ( followSet.size() != previousSize )
+                    {
+                        m_followSets[static_cast< NT >( *symbol )] = std::move( followSet );
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \brief  Builds the table: each rule is a candidate for the terminals that can start it, and if it is nullable, for
+ *         the terminals that can follow its non-terminal. Records an entry with more than one candidate as a conflict,
+ *         and logs how many there are once the table is built.
+ */
+void
+PredictionTable::BuildTable()
+{
+    size_t numNtRows{ 0u };
+    for ( const auto& ruleSet : m_ruleSets )
+    {
+        numNtRows = std::max( numNtRows, GetNtIndex( ruleSet.first ) + 1u );
+        for ( const Rule& rule : ruleSet.second )
+        {
+            for ( Symbol symbol : rule )
+            {
+                if ( SymbolType::Terminal == GrammarSymbols::GetSymbolType( symbol ) )
+                {
+                    m_numTerminalColumns = std::max( m_numTerminalColumns, GetTerminalIndex( symbol ) + 1u );
+                }
+            }
+        }
+    }
+    // The end of the tokens always has a column.
+    m_numTerminalColumns = std::max( m_numTerminalColumns, GetTerminalIndex( T::INVALID_TOKEN ) + 1u );
+    m_entries.assign( numNtRows * m_numTerminalColumns, std::make_pair( 0u, 0u ) );
+
+    // Terminals that can start each rule, or follow it if it is nullable.
+    std::vector< TerminalSet > predictSets;
+    for ( size_t ntIndex = 0u; ntIndex < numNtRows; ++ntIndex )
+    {
+        NT nt = static_cast< NT >( SymbolType::NonTerminal + ntIndex );
+        auto ruleSet = m_ruleSets.find( nt );
+        if ( m_ruleSets.end() == ruleSet )
+        {
+            continue;
+        }
+
+        const Rules& rules = ruleSet->second;
+        predictSets.assign( rules.size(), TerminalSet{} );
+        for ( size_t ruleIndex = 0u; ruleIndex < rules.size(); ++ruleIndex )
+        {
+            if ( AddFirstSetOfSequence( rules[ruleIndex].begin(), rules[ruleIndex].end(), predictSets[ruleIndex] ) )
+            {
+                const TerminalSet& followSet = GetFollowSet( nt );
+                predictSets[ruleIndex].insert( followSet.begin(), followSet.end() );
+            }
+        }
+
+        for ( size_t terminalIndex = 0u; terminalIndex < m_numTerminalColumns; ++terminalIndex )
+        {
+            TokenType terminal = static_cast< TokenType >( SymbolType::Terminal + terminalIndex );
+            std::pair< size_t, size_t >& entry = m_entries[ntIndex * m_numTerminalColumns + terminalIndex];
+            entry.first = m_candidateRuleIndices.size();
+            for ( size_t ruleIndex = 0u; ruleIndex < rules.size(); ++ruleIndex )
+            {
+                if ( predictSets[ruleIndex].end() != predictSets[ruleIndex].find( terminal ) )
+                {
+                    m_candidateRuleIndices.push_back( ruleIndex );
+                }
+            }
+            entry.second = m_candidateRuleIndices.size();
+
+            if ( 1u < entry.second - entry.first )
+            {
+                std::string conflict = GrammarSymbols::ConvertSymbolToString( nt ) + " on "
+                                       + GrammarSymbols::ConvertSymbolToString( terminal ) + ":";
+                for ( size_t i = entry.first; i < entry.second; ++i )
+                {
+                    conflict += " '" + GrammarRules::ConvertRuleToString( rules[m_candidateRuleIndices[i]] ) + "'";
+                }
+                LOG_INFO_MEDIUM_LEVEL( "LL(1) conflict, rules will be tried in order: " + conflict );
+                m_conflicts.push_back( std::move( conflict ) );
+            }
+        }
+    }
+
+    if ( !m_conflicts.empty() )
+    {
+        const std::string summary = "Grammar is not LL(1): " + std::to_string( m_conflicts.size() )
+                                    + " table entries have more than one candidate rule, which will be tried in order.";
+        // The language grammar is known not to be LL(1), so only warn about other grammars.
+        if ( &g_nonTerminalRuleSets == &m_ruleSets )
+        {
+            LOG_INFO_MEDIUM_LEVEL( summary );
+        }
+        else
+        {
+            LOG_WARN( summary );
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ * Contains declaration of class which predicts which grammar rules can match the next token.
+ */
+
+#pragma once
+#include "Grammar.h"
+#include "Token.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace GrammarRules;
+
+/**
+ * \brief  Table of the rules each non-terminal could expand to, given the type of the next token. Built from the FIRST
+ *         and FOLLOW sets of a grammar, so the parser only tries the rules that could match, in grammar order.
+ *
+ *         Where the grammar is LL(1), each entry holds at most one rule and parsing is deterministic. Where more than
+ *         one rule can start with the same token (e.g. a rule and a longer rule extending it), the entry holds all of
+ *         them and the parser backtracks between them as before. These conflicts are recorded when the table is built.
+ *
+ *         T::INVALID_TOKEN stands for the end of the tokens. As parsing can start from any non-terminal, the end of the
+ *         tokens is in the FOLLOW set of every non-terminal.
+ */
+class PredictionTable
+{
+public:
+    using TerminalSet = std::set< TokenType >;
+
+    /**
+     * \brief  View of the indices of the candidate rules in one table entry, in grammar order. Points into the table,
+     *         so only valid for as long as the table is alive.
+     */
+    class Candidates
+    {
+    public:
+        Candidates( const size_t* begin, const size_t* end ) : m_begin( begin ), m_end( end ) {}
+
+        const size_t* begin() const { return m_begin; }
+        const size_t* end() const { return m_end; }
+        size_t size() const { return static_cast< size_t >( m_end - m_begin ); }
+        bool empty() const { return m_begin == m_end; }
+
+    private:
+        const size_t* m_begin;
+        const size_t* m_end;
+    };
+
+    PredictionTable( const std::unordered_map< NT, Rules >& ruleSets );
+
+    // The table for g_nonTerminalRuleSets, built on first use.
+    static const PredictionTable& GetInstance();
+
+    Candidates GetCandidateRules( NT nt, TokenType nextToken ) const;
+
+    bool IsNullable( NT nt ) const;
+    const TerminalSet& GetFirstSet( NT nt ) const;
+    const TerminalSet& GetFollowSet( NT nt ) const;
+
+    /**
+     * Gets a description of each table entry which holds more than one rule, i.e. where the grammar isn't LL(1).
+     */
+    const std::vector< std::string >&
+    GetConflicts() const
+    {
+        return m_conflicts;
+    }
+
+protected:
+    static size_t GetNtIndex( Symbol nt );
+    static size_t GetTerminalIndex( Symbol terminal );
+
+    void CalculateNullable();
+    void CalculateFirstSets();
+    void CalculateFollowSets();
+    void BuildTable();
+
+    bool AddFirstSetOfSequence( Rule::const_iterator begin, Rule::const_iterator end, TerminalSet& firstSet ) const;
+
+    const std::unordered_map< NT, Rules >& m_ruleSets;
+
+    std::unordered_map< NT, bool > m_nullable;
+    std::unordered_map< NT, TerminalSet > m_firstSets;
+    std::unordered_map< NT, TerminalSet > m_followSets;
+
+    // Number of columns in the table: one for every terminal up to the highest used by the grammar.
+    size_t m_numTerminalColumns;
+    // For each (non-terminal, terminal) entry, the start and end of its candidates in m_candidateRuleIndices. Indexed
+    // by non-terminal index * m_numTerminalColumns + terminal index.
+    std::vector< std::pair< size_t, size_t > > m_entries;
+    // Candidate rule indices for every entry, stored contiguously.
+    std::vector< size_t > m_candidateRuleIndices;
+
+    // Description of each entry with more than one candidate. How many there are is logged once the table is built,
+    // as a warning unless the grammar is the language grammar.
+    std::vector< std::string > m_conflicts;
+};
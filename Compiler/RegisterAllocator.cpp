@@ -0,0 +1,370 @@
+/**
+ * Contains definition of the allocation of registers to variables over a whole program.
+ */
+
+#include <algorithm>
+#include <set>
+#include <string>
+
+#include "Logger.h"
+#include "RegisterAllocator.h"
+
+using namespace Assembly;
+
+/**
+ * \brief  Gets the first instruction index in the range. The range must not be empty.
+ *
+ * \return  Index of the start of the first segment.
+ */
+size_t
+LiveRange::GetStart() const
+{
+    return segments.front().first;
+}
+
+/**
+ * \brief  Gets the last instruction index in the range. The range must not be empty.
+ *
+ * \return  Index of the end of the last segment.
+ */
+size_t
+LiveRange::GetEnd() const
+{
+    return segments.back().second;
+}
+
+/**
+ * \brief  Checks whether an instruction is inside one of the segments of the range.
+ *
+ * \param[in]  index  The instruction index.
+ *
+ * \return  True if the variable is live at the instruction, false if it is before, after, or in a hole of the range.
+ */
+bool
+LiveRange::Covers(
+    size_t index
+) const
+{
+    // Find the last segment starting at or before the index.
+    auto it = std::upper_bound( segments.begin(), segments.end(), index,
+                                []( size_t value, const Segment& segment ) { return value < segment.first; } );
+    return segments.begin() != it && index <= std::prev( it )->second;
+}
+
+/**
+ * \brief  Checks whether the segment containing an instruction continues past it. For an instruction writing to the
+ *         variable, this is whether the value written is ever read.
+ *
+ * \param[in]  index  The instruction index.
+ *
+ * \return  True if the variable is live at the instruction and the one after it, in the same segment.
+ */
+bool
+LiveRange::ContinuesAfter(
+    size_t index
+) const
+{
+    auto it = std::upper_bound( segments.begin(), segments.end(), index,
+                                []( size_t value, const Segment& segment ) { return value < segment.first; } );
+    return segments.begin() != it && index < std::prev( it )->second;
+}
+
+/**
+ * \brief  Checks whether any instruction is in both this range and another.
+ *
+ * \param[in]  other  The other range.
+ *
+ * \return  True if the ranges overlap, false otherwise.
+ */
+bool
+LiveRange::Intersects(
+    const LiveRange& other
+) const
+{
+    auto it = segments.begin();
+    auto otherIt = other.segments.begin();
+    while ( segments.end() != it && other.segments.end() != otherIt )
+    {
+        if ( it->second < otherIt->first )
+        {
+            ++it;
+        }
+        else if ( otherIt->second < it->first )
+        {
+            ++otherIt;
+        }
+        else
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+RegisterAllocator::RegisterAllocator(
+    const LiveRanges& liveRanges,
+    const SpillCosts& spillCosts,
+    uint8_t firstRegister,
+    size_t numRegisters
+)
+: m_spillCosts( spillCosts ),
+  m_firstRegister( firstRegister ),
+  m_numRegisters( numRegisters )
+{
+    if ( 0u == m_numRegisters )
+    {
+        LOG_ERROR_AND_THROW( "Register allocation needs at least one register.", std::invalid_argument );
+    }
+    Allocate( liveRanges );
+}
+
+/**
+ * \brief  Checks whether a variable lives in memory rather than a register.
+ *
+ * \param[in]  var  The variable.
+ *
+ * \return  True if the variable was spilled, false otherwise.
+ */
+bool
+RegisterAllocator::IsSpilled(
+    VarId var
+) const
+{
+    return std::binary_search( m_spilledVars.begin(), m_spilledVars.end(), var );
+}
+
+/**
+ * \brief  Gets the register allocated to a variable. Throws if it was spilled, or isn't in the program.
+ *
+ * \param[in]  var  The variable.
+ *
+ * \return  The register number.
+ */
+uint8_t
+RegisterAllocator::GetRegister(
+    VarId var
+) const
+{
+    auto allocated = m_registers.find( var );
+    if ( m_registers.end() == allocated )
+    {
+        LOG_ERROR_AND_THROW( "Variable " + std::to_string( static_cast< uint32_t >( var ) )
+                             + " has not been allocated a register.", std::out_of_range );
+    }
+    return allocated->second;
+}
+
+/**
+ * \brief  Counts the distinct registers allocated to any variable.
+ *
+ * \return  Number of registers used.
+ */
+size_t
+RegisterAllocator::GetNumRegistersUsed() const
+{
+    std::set< uint8_t > usedRegisters;
+    for ( const auto& allocated : m_registers )
+    {
+        usedRegisters.insert( allocated.second );
+    }
+    return usedRegisters.size();
+}
+
+/**
+ * \brief  Allocates a register to, or spills, every variable with a non-empty live range. Variables are visited in
+ *         order of the start of their live range (then by ID, so the result doesn't depend on hashing order).
+ *
+ * \param[in]  liveRanges  The live range of each variable.
+ */
+void
+RegisterAllocator::Allocate(
+    const LiveRanges& liveRanges
+)
+{
+    std::vector< VarId > unhandled;
+    unhandled.reserve( liveRanges.size() );
+    for ( const auto& entry : liveRanges )
+    {
+        if ( !entry.second.IsEmpty() )
+        {
+            unhandled.push_back( entry.first );
+        }
+    }
+    std::sort( unhandled.begin(), unhandled.end(),
+               [&]( VarId lhs, VarId rhs )
+               {
+                   size_t lhsStart = liveRanges.at( lhs ).GetStart();
+                   size_t rhsStart = liveRanges.at( rhs ).GetStart();
+                   return lhsStart < rhsStart || ( lhsStart == rhsStart && lhs < rhs );
+               } );
+
+    for ( VarId var : unhandled )
+    {
+        UpdateActiveAndInactive( liveRanges.at( var ).GetStart(), liveRanges );
+        if ( !TryAllocateFreeRegister( var, liveRanges ) )
+        {
+            AllocateBlockedRegister( var, liveRanges );
+        }
+    }
+
+    std::sort( m_spilledVars.begin(), m_spilledVars.end() );
+    m_active.clear();
+    m_inactive.clear();
+}
+
+/**
+ * \brief  Moves the variables holding registers between active and inactive according to whether they are live at
+ *         the current instruction, and drops those whose live range has ended.
+ *
+ * \param[in]  index       The current instruction index.
+ * \param[in]  liveRanges  The live range of each variable.
+ */
+void
+RegisterAllocator::UpdateActiveAndInactive(
+    size_t index,
+    const LiveRanges& liveRanges
+)
+{
+    std::vector< VarId > active;
+    std::vector< VarId > inactive;
+    auto sortVar = [&]( VarId var )
+    {
+        const LiveRange& range = liveRanges.at( var );
+        if ( range.GetEnd() >= index )
+        {
+            ( range.Covers( index ) ? active : inactive ).push_back( var );
+        }
+    };
+    std::for_each( m_active.begin(), m_active.end(), sortVar );
+    std::for_each( m_inactive.begin(), m_inactive.end(), sortVar );
+    std::swap( m_active, active );
+    std::swap( m_inactive, inactive );
+}
+
+/**
+ * \brief  Allocates a register to a variable if one is free for all of its live range, i.e. not held by an active
+ *         variable, nor by an inactive variable whose live range overlaps it later on.
+ *
+ * \param[in]  var         The variable.
+ * \param[in]  liveRanges  The live range of each variable.
+ *
+ * \return  True if a register was allocated, false if none are free.
+ */
+bool
+RegisterAllocator::TryAllocateFreeRegister(
+    VarId var,
+    const LiveRanges& liveRanges
+)
+{
+    const LiveRange& range = liveRanges.at( var );
+    std::vector< bool > isFree( m_numRegisters, true );
+    for ( VarId active : m_active )
+    {
+        isFree[m_registers.at( active ) - m_firstRegister] = false;
+    }
+    for ( VarId inactive : m_inactive )
+    {
+        if ( range.Intersects( liveRanges.at( inactive ) ) )
+        {
+            isFree[m_registers.at( inactive ) - m_firstRegister] = false;
+        }
+    }
+
+    auto freeRegister = std::find( isFree.begin(), isFree.end(), true );
+    if ( isFree.end() == freeRegister )
+    {
+        return false;
+    }
+    m_registers[var] = static_cast< uint8_t >( m_firstRegister + ( freeRegister - isFree.begin() ) );
+    m_active.push_back( var );
+    return true;
+}
+
+/**
+ * \brief  When no register is free, spills whichever of the variable and the active variables is cheapest to keep in
+ *         memory. Between equally cheap variables, the one that lives the longest is spilled, as this frees a register
+ *         for the most instructions. If an active variable is spilled, its register is given to the variable - unless
+ *         that register is also needed later by an inactive variable.
+ *
+ * \param[in]  var         The variable.
+ * \param[in]  liveRanges  The live range of each variable.
+ */
+void
+RegisterAllocator::AllocateBlockedRegister(
+    VarId var,
+    const LiveRanges& liveRanges
+)
+{
+    const LiveRange& range = liveRanges.at( var );
+    std::vector< bool > isNeededByInactive( m_numRegisters, false );
+    for ( VarId inactive : m_inactive )
+    {
+        if ( range.Intersects( liveRanges.at( inactive ) ) )
+        {
+            isNeededByInactive[m_registers.at( inactive ) - m_firstRegister] = true;
+        }
+    }
+
+    VarId varToSpill = var;
+    double lowestCost = GetSpillCost( var );
+    size_t furthestEnd = range.GetEnd();
+    for ( VarId active : m_active )
+    {
+        if ( isNeededByInactive[m_registers.at( active ) - m_firstRegister] )
+        {
+            continue;
+        }
+        double activeCost = GetSpillCost( active );
+        size_t activeEnd = liveRanges.at( active ).GetEnd();
+        if ( activeCost < lowestCost || ( activeCost == lowestCost && activeEnd > furthestEnd ) )
+        {
+            varToSpill = active;
+            lowestCost = activeCost;
+            furthestEnd = activeEnd;
+        }
+    }
+
+    if ( var != varToSpill )
+    {
+        // The spilled variable never holds its register, so it can be given away for its whole live range.
+        m_registers[var] = m_registers.at( varToSpill );
+        m_registers.erase( varToSpill );
+        m_active.erase( std::find( m_active.begin(), m_active.end(), varToSpill ) );
+        m_active.push_back( var );
+    }
+    Spill( varToSpill );
+}
+
+/**
+ * \brief  Gets the cost of spilling a variable. Throws if it has none.
+ *
+ * \param[in]  var  The variable.
+ *
+ * \return  The spill cost.
+ */
+double
+RegisterAllocator::GetSpillCost(
+    VarId var
+) const
+{
+    auto spillCost = m_spillCosts.find( var );
+    if ( m_spillCosts.end() == spillCost )
+    {
+        LOG_ERROR_AND_THROW( "Variable " + std::to_string( static_cast< uint32_t >( var ) ) + " has no spill cost.",
+                             std::invalid_argument );
+    }
+    return spillCost->second;
+}
+
+/**
+ * \brief  Records a variable as living in memory.
+ *
+ * \param[in]  var  The variable.
+ */
+void
+RegisterAllocator::Spill(
+    VarId var
+)
+{
+    m_spilledVars.push_back( var );
+}
@@ -0,0 +1,94 @@
+/**
+ * Contains declaration of the allocation of registers to variables over a whole program.
+ */
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "VariableTable.h"
+
+namespace Assembly
+{
+    /**
+     * \brief  The instructions over which a variable holds a value that may still be read. This is a sorted list of
+     *         disjoint segments rather than a single interval, so that the gaps between them (lifetime holes, e.g.
+     *         between a value's last use and the variable being written to again) can be given to other variables.
+     */
+    struct LiveRange
+    {
+        // First and last instruction index of a segment, inclusive.
+        using Segment = std::pair< size_t, size_t >;
+
+        size_t GetStart() const;
+        size_t GetEnd() const;
+        bool IsEmpty() const { return segments.empty(); }
+        bool Covers( size_t index ) const;
+        bool ContinuesAfter( size_t index ) const;
+        bool Intersects( const LiveRange& other ) const;
+
+        // Sorted by ascending instruction index, with no two segments overlapping. Segments are only adjacent where a
+        // value that is never read is followed by a write to the same variable.
+        std::vector< Segment > segments;
+    };
+
+    /**
+     * \brief  Allocates registers to variables over the whole program, using linear scan over the live ranges of all
+     *         variables in program order. Each variable either keeps one register for all of its live range, or is
+     *         spilled, i.e. lives in memory for all of its live range and is only loaded into a temporary register
+     *         around each instruction referencing it. As a variable never moves between registers and memory, no code
+     *         is needed at the boundaries of basic blocks.
+     *
+     *         Variables whose live ranges overlap interfere and are given different registers, but a variable may be
+     *         given the register of another whose range has a hole covering it. When no register is free, the
+     *         variable with the lowest spill cost (the estimated number of extra instructions run if it were spilled)
+     *         is spilled. Allocation happens on construction.
+     */
+    class RegisterAllocator
+    {
+    public:
+        using Ptr = std::shared_ptr< RegisterAllocator >;
+        using LiveRanges = std::unordered_map< VarId, LiveRange >;
+        using SpillCosts = std::unordered_map< VarId, double >;
+
+        RegisterAllocator(
+            const LiveRanges& liveRanges,
+            const SpillCosts& spillCosts,
+            uint8_t firstRegister,
+            size_t numRegisters
+        );
+
+        bool IsSpilled( VarId var ) const;
+        uint8_t GetRegister( VarId var ) const;
+
+        const std::vector< VarId >& GetSpilledVars() const { return m_spilledVars; }
+        size_t GetNumRegistersUsed() const;
+
+    protected:
+        void Allocate( const LiveRanges& liveRanges );
+        void UpdateActiveAndInactive( size_t index, const LiveRanges& liveRanges );
+        bool TryAllocateFreeRegister( VarId var, const LiveRanges& liveRanges );
+        void AllocateBlockedRegister( VarId var, const LiveRanges& liveRanges );
+        double GetSpillCost( VarId var ) const;
+        void Spill( VarId var );
+
+        // The estimated number of extra instructions run if each variable were spilled.
+        SpillCosts m_spillCosts;
+        uint8_t m_firstRegister;
+        size_t m_numRegisters;
+
+        // The variables allocated a register, and the number of the register.
+        std::unordered_map< VarId, uint8_t > m_registers;
+        // The variables not allocated a register, in ascending order of ID.
+        std::vector< VarId > m_spilledVars;
+
+        // While allocating: the variables holding a register whose live range covers the current instruction, and
+        // those holding a register whose live range has a hole at the current instruction.
+        std::vector< VarId > m_active;
+        std::vector< VarId > m_inactive;
+    };
+
+} // namespace Assembly
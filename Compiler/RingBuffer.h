@@ -0,0 +1,172 @@
+/**
+ * Contains declaration and definition of a bounded lock-free queue.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+/**
+ * \brief  Fixed-capacity queue which any number of threads can push to and pop from without locking. Each slot has a
+ *         sequence number recording whether it is ready to be written or read, so threads only contend on the counter
+ *         at the end of the queue they are using, and never wait on each other while copying values.
+ *
+ * \tparam  T  The type of value stored. Values are moved in and out of slots, so it must be default-constructible and
+ *             move-assignable.
+ */
+template< class T >
+class RingBuffer
+{
+public:
+    RingBuffer( size_t capacity );
+
+    // Slots are shared with other threads, so the buffer can't be copied or moved.
+    RingBuffer( const RingBuffer& ) = delete;
+    RingBuffer& operator=( const RingBuffer& ) = delete;
+
+    bool TryPush( T& value );
+    bool TryPop( T& value );
+
+    size_t
+    GetCapacity() const
+    {
+        return m_indexMask + 1u;
+    }
+
+private:
+    struct Slot
+    {
+        // Equal to the slot's position when it is free to be pushed to, and one more than its position when it holds a
+        // value ready to be popped.
+        std::atomic< size_t > sequence;
+        T value;
+    };
+
+    const size_t m_indexMask;
+    std::unique_ptr< Slot[] > m_slots;
+
+    // Kept on separate cache lines so that pushing and popping threads don't invalidate each other's cached counter.
+    alignas( 64 ) std::atomic< size_t > m_pushPosition;
+    alignas( 64 ) std::atomic< size_t > m_popPosition;
+};
+
+/**
+ * Constructor for RingBuffer.
+ *
+ * \param[in]  capacity  Maximum number of values held at once. Must be a power of 2, so that positions can be wrapped
+ *                       with a mask.
+ */
+template< class T >
+RingBuffer< T >::RingBuffer(
+    size_t capacity
+)
+: m_indexMask( capacity - 1u ),
+  m_slots( std::make_unique< Slot[] >( capacity ) ),
+  m_pushPosition( 0u ),
+  m_popPosition( 0u )
+{
+    if ( 0u == capacity || 0u != ( capacity & m_indexMask ) )
+    {
+        throw std::invalid_argument( "Ring buffer capacity must be a power of 2, got " + std::to_string( capacity ) );
+    }
+    for ( size_t position = 0u; position < capacity; ++position )
+    {
+        m_slots[position].sequence.store( position, std::memory_order_relaxed );
+    }
+}
+
+/**
+ * \brief  Pushes a value onto the back of the queue, if there is space.
+ *
+ * \param[in,out]  value  The value to push. Moved from if the push succeeds.
+ *
+ * \return  True if the value was pushed, false if the queue is full.
+ */
+template< class T >
+bool
+RingBuffer< T >::TryPush(
+    T& value
+)
+{
+    Slot* slot;
+    size_t position = m_pushPosition.load( std::memory_order_relaxed );
+    while ( true )
+    {
+        slot = &m_slots[position & m_indexMask];
+        size_t sequence = slot->sequence.load( std::memory_order_acquire );
+        intptr_t difference = static_cast< intptr_t >( sequence ) - static_cast< intptr_t >( position );
+        if ( 0 == difference )
+        {
+            // The slot is free: claim it by advancing the push position.
+            if ( m_pushPosition.compare_exchange_weak( position, position + 1u, std::memory_order_relaxed ) )
+            {
+                break;
+            }
+        }
+        else if ( 0 > difference )
+        {
+            // The slot still holds a value from the previous lap, so the queue is full.
+            return false;
+        }
+        else
+        {
+            // Another thread claimed this position first.
+            position = m_pushPosition.load( std::memory_order_relaxed );
+        }
+    }
+
+    slot->value = std::move( value );
+    slot->sequence.store( position + 1u, std::memory_order_release );
+    return true;
+}
+
+/**
+ * \brief  Pops the value from the front of the queue, if there is one.
+ *
+ * \param[out]  value  Assigned the popped value if the pop succeeds.
+ *
+ * \return  True if a value was popped, false if the queue is empty.
+ */
+template< class T >
+bool
+RingBuffer< T >::TryPop(
+    T& value
+)
+{
+    Slot* slot;
+    size_t position = m_popPosition.load( std::memory_order_relaxed );
+    while ( true )
+    {
+        slot = &m_slots[position & m_indexMask];
+        size_t sequence = slot->sequence.load( std::memory_order_acquire );
+        intptr_t difference = static_cast< intptr_t >( sequence ) - static_cast< intptr_t >( position + 1u );
+        if ( 0 == difference )
+        {
+            // The slot holds a value: claim it by advancing the pop position.
+            if ( m_popPosition.compare_exchange_weak( position, position + 1u, std::memory_order_relaxed ) )
+            {
+                break;
+            }
+        }
+        else if ( 0 > difference )
+        {
+            // The slot hasn't been pushed to yet, so the queue is empty.
+            return false;
+        }
+        else
+        {
+            // Another thread claimed this position first.
+            position = m_popPosition.load( std::memory_order_relaxed );
+        }
+    }
+
+    value = std::move( slot->value );
+    // Free the slot for the push one lap ahead.
+    slot->sequence.store( position + m_indexMask + 1u, std::memory_order_release );
+    return true;
+}
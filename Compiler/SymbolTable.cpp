@@ -3,64 +3,52 @@
  * checking and code generation.
  */
 
-#include <stdexcept>
-
 #include "SymbolTable.h"
-#include "Logger.h"
+
+/**
+ * Constructor for SymbolTable.
+ *
+ * \param[in]  parentTable  The table of the enclosing scope, with which symbols are shared. Null if this is the table
+ *                          associated with the root node of the AST, which creates a new set of symbols.
+ */
+SymbolTable::SymbolTable(
+    SymbolTable::Ptr parentTable
+)
+: m_symbols( nullptr == parentTable ? std::make_shared< FlatSymbolTable >() : parentTable->m_symbols ),
+  m_scopeId( m_symbols->AddScope( nullptr == parentTable ? g_noScope : parentTable->m_scopeId ) )
+{
+}
 
 /**
  * \brief  Searches for and returns entry corresponding to the identifier, either in this table or a parent table.
  *
- * \param[in]  identifier  The string identifier of the symbol which the entry corresponds to.
+ * \param[in]  identifier  The interned identifier of the symbol which the entry corresponds to.
  *
  * \return  Pointer to the associated symbol table entry, or nullptr if one couldn't be found.
  */
-SymbolTableEntry::Ptr
+SymbolTableEntry*
 SymbolTable::GetEntryIfExists(
-    const std::string& identifier
+    IdentifierId identifier
 )
 {
-    if ( 0u < m_table.count( identifier ) )
-    {
-        return m_table.find( identifier )->second;
-    }
-    // If no entry in this table, try parent table if we have one.
-    else if ( nullptr != m_parentTable )
-    {
-        return m_parentTable->GetEntryIfExists( identifier );
-    }
-    else
-    {
-        return nullptr;
-    }
+    return m_symbols->GetEntryIfExists( m_scopeId, identifier );
 }
 
 /**
- * \brief  Adds entry to symbol table.
+ * \brief  Adds entry to symbol table. Throws if this table already contains an entry for the identifier.
+ *
+ * \param[in]  identifier  The interned identifier of the symbol which the entry corresponds to.
+ * \param[in]  entry       The entry to store.
  *
- * \param[in]  identifier  The string identifier of the symbol which the entry corresponds to.
- * \param[in]  entry       Ptr to the created entry.
+ * \return  The stored entry.
  */
-void
+SymbolTableEntry&
 SymbolTable::AddEntry(
-    const std::string& identifier,
-    SymbolTableEntry::Ptr entry
+    IdentifierId identifier,
+    const SymbolTableEntry& entry
 )
 {
-    if ( nullptr == entry )
-    {
-        LOG_ERROR_AND_THROW( "Could not add symbol table entry for '" + identifier + "': given a nullptr entry struct.",
-                             std::runtime_error );
-    }
-
-    // If table already contains this entry, throw error
-    if ( 0u < m_table.count( identifier ) )
-    {
-        LOG_ERROR_AND_THROW( "Could not add symbol table entry for '" + identifier + "': entry already exists",
-                             std::runtime_error );
-    }
-
-    m_table.insert( { identifier, entry } );
+    return m_symbols->AddEntry( m_scopeId, identifier, entry );
 }
 
 /**
@@ -71,5 +59,5 @@ SymbolTable::AddEntry(
 size_t
 SymbolTable::GetNumEntries()
 {
-    return m_table.size();
-}
\ No newline at end of file
+    return m_symbols->GetNumEntries( m_scopeId );
+}
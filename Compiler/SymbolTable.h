@@ -5,31 +5,34 @@
 
 #pragma once
 
-#include "SymbolTableEntry.h"
+#include "FlatSymbolTable.h"
 
-#include <unordered_map>
 #include <string>
 
+/**
+ * \brief  The symbol table of a single scope. The symbols themselves are stored in a FlatSymbolTable shared by every
+ *         scope of the program, so a table is only a handle to its scope: looking up a symbol searches this scope and
+ *         its enclosing scopes at once, rather than each table in turn.
+ */
 class SymbolTable
 {
 public:
     using Ptr = std::shared_ptr< SymbolTable >;
-    SymbolTable( SymbolTable::Ptr parentTable )
-    : m_table(),
-      m_parentTable( parentTable )
-    {
-    }
+    SymbolTable( SymbolTable::Ptr parentTable );
 
-    SymbolTableEntry::Ptr GetEntryIfExists( const std::string& identifier );
+    SymbolTableEntry* GetEntryIfExists( IdentifierId identifier );
 
-    void AddEntry( const std::string& identifier, SymbolTableEntry::Ptr entry );
+    SymbolTableEntry& AddEntry( IdentifierId identifier, const SymbolTableEntry& entry );
 
     size_t GetNumEntries();
 
+    ScopeId GetScopeId() const { return m_scopeId; }
+    const VariableTable::Ptr& GetVariableTable() const { return m_symbols->GetVariableTable(); }
+
 protected:
-    // The table itself. Maps string identifiers to structs containing associated information.
-    std::unordered_map< std::string, SymbolTableEntry::Ptr > m_table;
+    // The table storing the symbols of this scope and every other scope of the program.
+    FlatSymbolTable::Ptr m_symbols;
 
-    // The table of the parent scope. Null if this is the table associated with the root node of the AST.
-    SymbolTable::Ptr m_parentTable;
-};
\ No newline at end of file
+    // This table's scope within m_symbols.
+    ScopeId m_scopeId;
+};
@@ -4,15 +4,16 @@
 
 #pragma once
 #include "TokenValue.h"
+#include "VariableTable.h"
 
 /**
  * \brief  Holds information about a symbol (e.g. identifier) in source code.
  */
 struct SymbolTableEntry
 {
-    using Ptr = std::shared_ptr< SymbolTableEntry >;
-
-    DataType dataType;
-    bool isReadFrom;
-    bool isWrittenTo;
+    DataType dataType{};
+    bool isReadFrom{ false };
+    bool isWrittenTo{ false };
+    // ID of the variable the symbol is stored in, allocated when the entry is added to a symbol table.
+    VarId varId{ g_invalidVarId };
 };
\ No newline at end of file
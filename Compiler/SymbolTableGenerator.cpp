@@ -3,17 +3,18 @@
  */
 
 #include "SymbolTableGenerator.h"
+#include "AstArena.h"
 #include <stdexcept>
 
 /**
  * \brief  Creates symbol table to store information about all symbols within this scope of this AST, and stores it
- *         inside the root tree node. Recursively adds symbol tables for any scope-defining subtrees.
+ *         inside the root tree node. Also adds symbol tables for any scope-defining subtrees.
  *
  * \param[in]  treeRootNode  The root node of the AST defining the scope of the symbol table.
  */
 void
 SymbolTableGenerator::GenerateSymbolTableForAst(
-    AstNode::Ptr treeRootNode
+    AstNode treeRootNode
 )
 {
     if ( nullptr == treeRootNode )
@@ -21,7 +22,7 @@ SymbolTableGenerator::GenerateSymbolTableForAst(
         LOG_ERROR_AND_THROW( "Generate symbol table called with nullptr AST node.", std::invalid_argument );
     }
 
-    if ( nullptr != treeRootNode->m_symbolTable )
+    if ( nullptr != treeRootNode.GetSymbolTable() )
     {
         LOG_ERROR_AND_THROW( "Cannot generate symbol table: node already has an existing table.", std::runtime_error );
     }
@@ -29,6 +30,38 @@ SymbolTableGenerator::GenerateSymbolTableForAst(
     CreateTableForAstFromParent( nullptr, treeRootNode );
 }
 
+/**
+ * \brief  Populates a symbol table with the symbols of a single node in its scope and the node's sub-tree, creating
+ *         tables for any scope-defining nodes. Allows a table to be populated one statement at a time, e.g. while
+ *         the statements are being parsed, before the node defining the scope has been created.
+ *
+ * \param[in]  table  The symbol table of the scope the node is in.
+ * \param[in]  node   The node to add symbols from. Must not be the node defining the table's scope.
+ */
+void
+SymbolTableGenerator::PopulateTableFromNode(
+    SymbolTable::Ptr table,
+    AstNode node
+)
+{
+    if ( nullptr == table || nullptr == node )
+    {
+        LOG_ERROR_AND_THROW( "Populate symbol table called with nullptr table or AST node.", std::invalid_argument );
+    }
+    if ( !node.IsStorageInUse() )
+    {
+        LOG_ERROR_AND_THROW( "Trying to populate symbol table: AST node not storing any value.", std::runtime_error );
+    }
+
+    // The node has no parent yet, so it can't be the identifier being assigned to.
+    constexpr size_t childIndex{ 0u };
+    SymbolTable::Ptr subTreeTable = Visit( node, table, nullptr, childIndex );
+    if ( nullptr != subTreeTable )
+    {
+        PopulateTableFromSubTree( subTreeTable, node );
+    }
+}
+
 /**
  * \brief  Internal method for creating a symbol table for a given AST node, from a given parent table.
  *
@@ -38,18 +71,46 @@ SymbolTableGenerator::GenerateSymbolTableForAst(
 void
 SymbolTableGenerator::CreateTableForAstFromParent(
     SymbolTable::Ptr parentTable,
-    AstNode::Ptr treeRootNode
+    AstNode treeRootNode
 )
 {
     SymbolTable::Ptr symbolTable = std::make_shared< SymbolTable >( parentTable );
-    treeRootNode->m_symbolTable = symbolTable;
+    treeRootNode.GetArena()->SetSymbolTable( treeRootNode, symbolTable );
 
     PopulateTableFromSubTree( symbolTable, treeRootNode );
 }
 
 /**
- * \brief  Considers each child node and populates the table with any symbols it finds. If subtrees are found, it
- *         either creates a new symbol table, or recursively calls to continue traversing the nodes in this scope.
+ * \brief  Gets the children of a sub-tree node, to be checked when populating a symbol table.
+ *
+ * \param[in]  node  Node holding the children.
+ *
+ * \return  The node's children.
+ */
+static AstNode::ChildRange
+GetSubTreeChildren(
+    AstNode node
+)
+{
+    // If node is holding a token rather than child nodes, throw error
+    if ( node.IsStoringToken() && node.IsStorageInUse() )
+    {
+        // Expect that this will only be called on sub-tree nodes, so it should contain a valid storage of
+        // child nodes.
+        LOG_ERROR_AND_THROW( "Unexpected lack of children for a scope-defining AST node.", std::runtime_error );
+    }
+    return node.GetChildren();
+}
+
+/**
+ * \brief  Considers each node in the sub-tree and populates the table with any symbols it finds. If scope-defining
+ *         sub-trees are found, it creates a new symbol table for them and populates that instead until the sub-tree
+ *         has been traversed.
+ *
+ *         The tree is traversed depth-first, visiting children left to right, using an explicit stack of the nodes
+ *         being traversed rather than recursion, so the depth of the tree is only limited by memory. Each child is
+ *         passed to the handler for its label, which returns the table to populate from the child's sub-tree if it is
+ *         to be traversed.
  *
  * \param[in]  table       The symbol table of the current scope, to populate with entries.
  * \param[in]  parentNode  Parent of child nodes to check. Pass this instead of children so we can check the operation
@@ -58,110 +119,158 @@ SymbolTableGenerator::CreateTableForAstFromParent(
 void
 SymbolTableGenerator::PopulateTableFromSubTree(
     SymbolTable::Ptr table,
-    AstNode::Ptr parentNode
+    AstNode parentNode
 )
 {
-    // If node is holding child nodes and not a token, throw error
-    if ( parentNode->IsStoringToken() && parentNode->IsStorageInUse() )
-    {
-        // Expect that this method will only be called on scope nodes, so it should contain a valid storage of
-        // child nodes.
-        LOG_ERROR_AND_THROW( "Unexpected lack of children for a scope-defining AST node.", std::runtime_error );
-    }
-    AstNode::Children children = parentNode->GetChildren();
+    std::vector< SubTreeFrame > frames;
+    frames.push_back( { table, parentNode, GetSubTreeChildren( parentNode ), 0u } );
 
-    // If child is an identifier, locate existing entry or create new one
-    // If child is a scope node, generate new table for this child
-    // Else if child is not a scope-definer but has children of its own, repeat the same process for its children
-    for ( size_t i = 0; i < children.size(); i++ )
+    while ( !frames.empty() )
     {
-        auto child = children[i];
-
-        if ( child->IsStorageInUse() )
+        SubTreeFrame& frame = frames.back();
+        if ( frame.nextChildIndex >= frame.children.size() )
         {
-            // If child holds a token
-            if ( child->IsStoringToken() )
-            {
-                if ( TokenType::IDENTIFIER == child->m_nodeLabel )
-                {
-                    std::string identifier = child->GetToken()->m_value->m_value.stringValue;
-                    SymbolTableEntry::Ptr entry = table->GetEntryIfExists( identifier );
-                    // If on left side of assignment, it's a write operation
-                    if ( TokenType::ASSIGN == parentNode->m_nodeLabel && 0u == i )
-                    {
-                        // Because this is an identifier and not a (data type + identifier), we expect there to already
-                        // an entry.
-                        if ( nullptr == entry )
-                        {
-                            LOG_ERROR_AND_THROW( "Trying to write to undeclared identifier: '" + identifier + "'",
-                                                 std::runtime_error );
-                        }
-
-                        entry->isWrittenTo = true;
-                    }
-                    // Else it's a read operation
-                    else
-                    {
-                        // Read operation expects an entry to exist
-                        if ( nullptr == entry )
-                        {
-                            LOG_ERROR_AND_THROW( "Trying to read from undeclared identifier: '" + identifier + "'",
-                                                 std::runtime_error );
-                        }
-
-                        entry->isReadFrom = true;
-                    }
-                }
-                // Ignore any other token types
-            }
-            // Else if child is holding a "variable" rule (it still represents a single identifier)
-            else if ( NT::Variable == child->m_nodeLabel )
-            {
-                AstNode::Children variableChildren = child->GetChildren();
-                // Get rightmost child to get identifier node. With two children this should be 2.
-                if ( 2u != variableChildren.size() )
-                {
-                    LOG_ERROR_AND_THROW( "Encountered 'variable' rule node with unexpected number of children: "
-                                         + std::to_string( variableChildren.size() ), std::runtime_error );
-                }
-                AstNode::Ptr idNode = variableChildren[1];
-                std::string identifier = idNode->GetToken()->m_value->m_value.stringValue;
-
-                // Expect no existing entry as it is being declared
-                SymbolTableEntry::Ptr entry = table->GetEntryIfExists( identifier );
-                if ( nullptr != entry )
-                {
-                    LOG_ERROR_AND_THROW( "Trying to re-declare existing variable: '" + identifier + "'",
-                                         std::runtime_error );
-                }
-
-                // Create new entry and add to table
-                AstNode::Ptr dataTypeNode = variableChildren[0];
-                DataType dataType = dataTypeNode->GetToken()->m_value->m_value.dataTypeValue;
-
-                entry = std::make_shared< SymbolTableEntry >();
-                entry->dataType = dataType;
-                table->AddEntry( identifier, entry );
-            }
-            // If child represents sub-tree
-            else
-            {
-                // If scope-defining sub-tree, create new table
-                if ( child->IsScopeDefiningNode() )
-                {
-                    CreateTableForAstFromParent( table, child );
-                }
-                // Else continue populating in this scope
-                else
-                {
-                    PopulateTableFromSubTree( table, child );
-                }
-            }
+            frames.pop_back();
+            continue;
         }
-        else
+
+        const size_t i = frame.nextChildIndex++;
+        AstNode child = frame.children[i];
+
+        if ( !child.IsStorageInUse() )
         {
             LOG_ERROR_AND_THROW( "Trying to populate symbol table: AST node not storing any value.",
                                  std::runtime_error );
         }
+
+        // If child represents a sub-tree, traverse it before the rest of this node's children.
+        SymbolTable::Ptr childTable = Visit( child, frame.table, frame.parentNode, i );
+        if ( nullptr != childTable )
+        {
+            // Pushing may reallocate the stack, so the current frame must not be used after this.
+            frames.push_back( { childTable, child, GetSubTreeChildren( child ), 0u } );
+        }
     }
-}
\ No newline at end of file
+}
+
+/**
+ * \brief  Checks an identifier being read from or written to has been declared, and marks its entry accordingly.
+ *
+ * \param[in]  node        The identifier node.
+ * \param[in]  table       The symbol table of the current scope.
+ * \param[in]  parentNode  Parent of the identifier node, e.g. an assignment. Nullptr if it has no parent.
+ * \param[in]  childIndex  Position of the identifier node in its parent's children.
+ *
+ * \return  Nullptr, as the node has no sub-tree.
+ */
+SymbolTable::Ptr
+SymbolTableGenerator::VisitNode(
+    AstLabel< T::IDENTIFIER >,
+    AstNode node,
+    const SymbolTable::Ptr& table,
+    AstNode parentNode,
+    size_t childIndex
+)
+{
+    const TokenValue& identifier = node.GetToken().m_value;
+    SymbolTableEntry* entry = table->GetEntryIfExists( identifier.GetIdentifierId() );
+    // If on left side of assignment, it's a write operation
+    if ( nullptr != parentNode && TokenType::ASSIGN == parentNode.GetNodeLabel() && 0u == childIndex )
+    {
+        // Because this is an identifier and not a (data type + identifier), we expect there to already an entry.
+        if ( nullptr == entry )
+        {
+            LOG_ERROR_AND_THROW( "Trying to write to undeclared identifier: '"
+                                 + std::string( identifier.GetStringValue() ) + "'", std::runtime_error );
+        }
+
+        entry->isWrittenTo = true;
+    }
+    // Else it's a read operation
+    else
+    {
+        // Read operation expects an entry to exist
+        if ( nullptr == entry )
+        {
+            LOG_ERROR_AND_THROW( "Trying to read from undeclared identifier: '"
+                                 + std::string( identifier.GetStringValue() ) + "'", std::runtime_error );
+        }
+
+        entry->isReadFrom = true;
+    }
+    return nullptr;
+}
+
+/**
+ * \brief  Adds an entry for a variable being declared. A "variable" rule node still represents a single identifier.
+ *
+ * \param[in]  node   The variable node.
+ * \param[in]  table  The symbol table of the current scope.
+ *
+ * \return  Nullptr, as the node's children have been handled.
+ */
+SymbolTable::Ptr
+SymbolTableGenerator::VisitNode(
+    AstLabel< NT::Variable >,
+    AstNode node,
+    const SymbolTable::Ptr& table,
+    AstNode,
+    size_t
+)
+{
+    AstNode::ChildRange variableChildren = node.GetChildren();
+    // Get rightmost child to get identifier node. With two children this should be 2.
+    if ( 2u != variableChildren.size() )
+    {
+        LOG_ERROR_AND_THROW( "Encountered 'variable' rule node with unexpected number of children: "
+                             + std::to_string( variableChildren.size() ), std::runtime_error );
+    }
+    AstNode idNode = variableChildren[1];
+    const TokenValue& identifier = idNode.GetToken().m_value;
+
+    // Expect no existing entry as it is being declared
+    if ( nullptr != table->GetEntryIfExists( identifier.GetIdentifierId() ) )
+    {
+        LOG_ERROR_AND_THROW( "Trying to re-declare existing variable: '" + std::string( identifier.GetStringValue() )
+                             + "'", std::runtime_error );
+    }
+
+    // Create new entry and add to table
+    AstNode dataTypeNode = variableChildren[0];
+    DataType dataType = dataTypeNode.GetToken().m_value.m_value.dataTypeValue;
+
+    SymbolTableEntry entry;
+    entry.dataType = dataType;
+    table->AddEntry( identifier.GetIdentifierId(), entry );
+    return nullptr;
+}
+
+/**
+ * \brief  Any other token is ignored. Any other sub-tree is traversed: if it is scope-defining, a new table is created
+ *         for it, otherwise it continues populating the current table.
+ *
+ * \param[in]  node   The node being checked.
+ * \param[in]  table  The symbol table of the current scope.
+ *
+ * \return  The table to populate from the node's sub-tree, or nullptr if it has none.
+ */
+SymbolTable::Ptr
+SymbolTableGenerator::VisitUnhandled(
+    AstNode node,
+    const SymbolTable::Ptr& table,
+    AstNode,
+    size_t
+)
+{
+    if ( node.IsStoringToken() )
+    {
+        return nullptr;
+    }
+    if ( node.IsScopeDefiningNode() )
+    {
+        SymbolTable::Ptr childTable = std::make_shared< SymbolTable >( table );
+        node.GetArena()->SetSymbolTable( node, childTable );
+        return childTable;
+    }
+    return table;
+}
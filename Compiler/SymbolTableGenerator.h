@@ -6,9 +6,12 @@
 #pragma once
 
 #include "SymbolTable.h"
-#include "AstNode.h"
+#include "AstVisitor.h"
+
+#include <vector>
 
 class SymbolTableGenerator
+    : private AstVisitor< SymbolTableGenerator, SymbolTable::Ptr, const SymbolTable::Ptr&, AstNode, size_t >
 {
 public:
     using UPtr = std::unique_ptr< SymbolTableGenerator >;
@@ -16,10 +19,32 @@ public:
 
     SymbolTableGenerator() = default;
 
-    void GenerateSymbolTableForAst( AstNode::Ptr treeRootNode );
+    void GenerateSymbolTableForAst( AstNode treeRootNode );
+    void PopulateTableFromNode( SymbolTable::Ptr table, AstNode node );
 
 private:
-    void CreateTableForAstFromParent( SymbolTable::Ptr parentTable, AstNode::Ptr treeRootNode );
+    friend class AstVisitor< SymbolTableGenerator, SymbolTable::Ptr, const SymbolTable::Ptr&, AstNode, size_t >;
+
+    // Labels of the nodes which add to or check a symbol table. All other sub-tree nodes are traversed.
+    using HandledLabels = AstLabelList< T::IDENTIFIER, NT::Variable >;
+
+    // A sub-tree being traversed while populating a symbol table, and how far through its children the traversal is.
+    struct SubTreeFrame
+    {
+        SymbolTable::Ptr table;
+        AstNode parentNode;
+        AstNode::ChildRange children;
+        size_t nextChildIndex;
+    };
+
+    void CreateTableForAstFromParent( SymbolTable::Ptr parentTable, AstNode treeRootNode );
+
+    void PopulateTableFromSubTree( SymbolTable::Ptr table, AstNode parentNode );
 
-    void PopulateTableFromSubTree( SymbolTable::Ptr table, AstNode::Ptr parentNode );
+    SymbolTable::Ptr VisitNode( AstLabel< T::IDENTIFIER >, AstNode node, const SymbolTable::Ptr& table,
+                                AstNode parentNode, size_t childIndex );
+    SymbolTable::Ptr VisitNode( AstLabel< NT::Variable >, AstNode node, const SymbolTable::Ptr& table,
+                                AstNode parentNode, size_t childIndex );
+    SymbolTable::Ptr VisitUnhandled( AstNode node, const SymbolTable::Ptr& table, AstNode parentNode,
+                                     size_t childIndex );
 };
\ No newline at end of file
@@ -56,30 +56,30 @@ TacExpressionGenerator::Multiply(
 
     // Temp vars declarations
 
-    std::string result = m_instructionFactory->GetNewTempVar( "multResult" );
+    VarId result = m_instructionFactory->GetNewTempVar( "multResult" );
     constexpr uint8_t resultInit{ 0u };
     m_instructionFactory->AddAssignmentInstruction( result, resultInit );
 
     // Copy operands into new temp vars because the values are edited.
-    std::string multiplier = m_instructionFactory->GetNewTempVar( "multiplier" );
+    VarId multiplier = m_instructionFactory->GetNewTempVar( "multiplier" );
     m_instructionFactory->AddAssignmentInstruction( multiplier, op1 );
-    std::string multiplicand = m_instructionFactory->GetNewTempVar( "multiplicand" );
+    VarId multiplicand = m_instructionFactory->GetNewTempVar( "multiplicand" );
     m_instructionFactory->AddAssignmentInstruction( multiplicand, op2 );
 
-    std::string bitCounter = m_instructionFactory->GetNewTempVar( "bitCounter" );
+    VarId bitCounter = m_instructionFactory->GetNewTempVar( "bitCounter" );
     constexpr uint8_t bitCtInit{ 8u }; // 8 bits in a byte, which is our current supported literal length.
     m_instructionFactory->AddAssignmentInstruction( bitCounter, bitCtInit );
 
 
     // Main loop
-    std::string mainLoopLabel = m_instructionFactory->GetNewLabel( "multLoop" );
+    LabelId mainLoopLabel = m_instructionFactory->GetNewLabel( "multLoop" );
     m_instructionFactory->SetNextInstructionLabel( mainLoopLabel );
-    std::string lsb = m_instructionFactory->GetNewTempVar( "lsb" ); // Use bitmask to retrieve the LSB, in bit form.
+    VarId lsb = m_instructionFactory->GetNewTempVar( "lsb" ); // Use bitmask to retrieve the LSB, in bit form.
     constexpr uint8_t lsbBitmask{ 0xfe };
     m_instructionFactory->AddInstruction( lsb, Opcode::AND, multiplier, lsbBitmask );
 
-    std::string shiftLabel = m_instructionFactory->GetNewLabel( "shift" );
-    m_instructionFactory->AddInstruction( shiftLabel, Opcode::BRE, lsb, 0u );
+    LabelId shiftLabel = m_instructionFactory->GetNewLabel( "shift" );
+    m_instructionFactory->AddBranchInstruction( shiftLabel, Opcode::BRE, lsb, 0u );
 
     m_instructionFactory->AddInstruction( result, Opcode::ADD, result, multiplicand );
 
@@ -91,7 +91,7 @@ TacExpressionGenerator::Multiply(
     constexpr uint8_t decrement{ 1u };
     m_instructionFactory->AddInstruction( bitCounter, Opcode::SUB, bitCounter, decrement );
 
-    m_instructionFactory->AddInstruction( mainLoopLabel, Opcode::BRLT, 0u, bitCounter );
+    m_instructionFactory->AddBranchInstruction( mainLoopLabel, Opcode::BRLT, 0u, bitCounter );
 
     return result;
 }
@@ -160,8 +160,10 @@ TacExpressionGenerator::AddDivModInstructions(
         Literal value2{ std::get< Literal >( op2 ) };
         if ( 0u == value2 )
         {
-            std::string value1String = std::holds_alternative< Literal >( op1 )
-                                       ? std::to_string( std::get< Literal >( op1 ) ) : std::get< std::string >( op1 );
+            std::string value1String
+                = std::holds_alternative< Literal >( op1 )
+                  ? std::to_string( std::get< Literal >( op1 ) )
+                  : "variable " + std::to_string( static_cast< uint32_t >( std::get< VarId >( op1 ) ) );
             std::string operation = ( DivMod::MOD == returnType ) ? " % " : " / ";
             LOG_ERROR_AND_THROW( "Division by zero not allowed: " + value1String + operation
                 + std::to_string( value2 ), std::invalid_argument );
@@ -205,31 +207,31 @@ TacExpressionGenerator::AddDivModInstructions(
 
     // Temp vars declarations
 
-    std::string result = m_instructionFactory->GetNewTempVar( "divResult" );
+    VarId result = m_instructionFactory->GetNewTempVar( "divResult" );
     constexpr uint8_t resultInit{ 0u };
     m_instructionFactory->AddAssignmentInstruction( result, resultInit );
 
     // Copy operands into new temp vars because the values are edited.
-    std::string dividend = m_instructionFactory->GetNewTempVar( "dividend" );
+    VarId dividend = m_instructionFactory->GetNewTempVar( "dividend" );
     m_instructionFactory->AddAssignmentInstruction( dividend, op1 );
-    std::string quotient = m_instructionFactory->GetNewTempVar( "quotient" );
+    VarId quotient = m_instructionFactory->GetNewTempVar( "quotient" );
     m_instructionFactory->AddAssignmentInstruction( quotient, op2 );
 
 
     // Main loop
-    std::string mainLoopLabel = m_instructionFactory->GetNewLabel( "divLoop" );
+    LabelId mainLoopLabel = m_instructionFactory->GetNewLabel( "divLoop" );
     m_instructionFactory->SetNextInstructionLabel( mainLoopLabel );
 
-    m_instructionFactory->AddInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, dividend, quotient );
-    // Retrieve pointer to this instruction to replace the target label at the end.
-    ThreeAddrInstruction::Ptr branchToEndInstr = m_instructionFactory->GetLatestInstruction();
+    m_instructionFactory->AddBranchInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, dividend, quotient );
+    // Retrieve index of this instruction to replace the target label at the end.
+    size_t branchToEndInstr = m_instructionFactory->GetLatestInstructionIndex();
 
     constexpr uint8_t increment{ 1u };
     m_instructionFactory->AddInstruction( result, Opcode::ADD, result, increment );
     m_instructionFactory->AddInstruction( dividend, Opcode::SUB, dividend, quotient );
 
     // Unconditional branch
-    m_instructionFactory->AddInstruction( mainLoopLabel, Opcode::BRE, result, result );
+    m_instructionFactory->AddBranchInstruction( mainLoopLabel, Opcode::BRE, result, result );
 
     m_instructionFactory->SetInstructionBranchToNextLabel( branchToEndInstr, "divModEnd" );
 
@@ -244,7 +246,7 @@ TacExpressionGenerator::AddDivModInstructions(
     LOG_ERROR_AND_THROW( "Unknown return specifier: can only be DIV or MOD. Value = " + std::to_string( returnType ),
                          std::invalid_argument );
 
-    return ""; // This is never reached, but used to satisfy compiler warning.
+    return g_invalidVarId; // This is never reached, but used to satisfy compiler warning.
 }
 
 /**
@@ -581,11 +583,12 @@ TacExpressionGenerator::AddComparisonInstructions(
      * end:
      */
 
-    std::string result = m_instructionFactory->GetNewTempVar( resultName );
+    VarId result = m_instructionFactory->GetNewTempVar( resultName );
     m_instructionFactory->AddAssignmentInstruction( result, valueIfBranchTrue );
 
-    m_instructionFactory->AddInstruction( TacInstructionFactory::PLACEHOLDER, branchType, branchOperand1, branchOperand2 );
-    ThreeAddrInstruction::Ptr branchToEndInstr = m_instructionFactory->GetLatestInstruction();
+    m_instructionFactory->AddBranchInstruction( TacInstructionFactory::PLACEHOLDER, branchType, branchOperand1,
+                                                branchOperand2 );
+    size_t branchToEndInstr = m_instructionFactory->GetLatestInstructionIndex();
 
     bool branchTrueBool{ static_cast< bool >( valueIfBranchTrue ) };
     const uint8_t skippableValue{ !branchTrueBool };
@@ -667,14 +670,14 @@ TacExpressionGenerator::LogicalOr(
     const Literal valueIfBranchFalse{ 0u };
 
     const std::string resultName = "isGt";
-    std::string result = m_instructionFactory->GetNewTempVar( resultName );
+    VarId result = m_instructionFactory->GetNewTempVar( resultName );
     m_instructionFactory->AddAssignmentInstruction( result, valueIfBranchTrue );
 
     const Operand zeroOp{ 0u };
-    m_instructionFactory->AddInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, zeroOp, op1 );
-    ThreeAddrInstruction::Ptr branchToEnd1 = m_instructionFactory->GetLatestInstruction();
-    m_instructionFactory->AddInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, zeroOp, op2 );
-    ThreeAddrInstruction::Ptr branchToEnd2 = m_instructionFactory->GetLatestInstruction();
+    m_instructionFactory->AddBranchInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, zeroOp, op1 );
+    size_t branchToEnd1 = m_instructionFactory->GetLatestInstructionIndex();
+    m_instructionFactory->AddBranchInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, zeroOp, op2 );
+    size_t branchToEnd2 = m_instructionFactory->GetLatestInstructionIndex();
 
     m_instructionFactory->AddAssignmentInstruction( result, valueIfBranchFalse );
 
@@ -754,14 +757,14 @@ TacExpressionGenerator::LogicalAnd(
     const Literal valueIfBranchFalse{ 1u };
 
     const std::string resultName = "isGt";
-    std::string result = m_instructionFactory->GetNewTempVar( resultName );
+    VarId result = m_instructionFactory->GetNewTempVar( resultName );
     m_instructionFactory->AddAssignmentInstruction( result, valueIfBranchTrue );
 
     const Operand zeroOp{ 0u };
-    m_instructionFactory->AddInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, zeroOp, op1 );
-    ThreeAddrInstruction::Ptr branchToEnd1 = m_instructionFactory->GetLatestInstruction();
-    m_instructionFactory->AddInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, zeroOp, op2 );
-    ThreeAddrInstruction::Ptr branchToEnd2 = m_instructionFactory->GetLatestInstruction();
+    m_instructionFactory->AddBranchInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, zeroOp, op1 );
+    size_t branchToEnd1 = m_instructionFactory->GetLatestInstructionIndex();
+    m_instructionFactory->AddBranchInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, zeroOp, op2 );
+    size_t branchToEnd2 = m_instructionFactory->GetLatestInstructionIndex();
 
     m_instructionFactory->AddAssignmentInstruction( result, valueIfBranchFalse );
 
@@ -4,50 +4,76 @@
 
 #include "TacInstructionFactory.h"
 
-TacInstructionFactory::TacInstructionFactory()
-: m_tempVarsInUse( 0u ),
-  m_labelsInUse( 0u ),
-  m_nextInstrLabel( "" )
+/**
+ * Constructor for TacInstructionFactory.
+ *
+ * \param[in]  variableTable  Table to add temporary variables to. This should be the table of the program's symbols,
+ *                            so that temporaries don't share IDs with them. If null, a new table is created.
+ */
+TacInstructionFactory::TacInstructionFactory(
+    VariableTable::Ptr variableTable //= nullptr
+)
+: m_variableTable( nullptr == variableTable ? std::make_shared< VariableTable >() : variableTable ),
+  m_nextInstrLabel( g_invalidLabelId )
 {
 }
 
 /**
- * \brief  Gets identifier representing the next temporary variable available to use. Uses a counter to keep track
- *         of how many are currently in use.
+ * \brief  Gets the next temporary variable available to use, adding it to the variable table.
  *
- * \param[in]  hrfName  Optional identifier name to use in combination with the counter, to allow easier debugging.
+ * \param[in]  hrfName  Optional name to store alongside the variable, to allow easier debugging.
  *
- * \return  String identifier of the next available temporary variable.
+ * \return  ID of the next available temporary variable.
  */
-std::string
+VarId
 TacInstructionFactory::GetNewTempVar(
     std::string hrfName //= "temp"
 )
 {
-    // Use a naming convention that isn't allowed by the grammar, to avoid naming clashes. This doesn't matter
-    // at this point in compilation as any string is a valid representation.
-    std::string id = std::to_string( m_tempVarsInUse ) + hrfName;
-    ++m_tempVarsInUse;
-    return id;
+    return m_variableTable->AddVariable( hrfName );
 }
 
 /**
- * \brief  Gets a new unique branch label. Uses a counter to keep track of the next available number.
+ * \brief  Gets a new unique branch label. Labels are numbered in the order they are created.
  *
- * \param[in]  hrfName  Optional label name to use in combination with the counter, to allow easier debugging.
+ * \param[in]  hrfName  Optional name to store alongside the label, to allow easier debugging.
  *
- * \return  Unique label in string form.
+ * \return  ID of the new label.
  */
-std::string
+LabelId
 TacInstructionFactory::GetNewLabel(
     std::string hrfName //= "label"
 )
 {
-    std::string label = std::to_string( m_labelsInUse ) + hrfName;
-    ++m_labelsInUse;
+    if ( static_cast< size_t >( g_invalidLabelId ) <= m_labelNames.size() )
+    {
+        LOG_ERROR_AND_THROW( "Too many labels to add '" + hrfName + "'.", std::runtime_error );
+    }
+    LabelId label = static_cast< LabelId >( m_labelNames.size() );
+    m_labelNames.push_back( std::move( hrfName ) );
     return label;
 }
 
+/**
+ * \brief  Gets the name a label was created with, for debugging. Throws if the label wasn't created by this factory.
+ *
+ * \param[in]  label  ID of the label.
+ *
+ * \return  The name of the label.
+ */
+const std::string&
+TacInstructionFactory::GetLabelName(
+    LabelId label
+) const
+{
+    size_t index = static_cast< size_t >( label );
+    if ( index >= m_labelNames.size() )
+    {
+        LOG_ERROR_AND_THROW( "Unknown label ID " + std::to_string( index ), std::out_of_range );
+    }
+    return m_labelNames[index];
+}
+
 /**
  * \brief  Sets the next instruction label. This should only be called if one has not already been set.
  *
@@ -55,13 +81,14 @@ TacInstructionFactory::GetNewLabel(
  */
 void
 TacInstructionFactory::SetNextInstructionLabel(
-    const std::string& label
+    LabelId label
 )
 {
-    if ( "" != m_nextInstrLabel )
+    if ( g_invalidLabelId != m_nextInstrLabel )
     {
-        LOG_ERROR_AND_THROW( "Trying to set next instruction label '" + label + "' but it is already set '"
-                             + m_nextInstrLabel + "'.", std::runtime_error );
+        LOG_ERROR_AND_THROW( "Trying to set next instruction label "
+                             + std::to_string( static_cast< uint32_t >( label ) ) + " but it is already set "
+                             + std::to_string( static_cast< uint32_t >( m_nextInstrLabel ) ) + ".", std::runtime_error );
     }
     m_nextInstrLabel = label;
 }
@@ -71,152 +98,173 @@ TacInstructionFactory::SetNextInstructionLabel(
  *         temporary variable (zero is considered an invalid address in the target architecture, so loading address 0
  *         will automatically load value 0).
  *
- * \param[in]  target    String representing the identifier of the target of the operation. This could be the result
- *                       of a calculation, or a target branch label.
+ * \param[in]  target    The variable the result of the operation is stored in.
  * \param[in]  opcode    The opcode of the operation, determining what type of instruction it is.
- * \param[in]  operand1  The first operand in the instruction. Can be identifier or literal.
- * \param[in]  operand2  The second operand in the instruction. Can be identifier or literal.
+ * \param[in]  operand1  The first operand in the instruction. Can be variable or literal.
+ * \param[in]  operand2  The second operand in the instruction. Can be variable or literal.
  */
 void
 TacInstructionFactory::AddInstruction(
-    std::string target,
+    VarId target,
     Opcode opcode,
     Operand operand1,
     Operand operand2
 )
 {
-    std::string op1String;
-    std::string op2String;
+    std::pair< VarId, VarId > operandVars = GetOperandVars( operand1, operand2 );
 
-    if ( std::holds_alternative< Literal >( operand1 ) )
-    {
-        Literal value = std::get< Literal >( operand1 );
-        // If value is zero, we can leave the string empty, as this will be converted to zero in assembly form.
-        if ( 0u != value )
-        {
-            op1String = GetNewTempVar( "constLiteral" );
-            AddAssignmentInstruction( op1String, value );
-        }
-    }
-    else
+    m_instructions.emplace_back( target, opcode, operandVars.first, operandVars.second, m_nextInstrLabel );
+
+    m_nextInstrLabel = g_invalidLabelId;
+}
+
+/**
+ * \brief  Creates a new branch instruction and adds it to the stored collection. Replaces any non-zero literals with a
+ *         new temporary variable, as with \ref AddInstruction.
+ *
+ * \param[in]  target    The label to branch to. PLACEHOLDER if it isn't known yet.
+ * \param[in]  opcode    The branch opcode.
+ * \param[in]  operand1  The first operand in the comparison. Can be variable or literal.
+ * \param[in]  operand2  The second operand in the comparison. Can be variable or literal.
+ */
+void
+TacInstructionFactory::AddBranchInstruction(
+    LabelId target,
+    Opcode opcode,
+    Operand operand1,
+    Operand operand2
+)
+{
+    if ( !ThreeAddrInstruction::IsOpcodeBranch( opcode ) )
     {
-        op1String = std::get< std::string >( operand1 );
+        LOG_ERROR_AND_THROW( "Trying to add branch instruction with non-branch opcode: " + std::to_string( opcode ),
+                             std::invalid_argument );
     }
+    std::pair< VarId, VarId > operandVars = GetOperandVars( operand1, operand2 );
 
-    if ( std::holds_alternative< Literal >( operand2 ) )
-    {
-        Literal value = std::get< Literal >( operand2 );
-        if ( 0u != value )
+    m_instructions.emplace_back( target, opcode, operandVars.first, operandVars.second, m_nextInstrLabel );
+
+    m_nextInstrLabel = g_invalidLabelId;
+}
+
+/**
+ * \brief  Gets the variables holding the values of two operands. Any non-zero literals are assigned to a new temporary
+ *         variable first, and zero literals are left empty, as this will be converted to zero in assembly form.
+ *
+ * \param[in]  operand1  The first operand. Can be variable or literal.
+ * \param[in]  operand2  The second operand. Can be variable or literal.
+ *
+ * \return  The variables of the first and second operand. g_invalidVarId for an empty or zero operand.
+ */
+std::pair< VarId, VarId >
+TacInstructionFactory::GetOperandVars(
+    Operand operand1,
+    Operand operand2
+)
+{
+    auto getOperandVar = [ this ]( Operand operand ) {
+        if ( std::holds_alternative< VarId >( operand ) )
         {
-            op2String = GetNewTempVar( "constLiteral" );
-            AddAssignmentInstruction( op2String, value );
+            return std::get< VarId >( operand );
         }
-    }
-    else
-    {
-        op2String = std::get< std::string >( operand2 );
-    }
-
-    ThreeAddrInstruction::Ptr instr
-        = std::make_shared< ThreeAddrInstruction >( target, opcode, op1String, op2String, m_nextInstrLabel );
-    m_instructions.push_back( instr );
+        Literal value = std::get< Literal >( operand );
+        if ( 0u == value )
+        {
+            return g_invalidVarId;
+        }
+        VarId tempVar = GetNewTempVar( "constLiteral" );
+        AddAssignmentInstruction( tempVar, value );
+        return tempVar;
+    };
 
-    if ( "" != m_nextInstrLabel )
-    {
-        m_nextInstrLabel = "";
-    }
+    VarId operand1Var = getOperandVar( operand1 );
+    VarId operand2Var = getOperandVar( operand2 );
+    return std::make_pair( operand1Var, operand2Var );
 }
 
 /**
  * \brief  Creates a new single-operand instruction and adds it to the stored collection.
  *
- * \param[in]  target   String representing the identifier of the target of the operation. This could be the result
- *                      of a calculation, or a target branch label.
+ * \param[in]  target   The variable the result of the operation is stored in.
  * \param[in]  opcode   The opcode of the operation, determining what type of instruction it is.
- * \param[in]  operand  The operand in the instruction. Can be identifier or literal.
+ * \param[in]  operand  The operand in the instruction. Can be variable or literal.
  */
 void
 TacInstructionFactory::AddSingleOperandInstruction(
-    std::string target,
+    VarId target,
     Opcode opcode,
     Operand operand
 )
 {
-    AddInstruction( target, opcode, operand, "" );
+    AddInstruction( target, opcode, operand, g_invalidVarId );
 }
 
 /**
  * \brief  Creates a new instruction with no operands and adds it to the stored collection.
  *
- * \param[in]  target   String representing the identifier of the target of the operation. This could be the result
- *                      of a calculation, or a target branch label.
- * \param[in]  operand  The operand in the instruction. Can be identifier or literal.
+ * \param[in]  target   The variable being assigned to.
+ * \param[in]  operand  The operand in the instruction. Can be variable or literal.
  */
 void
 TacInstructionFactory::AddAssignmentInstruction(
-    std::string target,
+    VarId target,
     Operand operand
 )
 {
-    ThreeAddrInstruction::Ptr instr = std::make_shared< ThreeAddrInstruction >( target, operand, m_nextInstrLabel );
-    m_instructions.push_back( instr );
+    m_instructions.emplace_back( target, operand, m_nextInstrLabel );
 
-    if ( "" != m_nextInstrLabel )
-    {
-        m_nextInstrLabel = "";
-    }
+    m_nextInstrLabel = g_invalidLabelId;
 }
 
 /**
  * \brief  Replaces the target of a given branch instruction so that it points to the current 'next instruction'. If
  *         there is no configured next label, it creates one and assigns this.
  *
- * \param[in]  instruction       The branch instruction to redirect.
- * \param[in]  labelIfNotExists  If there isn't a next label, this is used as the HRF prompt for creating a new one.
+ * \param[in]  instructionIndex  Index of the branch instruction to redirect, as returned by
+ *                               \ref GetLatestInstructionIndex.
+ * \param[in]  labelIfNotExists  If there isn't a next label, this is used as the HRF name for creating a new one.
  */
 void
 TacInstructionFactory::SetInstructionBranchToNextLabel(
-    ThreeAddrInstruction::Ptr instruction,
+    size_t instructionIndex,
     std::string labelIfNotExists
 )
 {
-    if ( nullptr == instruction )
+    if ( instructionIndex >= m_instructions.size() )
     {
-        LOG_ERROR_AND_THROW( "Passed a nullptr instruction.", std::invalid_argument );
+        LOG_ERROR_AND_THROW( "Instruction index " + std::to_string( instructionIndex ) + " is out of range.",
+                             std::invalid_argument );
     }
-    if ( !instruction->IsOperation() )
-    {
-        LOG_ERROR_AND_THROW( "Method called on assignment instruction", std::invalid_argument );
-    }
-    Operation::Ptr rhsOperation = instruction->GetOperation();
-    if ( !ThreeAddrInstruction::IsOpcodeBranch( rhsOperation->opcode ) )
+    // Only hold the reference while no instructions are added, as adding may reallocate the storage.
+    ThreeAddrInstruction& instruction = m_instructions[instructionIndex];
+    if ( !ThreeAddrInstruction::IsOpcodeBranch( instruction.m_opcode ) )
     {
         LOG_ERROR_AND_THROW( "This method can only be called on a branch instruction. Opcode: "
-                             + std::to_string( rhsOperation->opcode ), std::invalid_argument );
+                             + std::to_string( instruction.m_opcode ), std::invalid_argument );
     }
 
-    if ( "" == m_nextInstrLabel )
+    if ( g_invalidLabelId == m_nextInstrLabel )
     {
-        std::string endLabel = GetNewLabel( labelIfNotExists );
-        m_nextInstrLabel = endLabel;
+        m_nextInstrLabel = GetNewLabel( labelIfNotExists );
     }
 
-    instruction->m_target = m_nextInstrLabel;
+    instruction.m_branchTarget = m_nextInstrLabel;
 }
 
 /**
- * \brief  Returns the most recently added instruction pointer.
+ * \brief  Returns the index of the most recently added instruction. Indexes stay valid as more instructions are added,
+ *         unlike references into the storage.
  *
- * \return  The latest instruction pointer.
+ * \return  The latest instruction index.
  */
-ThreeAddrInstruction::Ptr
-TacInstructionFactory::GetLatestInstruction()
+size_t
+TacInstructionFactory::GetLatestInstructionIndex()
 {
     if ( m_instructions.empty() )
     {
         LOG_ERROR_AND_THROW( "Trying to access latest instruction from empty collection.", std::runtime_error );
     }
-    return m_instructions.back();
+    return m_instructions.size() - 1u;
 }
 
 /**
@@ -225,15 +273,15 @@ TacInstructionFactory::GetLatestInstruction()
  *
  * \return  The stored instructions.
  */
-TacInstructionFactory::Instructions
+const TacInstructionFactory::Instructions&
 TacInstructionFactory::GetInstructions()
 {
     // If the 'next instruction label' is set, add a filler instruction with this label so that previous instructions
     // have this label to branch to.
-    if ( "" != m_nextInstrLabel )
+    if ( g_invalidLabelId != m_nextInstrLabel )
     {
-        std::string tempVar = GetNewTempVar();
-        AddAssignmentInstruction( tempVar, 0u );
+        VarId tempVar = GetNewTempVar();
+        AddAssignmentInstruction( tempVar, Literal{ 0u } );
     }
     return m_instructions;
-}
\ No newline at end of file
+}
@@ -13,36 +13,42 @@ class TacInstructionFactory
 {
 public:
     using Ptr = std::shared_ptr< TacInstructionFactory >;
-    using Instructions = std::vector< ThreeAddrInstruction::Ptr >;
+    // Instructions are stored by value, contiguously, in the order they are added.
+    using Instructions = std::vector< ThreeAddrInstruction >;
 
-    TacInstructionFactory();
+    TacInstructionFactory( VariableTable::Ptr variableTable = nullptr );
 
-    virtual std::string GetNewTempVar( std::string hrfName = "temp" );
-    virtual std::string GetNewLabel( std::string hrfName = "label" );
+    virtual VarId GetNewTempVar( std::string hrfName = "temp" );
+    virtual LabelId GetNewLabel( std::string hrfName = "label" );
 
-    virtual void SetNextInstructionLabel( const std::string& label );
+    virtual void SetNextInstructionLabel( LabelId label );
 
-    virtual void AddInstruction( std::string target, Opcode opcode, Operand operand1, Operand operand2 );
-    virtual void AddSingleOperandInstruction( std::string target, Opcode opcode, Operand operand );
-    virtual void AddAssignmentInstruction( std::string target, Operand operand );
+    virtual void AddInstruction( VarId target, Opcode opcode, Operand operand1, Operand operand2 );
+    virtual void AddBranchInstruction( LabelId target, Opcode opcode, Operand operand1, Operand operand2 );
+    virtual void AddSingleOperandInstruction( VarId target, Opcode opcode, Operand operand );
+    virtual void AddAssignmentInstruction( VarId target, Operand operand );
 
-    virtual void SetInstructionBranchToNextLabel( ThreeAddrInstruction::Ptr instruction, std::string labelIfNotExists );
+    virtual void SetInstructionBranchToNextLabel( size_t instructionIndex, std::string labelIfNotExists );
 
-    virtual ThreeAddrInstruction::Ptr GetLatestInstruction();
-    virtual Instructions GetInstructions();
+    virtual size_t GetLatestInstructionIndex();
+    virtual const Instructions& GetInstructions();
 
-    // There is no chance of this accidentally being used by a real value, as all vars/labels have numbers in their
-    // UUIDs.
-    static inline const std::string PLACEHOLDER = "PLACEHOLDER";
+    const VariableTable::Ptr& GetVariableTable() const { return m_variableTable; }
+    const std::string& GetLabelName( LabelId label ) const;
+
+    // Target of a branch whose label isn't known yet. It is never allocated to a real label.
+    static constexpr LabelId PLACEHOLDER = g_invalidLabelId;
 
 protected:
+    std::pair< VarId, VarId > GetOperandVars( Operand operand1, Operand operand2 );
+
     // Storage of created instructions.
     Instructions m_instructions;
 
-    // Counter of the number of temporary variables currently in use.
-    size_t m_tempVarsInUse;
-    // Counter of the number of branch labels currently in use.
-    size_t m_labelsInUse;
-    // If non-empty, stores the value of the label to be attached to the next created instruction.
-    std::string m_nextInstrLabel;
+    // Table that temporary variables are added to, shared with the symbol tables of the program.
+    VariableTable::Ptr m_variableTable;
+    // The name of each branch label, indexed by ID, for easier debugging.
+    std::vector< std::string > m_labelNames;
+    // If valid, stores the label to be attached to the next created instruction.
+    LabelId m_nextInstrLabel;
 };
\ No newline at end of file
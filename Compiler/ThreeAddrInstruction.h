@@ -4,13 +4,15 @@
 
 #pragma once
 
-#include <string>
+#include <cstdint>
+#include <limits>
 #include <variant>
 #include <unordered_map>
-#include <memory>
 #include <stdexcept>
+#include <type_traits>
 
 #include "Grammar.h"
+#include "VariableTable.h"
 
 namespace TAC
 {
@@ -19,10 +21,11 @@ namespace TAC
     using Literal = uint8_t;
 
     // Opcodes of the intermediate representation - this is similar to the target assembly language, but removes the
-    // concept of load-store, as this is a level higher.
-    enum Opcode
+    // concept of load-store, as this is a level higher. Stored as a single byte to keep instructions compact.
+    enum Opcode : uint8_t
     {
         INVALID,
+        ASSIGN, // Copy a single variable or literal into the target
         ADD,
         SUB,
         AND,  // Bitwise and
@@ -43,96 +46,128 @@ namespace TAC
         { GrammarSymbols::T::RSHIFT, Opcode::RS }
     };
 
-    // Operand can either be a string identifier (empty string to represent no value), or a numeric value.
-    using Operand = std::variant< std::string, Literal >;
+    // Dense ID representing a branch label. IDs are allocated in order from 0 by the instruction factory.
+    enum class LabelId : uint32_t {};
 
-    /**
-     * \brief  Represents a RHS of an instruction in the case that an operation is being performed. This consists of
-     *         an opcode and 2 identifier strings (can be left empty to represent no value).
-     */
-    struct Operation
-    {
-        using Ptr = std::shared_ptr< Operation >;
-
-        Operation( Opcode operationCode, std::string op1, std::string op2 )
-        : opcode( operationCode ), operand1( op1 ), operand2( op2 )
-        {
-        }
-
-        Opcode opcode;
-        std::string operand1;
-        std::string operand2;
-    };
+    // Represents the absence of a label, e.g. an instruction that isn't branched to.
+    constexpr LabelId g_invalidLabelId{ std::numeric_limits< uint32_t >::max() };
 
-    // The right hand side of an instruction can either be a single operand (identifier or literal), or an opcode with
-    // two operands (i.e., an operation that is being performed).
-    using RHS = std::variant< Operand, Operation::Ptr >;
+    // Operand can either be a variable (g_invalidVarId to represent no value), or a numeric value.
+    using Operand = std::variant< VarId, Literal >;
 
     /**
      * \brief  Represents an instruction in three-address code. Stores the result of an operation, the operation type,
-     *         and up to two operands. The target and opcode may be unused in the case of branches and assignment
-     *         respectively. For this intermediate representation, identifier strings are still used, and registers/
-     *         memory are not considered.
+     *         and up to two operands. The target is a branch label in the case of branches, and an assignment copies
+     *         a single variable or literal. For this intermediate representation, variables are referred to by ID, and
+     *         registers/memory are not considered.
+     *
+     *         Instructions are small, trivially copyable records, so that they can be stored contiguously and passed
+     *         around by value. Anything variable-length, e.g. names, is kept in side tables and referred to by ID.
      */
     struct ThreeAddrInstruction
     {
-        using Ptr = std::shared_ptr< ThreeAddrInstruction >;
+        // Bit flags describing how to interpret the fields of the instruction.
+        enum Flags : uint8_t
+        {
+            FLAG_NONE = 0u,
+            FLAG_LITERAL_RHS = 1u << 0u, // The value of an assignment is m_literal rather than m_operand1
+        };
 
         ThreeAddrInstruction(
-            std::string target,
+            VarId target,
             Opcode opcode,
-            std::string operand1,
-            std::string operand2,
-            std::string label = "" // Only used if instruction has label attached
+            VarId operand1,
+            VarId operand2,
+            LabelId label = g_invalidLabelId // Only used if instruction has label attached
         )
         : m_target( target ),
-          m_label( label )
+          m_operand1( operand1 ),
+          m_operand2( operand2 ),
+          m_branchTarget( g_invalidLabelId ),
+          m_label( label ),
+          m_opcode( opcode ),
+          m_flags( FLAG_NONE ),
+          m_literal( 0u )
+        {
+        }
+
+        // Overloaded constructor for branch instructions, which target a label rather than a variable.
+        ThreeAddrInstruction(
+            LabelId branchTarget,
+            Opcode opcode,
+            VarId operand1,
+            VarId operand2,
+            LabelId label = g_invalidLabelId // Only used if instruction has label attached
+        )
+        : m_target( g_invalidVarId ),
+          m_operand1( operand1 ),
+          m_operand2( operand2 ),
+          m_branchTarget( branchTarget ),
+          m_label( label ),
+          m_opcode( opcode ),
+          m_flags( FLAG_NONE ),
+          m_literal( 0u )
         {
-            m_rhs = std::make_shared< Operation >( opcode, operand1, operand2 );
         }
 
         // Overloaded constructor for assignment instructions with a single RHS value.
         ThreeAddrInstruction(
-            std::string target,
+            VarId target,
             Operand value,
-            std::string label = "" // Only used if instruction has label attached
+            LabelId label = g_invalidLabelId // Only used if instruction has label attached
         )
         : m_target( target ),
-          m_label( label )
+          m_operand1( g_invalidVarId ),
+          m_operand2( g_invalidVarId ),
+          m_branchTarget( g_invalidLabelId ),
+          m_label( label ),
+          m_opcode( Opcode::ASSIGN ),
+          m_flags( FLAG_NONE ),
+          m_literal( 0u )
         {
-            m_rhs = value;
+            if ( std::holds_alternative< Literal >( value ) )
+            {
+                m_flags = FLAG_LITERAL_RHS;
+                m_literal = std::get< Literal >( value );
+            }
+            else
+            {
+                m_operand1 = std::get< VarId >( value );
+            }
         }
 
-        bool IsOperation()
+        bool IsOperation() const
         {
-            return std::holds_alternative< Operation::Ptr >( m_rhs );
+            return Opcode::ASSIGN != m_opcode;
         }
-        Operation::Ptr GetOperation()
+        /**
+         * \brief  Gets the value copied by an assignment instruction.
+         *
+         * \return  The literal or variable being assigned.
+         */
+        Operand GetAssignedValue() const
         {
-            if ( !IsOperation() )
+            if ( IsOperation() )
             {
-                throw std::invalid_argument( "Can only be called on operation type." );
+                throw std::invalid_argument( "Can only be called on assignment type." );
             }
-            return std::get< Operation::Ptr >( m_rhs );
+            if ( m_flags & FLAG_LITERAL_RHS )
+            {
+                return m_literal;
+            }
+            return m_operand1;
         }
 
         /**
-         * \brief  Determines if operand contains empty string or not.
+         * \brief  Determines if operand is empty or not.
          *
          * \param[in]  operand  The operand being checked.
          *
-         * \return  True if the operand is holding an empty string, false otherwise.
+         * \return  True if the operand is holding no variable, false otherwise.
          */
         static bool IsOperandEmpty( Operand operand )
         {
-            if ( std::holds_alternative< std::string >( operand ) )
-            {
-                if ( "" == std::get< std::string >( operand ) )
-                {
-                    return true;
-                }
-            }
-            return false;
+            return std::holds_alternative< VarId >( operand ) && g_invalidVarId == std::get< VarId >( operand );
         }
         /**
          * \brief  Determines if opcode is a branch type.
@@ -146,14 +181,26 @@ namespace TAC
             return Opcode::BRE == opcode || Opcode::BRLT == opcode;
         }
 
-        // The target of the operation, i.e. where the result will be stored.
-        std::string m_target;
-
-        // The right hand side of the instruction - either a single operand or an operation.
-        RHS m_rhs;
+        // The target of the operation, i.e. where the result will be stored. g_invalidVarId for branches.
+        VarId m_target;
+        // The operands of an operation. For an assignment, operand 1 is the variable being copied (unless the value is
+        // a literal), and operand 2 is unused. g_invalidVarId represents no value.
+        VarId m_operand1;
+        VarId m_operand2;
 
+        // The label a branch instruction jumps to. g_invalidLabelId for any other instruction.
+        LabelId m_branchTarget;
         // Optional label assigned to this instruction.
-        std::string m_label;
+        LabelId m_label;
+
+        Opcode m_opcode;
+        // Combination of Flags values.
+        uint8_t m_flags;
+        // The value of an assignment, if FLAG_LITERAL_RHS is set.
+        Literal m_literal;
     };
 
+    static_assert( std::is_trivially_copyable_v< ThreeAddrInstruction >, "TAC instructions should be plain records." );
+    static_assert( sizeof( ThreeAddrInstruction ) <= 24u, "TAC instructions should stay compact." );
+
 } // namespace TAC
\ No newline at end of file
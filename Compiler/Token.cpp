@@ -8,11 +8,11 @@
 using namespace TokenTypes;
 
 Token::Token( TokenType type )
-: Token( type, std::make_shared< TokenValue >() )
+: m_type( type )
 {
 }
 
-Token::Token( TokenType type, TokenValue::Ptr value )
+Token::Token( TokenType type, TokenValue value )
 : m_type( type ),
   m_value( value )
 {
@@ -20,45 +20,60 @@ Token::Token( TokenType type, TokenValue::Ptr value )
 
 Token::Token( TokenType type, uint8_t numericValue )
 : m_type( type ),
-  m_value( std::make_shared< TokenValue >( numericValue ) )
+  m_value( numericValue )
 {
 }
-Token::Token( TokenType type, std::string stringValue )
+Token::Token( TokenType type, std::string_view stringValue )
 : m_type( type ),
-  m_value( std::make_shared< TokenValue >( stringValue ) )
+  m_value( stringValue )
 {
 }
 Token::Token( TokenType type, DataType dataTypeValue )
 : m_type( type ),
-  m_value( std::make_shared< TokenValue >( dataTypeValue ) )
+  m_value( dataTypeValue )
 {
 }
 
+/**
+ * Converts token into human-readable string form, looking up identifiers in the shared identifier table.
+ *
+ * \return String form of token.
+ */
+std::string
+Token::ToString() const
+{
+    return ToString( *IdentifierTable::GetInstance() );
+}
+
 /**
  * Converts token into human-readable string form.
  *
+ * \param[in]  identifierTable  The table the token's identifier, if it has one, was interned into.
+ *
  * \return String form of token.
  */
 std::string
-Token::ToString()
+Token::ToString(
+    const IdentifierTable& identifierTable
+) const
 {
     std::string outputStr;
     outputStr += TokenTypes::ConvertTokenTypeToString( m_type );
 
-    if ( TokenValueType::UNUSED != m_value->m_valueType )
+    if ( TokenValueType::UNUSED != m_value.m_valueType )
     {
         outputStr += ":";
-        if ( TokenValueType::NUMERIC == m_value->m_valueType )
+        if ( TokenValueType::NUMERIC == m_value.m_valueType )
         {
-            outputStr += std::to_string( m_value->m_value.numericValue );
+            outputStr += std::to_string( m_value.m_value.numericValue );
         }
-        else if ( TokenValueType::STRING == m_value->m_valueType )
+        else if ( TokenValueType::STRING == m_value.m_valueType )
         {
-            outputStr +=  m_value->m_value.stringValue;
+            outputStr += identifierTable.GetName( m_value.GetIdentifierId() );
         }
-        else if ( TokenValueType::DTYPE == m_value->m_valueType )
+        else if ( TokenValueType::DTYPE == m_value.m_valueType )
         {
-            if ( DataType::DT_BYTE == m_value->m_value.dataTypeValue )
+            if ( DataType::DT_BYTE == m_value.m_value.dataTypeValue )
             {
                 outputStr += "byte";
             }
@@ -104,7 +119,7 @@ Token::ConvertTokensToString(
     {
         if ( tokens.size() > i )
         {
-            tokensString += tokens[i]->ToString();
+            tokensString += tokens[i].ToString();
             // If not the last element in string, add comma and space
             if ( i < startIndex + numTokens - 1u)
             {
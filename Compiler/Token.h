@@ -6,40 +6,39 @@
 
 #include "TokenTypes.h"
 #include <stdint.h>
-#include <memory>
-#include <deque>
+#include <vector>
 
 using namespace TokenTypes;
 
 /**
- * Token class.
+ * Token class. Tokens are small enough to be stored and passed by value.
  */
 class Token
 {
 public:
-    using Ptr = std::shared_ptr<Token>;
-
-    Token( TokenType type );
-    Token( TokenType type, TokenValue::Ptr value );
+    Token( TokenType type = TokenType::INVALID_TOKEN );
+    Token( TokenType type, TokenValue value );
     Token( TokenType type, uint8_t numericValue );
-    Token( TokenType type, std::string stringValue );
+    Token( TokenType type, std::string_view stringValue );
     Token( TokenType type, DataType dataTypeValue );
 
-    std::string ToString();
+    std::string ToString() const;
+    std::string ToString( const IdentifierTable& identifierTable ) const;
 
-    static std::string ConvertTokensToString( const std::deque< Token::Ptr >& tokens, size_t startIndex, size_t numTokens );
+    static std::string ConvertTokensToString( const std::vector< Token >& tokens, size_t startIndex, size_t numTokens );
 
     TokenType m_type;
 
     // Contains token value - e.g. if type is identifier, this would contain the variable name.
     // If the token represents a constant literal number, this would contain the number.
-    TokenValue::Ptr m_value;
+    TokenValue m_value;
 
     bool
     operator==( const Token& comparisonToken ) const
     {
-        return comparisonToken.m_type == m_type && *comparisonToken.m_value.get() == *m_value.get();
+        return comparisonToken.m_type == m_type && comparisonToken.m_value == m_value;
     }
 };
 
-using Tokens = std::deque< Token::Ptr >;
\ No newline at end of file
+// Tokens are stored contiguously, so they can be indexed without any pointer chasing.
+using Tokens = std::vector< Token >;
\ No newline at end of file
@@ -17,12 +17,12 @@ TokenTypes::ConvertTokenTypeToString (
 )
 {
     // If token type is an exact match to a string, use this
-    std::unordered_map< std::string,TokenType >::const_iterator iter;
+    std::unordered_map< std::string_view, TokenType >::const_iterator iter;
     for ( iter = g_tokenTypesExactMatches.begin(); iter != g_tokenTypesExactMatches.end(); ++iter )
     {
         if ( type == iter->second )
         {
-            return iter->first;
+            return std::string( iter->first );
         }
     }
 
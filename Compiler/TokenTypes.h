@@ -6,6 +6,7 @@
 
 #include <unordered_map>
 #include <string>
+#include <string_view>
 
 #include "TokenValue.h"
 #include "Logger.h"
@@ -16,8 +17,9 @@ namespace TokenTypes
 using namespace GrammarSymbols;
 using TokenType = T;
 
-// Contains the exact string matches (if they exist) of token types.
-const std::unordered_map<std::string, TokenType> g_tokenTypesExactMatches {
+// Contains the exact string matches (if they exist) of token types. Keyed by views of string literals, so that tokens
+// (which are views of the source) can be looked up without copying.
+const std::unordered_map<std::string_view, TokenType> g_tokenTypesExactMatches {
     // DATA_TYPE -> Non-exact match
     { "=", ASSIGN },
     // BYTE -> Non-exact match
@@ -59,7 +61,7 @@ const std::unordered_map<TokenType, TokenValueType> g_tokenValueTypes {
 };
 
 // Contains the mappings of data type token strings.
-const std::unordered_map<std::string, DataType> g_dataTypeStrings {
+const std::unordered_map<std::string_view, DataType> g_dataTypeStrings {
     { "byte", DataType::DT_BYTE },
 };
 
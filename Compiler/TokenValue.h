@@ -3,15 +3,13 @@
  */
 
 #pragma once
-#include <memory>
-#include <string>
+#include <string_view>
+#include <cstdint>
 
 #include "Grammar.h"
+#include "IdentifierTable.h"
 
-// Max length that a string value held by the token can be.
-constexpr size_t g_tokenStrValueMaxLen{ 32u };
-
-enum TokenValueType // The type of value being stored
+enum TokenValueType : uint8_t // The type of value being stored
 {
     UNUSED, // The token value is not holding anything
     NUMERIC,
@@ -25,12 +23,12 @@ enum DataType // Supported data types
 };
 
 /**
- * Optional value stored by a token - can be numeric or a string.
+ * Optional value stored by a token - can be numeric, a data type, or a string.
+ * String values are interned in the shared identifier table, and stored as their ID, so they can be compared without
+ * any string comparison.
  */
 struct TokenValue
 {
-    using Ptr = std::shared_ptr<TokenValue>;
-
     TokenValue()
     {
         m_value.numericValue = 0;
@@ -40,14 +38,14 @@ struct TokenValue
     {
         m_value.numericValue = numericValue;
     };
-    TokenValue( std::string stringValue )
+    TokenValue( std::string_view stringValue )
+    : TokenValue( IdentifierTable::GetInstance()->Intern( stringValue ) )
+    {
+    };
+    TokenValue( IdentifierId identifierId )
     : m_valueType( STRING )
     {
-        if ( stringValue.length() > g_tokenStrValueMaxLen )
-        {
-            printf( "Warning: Token value string %s exceeds max character length.\n", stringValue.c_str() );
-        }
-        strcpy_s( m_value.stringValue, g_tokenStrValueMaxLen, stringValue.c_str() );
+        m_value.identifierId = identifierId;
     };
     TokenValue( DataType dataTypeValue )
     : m_valueType( TokenValueType::DTYPE )
@@ -55,6 +53,32 @@ struct TokenValue
         m_value.dataTypeValue = dataTypeValue;
     };
 
+    /**
+     * Gets the ID of the string value held, or g_invalidIdentifierId if the value is not a string.
+     */
+    IdentifierId
+    GetIdentifierId() const
+    {
+        if ( STRING != m_valueType )
+        {
+            return g_invalidIdentifierId;
+        }
+        return m_value.identifierId;
+    }
+
+    /**
+     * Gets the string value held, or an empty string if the value is not a string.
+     */
+    std::string_view
+    GetStringValue() const
+    {
+        if ( STRING != m_valueType )
+        {
+            return std::string_view();
+        }
+        return IdentifierTable::GetInstance()->GetName( m_value.identifierId );
+    }
+
     bool
     operator==( const TokenValue& comparisonValue ) const
     {
@@ -68,7 +92,7 @@ struct TokenValue
         case NUMERIC:
             return comparisonValue.m_value.numericValue == m_value.numericValue;
         case STRING:
-            return strcmp( comparisonValue.m_value.stringValue, m_value.stringValue ) == 0;
+            return comparisonValue.m_value.identifierId == m_value.identifierId;
         case DTYPE:
             return comparisonValue.m_value.dataTypeValue == m_value.dataTypeValue;
         default:
@@ -81,8 +105,8 @@ struct TokenValue
 
     union Value
     {
-        uint8_t  numericValue;
-        char     stringValue[g_tokenStrValueMaxLen];
-        DataType dataTypeValue;
+        uint8_t      numericValue;
+        IdentifierId identifierId;
+        DataType     dataTypeValue;
     } m_value;
 };
@@ -3,72 +3,334 @@
  */
 
 #include "Tokeniser.h"
+#include "LexerDfa.h"
 #include "Logger.h"
 #include <stdexcept>
-#include <cctype>
+#include <algorithm>
+#include <charconv>
+#include <future>
 #include <inttypes.h>
 
+/**
+ * Constructor for Tokeniser.
+ *
+ * \param[in]  identifierTable  The table identifier strings are interned into. Defaults to the shared table.
+ */
+Tokeniser::Tokeniser(
+    IdentifierTable::Ptr identifierTable
+)
+: m_identifierTable( identifierTable ? identifierTable : IdentifierTable::GetInstance() )
+{
+}
+
 /**
  * Converts a string into tokens.
  *
  * \param[in]  inputString  The string to be converted. Can be a single line or a whole program.
  *
- * \return  A deque of tokens representing the given string.
+ * \return  A contiguous collection of tokens representing the given string.
+ */
+Tokens
+Tokeniser::ConvertStringToTokens(
+    std::string_view inputString
+)
+{
+    Tokens tokens{};
+    ConvertLinesAndAppend( inputString, tokens, nullptr );
+    return tokens;
+}
+
+/**
+ * Converts a string into tokens, recording which tokens came from each line so that lines can later be re-tokenised
+ * with RetokeniseLines().
+ *
+ * \param[in]   inputString     The string to be converted. Can be a single line or a whole program.
+ * \param[out]  lineTokenIndex  Populated with the index of the first token of each line.
+ *
+ * \return  A contiguous collection of tokens representing the given string.
  */
 Tokens
 Tokeniser::ConvertStringToTokens(
-    const std::string& inputString
+    std::string_view inputString,
+    LineTokenIndex& lineTokenIndex
 )
 {
     Tokens tokens{};
+    lineTokenIndex.clear();
+    ConvertLinesAndAppend( inputString, tokens, &lineTokenIndex );
+    lineTokenIndex.push_back( tokens.size() );
+    return tokens;
+}
+
+/**
+ * Re-tokenises a range of edited lines, splicing the new tokens into an existing collection in place of the tokens
+ * of the lines that were replaced. Only the replacement lines are converted, so the cost of conversion depends on the
+ * size of the edit rather than the size of the program. If the replacement lines can't be converted, an exception is
+ * thrown and the existing tokens are left unchanged.
+ *
+ * \param[in]      replacementLines     The new text of the edited lines. Empty if the lines were deleted, or if they
+ *                                      were replaced by a single blank line.
+ * \param[in]      numReplacementLines  The number of lines in the replacement text: 0 if the lines were deleted,
+ *                                      otherwise one more than the number of newlines in it.
+ * \param[in]      firstLine            The index of the first line that was replaced, or where lines were inserted.
+ * \param[in]      numReplacedLines     The number of lines in the previous version that were replaced.
+ * \param[in,out]  tokens               The tokens of the previous version, updated to those of the edited version.
+ * \param[in,out]  lineTokenIndex       The line token index of the previous version, updated to match the tokens.
+ */
+void
+Tokeniser::RetokeniseLines(
+    std::string_view replacementLines,
+    size_t numReplacementLines,
+    size_t firstLine,
+    size_t numReplacedLines,
+    Tokens& tokens,
+    LineTokenIndex& lineTokenIndex
+)
+{
+    if ( lineTokenIndex.empty() || lineTokenIndex.back() != tokens.size() )
+    {
+        LOG_ERROR_AND_THROW( "Line token index does not match the tokens being edited.", std::invalid_argument );
+    }
+    const size_t numLines = lineTokenIndex.size() - 1u;
+    if ( firstLine > numLines || numReplacedLines > numLines - firstLine )
+    {
+        LOG_ERROR_AND_THROW( "Edited lines " + std::to_string( firstLine ) + "+" + std::to_string( numReplacedLines )
+                             + " out of range of " + std::to_string( numLines ) + " lines.", std::out_of_range );
+    }
+    // An empty string can be either no lines or one blank line, so the number of lines is given rather than counted.
+    const size_t numNewLines = static_cast< size_t >( std::count( replacementLines.begin(), replacementLines.end(),
+                                                                  '\n' ) );
+    if ( 0u == numReplacementLines ? !replacementLines.empty() : numReplacementLines != numNewLines + 1u )
+    {
+        LOG_ERROR_AND_THROW( "Replacement text does not have " + std::to_string( numReplacementLines ) + " lines.",
+                             std::invalid_argument );
+    }
 
+    Tokens newTokens{};
+    LineTokenIndex newLineTokenIndex{};
+    if ( replacementLines.empty() && 0u != numReplacementLines )
+    {
+        // A blank line has no tokens.
+        newLineTokenIndex.push_back( 0u );
+    }
+    else
+    {
+        ConvertLinesAndAppend( replacementLines, newTokens, &newLineTokenIndex );
+    }
+
+    // Replace the tokens of the edited lines.
+    const size_t firstToken = lineTokenIndex[firstLine];
+    const size_t numReplacedTokens = lineTokenIndex[firstLine + numReplacedLines] - firstToken;
+    auto firstReplacedToken = tokens.begin() + firstToken;
+    tokens.erase( firstReplacedToken, firstReplacedToken + numReplacedTokens );
+    tokens.insert( tokens.begin() + firstToken, newTokens.begin(), newTokens.end() );
+
+    // Replace the index entries of the edited lines, and shift those of the following lines to match.
+    auto firstReplacedLine = lineTokenIndex.begin() + firstLine;
+    lineTokenIndex.erase( firstReplacedLine, firstReplacedLine + numReplacedLines );
+    for ( size_t& newLineStart : newLineTokenIndex )
+    {
+        newLineStart += firstToken;
+    }
+    lineTokenIndex.insert( lineTokenIndex.begin() + firstLine, newLineTokenIndex.begin(), newLineTokenIndex.end() );
+    for ( size_t line = firstLine + newLineTokenIndex.size(); line < lineTokenIndex.size(); ++line )
+    {
+        lineTokenIndex[line] = lineTokenIndex[line] - numReplacedTokens + newTokens.size();
+    }
+}
+
+/**
+ * Converts each line of a string into tokens.
+ *
+ * \param[in]      inputString     The string to be converted. An empty string has no lines.
+ * \param[in,out]  tokens          Collection of tokens to append to.
+ * \param[in,out]  lineTokenIndex  If not null, the index of the first token of each line is appended to this.
+ */
+void
+Tokeniser::ConvertLinesAndAppend(
+    std::string_view inputString,
+    Tokens& tokens,
+    LineTokenIndex* lineTokenIndex
+)
+{
     if ( !inputString.empty() )
     {
         // Convert each line in the string
         size_t currentIndex{ 0u };
-        size_t newLinePos = inputString.find( "\n" );
-        while ( std::string::npos != newLinePos )
+        size_t newLinePos = inputString.find( '\n' );
+        while ( std::string_view::npos != newLinePos )
         {
-            std::string line = inputString.substr( currentIndex, newLinePos-currentIndex );
-            ConvertSingleLineAndAppend( line, tokens );
+            if ( nullptr != lineTokenIndex )
+            {
+                lineTokenIndex->push_back( tokens.size() );
+            }
+            ConvertSingleLineAndAppend( inputString.substr( currentIndex, newLinePos-currentIndex ), tokens );
 
             currentIndex = newLinePos + 1u;
-            newLinePos = inputString.find( "\n", currentIndex );
+            newLinePos = inputString.find( '\n', currentIndex );
         }
 
         // Convert final line
-        std::string line = inputString.substr( currentIndex, std::string::npos );
-        ConvertSingleLineAndAppend( line, tokens );
+        if ( nullptr != lineTokenIndex )
+        {
+            lineTokenIndex->push_back( tokens.size() );
+        }
+        ConvertSingleLineAndAppend( inputString.substr( currentIndex ), tokens );
+    }
+}
+
+/**
+ * Converts a string into tokens, splitting it into chunks of whole lines which are converted in parallel. The tokens
+ * and identifier IDs produced are identical to those from ConvertStringToTokens().
+ *
+ * \param[in]  inputString   The string to be converted. Can be a single line or a whole program.
+ * \param[in]  numThreads    The maximum number of chunks to convert at once.
+ * \param[in]  minChunkSize  The minimum size of each chunk. If the input is too small to be split into at least two
+ *                           chunks, it is converted on the calling thread.
+ *
+ * \return  A contiguous collection of tokens representing the given string.
+ */
+Tokens
+Tokeniser::ConvertStringToTokensParallel(
+    std::string_view inputString,
+    size_t numThreads,
+    size_t minChunkSize
+)
+{
+    size_t numChunks = std::min( numThreads, inputString.size() / std::max( minChunkSize, size_t{ 1u } ) );
+    std::vector< std::string_view > chunks = SplitIntoChunks( inputString, numChunks );
+    if ( 2u > chunks.size() )
+    {
+        return ConvertStringToTokens( inputString );
+    }
+    LOG_INFO( "Converting string to tokens in " + std::to_string( chunks.size() ) + " chunks." );
+
+    // The identifier table isn't thread-safe, so each chunk is converted by its own tokeniser with its own table. The
+    // chunk-local IDs are mapped to IDs in this tokeniser's table as the chunks are appended in order.
+    using ChunkResult = std::pair< Tokens, IdentifierTable::Ptr >;
+    std::vector< std::future< ChunkResult > > chunkResults;
+    chunkResults.reserve( chunks.size() );
+    for ( std::string_view chunk : chunks )
+    {
+        chunkResults.push_back( std::async( std::launch::async, [chunk]() {
+            IdentifierTable::Ptr chunkIdentifierTable = std::make_shared< IdentifierTable >();
+            Tokeniser chunkTokeniser( chunkIdentifierTable );
+            return ChunkResult( chunkTokeniser.ConvertStringToTokens( chunk ), chunkIdentifierTable );
+        } ) );
+    }
+
+    // Getting each result in order rethrows the exception from the earliest failing chunk, which is the same one the
+    // serial conversion would have thrown.
+    Tokens tokens{};
+    for ( std::future< ChunkResult >& chunkResult : chunkResults )
+    {
+        ChunkResult result = chunkResult.get();
+        AppendChunkTokens( result.first, *result.second, tokens );
     }
 
     return tokens;
 }
 
+/**
+ * Splits a string into roughly equal chunks, each ending at the end of a line.
+ *
+ * \param[in]  inputString  The string to be split.
+ * \param[in]  numChunks    The number of chunks to aim for. There may be fewer if the string has few lines.
+ *
+ * \return  Views of consecutive chunks, which together make up the whole string.
+ */
+std::vector< std::string_view >
+Tokeniser::SplitIntoChunks(
+    std::string_view inputString,
+    size_t numChunks
+)
+{
+    std::vector< std::string_view > chunks{};
+    if ( 0u == numChunks )
+    {
+        return chunks;
+    }
+    const size_t targetChunkSize = inputString.size() / numChunks;
+
+    size_t chunkStart{ 0u };
+    while ( chunkStart < inputString.size() )
+    {
+        // End the chunk at the first newline after the target size, so no line is split between chunks.
+        size_t newLinePos = std::string_view::npos;
+        if ( chunks.size() + 1u < numChunks )
+        {
+            newLinePos = inputString.find( '\n', chunkStart + std::max( targetChunkSize, size_t{ 1u } ) - 1u );
+        }
+        if ( std::string_view::npos == newLinePos )
+        {
+            chunks.push_back( inputString.substr( chunkStart ) );
+            break;
+        }
+        chunks.push_back( inputString.substr( chunkStart, newLinePos + 1u - chunkStart ) );
+        chunkStart = newLinePos + 1u;
+    }
+
+    return chunks;
+}
+
+/**
+ * Appends the tokens converted from a chunk, mapping any chunk-local identifier IDs to IDs in this tokeniser's table.
+ * Identifiers are interned in order of their local IDs, i.e. the order they first appear in the chunk, so appending
+ * chunks in order allocates IDs in the same order as a serial conversion.
+ *
+ * \param[in,out]  chunkTokens           Tokens converted from the chunk. Identifier values are updated in place.
+ * \param[in]      chunkIdentifierTable  The table the chunk's identifiers were interned into.
+ * \param[in,out]  tokens                Collection of tokens to append to.
+ */
+void
+Tokeniser::AppendChunkTokens(
+    Tokens& chunkTokens,
+    const IdentifierTable& chunkIdentifierTable,
+    Tokens& tokens
+)
+{
+    std::vector< IdentifierId > idMapping{};
+    idMapping.reserve( chunkIdentifierTable.GetNumIdentifiers() );
+    for ( uint32_t localId = 0u; localId < chunkIdentifierTable.GetNumIdentifiers(); ++localId )
+    {
+        idMapping.push_back( m_identifierTable->Intern( chunkIdentifierTable.GetName( IdentifierId{ localId } ) ) );
+    }
+
+    for ( Token& token : chunkTokens )
+    {
+        if ( TokenValueType::STRING == token.m_value.m_valueType )
+        {
+            token.m_value = TokenValue( idMapping[static_cast< uint32_t >( token.m_value.GetIdentifierId() )] );
+        }
+    }
+
+    tokens.insert( tokens.end(), chunkTokens.begin(), chunkTokens.end() );
+}
+
 /**
  * Converts a single line string into tokens.
  *
  * \param[in]      inputString   The string to be converted, representing a single line of code.
- * \param[in,out]  tokens        Deque of tokens to append to.
+ * \param[in,out]  tokens        Collection of tokens to append to.
  */
 void
 Tokeniser::ConvertSingleLineAndAppend(
-    const std::string& inputString,
+    std::string_view inputString,
     Tokens& tokens
 )
 {
-    LOG_INFO_MEDIUM_LEVEL( "Converting line '" + inputString + "' to tokens." );
+    LOG_INFO_MEDIUM_LEVEL( "Converting line '" + std::string( inputString ) + "' to tokens." );
 
-    std::string workingCopy = inputString;
-    // If there is a comment anywhere in the line, remove everything after the comment prefix and create a working
-    // copy.
+    std::string_view workingCopy = inputString;
+    // If there is a comment anywhere in the line, remove everything after the comment prefix from the working view.
     // This needs refactoring if we ever support string literals as this doesn't account for something being within
     // quotation marks.
     size_t commentPos = inputString.find( g_commentPrefix, 0u );
-    if ( std::string::npos != commentPos )
+    if ( std::string_view::npos != commentPos )
     {
         // Take a substring ending at the comment
         workingCopy = inputString.substr( 0, commentPos );
-        LOG_INFO_LOW_LEVEL( "Skipping commented part: working copy is '" + workingCopy + "'" );
+        LOG_INFO_LOW_LEVEL( "Skipping commented part: working copy is '" + std::string( workingCopy ) + "'" );
     }
 
     // If line is now empty
@@ -79,16 +341,17 @@ Tokeniser::ConvertSingleLineAndAppend(
     }
 
     size_t currentIndex{ 0u };
-    Token::Ptr nextToken;
-    while ( nullptr != ( nextToken = GetNextToken( workingCopy, currentIndex ) ) )
+    Token nextToken;
+    while ( TokenType::INVALID_TOKEN != ( nextToken = GetNextToken( workingCopy, currentIndex ) ).m_type )
     {
-        LOG_INFO_LOW_LEVEL( "Found token " + nextToken->ToString() );
+        LOG_INFO_LOW_LEVEL( "Found token " + nextToken.ToString( *m_identifierTable ) );
         tokens.push_back( nextToken );
     }
 
     if ( 0u == currentIndex )
     {
-        LOG_ERROR_AND_THROW( "Could not find any tokens in line '" + inputString + "'", std::invalid_argument );
+        LOG_ERROR_AND_THROW( "Could not find any tokens in line '" + std::string( inputString ) + "'",
+                             std::invalid_argument );
     }
 
     // Check there are no non-whitespace characters left at the end of the line.
@@ -96,8 +359,9 @@ Tokeniser::ConvertSingleLineAndAppend(
     {
         if ( !IsWhitespace( workingCopy[index] ) )
         {
-            LOG_ERROR_AND_THROW( "Non-matching characters left at end of line '" + inputString + "': leftover '"
-                                 + workingCopy.substr( index, workingCopy.size()-index ) + "'", std::invalid_argument );
+            LOG_ERROR_AND_THROW( "Non-matching characters left at end of line '" + std::string( inputString )
+                                 + "': leftover '" + std::string( workingCopy.substr( index ) ) + "'",
+                                 std::invalid_argument );
         }
     }
 }
@@ -108,27 +372,24 @@ Tokeniser::ConvertSingleLineAndAppend(
  * \param[in]      inputString   The string from which to get the token.
  * \param[in,out]  startIndex    The index of the beginning of the substring representing the next token.
  *
- * \return  The next token starting at index (the largest possible that matches a rule), or nullptr if there is
- *          no matching token to be found.
+ * \return  The next token starting at index (the largest possible that matches a rule), or a token of type
+ *          INVALID_TOKEN if there is no matching token to be found.
  */
-Token::Ptr
+Token
 Tokeniser::GetNextToken(
-    const std::string& inputString,
+    std::string_view inputString,
     size_t& startIndex
 )
 {
     /**
      * Algorithm is as follows:
      *
-     * Given a start pointer, create end pointer = start+1 (skipping any whitespace at the start).
+     * Given a start index (skipping any whitespace at the start), feed each character into the lexer DFA in turn.
+     * Whenever the DFA is in an accepting state, record the token type and the end index - we can't assume the first
+     * match is actually the right token, due to possibilities like < and <=, or | and ||.
      *
-     * Increment end ptr until a valid substring (one that matches a token) is found. When this happens,
-     * mark that a valid substring has been found and record the last valid token type. We can't assume exact matches
-     * are actually the right token, due to possibilities like + and ++, or | and ||.
-     *
-     * Continue until we find whitespace or end of string, or when the token becomes invalid.
-     * Note: this doesn't support rules where x is valid, xy is invalid, xyz is valid.
-     * When this happens, create token for last valid substring, then update start ptr to last valid end ptr + 1.
+     * Stop when the DFA rejects a character or the end of the string is reached, and create a token from the last
+     * accepted substring. Each character is looked at once, and no substrings are created until the token is known.
      */
 
     // Skip past any whitespace at the start of the token string.
@@ -139,59 +400,54 @@ Tokeniser::GetNextToken(
     // If we have reached the end of the string i.e. there are no more non-whitespace chars
     if ( inputString.size() == startIndex )
     {
-        return nullptr;
+        return Token( TokenType::INVALID_TOKEN );
     }
 
-    size_t endIndex{ startIndex + 1u }; // End of current substring (exclusive)
+    const LexerDfa& dfa = LexerDfa::GetInstance();
+    LexerDfa::State state = LexerDfa::START_STATE;
 
     TokenType lastValidTokenType = TokenType::INVALID_TOKEN;
+    size_t lastValidEndIndex{ startIndex }; // End of last accepted substring (exclusive)
 
-    // Loop until we hit the end of the string or a whitespace character
-    while ( endIndex <= inputString.size() && !IsWhitespace( inputString[endIndex-1u] ) )
+    for ( size_t index = startIndex; index < inputString.size(); ++index )
     {
-        std::string currentSubstring = inputString.substr( startIndex, endIndex - startIndex );
-        // If the current substring matches a token, record it as the latest valid end index.
-        TokenType tokenType = GetTokenType( currentSubstring );
-        if ( TokenType::INVALID_TOKEN == tokenType )
+        state = dfa.GetNextState( state, inputString[index] );
+        if ( LexerDfa::REJECT_STATE == state )
         {
-            // If substring is >1 chars, then it is invalid because it represents the combination of the edges
-            // of 2 tokens. This isn't permitted if both 'borders' are alphanumeric or _, e.g. tokens "for" and "1"
-            // must be separated by whitespace, but "for" and "(" is ok.
-            if ( 1u < currentSubstring.size() )
-            {
-                size_t lastIndex = currentSubstring.size() - 1u;
-                if ( std::isalnum( currentSubstring[lastIndex] ) || '_' == currentSubstring[lastIndex] )
-                {
-                    // If last char i.e. first char of new token is alphanumeric or _, compare to the previous
-                    // to see if this combination is allowed without whitespace.
-                    size_t indexOfLastInValidSubstr = lastIndex - 1u;
-                    if ( std::isalnum( currentSubstring[indexOfLastInValidSubstr] )
-                         || '_' == currentSubstring[indexOfLastInValidSubstr]
-                        )
-                    {
-                        return nullptr;
-                    }
-                }
-            }
             break;
         }
-        else
+
+        TokenType acceptedType = dfa.GetAcceptedType( state );
+        if ( TokenType::INVALID_TOKEN != acceptedType )
         {
-            lastValidTokenType = tokenType;
-            ++endIndex;
+            lastValidTokenType = acceptedType;
+            lastValidEndIndex = index + 1u;
         }
     }
 
-    size_t lastValidEndIndex = endIndex - 1u;
-    // If no matching token is found, return nullptr.
-    if ( 0u >= lastValidEndIndex )
+    // If no matching token is found, return an invalid token.
+    if ( TokenType::INVALID_TOKEN == lastValidTokenType )
     {
-        return nullptr;
+        return Token( TokenType::INVALID_TOKEN );
+    }
+
+    // The borders of 2 tokens can't both be alphanumeric or _, e.g. tokens "for" and "1" must be separated by
+    // whitespace, but "for" and "(" is ok.
+    if ( lastValidEndIndex < inputString.size()
+         && LexerDfa::IsWordCharacter( inputString[lastValidEndIndex] )
+         && LexerDfa::IsWordCharacter( inputString[lastValidEndIndex - 1u] )
+        )
+    {
+        return Token( TokenType::INVALID_TOKEN );
     }
 
     // Create token from the latest matching substring.
-    std::string validTokenString = inputString.substr( startIndex, lastValidEndIndex - startIndex );
-    Token::Ptr token = CreateTokenFromString( lastValidTokenType, validTokenString );
+    std::string_view validTokenString = inputString.substr( startIndex, lastValidEndIndex - startIndex );
+    if ( TokenType::IDENTIFIER == lastValidTokenType )
+    {
+        lastValidTokenType = GetIdentifierTokenType( validTokenString );
+    }
+    Token token = CreateTokenFromString( lastValidTokenType, validTokenString );
 
     // Update out parameter to point to start of next substring.
     startIndex = lastValidEndIndex;
@@ -211,27 +467,28 @@ Tokeniser::IsWhitespace(
     const char character
 )
 {
-    return ' ' == character || '\t' == character || '\n' == character;
+    // Carriage returns are included so that files with Windows line endings can be read as they are.
+    return ' ' == character || '\t' == character || '\n' == character || '\r' == character;
 }
 
 /**
- * Gets the token type of a string representing a token.
+ * Gets the token type of a string accepted by the lexer as an identifier. This may be a reserved word, e.g. a keyword
+ * or a data type, rather than a user-defined identifier.
  *
  * \param[in]  tokenString  The string representing the token being queried.
  *
- * \return  The type of token belonging to the string (INVALID_TOKEN if the string does not represent a recognised
- *          token).
+ * \return  The type of token belonging to the string.
  */
 TokenType
-Tokeniser::GetTokenType(
-    const std::string& tokenString
+Tokeniser::GetIdentifierTokenType(
+    std::string_view tokenString
 ) noexcept
 {
-    LOG_INFO_LOW_LEVEL( "Trying to get token type for " + tokenString );
     // If the string has an exact match, return that type
-    if ( 0 < g_tokenTypesExactMatches.count( tokenString ) )
+    auto exactMatch = g_tokenTypesExactMatches.find( tokenString );
+    if ( g_tokenTypesExactMatches.end() != exactMatch )
     {
-        return g_tokenTypesExactMatches.find( tokenString )->second;
+        return exactMatch->second;
     }
     // If string represents a data type token
     if ( 0 < g_dataTypeStrings.count( tokenString ) )
@@ -239,37 +496,7 @@ Tokeniser::GetTokenType(
         return TokenType::DATA_TYPE;
     }
 
-    // If first char, proceed assuming it is a numeric literal
-    if ( 0u != std::isdigit( tokenString[0] ) )
-    {
-        for ( size_t index = 1u; index < tokenString.size(); ++index )
-        {
-            if ( 0u == std::isdigit( tokenString[index] ) )
-            {
-                return TokenType::INVALID_TOKEN;
-            }
-        }
-        // If all characters are digits, return byte type - this is currently the only numeric type we support.
-        return TokenType::BYTE;
-    }
-    // If starts with letter or _ then proceed assuming it is an identifier
-    else if ( 0u != std::isalpha( tokenString[0] ) || '_' == tokenString[0] )
-    {
-        for ( size_t index = 1u; index < tokenString.size(); ++index )
-        {
-            // If not alphanumeric or _, then it is invalid
-            if ( 0u == std::isalnum( tokenString[index] ) && '_' != tokenString[index] )
-            {
-                return TokenType::INVALID_TOKEN;
-            }
-        }
-        return TokenType::IDENTIFIER;
-    }
-
-    // If unrecognised, return invalid type
-    // TODO: fix - unrecognised symbol e.g. ^ seems to cause the program to hang.
-    LOG_INFO_LOW_LEVEL( "Unrecognised token type for string " + tokenString );
-    return TokenType::INVALID_TOKEN;
+    return TokenType::IDENTIFIER;
 }
 
 /**
@@ -280,54 +507,56 @@ Tokeniser::GetTokenType(
  *
  * \return  The token that the given string represents.
  */
-Token::Ptr
+Token
 Tokeniser::CreateTokenFromString(
     const TokenType type,
-    const std::string& tokenString
+    std::string_view tokenString
 )
 {
-    TokenValue::Ptr tokenValue;
+    TokenValue tokenValue;
     // If g_tokenValueTypes contains type, i.e. it is a value-holding token type
     if ( 0 < g_tokenValueTypes.count( type ) )
     {
         TokenValueType valueType = g_tokenValueTypes.find( type )->second;
         if ( TokenValueType::NUMERIC == valueType )
         {
+            uint64_t numericValue{ 0u };
+            const char* stringEnd = tokenString.data() + tokenString.size();
+            std::from_chars_result result = std::from_chars( tokenString.data(), stringEnd, numericValue );
+            if ( std::errc() != result.ec || stringEnd != result.ptr )
+            {
+                LOG_ERROR_AND_THROW( "Could not convert '" + std::string( tokenString ) + "' to a numeric value.",
+                                     std::out_of_range );
+            }
             // Use 8-bit value since currently we are only supporting the byte data type.
-            uint64_t numericValue = std::stoi( tokenString );
             if ( numericValue > 0xFF )
             {
                 LOG_WARN( "Numeric value " + std::to_string(numericValue) + " too large: information may be lost in truncation." );
             }
             uint8_t numericValueByte = static_cast< uint8_t >( numericValue );
-            tokenValue = std::make_shared< TokenValue >( numericValueByte );
+            tokenValue = TokenValue( numericValueByte );
         }
         else if ( TokenValueType::STRING == valueType )
         {
-            tokenValue = std::make_shared< TokenValue >( tokenString );
+            tokenValue = TokenValue( m_identifierTable->Intern( tokenString ) );
         }
         else if ( TokenValueType::DTYPE == valueType )
         {
-            if ( 0 < g_dataTypeStrings.count( tokenString ) )
+            auto dataTypeIter = g_dataTypeStrings.find( tokenString );
+            if ( g_dataTypeStrings.end() != dataTypeIter )
             {
-                DataType dataType = g_dataTypeStrings.find( tokenString )->second;
-                tokenValue = std::make_shared< TokenValue >( dataType );
+                tokenValue = TokenValue( dataTypeIter->second );
             }
             else
             {
-                LOG_ERROR_AND_THROW( "Unknown data type " + tokenString, std::runtime_error );
+                LOG_ERROR_AND_THROW( "Unknown data type " + std::string( tokenString ), std::runtime_error );
             }
         }
         else
         {
-            LOG_ERROR_AND_THROW( "Unknown token value type " + tokenString, std::runtime_error );
+            LOG_ERROR_AND_THROW( "Unknown token value type " + std::string( tokenString ), std::runtime_error );
         }
     }
-    else
-    {
-        tokenValue = std::make_shared< TokenValue >();
-    }
 
-    Token::Ptr token = std::make_shared<Token>( type, tokenValue );
-    return token;
-}
\ No newline at end of file
+    return Token( type, tokenValue );
+}
@@ -5,29 +5,57 @@
 #pragma once
 
 #include "Token.h"
+#include "IdentifierTable.h"
 #include <string>
+#include <string_view>
 #include <memory>
+#include <vector>
 
 // Defines the prefix string that means "everything else on this line is comment"
 const std::string g_commentPrefix = "//";
 
+// For each line of a converted string, the index of its first token. Has a final entry for the end of the tokens, so
+// the tokens of line i are those in the range [index[i], index[i + 1]).
+using LineTokenIndex = std::vector< size_t >;
+
+// Minimum size in bytes of the chunks lexed in parallel, so that small inputs aren't split over many threads.
+constexpr size_t g_minParallelChunkSize = 64u * 1024u;
+
 // Class responsible for converting a string into a stream of tokens.
 class Tokeniser
 {
 public:
     using Ptr = std::shared_ptr< Tokeniser >;
     using UPtr = std::unique_ptr< Tokeniser >;
-    Tokeniser() = default;
-
-    Tokens ConvertStringToTokens( const std::string& inputString );
+    Tokeniser( IdentifierTable::Ptr identifierTable = nullptr );
+
+    Tokens ConvertStringToTokens( std::string_view inputString );
+    Tokens ConvertStringToTokens( std::string_view inputString, LineTokenIndex& lineTokenIndex );
+    Tokens ConvertStringToTokensParallel( std::string_view inputString,
+                                          size_t numThreads,
+                                          size_t minChunkSize = g_minParallelChunkSize );
+
+    void RetokeniseLines( std::string_view replacementLines,
+                          size_t numReplacementLines,
+                          size_t firstLine,
+                          size_t numReplacedLines,
+                          Tokens& tokens,
+                          LineTokenIndex& lineTokenIndex );
 protected:
-    void ConvertSingleLineAndAppend( const std::string& inputString, Tokens& tokens );
+    void ConvertLinesAndAppend( std::string_view inputString, Tokens& tokens, LineTokenIndex* lineTokenIndex );
+    std::vector< std::string_view > SplitIntoChunks( std::string_view inputString, size_t numChunks );
+    void AppendChunkTokens( Tokens& chunkTokens, const IdentifierTable& chunkIdentifierTable, Tokens& tokens );
 
-    Token::Ptr GetNextToken( const std::string& inputString, size_t& startIndex );
+    void ConvertSingleLineAndAppend( std::string_view inputString, Tokens& tokens );
 
-    TokenType GetTokenType( const std::string& tokenString ) noexcept;
+    Token GetNextToken( std::string_view inputString, size_t& startIndex );
+
+    TokenType GetIdentifierTokenType( std::string_view tokenString ) noexcept;
 
     bool IsWhitespace( const char character );
 
-    Token::Ptr CreateTokenFromString( const TokenType type, const std::string& tokenString );
+    Token CreateTokenFromString( const TokenType type, std::string_view tokenString );
+
+    // Table that identifier token strings are interned into.
+    IdentifierTable::Ptr m_identifierTable;
 };
\ No newline at end of file
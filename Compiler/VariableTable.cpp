@@ -0,0 +1,76 @@
+/**
+ * Contains definition of the table of variables referred to by the intermediate code.
+ */
+
+#include "VariableTable.h"
+#include "Logger.h"
+
+#include <stdexcept>
+
+/**
+ * \brief  Allocates the next ID to a new variable.
+ *
+ * \param[in]  name  Human-readable name of the variable, e.g. its identifier, or the purpose of a temporary.
+ *
+ * \return  The ID of the new variable.
+ */
+VarId
+VariableTable::AddVariable(
+    const std::string& name
+)
+{
+    if ( static_cast< size_t >( g_invalidVarId ) <= m_names.size() )
+    {
+        LOG_ERROR_AND_THROW( "Too many variables to add '" + name + "'.", std::runtime_error );
+    }
+
+    VarId newId = static_cast< VarId >( m_names.size() );
+    m_names.push_back( name );
+    return newId;
+}
+
+/**
+ * \brief  Gets the name a variable was added with. Throws if the ID was not allocated by this table.
+ *
+ * \param[in]  id  The ID of the variable.
+ *
+ * \return  The name of the variable.
+ */
+const std::string&
+VariableTable::GetName(
+    VarId id
+) const
+{
+    size_t index = static_cast< size_t >( id );
+    if ( index >= m_names.size() )
+    {
+        LOG_ERROR_AND_THROW( "Unknown variable ID " + std::to_string( index ), std::out_of_range );
+    }
+    return m_names[index];
+}
+
+/**
+ * \brief  Gets a name that uniquely identifies a variable, for logging. Combines its name and ID.
+ *
+ * \param[in]  id  The ID of the variable.
+ *
+ * \return  The unique name of the variable.
+ */
+std::string
+VariableTable::GetDebugName(
+    VarId id
+) const
+{
+    return GetName( id ) + "#" + std::to_string( static_cast< uint32_t >( id ) );
+}
+
+/**
+ * \brief  Gets the number of variables that have been added.
+ *
+ * \return  Number of variables in the table.
+ */
+size_t
+VariableTable::GetNumVariables() const
+{
+    return m_names.size();
+}
@@ -0,0 +1,45 @@
+/**
+ * Contains declaration of the table of variables referred to by the intermediate code.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Dense ID representing a variable: either a symbol declared in the program, or a temporary created while generating
+// code. IDs are allocated in order from 0, so can be used to index arrays, and are the same every time a program is
+// compiled. Scoped so that it can't be implicitly confused with a numeric value.
+enum class VarId : uint32_t {};
+
+// Represents the absence of a variable, e.g. an unused operand.
+constexpr VarId g_invalidVarId{ std::numeric_limits< uint32_t >::max() };
+
+/**
+ * \brief  Allocates the IDs of the variables in a program, and stores a human-readable name for each so that they can
+ *         be identified when debugging. The names are only a side table: later stages refer to variables by ID alone.
+ *
+ *         One table is shared by the symbol tables of a program, which allocate an ID for each declared symbol, and the
+ *         code generation stages, which allocate IDs for any temporaries they need. This class is not thread-safe.
+ */
+class VariableTable
+{
+public:
+    using Ptr = std::shared_ptr< VariableTable >;
+
+    VariableTable() = default;
+
+    VarId AddVariable( const std::string& name );
+
+    const std::string& GetName( VarId id ) const;
+    std::string GetDebugName( VarId id ) const;
+
+    size_t GetNumVariables() const;
+
+private:
+    // The name each variable was added with, indexed by ID. Not necessarily unique, e.g. temporaries of the same kind.
+    std::vector< std::string > m_names;
+};
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <boost/test/unit_test.hpp>
 
 #include "AssemblyGenerator.h"
@@ -10,12 +12,76 @@ class AssemblyGenerator_Test : public AssemblyGenerator
 public:
     using Ptr = std::shared_ptr< AssemblyGenerator_Test >;
     using AssemblyGenerator::AssemblyGenerator;
-    using AssemblyGenerator::m_basicBlockStarts;
-    using AssemblyGenerator::LiveInterval;
-    using AssemblyGenerator::m_liveIntervals;
+    using AssemblyGenerator::m_liveRanges;
+    using AssemblyGenerator::CalculateSpillCosts;
+    using AssemblyGenerator::GetMemoryLocation;
+};
+
+class AssemblyGeneratorTestsFixture
+{
+public:
+    AssemblyGeneratorTestsFixture()
+    : m_variableTable( std::make_shared< VariableTable >() ),
+      m_var1( m_variableTable->AddVariable( "var1" ) ),
+      m_var2( m_variableTable->AddVariable( "var2" ) )
+    {};
+
+    // Table of the variables referred to by the test instructions.
+    VariableTable::Ptr m_variableTable;
+    VarId m_var1;
+    VarId m_var2;
+
+    // Arbitrary labels, for branch targets and labelled instructions.
+    const TAC::LabelId m_branchTarget{ 0u };
+    const TAC::LabelId m_label{ 1u };
+
+    /**
+     * Counts the LDI instructions loading a memory address for a spilled variable.
+     *
+     * \param[in]  assembly  The generated assembly instructions.
+     *
+     * \return  Number of LDIs into the memory address register.
+     */
+    size_t CountAddressLoads( const Instructions& assembly )
+    {
+        return std::count_if( assembly.begin(), assembly.end(),
+                              []( const Instruction& instruction )
+                              {
+                                  return Opcode::LDI == std::get< 1 >( instruction )
+                                         && InstructionTarget{ static_cast< uint8_t >( MEM_ADDR_TEMP_REG ) }
+                                                == std::get< 2 >( instruction );
+                              } );
+    }
+
+    /**
+     * Adds instructions writing to one more variable than there are registers, then reading each of them in the same
+     * order, so that one of them has to be spilled.
+     *
+     * \param[in,out]  instructions  The instructions to add to.
+     * \param[in]      namePrefix    Prefix for the names of the variables.
+     *
+     * \return  The variables added, in order.
+     */
+    std::vector< VarId > AddRegisterPressure(
+        AssemblyGenerator::TacInstructions& instructions,
+        const std::string& namePrefix
+    )
+    {
+        std::vector< VarId > vars;
+        for ( size_t index = 0; index <= NUM_AVAILABLE_REGS; ++index )
+        {
+            vars.push_back( m_variableTable->AddVariable( namePrefix + std::to_string( index ) ) );
+            instructions.emplace_back( vars.back(), TAC::Literal{ static_cast< TAC::Literal >( index ) } );
+        }
+        for ( VarId var : vars )
+        {
+            instructions.emplace_back( var, TAC::Opcode::ADD, var, var );
+        }
+        return vars;
+    }
 };
 
-BOOST_AUTO_TEST_SUITE( AssemblyGeneratorTests )
+BOOST_FIXTURE_TEST_SUITE( AssemblyGeneratorTests, AssemblyGeneratorTestsFixture )
 
 /**
  * Tests that method for calculating basic block boundaries will populate its collection with a single zero element if
@@ -25,17 +91,19 @@ BOOST_AUTO_TEST_CASE( CalculateBasicBlocks_NoBranches )
 {
     // Simulate a few simple operations, with no branching or labels.
     AssemblyGenerator::TacInstructions instructions{
-        std::make_shared< TAC::ThreeAddrInstruction >( "var1", 5u ),
-        std::make_shared< TAC::ThreeAddrInstruction >( "var2", TAC::Opcode::ADD, "var1", "var1" ),
-        std::make_shared< TAC::ThreeAddrInstruction >( "var1", TAC::Opcode::LS, "var2", "" )
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u } ),
+        TAC::ThreeAddrInstruction( m_var2, TAC::Opcode::ADD, m_var1, m_var1 ),
+        TAC::ThreeAddrInstruction( m_var1, TAC::Opcode::LS, m_var2, g_invalidVarId )
     };
 
-    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions );
-    BOOST_CHECK_EQUAL( 0u, generator->m_basicBlockStarts.size() );
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    BOOST_CHECK( nullptr == generator->GetControlFlowGraph() );
     generator->CalculateBasicBlocks();
 
-    BOOST_REQUIRE_EQUAL( 1u, generator->m_basicBlockStarts.size() );
-    BOOST_CHECK_EQUAL( 0u, generator->m_basicBlockStarts[0] );
+    BOOST_REQUIRE( nullptr != generator->GetControlFlowGraph() );
+    BOOST_REQUIRE_EQUAL( 1u, generator->GetControlFlowGraph()->GetNumBlocks() );
+    BOOST_CHECK_EQUAL( 0u, generator->GetControlFlowGraph()->GetBlock( 0 ).start );
+    BOOST_CHECK_EQUAL( instructions.size(), generator->GetControlFlowGraph()->GetBlock( 0 ).end );
 }
 
 /**
@@ -44,67 +112,78 @@ BOOST_AUTO_TEST_CASE( CalculateBasicBlocks_NoBranches )
  */
 BOOST_AUTO_TEST_CASE( CalculateBasicBlocks_OneBranchAtEnd )
 {
-    // Simulate a few simple operations, with 1 branching instruction as the last instruction.
+    // Simulate a few simple operations, with 1 branching instruction as the last instruction. It branches back to the
+    // first instruction, which is already the start of a block.
     AssemblyGenerator::TacInstructions instructions{
-        std::make_shared< TAC::ThreeAddrInstruction >( "var1", 5u ),
-        std::make_shared< TAC::ThreeAddrInstruction >( "var2", TAC::Opcode::ADD, "var1", "var1" ),
-        std::make_shared< TAC::ThreeAddrInstruction >( "branchTarget", TAC::Opcode::BRE, "var2", "" )
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u }, m_branchTarget ),
+        TAC::ThreeAddrInstruction( m_var2, TAC::Opcode::ADD, m_var1, m_var1 ),
+        TAC::ThreeAddrInstruction( m_branchTarget, TAC::Opcode::BRE, m_var2, g_invalidVarId )
     };
 
-    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions );
-    BOOST_CHECK_EQUAL( 0u, generator->m_basicBlockStarts.size() );
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    BOOST_CHECK( nullptr == generator->GetControlFlowGraph() );
     generator->CalculateBasicBlocks();
 
-    BOOST_REQUIRE_EQUAL( 1u, generator->m_basicBlockStarts.size() );
-    BOOST_CHECK_EQUAL( 0u, generator->m_basicBlockStarts[0] );
+    BOOST_REQUIRE( nullptr != generator->GetControlFlowGraph() );
+    BOOST_REQUIRE_EQUAL( 1u, generator->GetControlFlowGraph()->GetNumBlocks() );
+    BOOST_CHECK_EQUAL( 0u, generator->GetControlFlowGraph()->GetBlock( 0 ).start );
+    BOOST_CHECK_EQUAL( instructions.size(), generator->GetControlFlowGraph()->GetBlock( 0 ).end );
 }
 
 /**
  * Tests that method for calculating basic block boundaries will successfully populate with the start of the blocks,
  * if there are multiple. Check it considers both branches and labels as block boundaries, and that it correctly
- * handles consecutive branch instructions.
+ * handles consecutive boundaries.
  */
 BOOST_AUTO_TEST_CASE( CalculateBasicBlocks_MultipleBlocks )
 {
     // Simulate a a program with multiple blocks, as well as consecutive block boundaries.
     AssemblyGenerator::TacInstructions instructions{
-        std::make_shared< TAC::ThreeAddrInstruction >( "var1", 5u ),
-        std::make_shared< TAC::ThreeAddrInstruction >( "var2", TAC::Opcode::ADD, "var1", "var1" ),
-        std::make_shared< TAC::ThreeAddrInstruction >( "branchTarget", TAC::Opcode::BRE, "var2", "" ),
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u } ),
+        TAC::ThreeAddrInstruction( m_var2, TAC::Opcode::ADD, m_var1, m_var1 ),
+        TAC::ThreeAddrInstruction( m_branchTarget, TAC::Opcode::BRE, m_var2, g_invalidVarId ),
         // expect a block boundary here, so the next block starts at index 3
-        std::make_shared< TAC::ThreeAddrInstruction >( "var1", 5u ),
-        std::make_shared< TAC::ThreeAddrInstruction >( "var2", TAC::Opcode::ADD, "var1", "var1", "label"),
-        // expect a block boundary due to using a label - next block at index 5
-        std::make_shared< TAC::ThreeAddrInstruction >( "branchTarget", TAC::Opcode::BRLT, "var1", "var2" ),
-        // expect another immediate new block, at index 6
-        std::make_shared< TAC::ThreeAddrInstruction >( "var1", 5u ),
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u } ),
+        // expect a block boundary due to using a label, as it may be branched to - next block at index 4
+        TAC::ThreeAddrInstruction( m_var2, TAC::Opcode::ADD, m_var1, m_var1, m_label ),
+        TAC::ThreeAddrInstruction( m_branchTarget, TAC::Opcode::BRLT, m_var1, m_var2 ),
+        // expect another new block after the branch, at index 6
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u }, m_branchTarget ),
     };
 
-    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions );
-    BOOST_CHECK_EQUAL( 0u, generator->m_basicBlockStarts.size() );
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    BOOST_CHECK( nullptr == generator->GetControlFlowGraph() );
     generator->CalculateBasicBlocks();
 
-    const std::vector< size_t > expectedBlockBoundaries{ 0, 3, 5, 6 };
+    BOOST_REQUIRE( nullptr != generator->GetControlFlowGraph() );
+    const TAC::ControlFlowGraph& cfg = *generator->GetControlFlowGraph();
+    std::vector< size_t > blockStarts;
+    for ( size_t block = 0; block < cfg.GetNumBlocks(); ++block )
+    {
+        blockStarts.push_back( cfg.GetBlock( block ).start );
+    }
+    const std::vector< size_t > expectedBlockBoundaries{ 0, 3, 4, 6 };
     BOOST_CHECK_EQUAL_COLLECTIONS( expectedBlockBoundaries.begin(), expectedBlockBoundaries.end(),
-                                   generator->m_basicBlockStarts.begin(), generator->m_basicBlockStarts.end() );
+                                   blockStarts.begin(), blockStarts.end() );
 }
 
 /**
- * Tests that method for calculating live intervals will ignore empty string identifiers, and not add any entries.
+ * Tests that method for calculating live intervals will ignore invalid variable IDs, and not add any entries.
  */
-BOOST_AUTO_TEST_CASE( CalculateLiveIntervals_EmptyString )
+BOOST_AUTO_TEST_CASE( CalculateLiveIntervals_InvalidVarId )
 {
-    // Use fake instruction with empty string identifier (this wouldn't be a valid lhs value but this is for the sake
+    // Use fake instruction with invalid variable ID (this wouldn't be a valid lhs value but this is for the sake
     // of testing the live interval method only.
     AssemblyGenerator::TacInstructions instructions{
-        std::make_shared< TAC::ThreeAddrInstruction >( "", 5u )
+        TAC::ThreeAddrInstruction( g_invalidVarId, TAC::Literal{ 5u } )
     };
 
-    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions );
-    BOOST_CHECK_EQUAL( 0u, generator->m_liveIntervals.size() );
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    BOOST_CHECK_EQUAL( 0u, generator->m_liveRanges.size() );
+    generator->CalculateBasicBlocks();
     generator->CalculateLiveIntervals();
     // Check no entry has been added
-    BOOST_CHECK_EQUAL( 0u, generator->m_liveIntervals.size() );
+    BOOST_CHECK_EQUAL( 0u, generator->m_liveRanges.size() );
 }
 
 /**
@@ -113,21 +192,21 @@ BOOST_AUTO_TEST_CASE( CalculateLiveIntervals_EmptyString )
  */
 BOOST_AUTO_TEST_CASE( CalculateLiveIntervals_OneReference )
 {
-    const std::string id{ "var1"};
     AssemblyGenerator::TacInstructions instructions{
-        std::make_shared< TAC::ThreeAddrInstruction >( id, 5u )
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u } )
     };
 
-    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions );
-    BOOST_CHECK_EQUAL( 0u, generator->m_liveIntervals.size() );
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    BOOST_CHECK_EQUAL( 0u, generator->m_liveRanges.size() );
+    generator->CalculateBasicBlocks();
     generator->CalculateLiveIntervals();
 
-    BOOST_REQUIRE_EQUAL( 1u, generator->m_liveIntervals.size() );
-    AssemblyGenerator_Test::LiveInterval liveInterval = generator->m_liveIntervals[id];
+    BOOST_REQUIRE_EQUAL( 1u, generator->m_liveRanges.size() );
+    const LiveRange& liveRange = generator->m_liveRanges[m_var1];
     constexpr size_t expectedStartIndex{ 0u };
     constexpr size_t expectedEndIndex{ expectedStartIndex };
-    BOOST_CHECK_EQUAL( expectedStartIndex, liveInterval.first );
-    BOOST_CHECK_EQUAL( expectedEndIndex, liveInterval.second );
+    BOOST_CHECK_EQUAL( expectedStartIndex, liveRange.GetStart() );
+    BOOST_CHECK_EQUAL( expectedEndIndex, liveRange.GetEnd() );
 }
 
 /**
@@ -136,14 +215,17 @@ BOOST_AUTO_TEST_CASE( CalculateLiveIntervals_OneReference )
 BOOST_AUTO_TEST_CASE( CalculateLiveIntervals_DoesntAddBranchTarget )
 {
     AssemblyGenerator::TacInstructions instructions{
-        std::make_shared< TAC::ThreeAddrInstruction >( "branchTarget", TAC::Opcode::BRE, "", "" )
+        TAC::ThreeAddrInstruction(
+            m_branchTarget, TAC::Opcode::BRE, g_invalidVarId, g_invalidVarId, m_branchTarget
+        )
     };
 
-    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions );
-    BOOST_CHECK_EQUAL( 0u, generator->m_liveIntervals.size() );
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    BOOST_CHECK_EQUAL( 0u, generator->m_liveRanges.size() );
+    generator->CalculateBasicBlocks();
     generator->CalculateLiveIntervals();
     // Check no entry has been added
-    BOOST_CHECK_EQUAL( 0u, generator->m_liveIntervals.size() );
+    BOOST_CHECK_EQUAL( 0u, generator->m_liveRanges.size() );
 }
 
 /**
@@ -152,35 +234,491 @@ BOOST_AUTO_TEST_CASE( CalculateLiveIntervals_DoesntAddBranchTarget )
  */
 BOOST_AUTO_TEST_CASE( CalculateLiveIntervals_MultipleReferences )
 {
-    const std::string varA{ "a" }; // Expect range of 0-2
-    const std::string varB{ "b" }; // Expect range of 1-3
-    const std::string varC{ "c" }; // Expect range of 2-2
+    const VarId varA = m_variableTable->AddVariable( "a" ); // Expect range of 0-2
+    const VarId varB = m_variableTable->AddVariable( "b" ); // Expect range of 1-3
+    const VarId varC = m_variableTable->AddVariable( "c" ); // Expect range of 2-2
 
     // Some assignment/operation instructions with variables of varying live intervals.
     AssemblyGenerator::TacInstructions instructions{
-        std::make_shared< TAC::ThreeAddrInstruction >( varA, 1u ),
-        std::make_shared< TAC::ThreeAddrInstruction >( varB, 2u ),
-        std::make_shared< TAC::ThreeAddrInstruction >( varC, TAC::Opcode::ADD, varA, varB ),
-        std::make_shared< TAC::ThreeAddrInstruction >( varB, 3u ),
+        TAC::ThreeAddrInstruction( varA, TAC::Literal{ 1u } ),
+        TAC::ThreeAddrInstruction( varB, TAC::Literal{ 2u } ),
+        TAC::ThreeAddrInstruction( varC, TAC::Opcode::ADD, varA, varB ),
+        TAC::ThreeAddrInstruction( varB, TAC::Literal{ 3u } ),
+    };
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    BOOST_CHECK_EQUAL( 0u, generator->m_liveRanges.size() );
+    generator->CalculateBasicBlocks();
+    generator->CalculateLiveIntervals();
+
+    BOOST_REQUIRE_EQUAL( 3u, generator->m_liveRanges.size() );
+
+    const LiveRange& liveRangeA = generator->m_liveRanges[varA];
+    BOOST_CHECK_EQUAL( 0u, liveRangeA.GetStart() );
+    BOOST_CHECK_EQUAL( 2u, liveRangeA.GetEnd() );
+
+    const LiveRange& liveRangeB = generator->m_liveRanges[varB];
+    BOOST_CHECK_EQUAL( 1u, liveRangeB.GetStart() );
+    BOOST_CHECK_EQUAL( 3u, liveRangeB.GetEnd() );
+
+    const LiveRange& liveRangeC = generator->m_liveRanges[varC];
+    BOOST_CHECK_EQUAL( 2u, liveRangeC.GetStart() );
+    BOOST_CHECK_EQUAL( 2u, liveRangeC.GetEnd() );
+}
+
+/**
+ * Tests that method for calculating live intervals extends the interval of a variable whose value is carried around a
+ * loop, to the end of the loop, even though it isn't referenced there.
+ */
+BOOST_AUTO_TEST_CASE( CalculateLiveIntervals_LiveAcrossLoop )
+{
+    const VarId varA = m_variableTable->AddVariable( "a" ); // Used at the loop head, so expect range of 0-3
+    const VarId varB = m_variableTable->AddVariable( "b" ); // Expect range of 1-4
+    const VarId varC = m_variableTable->AddVariable( "c" ); // Expect range of 2-4
+
+    AssemblyGenerator::TacInstructions instructions{
+        TAC::ThreeAddrInstruction( varA, TAC::Literal{ 1u } ),
+        TAC::ThreeAddrInstruction( varB, TAC::Opcode::ADD, varA, varA, m_label ),
+        TAC::ThreeAddrInstruction( varC, TAC::Opcode::ADD, varB, varB ),
+        TAC::ThreeAddrInstruction( m_label, TAC::Opcode::BRLT, varB, varC ),
+        TAC::ThreeAddrInstruction( varB, varC )
+    };
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
+    generator->CalculateLiveIntervals();
+
+    BOOST_REQUIRE( nullptr != generator->GetLiveness() );
+    BOOST_CHECK( generator->GetLiveness()->IsLiveOut( 1, varA ) );
+
+    const LiveRange& liveRangeA = generator->m_liveRanges[varA];
+    BOOST_CHECK_EQUAL( 0u, liveRangeA.GetStart() );
+    BOOST_CHECK_EQUAL( 3u, liveRangeA.GetEnd() );
+
+    const LiveRange& liveRangeB = generator->m_liveRanges[varB];
+    BOOST_CHECK_EQUAL( 1u, liveRangeB.GetStart() );
+    BOOST_CHECK_EQUAL( 4u, liveRangeB.GetEnd() );
+
+    const LiveRange& liveRangeC = generator->m_liveRanges[varC];
+    BOOST_CHECK_EQUAL( 2u, liveRangeC.GetStart() );
+    BOOST_CHECK_EQUAL( 4u, liveRangeC.GetEnd() );
+}
+
+/**
+ * Tests that a variable's live range has a hole between the last read of one value and it being written to again.
+ */
+BOOST_AUTO_TEST_CASE( CalculateLiveIntervals_LifetimeHole )
+{
+    const VarId varA = m_variableTable->AddVariable( "a" ); // Expect segments of 0-1 and 3-4
+    const VarId varB = m_variableTable->AddVariable( "b" );
+    const VarId varC = m_variableTable->AddVariable( "c" );
+
+    AssemblyGenerator::TacInstructions instructions{
+        TAC::ThreeAddrInstruction( varA, TAC::Literal{ 1u } ),
+        TAC::ThreeAddrInstruction( varB, TAC::Opcode::ADD, varA, varA ),
+        TAC::ThreeAddrInstruction( varC, TAC::Opcode::ADD, varB, varB ),
+        TAC::ThreeAddrInstruction( varA, TAC::Literal{ 2u } ),
+        TAC::ThreeAddrInstruction( varB, TAC::Opcode::ADD, varA, varC )
+    };
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
+    generator->CalculateLiveIntervals();
+
+    const LiveRange& liveRangeA = generator->m_liveRanges[varA];
+    const std::vector< LiveRange::Segment > expectedSegments{ { 0u, 1u }, { 3u, 4u } };
+    BOOST_REQUIRE_EQUAL( expectedSegments.size(), liveRangeA.segments.size() );
+    BOOST_CHECK( expectedSegments == liveRangeA.segments );
+    BOOST_CHECK( !liveRangeA.Covers( 2u ) );
+
+    // The value of c is live from its only write to its only read, so there is no hole.
+    const LiveRange& liveRangeC = generator->m_liveRanges[varC];
+    BOOST_CHECK_EQUAL( 1u, liveRangeC.segments.size() );
+    BOOST_CHECK_EQUAL( 2u, liveRangeC.GetStart() );
+    BOOST_CHECK_EQUAL( 4u, liveRangeC.GetEnd() );
+}
+
+/**
+ * Tests that method for calculating live intervals throws if the basic blocks haven't been calculated first.
+ */
+BOOST_AUTO_TEST_CASE( CalculateLiveIntervals_NoBasicBlocks )
+{
+    AssemblyGenerator::TacInstructions instructions{
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u } )
+    };
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    BOOST_CHECK_THROW( generator->CalculateLiveIntervals(), std::runtime_error );
+}
+
+/**
+ * Tests that spill costs count the loads and stores each reference would need, weighted by the loop depth of the
+ * instruction.
+ */
+BOOST_AUTO_TEST_CASE( CalculateSpillCosts_WeightedByLoopDepth )
+{
+    const VarId counter = m_variableTable->AddVariable( "counter" );
+
+    AssemblyGenerator::TacInstructions instructions{
+        TAC::ThreeAddrInstruction( counter, TAC::Literal{ 8u } ),
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 1u } ),
+        TAC::ThreeAddrInstruction( counter, TAC::Opcode::SUB, counter, m_var1, m_label ),
+        TAC::ThreeAddrInstruction( m_label, TAC::Opcode::BRLT, g_invalidVarId, counter ),
+        TAC::ThreeAddrInstruction( m_var2, TAC::Opcode::ADD, m_var1, m_var1 )
+    };
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
+    generator->CalculateLiveIntervals();
+    BOOST_REQUIRE_EQUAL( 1u, generator->GetControlFlowGraph()->GetLoops().size() );
+
+    RegisterAllocator::SpillCosts spillCosts = generator->CalculateSpillCosts();
+    BOOST_REQUIRE_EQUAL( 3u, spillCosts.size() );
+
+    const double loopFrequency = LOOP_ITERATIONS_ESTIMATE;
+    // Counter: a store outside the loop, and a load, store and load inside it.
+    BOOST_CHECK_EQUAL( SPILL_STORE_COST + loopFrequency * ( 2 * SPILL_LOAD_COST + SPILL_STORE_COST ),
+                       spillCosts[counter] );
+    // Var 1: a store outside the loop, a load inside it, then two loads after it.
+    BOOST_CHECK_EQUAL( SPILL_STORE_COST + loopFrequency * SPILL_LOAD_COST + 2 * SPILL_LOAD_COST, spillCosts[m_var1] );
+    BOOST_CHECK_EQUAL( static_cast< double >( SPILL_STORE_COST ), spillCosts[m_var2] );
+}
+
+/**
+ * Tests that allocating registers throws if the live intervals haven't been calculated first.
+ */
+BOOST_AUTO_TEST_CASE( AllocateRegisters_NoLiveIntervals )
+{
+    AssemblyGenerator::TacInstructions instructions{
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u } )
+    };
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
+    BOOST_CHECK_THROW( generator->AllocateRegisters(), std::runtime_error );
+}
+
+/**
+ * Tests that spilled variables whose live ranges don't overlap share a memory location.
+ */
+BOOST_AUTO_TEST_CASE( AllocateRegisters_SharesMemoryLocations )
+{
+    AssemblyGenerator::TacInstructions instructions;
+    std::vector< VarId > firstVars = AddRegisterPressure( instructions, "a" );
+    std::vector< VarId > secondVars = AddRegisterPressure( instructions, "b" );
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
+    generator->CalculateLiveIntervals();
+    generator->AllocateRegisters();
+
+    const std::vector< VarId >& spilledVars = generator->GetRegisterAllocator()->GetSpilledVars();
+    BOOST_REQUIRE_EQUAL( 2u, spilledVars.size() );
+    BOOST_CHECK( firstVars.back() == spilledVars.front() );
+    BOOST_CHECK( secondVars.back() == spilledVars.back() );
+    BOOST_CHECK_EQUAL( MEM_ADDR_OFFSET, generator->GetMemoryLocation( firstVars.back() ) );
+    BOOST_CHECK_EQUAL( MEM_ADDR_OFFSET, generator->GetMemoryLocation( secondVars.back() ) );
+    BOOST_CHECK_EQUAL( 1u, generator->GetPeakMemoryUsage() );
+}
+
+/**
+ * Tests that allocating registers throws if more spilled variables are live at once than there are memory locations.
+ */
+BOOST_AUTO_TEST_CASE( AllocateRegisters_OutOfMemory )
+{
+    std::vector< VarId > vars;
+    AssemblyGenerator::TacInstructions instructions;
+    for ( size_t index = 0; index <= NUM_AVAILABLE_REGS + NUM_MEM_ADDRS; ++index )
+    {
+        vars.push_back( m_variableTable->AddVariable( "v" + std::to_string( index ) ) );
+        instructions.emplace_back( vars.back(), TAC::Literal{ 0u } );
+    }
+    for ( VarId var : vars )
+    {
+        instructions.emplace_back( var, TAC::Opcode::ADD, var, var );
+    }
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
+    generator->CalculateLiveIntervals();
+    BOOST_CHECK_THROW( generator->AllocateRegisters(), std::runtime_error );
+}
+
+/**
+ * Tests that generating assembly throws if the basic blocks, live intervals and registers haven't been calculated
+ * first.
+ */
+BOOST_AUTO_TEST_CASE( GenerateAssemblyInstructions_NoBasicBlocks )
+{
+    AssemblyGenerator::TacInstructions instructions{
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u } )
+    };
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    BOOST_CHECK_THROW( generator->GenerateAssemblyInstructions(), std::runtime_error );
+    generator->CalculateBasicBlocks();
+    BOOST_CHECK_THROW( generator->GenerateAssemblyInstructions(), std::runtime_error );
+    generator->CalculateLiveIntervals();
+    BOOST_CHECK_THROW( generator->GenerateAssemblyInstructions(), std::runtime_error );
+}
+
+/**
+ * Tests that a variable live across a block boundary keeps its register, so is neither saved at the end of the first
+ * block nor loaded in the second.
+ */
+BOOST_AUTO_TEST_CASE( GenerateAssemblyInstructions_KeepsRegistersAcrossBlocks )
+{
+    const VarId temp = m_variableTable->AddVariable( "temp" );
+
+    AssemblyGenerator::TacInstructions instructions{
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u } ),
+        // The temporary is only used in the first block, so is dead at its end.
+        TAC::ThreeAddrInstruction( temp, TAC::Opcode::ADD, m_var1, m_var1 ),
+        // Var 1 is used in the second block, having been written to in the first.
+        TAC::ThreeAddrInstruction( m_var2, TAC::Opcode::SUB, m_var1, m_var1, m_label )
+    };
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
+    generator->CalculateLiveIntervals();
+    generator->AllocateRegisters();
+    BOOST_REQUIRE_EQUAL( 2u, generator->GetControlFlowGraph()->GetNumBlocks() );
+
+    Instructions assembly = generator->GenerateAssemblyInstructions();
+
+    size_t numMemoryAccesses = std::count_if( assembly.begin(), assembly.end(),
+                                              []( const Instruction& instruction )
+                                              {
+                                                  Opcode opcode = std::get< 1 >( instruction );
+                                                  return Opcode::STR == opcode || Opcode::LD == opcode;
+                                              } );
+    BOOST_CHECK_EQUAL( 0u, numMemoryAccesses );
+    BOOST_REQUIRE_EQUAL( instructions.size(), assembly.size() );
+
+    // Var 1 is written to in the first instruction, and read in the last.
+    uint8_t var1Register = std::get< uint8_t >( std::get< 2 >( assembly.front() ) );
+    BOOST_CHECK_EQUAL( var1Register, std::get< 3 >( assembly.back() ) );
+    BOOST_CHECK( m_label == std::get< 0 >( assembly.back() ) );
+}
+
+/**
+ * Tests that when more variables are live at once than there are registers, one is spilled for its whole live range:
+ * it is saved after every write whose value is read, and loaded into a temporary register before every read.
+ */
+BOOST_AUTO_TEST_CASE( GenerateAssemblyInstructions_SpillsWhenOutOfRegisters )
+{
+    AssemblyGenerator::TacInstructions instructions;
+    std::vector< VarId > vars = AddRegisterPressure( instructions, "v" );
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
+    generator->CalculateLiveIntervals();
+    generator->AllocateRegisters();
+
+    // All variables are referenced the same number of times, so the last one written is spilled as it lives longest.
+    const std::vector< VarId >& spilledVars = generator->GetRegisterAllocator()->GetSpilledVars();
+    BOOST_REQUIRE_EQUAL( 1u, spilledVars.size() );
+    BOOST_CHECK( vars.back() == spilledVars.front() );
+
+    Instructions assembly = generator->GenerateAssemblyInstructions();
+    auto countOpcode = [&]( Opcode opcode )
+    {
+        return std::count_if( assembly.begin(), assembly.end(),
+                              [&]( const Instruction& instruction )
+                              {
+                                  return opcode == std::get< 1 >( instruction );
+                              } );
+    };
+    // Two writes to the spilled variable, of which only the first is read again, and two reads of it by the same
+    // instruction.
+    BOOST_CHECK_EQUAL( 1, countOpcode( Opcode::STR ) );
+    BOOST_CHECK_EQUAL( 2, countOpcode( Opcode::LD ) );
+}
+
+/**
+ * Tests that writing a value to a spilled variable that is never read doesn't store it to memory, even if the variable
+ * is written to again straight afterwards.
+ */
+BOOST_AUTO_TEST_CASE( GenerateAssemblyInstructions_SkipsDeadStoreOfSpilledVar )
+{
+    AssemblyGenerator::TacInstructions instructions;
+    std::vector< VarId > vars = AddRegisterPressure( instructions, "v" );
+    // Write to every variable twice more without reading it. Every variable is given the same extra writes, so the last
+    // is still the one spilled.
+    for ( VarId var : vars )
+    {
+        instructions.emplace_back( var, TAC::Literal{ 7u } );
+        instructions.emplace_back( var, TAC::Literal{ 7u } );
+    }
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
+    generator->CalculateLiveIntervals();
+    generator->AllocateRegisters();
+    BOOST_REQUIRE( generator->GetRegisterAllocator()->IsSpilled( vars.back() ) );
+
+    // Of the four writes to the spilled variable, only the first is read, so only it is stored.
+    Instructions assembly = generator->GenerateAssemblyInstructions();
+    size_t numStores = std::count_if( assembly.begin(), assembly.end(),
+                                      []( const Instruction& instruction )
+                                      {
+                                          return Opcode::STR == std::get< 1 >( instruction );
+                                      } );
+    BOOST_CHECK_EQUAL( 1u, numStores );
+}
+
+/**
+ * Tests that the address of a spilled variable is only loaded once in a block, as long as the register holding it
+ * isn't overwritten in between.
+ */
+BOOST_AUTO_TEST_CASE( GenerateAssemblyInstructions_SkipsRepeatedAddressLoads )
+{
+    AssemblyGenerator::TacInstructions instructions;
+    AddRegisterPressure( instructions, "v" );
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
+    generator->CalculateLiveIntervals();
+    generator->AllocateRegisters();
+    BOOST_REQUIRE_EQUAL( 1u, generator->GetControlFlowGraph()->GetNumBlocks() );
+    BOOST_REQUIRE_EQUAL( 1u, generator->GetRegisterAllocator()->GetSpilledVars().size() );
+
+    // The spilled variable is stored, then loaded twice and stored again, all from the same address.
+    Instructions assembly = generator->GenerateAssemblyInstructions();
+    BOOST_CHECK_EQUAL( 1u, CountAddressLoads( assembly ) );
+}
+
+/**
+ * Tests that the values held by registers are forgotten at the start of a block, as it may be branched to.
+ */
+BOOST_AUTO_TEST_CASE( GenerateAssemblyInstructions_ReloadsAddressInNewBlock )
+{
+    AssemblyGenerator::TacInstructions instructions;
+    AddRegisterPressure( instructions, "v" );
+    // Start a new block at the first read of the variables.
+    instructions[NUM_AVAILABLE_REGS + 1u].m_label = m_label;
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
+    generator->CalculateLiveIntervals();
+    generator->AllocateRegisters();
+    BOOST_REQUIRE_EQUAL( 2u, generator->GetControlFlowGraph()->GetNumBlocks() );
+
+    Instructions assembly = generator->GenerateAssemblyInstructions();
+    BOOST_CHECK_EQUAL( 2u, CountAddressLoads( assembly ) );
+}
+
+/**
+ * Tests that assigning a literal to a variable is skipped if its register still holds that literal, but not if the
+ * register has been written to since.
+ */
+BOOST_AUTO_TEST_CASE( GenerateAssemblyInstructions_SkipsRepeatedLiteral )
+{
+    AssemblyGenerator::TacInstructions instructions{
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u } ),
+        TAC::ThreeAddrInstruction( m_var2, TAC::Opcode::ADD, m_var1, m_var1 ),
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u } ),
+        TAC::ThreeAddrInstruction( m_var1, TAC::Opcode::ADD, m_var1, m_var2 ),
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u } ),
+        TAC::ThreeAddrInstruction( m_var2, TAC::Opcode::ADD, m_var1, m_var1 )
     };
 
-    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions );
-    BOOST_CHECK_EQUAL( 0u, generator->m_liveIntervals.size() );
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
     generator->CalculateLiveIntervals();
+    generator->AllocateRegisters();
+
+    Instructions assembly = generator->GenerateAssemblyInstructions();
+    const std::vector< Opcode > expectedOpcodes{ Opcode::LDI, Opcode::ADD, Opcode::ADD, Opcode::LDI, Opcode::ADD };
+    std::vector< Opcode > opcodes;
+    for ( const Instruction& instruction : assembly )
+    {
+        opcodes.push_back( std::get< 1 >( instruction ) );
+    }
+    BOOST_CHECK_EQUAL_COLLECTIONS( expectedOpcodes.begin(), expectedOpcodes.end(), opcodes.begin(), opcodes.end() );
+}
+
+/**
+ * Tests that a loop counter is kept in a register in preference to variables only used outside the loop, even though
+ * its live range is the longest.
+ */
+BOOST_AUTO_TEST_CASE( GenerateAssemblyInstructions_KeepsLoopCounterInRegister )
+{
+    const VarId counter = m_variableTable->AddVariable( "counter" );
 
-    BOOST_REQUIRE_EQUAL( 3u, generator->m_liveIntervals.size() );
+    // Fill every register with a variable live across the loop, but not used in it.
+    std::vector< VarId > vars;
+    AssemblyGenerator::TacInstructions instructions;
+    for ( size_t index = 0; index < NUM_AVAILABLE_REGS; ++index )
+    {
+        vars.push_back( m_variableTable->AddVariable( "v" + std::to_string( index ) ) );
+        instructions.emplace_back( vars.back(), TAC::Literal{ static_cast< TAC::Literal >( index ) } );
+    }
+    instructions.emplace_back( counter, TAC::Literal{ 8u } );
+    instructions.emplace_back( counter, TAC::Opcode::RS, counter, counter, m_label );
+    instructions.emplace_back( m_label, TAC::Opcode::BRLT, g_invalidVarId, counter );
+    for ( VarId var : vars )
+    {
+        instructions.emplace_back( var, TAC::Opcode::ADD, var, var );
+    }
+    instructions.emplace_back( m_var1, TAC::Opcode::ADD, counter, counter );
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
+    generator->CalculateLiveIntervals();
+    generator->AllocateRegisters();
 
-    AssemblyGenerator_Test::LiveInterval liveIntervalA = generator->m_liveIntervals[varA];
-    BOOST_CHECK_EQUAL( 0u, liveIntervalA.first );
-    BOOST_CHECK_EQUAL( 2u, liveIntervalA.second );
+    const std::vector< VarId >& spilledVars = generator->GetRegisterAllocator()->GetSpilledVars();
+    BOOST_REQUIRE_EQUAL( 1u, spilledVars.size() );
+    BOOST_CHECK( counter != spilledVars.front() );
+
+    // None of the loop's instructions need loads or stores.
+    Instructions assembly = generator->GenerateAssemblyInstructions();
+    auto loopStart = std::find_if( assembly.begin(), assembly.end(),
+                                   [&]( const Instruction& instruction )
+                                   {
+                                       return m_label == std::get< 0 >( instruction );
+                                   } );
+    BOOST_REQUIRE( assembly.end() != loopStart );
+    BOOST_CHECK( Opcode::RS == std::get< 1 >( *loopStart ) );
+    BOOST_CHECK( Opcode::BRLT == std::get< 1 >( *std::next( loopStart ) ) );
+}
+
+/**
+ * Tests that generating assembly converts the instructions of every block, including all of the last block.
+ */
+BOOST_AUTO_TEST_CASE( GenerateAssemblyInstructions_MultipleBlocks )
+{
+    AssemblyGenerator::TacInstructions instructions{
+        TAC::ThreeAddrInstruction( m_var1, TAC::Literal{ 5u } ),
+        TAC::ThreeAddrInstruction( m_branchTarget, TAC::Opcode::BRE, m_var1, g_invalidVarId ),
+        TAC::ThreeAddrInstruction( m_var2, TAC::Opcode::ADD, m_var1, m_var1, m_branchTarget ),
+        TAC::ThreeAddrInstruction( m_var1, TAC::Opcode::SUB, m_var2, m_var1 ),
+        TAC::ThreeAddrInstruction( m_var2, TAC::Opcode::LS, m_var1, g_invalidVarId )
+    };
+
+    AssemblyGenerator_Test::Ptr generator = std::make_shared< AssemblyGenerator_Test >( instructions, m_variableTable );
+    generator->CalculateBasicBlocks();
+    generator->CalculateLiveIntervals();
+    generator->AllocateRegisters();
+    BOOST_REQUIRE_EQUAL( 2u, generator->GetControlFlowGraph()->GetNumBlocks() );
 
-    AssemblyGenerator_Test::LiveInterval liveIntervalB = generator->m_liveIntervals[varB];
-    BOOST_CHECK_EQUAL( 1u, liveIntervalB.first );
-    BOOST_CHECK_EQUAL( 3u, liveIntervalB.second );
+    Instructions assembly = generator->GenerateAssemblyInstructions();
 
-    AssemblyGenerator_Test::LiveInterval liveIntervalC = generator->m_liveIntervals[varC];
-    BOOST_CHECK_EQUAL( 2u, liveIntervalC.first );
-    BOOST_CHECK_EQUAL( 2u, liveIntervalC.second );
+    // Every operation should have been converted, in order. Loads and stores are also added around these for variables
+    // in memory, so ignore them.
+    const std::vector< Opcode > expectedOpcodes{ Opcode::BRE, Opcode::ADD, Opcode::SUB, Opcode::LS };
+    std::vector< Opcode > convertedOpcodes;
+    for ( const Instruction& instruction : assembly )
+    {
+        Opcode opcode = std::get< 1 >( instruction );
+        if ( Opcode::LDI != opcode && Opcode::LD != opcode && Opcode::STR != opcode )
+        {
+            convertedOpcodes.push_back( opcode );
+        }
+    }
+    BOOST_CHECK_EQUAL_COLLECTIONS( expectedOpcodes.begin(), expectedOpcodes.end(),
+                                   convertedOpcodes.begin(), convertedOpcodes.end() );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // AssemblyGeneratorTests
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include <boost/test/unit_test.hpp>
+#include "AstArena.h"
+
+BOOST_AUTO_TEST_SUITE( AstArenaTests )
+
+/**
+ * Tests that a node created from child nodes refers to those children, in order.
+ */
+BOOST_AUTO_TEST_CASE( CreateNode_Children )
+{
+    AstArena arena;
+    AstNode child1 = arena.CreateNode( TokenType::BYTE, Token( TokenType::BYTE, 1u ) );
+    AstNode child2 = arena.CreateNode( TokenType::BYTE, Token( TokenType::BYTE, 2u ) );
+    AstNode parent = arena.CreateNode( TokenType::PLUS, AstNode::Children{ child1, child2 } );
+    BOOST_CHECK_EQUAL( 3u, arena.GetNumNodes() );
+
+    BOOST_CHECK_EQUAL( TokenType::PLUS, parent.GetNodeLabel() );
+    BOOST_REQUIRE( !parent.IsStoringToken() );
+    AstNode::ChildRange children = parent.GetChildren();
+    BOOST_REQUIRE_EQUAL( 2u, children.size() );
+    BOOST_CHECK( child1 == children[0] );
+    BOOST_CHECK( child2 == children[1] );
+
+    size_t numVisited{ 0u };
+    for ( AstNode child : children )
+    {
+        BOOST_CHECK( Token( TokenType::BYTE, static_cast< uint8_t >( numVisited + 1u ) ) == child.GetToken() );
+        ++numVisited;
+    }
+    BOOST_CHECK_EQUAL( 2u, numVisited );
+}
+
+/**
+ * Tests that a node's children can still be read after more nodes have been added to the arena.
+ */
+BOOST_AUTO_TEST_CASE( ChildRange_ValidAfterMoreNodesAdded )
+{
+    AstArena arena;
+    AstNode child = arena.CreateNode( TokenType::IDENTIFIER, Token( TokenType::IDENTIFIER, "child" ) );
+    AstNode parent = arena.CreateNode( TokenType::NOT, AstNode::Children{ child } );
+    AstNode::ChildRange children = parent.GetChildren();
+
+    for ( size_t i = 0u; i < 1000u; ++i )
+    {
+        arena.CreateNode( TokenType::NOT, AstNode::Children{ parent } );
+    }
+
+    BOOST_REQUIRE_EQUAL( 1u, children.size() );
+    BOOST_CHECK( child == children[0] );
+    BOOST_CHECK_THROW( children[1], std::out_of_range );
+}
+
+/**
+ * Tests that a node can't be created from a null child, or from a child stored in a different arena.
+ */
+BOOST_AUTO_TEST_CASE( CreateNode_InvalidChild )
+{
+    AstArena arena;
+    AstArena otherArena;
+    AstNode otherChild = otherArena.CreateNode( TokenType::BYTE, Token( TokenType::BYTE, 1u ) );
+
+    BOOST_CHECK_THROW( arena.CreateNode( TokenType::NOT, AstNode::Children{ otherChild } ), std::invalid_argument );
+    BOOST_CHECK_THROW( arena.CreateNode( TokenType::NOT, AstNode::Children{ nullptr } ), std::invalid_argument );
+}
+
+/**
+ * Tests that a symbol table assigned to a node can be read back, other nodes are unaffected, and a node from another
+ * arena can't be assigned one.
+ */
+BOOST_AUTO_TEST_CASE( SymbolTableAnnotation )
+{
+    AstArena arena;
+    AstNode child = arena.CreateNode( TokenType::BYTE, Token( TokenType::BYTE, 1u ) );
+    AstNode scopeNode = arena.CreateNode( TokenType::WHILE, AstNode::Children{ child } );
+    BOOST_CHECK_EQUAL( nullptr, scopeNode.GetSymbolTable() );
+
+    SymbolTable::Ptr table = std::make_shared< SymbolTable >( nullptr );
+    arena.SetSymbolTable( scopeNode, table );
+    BOOST_CHECK_EQUAL( table, scopeNode.GetSymbolTable() );
+    BOOST_CHECK_EQUAL( nullptr, child.GetSymbolTable() );
+
+    // Only nodes stored in the arena can be given a table.
+    AstArena otherArena;
+    AstNode otherNode = otherArena.CreateNode( TokenType::WHILE, Token( TokenType::WHILE ) );
+    BOOST_CHECK_THROW( arena.SetSymbolTable( otherNode, table ), std::invalid_argument );
+    BOOST_CHECK_THROW( arena.SetSymbolTable( nullptr, table ), std::invalid_argument );
+    BOOST_CHECK_EQUAL( nullptr, otherNode.GetSymbolTable() );
+}
+
+/**
+ * Tests that a null node compares equal to nullptr, and can't be read.
+ */
+BOOST_AUTO_TEST_CASE( NullNode )
+{
+    AstNode node;
+    BOOST_CHECK( nullptr == node );
+    BOOST_CHECK_THROW( node.GetNodeLabel(), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // AstArenaTests
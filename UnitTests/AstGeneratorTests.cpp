@@ -1,6 +1,20 @@
 #include <boost/test/unit_test.hpp>
 #include "AstGenerator.h"
 
+/**
+ * Exposes the look-ahead used by AstGenerator.
+ */
+class AstGenerator_Test : public AstGenerator
+{
+public:
+    AstGenerator_Test( const Tokens& tokens, GrammarSymbols::NT startingNt, AstArena& arena )
+    : AstGenerator( tokens, startingNt, arena )
+    {}
+
+    using AstGenerator::PerformLookAhead;
+    using AstGenerator::m_matchingBrackets;
+};
+
 class AstGeneratorTestsFixture
 {
 public:
@@ -11,14 +25,18 @@ public:
      *         the token type, and checks it is storing the given token.
      */
     void
-    CheckNodeIsTokenWrapper( AstNode::Ptr node, Token::Ptr token )
+    CheckNodeIsTokenWrapper( AstNode node, Token token )
     {
-        BOOST_CHECK_EQUAL( token->m_type, node->m_nodeLabel );
-        BOOST_REQUIRE( node->IsStoringToken() );
-        BOOST_REQUIRE( node->IsStorageInUse() );
-        Token::Ptr nodeToken = node->GetToken();
-        BOOST_CHECK( *token.get() == *nodeToken.get() );
+        BOOST_CHECK_EQUAL( token.m_type, node.GetNodeLabel() );
+        BOOST_REQUIRE( node.IsStoringToken() );
+        BOOST_REQUIRE( node.IsStorageInUse() );
+        Token nodeToken = node.GetToken();
+        BOOST_CHECK( token == nodeToken );
     }
+
+protected:
+    // Arena storing the nodes of the ASTs created by the test case.
+    AstArena m_arena;
 };
 
 BOOST_FIXTURE_TEST_SUITE( AstGeneratorTests, AstGeneratorTestsFixture )
@@ -30,7 +48,7 @@ BOOST_AUTO_TEST_CASE( EmptyTokens )
 {
     Tokens tokens{};
     constexpr GrammarSymbols::NT startingNt { NT::Block };
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
     BOOST_CHECK_THROW( astGenerator->GenerateAst(), std::invalid_argument );
 }
 
@@ -41,10 +59,10 @@ BOOST_AUTO_TEST_CASE( EmptyTokens )
 BOOST_AUTO_TEST_CASE( StartingNtHasNoRules )
 {
     // Arbitrary token to avoid the empty tokens error
-    Tokens tokens{ std::make_shared< Token >( TokenType::AND ) };
+    Tokens tokens{ Token( TokenType::AND ) };
     // Out of range value
     constexpr GrammarSymbols::NT startingNt { static_cast< NT >( SymbolType::NonTerminal + 1000u ) };
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
     BOOST_CHECK_THROW( astGenerator->GenerateAst(), std::invalid_argument );
 }
 
@@ -57,11 +75,11 @@ BOOST_AUTO_TEST_CASE( NoMatchesForAnyRules )
     // Variable can either resolve to data type + id, or just id
     constexpr GrammarSymbols::NT startingNt { Variable };
     // Arbitrary token - doesn't match above rules
-    Tokens tokens{ std::make_shared< Token >( TokenType::AND ) };
+    Tokens tokens{ Token( TokenType::AND ) };
 
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
 
-    BOOST_CHECK_EQUAL( nullptr, astGenerator->GenerateAst() );
+    BOOST_CHECK( nullptr == astGenerator->GenerateAst() );
 }
 
 /**
@@ -74,13 +92,13 @@ BOOST_AUTO_TEST_CASE( MatchesRule_SingleTerminal )
     constexpr GrammarSymbols::NT startingNt { Variable };
     // A single ID token should match one of the rules for Variable
     const std::string tokenString = "hello";
-    Token::Ptr idToken = std::make_shared< Token >( TokenType::IDENTIFIER, tokenString );
+    Token idToken = Token( TokenType::IDENTIFIER, tokenString );
     Tokens tokens{ idToken };
 
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
 
-    AstNode::Ptr returnedNode = astGenerator->GenerateAst();
-    BOOST_REQUIRE_NE( nullptr, returnedNode );
+    AstNode returnedNode = astGenerator->GenerateAst();
+    BOOST_REQUIRE( nullptr != returnedNode );
 
     // Check the returned node is a wrapper around the given token
     CheckNodeIsTokenWrapper( returnedNode, idToken );
@@ -96,13 +114,13 @@ BOOST_AUTO_TEST_CASE( HighLevelRule_SingleTerminalMatch )
     constexpr GrammarSymbols::NT startingNt { Logical };
     // A single ID token should match one of the rules for Variable, or Factor
     const std::string tokenString = "hello";
-    Token::Ptr idToken = std::make_shared< Token >( TokenType::IDENTIFIER, tokenString );
+    Token idToken = Token( TokenType::IDENTIFIER, tokenString );
     Tokens tokens{ idToken };
 
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
 
-    AstNode::Ptr returnedNode = astGenerator->GenerateAst();
-    BOOST_REQUIRE_NE( nullptr, returnedNode );
+    AstNode returnedNode = astGenerator->GenerateAst();
+    BOOST_REQUIRE( nullptr != returnedNode );
 
     // Check the returned node is a wrapper around the given token
     CheckNodeIsTokenWrapper( returnedNode, idToken );
@@ -120,13 +138,13 @@ BOOST_AUTO_TEST_CASE( MatchesRule_SingleNonTerminal )
 
     // A single ID token should match one of the rules for Factor
     const std::string tokenString = "hello";
-    Token::Ptr idToken = std::make_shared< Token >( TokenType::IDENTIFIER, tokenString );
+    Token idToken = Token( TokenType::IDENTIFIER, tokenString );
     Tokens tokens{ idToken };
 
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
 
-    AstNode::Ptr returnedNode = astGenerator->GenerateAst();
-    BOOST_REQUIRE_NE( nullptr, returnedNode );
+    AstNode returnedNode = astGenerator->GenerateAst();
+    BOOST_REQUIRE( nullptr != returnedNode );
 
     // Expect the wrapper around the ID token to be returned, as there are no other symbols/child symbols in the rule.
     CheckNodeIsTokenWrapper( returnedNode, idToken );
@@ -145,36 +163,36 @@ BOOST_AUTO_TEST_CASE( MatchesRule_MultipleMixedSymbols )
 
     // A single ID token should match one of the rules for Factor
     const std::string tokenString1 = "hello";
-    Token::Ptr idToken1 = std::make_shared< Token >( TokenType::IDENTIFIER, tokenString1 );
+    Token idToken1 = Token( TokenType::IDENTIFIER, tokenString1 );
     const std::string tokenString2 = "hello2";
-    Token::Ptr idToken2 = std::make_shared< Token >( TokenType::IDENTIFIER, tokenString2 );
+    Token idToken2 = Token( TokenType::IDENTIFIER, tokenString2 );
 
-    Token::Ptr expToken = std::make_shared< Token >( TokenType::MULTIPLY );
+    Token expToken = Token( TokenType::MULTIPLY );
 
     // The set of tokens should satisfy the rule "Factor MULTIPLY Factor"
     Tokens tokens{ idToken1, expToken, idToken2 };
 
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
 
-    AstNode::Ptr returnedNode = astGenerator->GenerateAst();
-    BOOST_REQUIRE_NE( nullptr, returnedNode );
+    AstNode returnedNode = astGenerator->GenerateAst();
+    BOOST_REQUIRE( nullptr != returnedNode );
 
     // Check the returned node is as expected:
     // - With label MULTIPLY
     // - Storing two child nodes, each containing the ID tokens
-    BOOST_CHECK_EQUAL( TokenType::MULTIPLY, returnedNode->m_nodeLabel );
+    BOOST_CHECK_EQUAL( TokenType::MULTIPLY, returnedNode.GetNodeLabel() );
 
-    BOOST_CHECK( returnedNode->IsStorageInUse() );
-    BOOST_CHECK( !returnedNode->IsStoringToken() ); // Expect it to be storing children
-    AstNode::Children children = returnedNode->GetChildren();
+    BOOST_CHECK( returnedNode.IsStorageInUse() );
+    BOOST_CHECK( !returnedNode.IsStoringToken() ); // Expect it to be storing children
+    AstNode::ChildRange children = returnedNode.GetChildren();
     BOOST_REQUIRE_EQUAL( 2u, children.size() );
 
     // Check first child holds the first ID token
-    AstNode::Ptr child1 = children[0];
+    AstNode child1 = children[0];
     CheckNodeIsTokenWrapper( child1, idToken1 );
 
     // Check second child holds the second ID token
-    AstNode::Ptr child2 = children[1];
+    AstNode child2 = children[1];
     CheckNodeIsTokenWrapper( child2, idToken2 );
 }
 
@@ -188,19 +206,19 @@ BOOST_AUTO_TEST_CASE( MatchesRule_LeftoverTokens_NotAllowed )
     constexpr GrammarSymbols::NT startingNt { Variable };
     // A single ID token should match one of the rules for Variable
     const std::string tokenString = "hello";
-    Token::Ptr idToken = std::make_shared< Token >( TokenType::IDENTIFIER, tokenString );
+    Token idToken = Token( TokenType::IDENTIFIER, tokenString );
 
-    Token::Ptr excessToken = std::make_shared< Token >( TokenType::MOD );
-    Token::Ptr excessToken1 = std::make_shared< Token >( TokenType::FOR );
+    Token excessToken = Token( TokenType::MOD );
+    Token excessToken1 = Token( TokenType::FOR );
     // Tokens contains a match followed by leftover token
     Tokens tokens{ idToken, excessToken, excessToken1 };
     size_t originalTokensSize = tokens.size();
 
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
 
     // Expect non-successful result
-    AstNode::Ptr returnedNode = astGenerator->GenerateAst();
-    BOOST_CHECK_EQUAL( nullptr, returnedNode );
+    AstNode returnedNode = astGenerator->GenerateAst();
+    BOOST_CHECK( nullptr == returnedNode );
 }
 
 /**
@@ -216,26 +234,26 @@ BOOST_AUTO_TEST_CASE( MatchesRule_LeftoverTokens_NotAllowed_NtLastSymbol )
 
     // A single ID token should match one of the rules for Factor
     const std::string tokenString1 = "hello";
-    Token::Ptr idToken1 = std::make_shared< Token >( TokenType::IDENTIFIER, tokenString1 );
+    Token idToken1 = Token( TokenType::IDENTIFIER, tokenString1 );
     const std::string tokenString2 = "hello2";
-    Token::Ptr idToken2 = std::make_shared< Token >( TokenType::IDENTIFIER, tokenString2 );
+    Token idToken2 = Token( TokenType::IDENTIFIER, tokenString2 );
 
-    Token::Ptr expToken = std::make_shared< Token >( TokenType::MULTIPLY );
+    Token expToken = Token( TokenType::MULTIPLY );
 
     // Excess leftover tokens
-    Token::Ptr excessToken = std::make_shared< Token >( TokenType::MOD );
-    Token::Ptr excessToken1 = std::make_shared< Token >( TokenType::FOR );
+    Token excessToken = Token( TokenType::MOD );
+    Token excessToken1 = Token( TokenType::FOR );
 
     // The set of tokens should satisfy the rule "Factor MULTIPLY Factor", with leftover tokens
     // at the end
     Tokens tokens{ idToken1, expToken, idToken2, excessToken, excessToken1 };
     size_t originalTokensSize = tokens.size();
 
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
 
     // Expect non-successful result
-    AstNode::Ptr returnedNode = astGenerator->GenerateAst();
-    BOOST_CHECK_EQUAL( nullptr, returnedNode );
+    AstNode returnedNode = astGenerator->GenerateAst();
+    BOOST_CHECK( nullptr == returnedNode );
 }
 
 /**
@@ -246,64 +264,64 @@ BOOST_AUTO_TEST_CASE( MultipleSubTrees_WhileLoop )
 {
     // Use tokens to represent the following:
     // while ( 1 ) { byte varName = 0; };
-    Token::Ptr whileToken = std::make_shared< Token >( TokenType::WHILE );
-    Token::Ptr parenOpenToken = std::make_shared< Token >( TokenType::PAREN_OPEN );
-    Token::Ptr oneToken = std::make_shared< Token >( TokenType::BYTE, 1u );
-    Token::Ptr parenCloseToken = std::make_shared< Token >( TokenType::PAREN_CLOSE);
-    Token::Ptr braceOpenToken = std::make_shared< Token >( TokenType::BRACE_OPEN);
-    Token::Ptr byteToken = std::make_shared< Token >( TokenType::DATA_TYPE, DataType::DT_BYTE );
-    Token::Ptr varToken = std::make_shared< Token >( TokenType::IDENTIFIER, "varName" );
-    Token::Ptr assignToken = std::make_shared< Token >( TokenType::ASSIGN );
-    Token::Ptr zeroToken = std::make_shared< Token >( TokenType::BYTE, 0u );
-    Token::Ptr semiColonToken1 = std::make_shared< Token >( TokenType::SEMICOLON );
-    Token::Ptr braceCloseToken = std::make_shared< Token >( TokenType::BRACE_CLOSE);
-    Token::Ptr semiColonToken2 = std::make_shared< Token >( TokenType::SEMICOLON );
+    Token whileToken = Token( TokenType::WHILE );
+    Token parenOpenToken = Token( TokenType::PAREN_OPEN );
+    Token oneToken = Token( TokenType::BYTE, 1u );
+    Token parenCloseToken = Token( TokenType::PAREN_CLOSE);
+    Token braceOpenToken = Token( TokenType::BRACE_OPEN);
+    Token byteToken = Token( TokenType::DATA_TYPE, DataType::DT_BYTE );
+    Token varToken = Token( TokenType::IDENTIFIER, "varName" );
+    Token assignToken = Token( TokenType::ASSIGN );
+    Token zeroToken = Token( TokenType::BYTE, 0u );
+    Token semiColonToken1 = Token( TokenType::SEMICOLON );
+    Token braceCloseToken = Token( TokenType::BRACE_CLOSE);
+    Token semiColonToken2 = Token( TokenType::SEMICOLON );
 
     Tokens tokens = { whileToken, parenOpenToken, oneToken, parenCloseToken, braceOpenToken, byteToken,
                       varToken, assignToken, zeroToken, semiColonToken1, braceCloseToken, semiColonToken2 };
 
     constexpr GrammarSymbols::NT startingNt{ NT::Block };
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
 
-    AstNode::Ptr returnedNode = astGenerator->GenerateAst();
-    BOOST_REQUIRE_NE( nullptr, returnedNode );
+    AstNode returnedNode = astGenerator->GenerateAst();
+    BOOST_REQUIRE( nullptr != returnedNode );
 
     // Check node label is WHILE
-    BOOST_CHECK_EQUAL( TokenType::WHILE, returnedNode->m_nodeLabel );
+    BOOST_CHECK_EQUAL( TokenType::WHILE, returnedNode.GetNodeLabel() );
     // Check is storing 2 children
-    BOOST_CHECK( returnedNode->IsStorageInUse() );
-    BOOST_CHECK( !returnedNode->IsStoringToken() ); // Expect it to be storing children
-    AstNode::Children children = returnedNode->GetChildren();
+    BOOST_CHECK( returnedNode.IsStorageInUse() );
+    BOOST_CHECK( !returnedNode.IsStoringToken() ); // Expect it to be storing children
+    AstNode::ChildRange children = returnedNode.GetChildren();
     BOOST_REQUIRE_EQUAL( 2u, children.size() );
 
     // Expect first child to be storing a BYTE token
-    AstNode::Ptr child1 = children[0];
+    AstNode child1 = children[0];
     CheckNodeIsTokenWrapper( child1, oneToken );
 
     // Expect second child to have label ASSIGN, and holding 2 child nodes
-    AstNode::Ptr assignNode = children[1];
-    BOOST_CHECK_EQUAL( TokenType::ASSIGN, assignNode->m_nodeLabel );
-    BOOST_CHECK( assignNode->IsStorageInUse() );
-    BOOST_CHECK( !assignNode->IsStoringToken() ); // Expect it to be storing children
-    AstNode::Children assignChildren = assignNode->GetChildren();
+    AstNode assignNode = children[1];
+    BOOST_CHECK_EQUAL( TokenType::ASSIGN, assignNode.GetNodeLabel() );
+    BOOST_CHECK( assignNode.IsStorageInUse() );
+    BOOST_CHECK( !assignNode.IsStoringToken() ); // Expect it to be storing children
+    AstNode::ChildRange assignChildren = assignNode.GetChildren();
     BOOST_REQUIRE_EQUAL( 2u, assignChildren.size() );
 
     // Expect first child of the assign node to be a Variable node, holding 2 wrapper nodes around the
     // data type and the identifier
-    AstNode::Ptr variableNode = assignChildren[0];
-    BOOST_CHECK_EQUAL( NT::Variable, variableNode->m_nodeLabel );
-    BOOST_CHECK( variableNode->IsStorageInUse() );
-    BOOST_CHECK( !variableNode->IsStoringToken() ); // Expect it to be storing children
-    AstNode::Children variableChildren = variableNode->GetChildren();
+    AstNode variableNode = assignChildren[0];
+    BOOST_CHECK_EQUAL( NT::Variable, variableNode.GetNodeLabel() );
+    BOOST_CHECK( variableNode.IsStorageInUse() );
+    BOOST_CHECK( !variableNode.IsStoringToken() ); // Expect it to be storing children
+    AstNode::ChildRange variableChildren = variableNode.GetChildren();
     BOOST_REQUIRE_EQUAL( 2u, variableChildren.size() );
 
-    AstNode::Ptr variableChild1 = variableChildren[0];
+    AstNode variableChild1 = variableChildren[0];
     CheckNodeIsTokenWrapper( variableChild1, byteToken );
-    AstNode::Ptr variableChild2 = variableChildren[1];
+    AstNode variableChild2 = variableChildren[1];
     CheckNodeIsTokenWrapper( variableChild2, varToken );
 
     // Expect second child of the assign node to be a wrapper node around the byte value of 0
-    AstNode::Ptr byteNode = assignChildren[1];
+    AstNode byteNode = assignChildren[1];
     CheckNodeIsTokenWrapper( byteNode, zeroToken );
 }
 
@@ -315,29 +333,29 @@ BOOST_AUTO_TEST_CASE( MultipleSubTrees_IfElse )
 {
     // Use tokens to represent the following:
     // if ( 1 ) { varName = 0; } else { varName = 0; };
-    Token::Ptr ifToken = std::make_shared< Token >( TokenType::IF );
+    Token ifToken = Token( TokenType::IF );
 
-    Token::Ptr parenOpenToken = std::make_shared< Token >( TokenType::PAREN_OPEN );
-    Token::Ptr oneToken = std::make_shared< Token >( TokenType::BYTE, 1u );
-    Token::Ptr parenCloseToken = std::make_shared< Token >( TokenType::PAREN_CLOSE);
+    Token parenOpenToken = Token( TokenType::PAREN_OPEN );
+    Token oneToken = Token( TokenType::BYTE, 1u );
+    Token parenCloseToken = Token( TokenType::PAREN_CLOSE);
 
-    Token::Ptr braceOpenToken = std::make_shared< Token >( TokenType::BRACE_OPEN);
-    Token::Ptr varToken = std::make_shared< Token >( TokenType::IDENTIFIER, "varName" );
-    Token::Ptr assignToken = std::make_shared< Token >( TokenType::ASSIGN );
-    Token::Ptr zeroToken = std::make_shared< Token >( TokenType::BYTE, 0u );
-    Token::Ptr semiColonToken = std::make_shared< Token >( TokenType::SEMICOLON );
-    Token::Ptr braceCloseToken = std::make_shared< Token >( TokenType::BRACE_CLOSE);
+    Token braceOpenToken = Token( TokenType::BRACE_OPEN);
+    Token varToken = Token( TokenType::IDENTIFIER, "varName" );
+    Token assignToken = Token( TokenType::ASSIGN );
+    Token zeroToken = Token( TokenType::BYTE, 0u );
+    Token semiColonToken = Token( TokenType::SEMICOLON );
+    Token braceCloseToken = Token( TokenType::BRACE_CLOSE);
 
-    Token::Ptr elseToken = std::make_shared< Token >( TokenType::ELSE );
+    Token elseToken = Token( TokenType::ELSE );
 
-    Token::Ptr braceOpenToken2 = std::make_shared< Token >( TokenType::BRACE_OPEN );
-    Token::Ptr varToken2 = std::make_shared< Token >( TokenType::IDENTIFIER, "varName" );
-    Token::Ptr assignToken2 = std::make_shared< Token >( TokenType::ASSIGN );
-    Token::Ptr zeroToken2 = std::make_shared< Token >( TokenType::BYTE, 0u );
-    Token::Ptr semiColonToken2 = std::make_shared< Token >( TokenType::SEMICOLON );
-    Token::Ptr braceCloseToken2 = std::make_shared< Token >( TokenType::BRACE_CLOSE );
+    Token braceOpenToken2 = Token( TokenType::BRACE_OPEN );
+    Token varToken2 = Token( TokenType::IDENTIFIER, "varName" );
+    Token assignToken2 = Token( TokenType::ASSIGN );
+    Token zeroToken2 = Token( TokenType::BYTE, 0u );
+    Token semiColonToken2 = Token( TokenType::SEMICOLON );
+    Token braceCloseToken2 = Token( TokenType::BRACE_CLOSE );
 
-    Token::Ptr semiColonToken3 = std::make_shared< Token >( TokenType::SEMICOLON );
+    Token semiColonToken3 = Token( TokenType::SEMICOLON );
 
     Tokens tokens = {
         ifToken,
@@ -361,71 +379,133 @@ BOOST_AUTO_TEST_CASE( MultipleSubTrees_IfElse )
     };
 
     constexpr GrammarSymbols::NT startingNt{ NT::Block };
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
 
-    AstNode::Ptr returnedNode = astGenerator->GenerateAst();
-    BOOST_REQUIRE_NE( nullptr, returnedNode );
+    AstNode returnedNode = astGenerator->GenerateAst();
+    BOOST_REQUIRE( nullptr != returnedNode );
 
     // Check node label is IF
-    BOOST_CHECK_EQUAL( TokenType::IF, returnedNode->m_nodeLabel );
+    BOOST_CHECK_EQUAL( TokenType::IF, returnedNode.GetNodeLabel() );
     // Check is storing 3 children
-    BOOST_CHECK( returnedNode->IsStorageInUse() );
-    BOOST_CHECK( !returnedNode->IsStoringToken() ); // Expect it to be storing children
-    AstNode::Children children = returnedNode->GetChildren();
+    BOOST_CHECK( returnedNode.IsStorageInUse() );
+    BOOST_CHECK( !returnedNode.IsStoringToken() ); // Expect it to be storing children
+    AstNode::ChildRange children = returnedNode.GetChildren();
     BOOST_REQUIRE_EQUAL( 3u, children.size() );
 
     // Expect first child to be storing a BYTE token
-    AstNode::Ptr child1 = children[0];
+    AstNode child1 = children[0];
     CheckNodeIsTokenWrapper( child1, oneToken );
 
     // Expect second child to have label ASSIGN, and holding 2 child nodes
     {
-        AstNode::Ptr assignNode = children[1];
-        BOOST_CHECK_EQUAL( TokenType::ASSIGN, assignNode->m_nodeLabel );
-        BOOST_CHECK( assignNode->IsStorageInUse() );
-        BOOST_CHECK( !assignNode->IsStoringToken() ); // Expect it to be storing children
-        AstNode::Children assignChildren = assignNode->GetChildren();
+        AstNode assignNode = children[1];
+        BOOST_CHECK_EQUAL( TokenType::ASSIGN, assignNode.GetNodeLabel() );
+        BOOST_CHECK( assignNode.IsStorageInUse() );
+        BOOST_CHECK( !assignNode.IsStoringToken() ); // Expect it to be storing children
+        AstNode::ChildRange assignChildren = assignNode.GetChildren();
         BOOST_REQUIRE_EQUAL( 2u, assignChildren.size() );
 
         // Expect first child of the assign node to be an ID node, holding 2 wrapper nodes around the
         // data type and the identifier
-        AstNode::Ptr idNode = assignChildren[0];
+        AstNode idNode = assignChildren[0];
         CheckNodeIsTokenWrapper( idNode, varToken );
 
         // Expect second child of the assign node to be a wrapper node around the byte value of 0
-        AstNode::Ptr byteNode = assignChildren[1];
+        AstNode byteNode = assignChildren[1];
         CheckNodeIsTokenWrapper( byteNode, zeroToken );
     }
 
     // Expect third child to be an ELSE node, with an assign child node
     {
-        AstNode::Ptr elseNode = children[2];
-        BOOST_CHECK_EQUAL( TokenType::ELSE, elseNode->m_nodeLabel );
-        BOOST_CHECK( elseNode->IsStorageInUse() );
-        BOOST_CHECK( !elseNode->IsStoringToken() ); // Expect it to be storing children
-        AstNode::Children elseChildren = elseNode->GetChildren();
+        AstNode elseNode = children[2];
+        BOOST_CHECK_EQUAL( TokenType::ELSE, elseNode.GetNodeLabel() );
+        BOOST_CHECK( elseNode.IsStorageInUse() );
+        BOOST_CHECK( !elseNode.IsStoringToken() ); // Expect it to be storing children
+        AstNode::ChildRange elseChildren = elseNode.GetChildren();
         BOOST_REQUIRE_EQUAL( 1u, elseChildren.size() );
 
         {
-            AstNode::Ptr assignNode = elseChildren[0];
-            BOOST_CHECK_EQUAL( TokenType::ASSIGN, assignNode->m_nodeLabel );
-            BOOST_CHECK( assignNode->IsStorageInUse() );
-            BOOST_CHECK( !assignNode->IsStoringToken() ); // Expect it to be storing children
-            AstNode::Children assignChildren = assignNode->GetChildren();
+            AstNode assignNode = elseChildren[0];
+            BOOST_CHECK_EQUAL( TokenType::ASSIGN, assignNode.GetNodeLabel() );
+            BOOST_CHECK( assignNode.IsStorageInUse() );
+            BOOST_CHECK( !assignNode.IsStoringToken() ); // Expect it to be storing children
+            AstNode::ChildRange assignChildren = assignNode.GetChildren();
             BOOST_REQUIRE_EQUAL( 2u, assignChildren.size() );
 
             // Expect first child of the assign node to be an ID node, holding 2 wrapper nodes around the
             // data type and the identifier
-            AstNode::Ptr idNode = assignChildren[0];
+            AstNode idNode = assignChildren[0];
             CheckNodeIsTokenWrapper( idNode, varToken );
 
             // Expect second child of the assign node to be a wrapper node around the byte value of 0
-            AstNode::Ptr byteNode = assignChildren[1];
+            AstNode byteNode = assignChildren[1];
             CheckNodeIsTokenWrapper( byteNode, zeroToken );
         }
     }
 }
 
+/**
+ * Tests that a long list of sections is parsed into a single Block node holding every section, rather than a chain of
+ * nested Block nodes, and without recursing once per section.
+ */
+BOOST_AUTO_TEST_CASE( ManySections_FlatBlock )
+{
+    constexpr size_t numSections{ 20000u };
+
+    // varName = 0; varName = 1; ...
+    Tokens tokens;
+    for ( size_t i = 0u; i < numSections; ++i )
+    {
+        tokens.push_back( Token( TokenType::IDENTIFIER, "varName" ) );
+        tokens.push_back( Token( TokenType::ASSIGN ) );
+        tokens.push_back( Token( TokenType::BYTE, static_cast< uint8_t >( i ) ) );
+        tokens.push_back( Token( TokenType::SEMICOLON ) );
+    }
+
+    constexpr GrammarSymbols::NT startingNt{ NT::Block };
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
+
+    AstNode returnedNode = astGenerator->GenerateAst();
+    BOOST_REQUIRE( nullptr != returnedNode );
+
+    BOOST_CHECK_EQUAL( NT::Block, returnedNode.GetNodeLabel() );
+    BOOST_REQUIRE( !returnedNode.IsStoringToken() );
+    AstNode::ChildRange children = returnedNode.GetChildren();
+    BOOST_REQUIRE_EQUAL( numSections, children.size() );
+
+    // Expect sections in source order, each an ASSIGN node
+    for ( size_t i = 0u; i < numSections; ++i )
+    {
+        BOOST_REQUIRE_EQUAL( TokenType::ASSIGN, children[i].GetNodeLabel() );
+        AstNode::ChildRange assignChildren = children[i].GetChildren();
+        BOOST_REQUIRE_EQUAL( 2u, assignChildren.size() );
+        CheckNodeIsTokenWrapper( assignChildren[1], Token( TokenType::BYTE, static_cast< uint8_t >( i ) ) );
+    }
+}
+
+/**
+ * Tests that a list of sections followed by tokens that aren't a section is rejected when leftover tokens aren't
+ * allowed.
+ */
+BOOST_AUTO_TEST_CASE( ManySections_LeftoverTokens )
+{
+    // varName = 0; varName = 1; varName
+    Tokens tokens;
+    for ( uint8_t i = 0u; i < 2u; ++i )
+    {
+        tokens.push_back( Token( TokenType::IDENTIFIER, "varName" ) );
+        tokens.push_back( Token( TokenType::ASSIGN ) );
+        tokens.push_back( Token( TokenType::BYTE, i ) );
+        tokens.push_back( Token( TokenType::SEMICOLON ) );
+    }
+    tokens.push_back( Token( TokenType::IDENTIFIER, "varName" ) );
+
+    constexpr GrammarSymbols::NT startingNt{ NT::Block };
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
+
+    BOOST_CHECK( nullptr == astGenerator->GenerateAst() );
+}
+
 /**
  * Tests that operators are parsed correctly regarding order, and parentheses. The current expected behaviour is as
  * follows:
@@ -448,11 +528,11 @@ BOOST_AUTO_TEST_SUITE( OrderOfOperationsTests )
 BOOST_AUTO_TEST_CASE( MultipleOperators_NoParentheses )
 {
     // Create tokens for a Logical expression
-    Token::Ptr byte1 = std::make_shared< Token >( TokenType::BYTE, 1 );
-    Token::Ptr plus = std::make_shared< Token >( TokenType::PLUS );
-    Token::Ptr byte2 = std::make_shared< Token >( TokenType::BYTE, 2 );
-    Token::Ptr multiply = std::make_shared< Token >( TokenType::MULTIPLY );
-    Token::Ptr byte3 = std::make_shared< Token >( TokenType::BYTE, 3 );
+    Token byte1 = Token( TokenType::BYTE, 1 );
+    Token plus = Token( TokenType::PLUS );
+    Token byte2 = Token( TokenType::BYTE, 2 );
+    Token multiply = Token( TokenType::MULTIPLY );
+    Token byte3 = Token( TokenType::BYTE, 3 );
 
     Tokens tokens{
         byte1,
@@ -464,36 +544,36 @@ BOOST_AUTO_TEST_CASE( MultipleOperators_NoParentheses )
 
     constexpr GrammarSymbols::NT startingNt { Logical };
 
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
 
-    AstNode::Ptr returnedNode = astGenerator->GenerateAst();
-    BOOST_REQUIRE_NE( nullptr, returnedNode );
+    AstNode returnedNode = astGenerator->GenerateAst();
+    BOOST_REQUIRE( nullptr != returnedNode );
 
     // Check the returned node is as expected:
     // - With label PLUS
     // - Storing two child nodes, one for the byte 1, and another for the multiply sub-tree
-    BOOST_CHECK_EQUAL( TokenType::PLUS, returnedNode->m_nodeLabel );
+    BOOST_CHECK_EQUAL( TokenType::PLUS, returnedNode.GetNodeLabel() );
 
-    BOOST_CHECK( returnedNode->IsStorageInUse() );
-    BOOST_CHECK( !returnedNode->IsStoringToken() ); // Expect it to be storing children
-    AstNode::Children children = returnedNode->GetChildren();
+    BOOST_CHECK( returnedNode.IsStorageInUse() );
+    BOOST_CHECK( !returnedNode.IsStoringToken() ); // Expect it to be storing children
+    AstNode::ChildRange children = returnedNode.GetChildren();
     BOOST_REQUIRE_EQUAL( 2u, children.size() );
 
     // Check first child holds the first byte token
-    AstNode::Ptr child1 = children[0];
+    AstNode child1 = children[0];
     CheckNodeIsTokenWrapper( child1, byte1 );
 
     // Check second child holds a subtree for the multiply operator
-    AstNode::Ptr child2 = children[1];
-    BOOST_CHECK_EQUAL( TokenType::MULTIPLY, child2->m_nodeLabel );
-    BOOST_CHECK( child2->IsStorageInUse() );
-    BOOST_CHECK( !child2->IsStoringToken() ); // Expect it to be storing children
-    AstNode::Children multiplyChildren = child2->GetChildren();
+    AstNode child2 = children[1];
+    BOOST_CHECK_EQUAL( TokenType::MULTIPLY, child2.GetNodeLabel() );
+    BOOST_CHECK( child2.IsStorageInUse() );
+    BOOST_CHECK( !child2.IsStoringToken() ); // Expect it to be storing children
+    AstNode::ChildRange multiplyChildren = child2.GetChildren();
     BOOST_REQUIRE_EQUAL( 2u, multiplyChildren.size() );
 
-    AstNode::Ptr multiplyChild1 = multiplyChildren[0];
+    AstNode multiplyChild1 = multiplyChildren[0];
     CheckNodeIsTokenWrapper( multiplyChild1, byte2 );
-    AstNode::Ptr multiplyChild2 = multiplyChildren[1];
+    AstNode multiplyChild2 = multiplyChildren[1];
     CheckNodeIsTokenWrapper( multiplyChild2, byte3 );
 }
 
@@ -504,13 +584,13 @@ BOOST_AUTO_TEST_CASE( MultipleOperators_NoParentheses )
 BOOST_AUTO_TEST_CASE( MultipleOperators_ParenthesesSetNewOrder )
 {
     // Create tokens for a Logical expression
-    Token::Ptr parenOpen = std::make_shared< Token >( TokenType::PAREN_OPEN );
-    Token::Ptr byte1 = std::make_shared< Token >( TokenType::BYTE, 1 );
-    Token::Ptr plus = std::make_shared< Token >( TokenType::PLUS );
-    Token::Ptr byte2 = std::make_shared< Token >( TokenType::BYTE, 2 );
-    Token::Ptr parenClose = std::make_shared< Token >( TokenType::PAREN_CLOSE );
-    Token::Ptr multiply = std::make_shared< Token >( TokenType::MULTIPLY );
-    Token::Ptr byte3 = std::make_shared< Token >( TokenType::BYTE, 3 );
+    Token parenOpen = Token( TokenType::PAREN_OPEN );
+    Token byte1 = Token( TokenType::BYTE, 1 );
+    Token plus = Token( TokenType::PLUS );
+    Token byte2 = Token( TokenType::BYTE, 2 );
+    Token parenClose = Token( TokenType::PAREN_CLOSE );
+    Token multiply = Token( TokenType::MULTIPLY );
+    Token byte3 = Token( TokenType::BYTE, 3 );
 
     Tokens tokens{
         parenOpen,
@@ -524,36 +604,36 @@ BOOST_AUTO_TEST_CASE( MultipleOperators_ParenthesesSetNewOrder )
 
     constexpr GrammarSymbols::NT startingNt { Logical };
 
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
 
-    AstNode::Ptr returnedNode = astGenerator->GenerateAst();
-    BOOST_REQUIRE_NE( nullptr, returnedNode );
+    AstNode returnedNode = astGenerator->GenerateAst();
+    BOOST_REQUIRE( nullptr != returnedNode );
 
     // Check the returned node is as expected:
     // - With label MULTIPLY
     // - Storing two child nodes, one for the plus node, and another for byte 3
-    BOOST_CHECK_EQUAL( TokenType::MULTIPLY, returnedNode->m_nodeLabel );
+    BOOST_CHECK_EQUAL( TokenType::MULTIPLY, returnedNode.GetNodeLabel() );
 
-    BOOST_CHECK( returnedNode->IsStorageInUse() );
-    BOOST_CHECK( !returnedNode->IsStoringToken() ); // Expect it to be storing children
-    AstNode::Children children = returnedNode->GetChildren();
+    BOOST_CHECK( returnedNode.IsStorageInUse() );
+    BOOST_CHECK( !returnedNode.IsStoringToken() ); // Expect it to be storing children
+    AstNode::ChildRange children = returnedNode.GetChildren();
     BOOST_REQUIRE_EQUAL( 2u, children.size() );
 
     // Check first child holds a subtree for the plus operator
-    AstNode::Ptr child1 = children[0];
-    BOOST_CHECK_EQUAL( TokenType::PLUS, child1->m_nodeLabel );
-    BOOST_CHECK( child1->IsStorageInUse() );
-    BOOST_CHECK( !child1->IsStoringToken() ); // Expect it to be storing children
-    AstNode::Children plusChildren = child1->GetChildren();
+    AstNode child1 = children[0];
+    BOOST_CHECK_EQUAL( TokenType::PLUS, child1.GetNodeLabel() );
+    BOOST_CHECK( child1.IsStorageInUse() );
+    BOOST_CHECK( !child1.IsStoringToken() ); // Expect it to be storing children
+    AstNode::ChildRange plusChildren = child1.GetChildren();
     BOOST_REQUIRE_EQUAL( 2u, plusChildren.size() );
 
-    AstNode::Ptr plusChild1 = plusChildren[0];
+    AstNode plusChild1 = plusChildren[0];
     CheckNodeIsTokenWrapper( plusChild1, byte1 );
-    AstNode::Ptr plusChild2 = plusChildren[1];
+    AstNode plusChild2 = plusChildren[1];
     CheckNodeIsTokenWrapper( plusChild2, byte2 );
 
     // Check second child holds the third byte token
-    AstNode::Ptr child2 = children[1];
+    AstNode child2 = children[1];
     CheckNodeIsTokenWrapper( child2, byte3 );
 }
 
@@ -564,11 +644,11 @@ BOOST_AUTO_TEST_CASE( MultipleOperators_ParenthesesSetNewOrder )
 BOOST_AUTO_TEST_CASE( MultipleOperatorsAtSameLevel_NoParentheses )
 {
     // Create tokens for a Logical expression
-    Token::Ptr byte1 = std::make_shared< Token >( TokenType::BYTE, 1 );
-    Token::Ptr plus = std::make_shared< Token >( TokenType::PLUS );
-    Token::Ptr byte2 = std::make_shared< Token >( TokenType::BYTE, 2 );
-    Token::Ptr minus = std::make_shared< Token >( TokenType::MINUS );
-    Token::Ptr byte3 = std::make_shared< Token >( TokenType::BYTE, 3 );
+    Token byte1 = Token( TokenType::BYTE, 1 );
+    Token plus = Token( TokenType::PLUS );
+    Token byte2 = Token( TokenType::BYTE, 2 );
+    Token minus = Token( TokenType::MINUS );
+    Token byte3 = Token( TokenType::BYTE, 3 );
 
     Tokens tokens{
         byte1,
@@ -580,10 +660,10 @@ BOOST_AUTO_TEST_CASE( MultipleOperatorsAtSameLevel_NoParentheses )
 
     constexpr GrammarSymbols::NT startingNt { Logical };
 
-    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
 
-    AstNode::Ptr returnedNode = astGenerator->GenerateAst();
-    BOOST_CHECK_EQUAL( nullptr, returnedNode );
+    AstNode returnedNode = astGenerator->GenerateAst();
+    BOOST_CHECK( nullptr == returnedNode );
 }
 
 /**
@@ -593,13 +673,13 @@ BOOST_AUTO_TEST_CASE( MultipleOperatorsAtSameLevel_NoParentheses )
  BOOST_AUTO_TEST_CASE( MultipleOperatorsAtSameLevel_Parentheses )
  {
      // Create tokens for a Logical expression
-     Token::Ptr parenOpen = std::make_shared< Token >( TokenType::PAREN_OPEN );
-     Token::Ptr byte1 = std::make_shared< Token >( TokenType::BYTE, 1 );
-     Token::Ptr plus = std::make_shared< Token >( TokenType::PLUS );
-     Token::Ptr byte2 = std::make_shared< Token >( TokenType::BYTE, 2 );
-     Token::Ptr parenClose = std::make_shared< Token >( TokenType::PAREN_CLOSE );
-     Token::Ptr minus = std::make_shared< Token >( TokenType::MINUS );
-     Token::Ptr byte3 = std::make_shared< Token >( TokenType::BYTE, 3 );
+     Token parenOpen = Token( TokenType::PAREN_OPEN );
+     Token byte1 = Token( TokenType::BYTE, 1 );
+     Token plus = Token( TokenType::PLUS );
+     Token byte2 = Token( TokenType::BYTE, 2 );
+     Token parenClose = Token( TokenType::PAREN_CLOSE );
+     Token minus = Token( TokenType::MINUS );
+     Token byte3 = Token( TokenType::BYTE, 3 );
 
      Tokens tokens{
          parenOpen,
@@ -613,39 +693,252 @@ BOOST_AUTO_TEST_CASE( MultipleOperatorsAtSameLevel_NoParentheses )
 
      constexpr GrammarSymbols::NT startingNt { Logical };
 
-     AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt );
+     AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
 
-     AstNode::Ptr returnedNode = astGenerator->GenerateAst();
-     BOOST_REQUIRE_NE( nullptr, returnedNode );
+     AstNode returnedNode = astGenerator->GenerateAst();
+     BOOST_REQUIRE( nullptr != returnedNode );
 
      // Check the returned node is as expected:
      // - With label MINUS
      // - Storing two child nodes, one for the plus node, and another for byte 3
-     BOOST_CHECK_EQUAL( TokenType::MINUS, returnedNode->m_nodeLabel );
+     BOOST_CHECK_EQUAL( TokenType::MINUS, returnedNode.GetNodeLabel() );
 
-     BOOST_CHECK( returnedNode->IsStorageInUse() );
-     BOOST_CHECK( !returnedNode->IsStoringToken() ); // Expect it to be storing children
-     AstNode::Children children = returnedNode->GetChildren();
+     BOOST_CHECK( returnedNode.IsStorageInUse() );
+     BOOST_CHECK( !returnedNode.IsStoringToken() ); // Expect it to be storing children
+     AstNode::ChildRange children = returnedNode.GetChildren();
      BOOST_REQUIRE_EQUAL( 2u, children.size() );
 
      // Check first child holds a subtree for the plus operator
-     AstNode::Ptr child1 = children[0];
-     BOOST_CHECK_EQUAL( TokenType::PLUS, child1->m_nodeLabel );
-     BOOST_CHECK( child1->IsStorageInUse() );
-     BOOST_CHECK( !child1->IsStoringToken() ); // Expect it to be storing children
-     AstNode::Children plusChildren = child1->GetChildren();
+     AstNode child1 = children[0];
+     BOOST_CHECK_EQUAL( TokenType::PLUS, child1.GetNodeLabel() );
+     BOOST_CHECK( child1.IsStorageInUse() );
+     BOOST_CHECK( !child1.IsStoringToken() ); // Expect it to be storing children
+     AstNode::ChildRange plusChildren = child1.GetChildren();
      BOOST_REQUIRE_EQUAL( 2u, plusChildren.size() );
 
-     AstNode::Ptr plusChild1 = plusChildren[0];
+     AstNode plusChild1 = plusChildren[0];
      CheckNodeIsTokenWrapper( plusChild1, byte1 );
-     AstNode::Ptr plusChild2 = plusChildren[1];
+     AstNode plusChild2 = plusChildren[1];
      CheckNodeIsTokenWrapper( plusChild2, byte2 );
 
      // Check second child holds the third byte token
-     AstNode::Ptr child2 = children[1];
+     AstNode child2 = children[1];
      CheckNodeIsTokenWrapper( child2, byte3 );
  }
 
+/**
+ * Tests an expression nested inside many levels of parentheses, where the innermost expression uses an operator from
+ * every precedence level. Every rule therefore passes the look-ahead at every level, so rules are only rejected after
+ * their sub-trees have been parsed.
+ */
+BOOST_AUTO_TEST_CASE( DeeplyNestedParentheses )
+{
+    const size_t nestingDepth{ 20u };
+    const std::vector< TokenType > operators{
+        TokenType::OR, TokenType::AND, TokenType::BITWISE_OR, TokenType::BITWISE_AND, TokenType::EQ, TokenType::NEQ,
+        TokenType::LEQ, TokenType::GEQ, TokenType::LT, TokenType::GT, TokenType::LSHIFT, TokenType::RSHIFT,
+        TokenType::PLUS, TokenType::MINUS, TokenType::MULTIPLY, TokenType::DIVIDE, TokenType::MOD
+    };
+
+    // ((...( 1 OR ( 1 AND ( ... ( 1 MOD 1 ) ... ) ) )...))
+    Tokens tokens;
+    tokens.insert( tokens.end(), nestingDepth, Token( TokenType::PAREN_OPEN ) );
+    for ( size_t i = 0u; i < operators.size(); ++i )
+    {
+        if ( 0u != i )
+        {
+            tokens.push_back( Token( TokenType::PAREN_OPEN ) );
+        }
+        tokens.push_back( Token( TokenType::BYTE, 1 ) );
+        tokens.push_back( Token( operators[i] ) );
+    }
+    tokens.push_back( Token( TokenType::BYTE, 1 ) );
+    tokens.insert( tokens.end(), operators.size() - 1u, Token( TokenType::PAREN_CLOSE ) );
+    tokens.insert( tokens.end(), nestingDepth, Token( TokenType::PAREN_CLOSE ) );
+
+    constexpr GrammarSymbols::NT startingNt { Logical };
+
+    AstGenerator::UPtr astGenerator = std::make_unique< AstGenerator >( tokens, startingNt, m_arena );
+
+    AstNode returnedNode = astGenerator->GenerateAst();
+    BOOST_REQUIRE( nullptr != returnedNode );
+
+    // Parentheses are skipped, so each operator's node holds a byte and the next operator's node.
+    AstNode currentNode = returnedNode;
+    for ( TokenType expectedOperator : operators )
+    {
+        BOOST_CHECK_EQUAL( expectedOperator, currentNode.GetNodeLabel() );
+        BOOST_REQUIRE( !currentNode.IsStoringToken() );
+        AstNode::ChildRange children = currentNode.GetChildren();
+        BOOST_REQUIRE_EQUAL( 2u, children.size() );
+        CheckNodeIsTokenWrapper( children[0], Token( TokenType::BYTE, 1 ) );
+        currentNode = children[1];
+    }
+    CheckNodeIsTokenWrapper( currentNode, Token( TokenType::BYTE, 1 ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END() // OrderOfOperationsTests
 
+BOOST_AUTO_TEST_SUITE( LookAheadTests )
+
+/**
+ * Tests that brackets are paired with their matching bracket, and unmatched brackets are left unpaired.
+ */
+BOOST_AUTO_TEST_CASE( MatchingBrackets )
+{
+    // { ( ( ) ) } )
+    Tokens tokens{ Token( TokenType::BRACE_OPEN ), Token( TokenType::PAREN_OPEN ), Token( TokenType::PAREN_OPEN ),
+                   Token( TokenType::PAREN_CLOSE ), Token( TokenType::PAREN_CLOSE ), Token( TokenType::BRACE_CLOSE ),
+                   Token( TokenType::PAREN_CLOSE ) };
+    AstGenerator_Test astGenerator( tokens, Block, m_arena );
+
+    std::vector< size_t > expectedMatches{ 5u, 4u, 3u, 2u, 1u, 0u, g_noMatchingBracket };
+    BOOST_CHECK_EQUAL_COLLECTIONS( expectedMatches.begin(), expectedMatches.end(),
+                                   astGenerator.m_matchingBrackets.begin(), astGenerator.m_matchingBrackets.end() );
+}
+
+/**
+ * Tests that each terminal of the rule must be found, in order, after the first symbol still to be parsed.
+ */
+BOOST_AUTO_TEST_CASE( TerminalsInOrder )
+{
+    // a = 1 ;
+    Tokens tokens{ Token( TokenType::IDENTIFIER, "a" ), Token( TokenType::ASSIGN ), Token( TokenType::BYTE, 1 ),
+                   Token( TokenType::SEMICOLON ) };
+    AstGenerator_Test astGenerator( tokens, Block, m_arena );
+
+    size_t tokenIndex{ 0u };
+    BOOST_CHECK( astGenerator.PerformLookAhead( tokenIndex, { Statement, T::SEMICOLON }, 0u ) );
+    BOOST_CHECK( astGenerator.PerformLookAhead( tokenIndex, { Variable, T::ASSIGN, Logical }, 0u ) );
+    BOOST_CHECK( !astGenerator.PerformLookAhead( tokenIndex, { Variable, T::SEMICOLON, T::ASSIGN }, 0u ) );
+    // The same token can't be used for two terminals.
+    BOOST_CHECK( !astGenerator.PerformLookAhead( tokenIndex, { T::SEMICOLON, T::SEMICOLON }, 0u ) );
+
+    // Symbols before the first index have already been parsed, so are not looked for.
+    tokenIndex = 2u;
+    BOOST_CHECK( !astGenerator.PerformLookAhead( tokenIndex, { Variable, T::ASSIGN, Logical }, 0u ) );
+    BOOST_CHECK( astGenerator.PerformLookAhead( tokenIndex, { Variable, T::ASSIGN, Logical }, 2u ) );
+    BOOST_CHECK_EQUAL( 2u, tokenIndex );
+}
+
+/**
+ * Tests that a rule starting with a bracket must start at the current token, and that its closing bracket must be the
+ * matching one.
+ */
+BOOST_AUTO_TEST_CASE( BracketedRule )
+{
+    // { a = 1 ; } }
+    Tokens tokens{ Token( TokenType::BRACE_OPEN ), Token( TokenType::IDENTIFIER, "a" ), Token( TokenType::ASSIGN ),
+                   Token( TokenType::BYTE, 1 ), Token( TokenType::SEMICOLON ), Token( TokenType::BRACE_CLOSE ),
+                   Token( TokenType::BRACE_CLOSE ) };
+    AstGenerator_Test astGenerator( tokens, Block, m_arena );
+
+    const Rule scopedBlockRule{ T::BRACE_OPEN, Block, T::BRACE_CLOSE };
+    size_t tokenIndex{ 0u };
+    BOOST_CHECK( astGenerator.PerformLookAhead( tokenIndex, scopedBlockRule, 0u ) );
+    // The closing bracket is matched, so there must be a semicolon after it.
+    BOOST_CHECK( !astGenerator.PerformLookAhead( tokenIndex, { T::BRACE_OPEN, Block, T::BRACE_CLOSE, T::SEMICOLON },
+                                                 0u ) );
+
+    tokenIndex = 1u;
+    BOOST_CHECK( !astGenerator.PerformLookAhead( tokenIndex, scopedBlockRule, 0u ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // LookAheadTests
+
+BOOST_AUTO_TEST_SUITE( FusedSymbolTableTests )
+
+/**
+ * Tests that symbol tables generated while parsing match those generated by the separate symbol table pass.
+ */
+BOOST_AUTO_TEST_CASE( SameAsSeparatePass )
+{
+    // byte a = 1; a = a; if ( a ) { byte b = a; };
+    Tokens tokens{ Token( TokenType::DATA_TYPE, DataType::DT_BYTE ), Token( TokenType::IDENTIFIER, "a" ),
+                   Token( TokenType::ASSIGN ), Token( TokenType::BYTE, 1u ), Token( TokenType::SEMICOLON ),
+                   Token( TokenType::IDENTIFIER, "a" ), Token( TokenType::ASSIGN ), Token( TokenType::IDENTIFIER, "a" ),
+                   Token( TokenType::SEMICOLON ), Token( TokenType::IF ), Token( TokenType::PAREN_OPEN ),
+                   Token( TokenType::IDENTIFIER, "a" ), Token( TokenType::PAREN_CLOSE ), Token( TokenType::BRACE_OPEN ),
+                   Token( TokenType::DATA_TYPE, DataType::DT_BYTE ), Token( TokenType::IDENTIFIER, "b" ),
+                   Token( TokenType::ASSIGN ), Token( TokenType::IDENTIFIER, "a" ), Token( TokenType::SEMICOLON ),
+                   Token( TokenType::BRACE_CLOSE ), Token( TokenType::SEMICOLON ) };
+    const IdentifierId idA = IdentifierTable::GetInstance()->Intern( "a" );
+    const IdentifierId idB = IdentifierTable::GetInstance()->Intern( "b" );
+
+    AstGenerator fusedGenerator( tokens, NT::Block, m_arena, std::make_shared< SymbolTableGenerator >() );
+    AstNode fusedRoot = fusedGenerator.GenerateAst();
+    BOOST_REQUIRE( nullptr != fusedRoot );
+
+    AstGenerator separateGenerator( tokens, NT::Block, m_arena );
+    AstNode separateRoot = separateGenerator.GenerateAst();
+    BOOST_REQUIRE( nullptr != separateRoot );
+    BOOST_CHECK( nullptr == separateRoot.GetSymbolTable() );
+    SymbolTableGenerator().GenerateSymbolTableForAst( separateRoot );
+
+    for ( AstNode root : { fusedRoot, separateRoot } )
+    {
+        SymbolTable::Ptr rootTable = root.GetSymbolTable();
+        BOOST_REQUIRE( nullptr != rootTable );
+        BOOST_CHECK_EQUAL( 1u, rootTable->GetNumEntries() );
+        SymbolTableEntry* entryA = rootTable->GetEntryIfExists( idA );
+        BOOST_REQUIRE( nullptr != entryA );
+        BOOST_CHECK( entryA->isReadFrom );
+        BOOST_CHECK( entryA->isWrittenTo );
+
+        AstNode::ChildRange sections = root.GetChildren();
+        BOOST_REQUIRE_EQUAL( 3u, sections.size() );
+        BOOST_REQUIRE_EQUAL( TokenType::IF, sections[2].GetNodeLabel() );
+        SymbolTable::Ptr ifTable = sections[2].GetSymbolTable();
+        BOOST_REQUIRE( nullptr != ifTable );
+        BOOST_CHECK( rootTable != ifTable );
+        BOOST_CHECK_EQUAL( 1u, ifTable->GetNumEntries() );
+        BOOST_CHECK( nullptr != ifTable->GetEntryIfExists( idB ) );
+        BOOST_CHECK( nullptr == rootTable->GetEntryIfExists( idB ) );
+    }
+}
+
+/**
+ * Tests that a program of a single statement, which becomes the root node itself, is still given a symbol table.
+ */
+BOOST_AUTO_TEST_CASE( SingleStatement )
+{
+    // byte a = 1;
+    Tokens tokens{ Token( TokenType::DATA_TYPE, DataType::DT_BYTE ), Token( TokenType::IDENTIFIER, "a" ),
+                   Token( TokenType::ASSIGN ), Token( TokenType::BYTE, 1u ), Token( TokenType::SEMICOLON ) };
+
+    AstGenerator astGenerator( tokens, NT::Block, m_arena, std::make_shared< SymbolTableGenerator >() );
+    AstNode root = astGenerator.GenerateAst();
+    BOOST_REQUIRE( nullptr != root );
+    BOOST_CHECK_EQUAL( TokenType::ASSIGN, root.GetNodeLabel() );
+
+    SymbolTable::Ptr rootTable = root.GetSymbolTable();
+    BOOST_REQUIRE( nullptr != rootTable );
+    BOOST_CHECK( nullptr != rootTable->GetEntryIfExists( IdentifierTable::GetInstance()->Intern( "a" ) ) );
+}
+
+/**
+ * Tests that identifiers which are re-declared, or used without being declared, throw while parsing.
+ */
+BOOST_AUTO_TEST_CASE( IdentifierErrors )
+{
+    // byte a = 1; byte a = 2;
+    Tokens redeclareTokens{ Token( TokenType::DATA_TYPE, DataType::DT_BYTE ), Token( TokenType::IDENTIFIER, "a" ),
+                            Token( TokenType::ASSIGN ), Token( TokenType::BYTE, 1u ), Token( TokenType::SEMICOLON ),
+                            Token( TokenType::DATA_TYPE, DataType::DT_BYTE ), Token( TokenType::IDENTIFIER, "a" ),
+                            Token( TokenType::ASSIGN ), Token( TokenType::BYTE, 2u ), Token( TokenType::SEMICOLON ) };
+    AstGenerator redeclareGenerator( redeclareTokens, NT::Block, m_arena, std::make_shared< SymbolTableGenerator >() );
+    BOOST_CHECK_THROW( redeclareGenerator.GenerateAst(), std::runtime_error );
+
+    // byte a = 1; a = b;
+    Tokens undeclaredTokens{ Token( TokenType::DATA_TYPE, DataType::DT_BYTE ), Token( TokenType::IDENTIFIER, "a" ),
+                             Token( TokenType::ASSIGN ), Token( TokenType::BYTE, 1u ), Token( TokenType::SEMICOLON ),
+                             Token( TokenType::IDENTIFIER, "a" ), Token( TokenType::ASSIGN ),
+                             Token( TokenType::IDENTIFIER, "b" ), Token( TokenType::SEMICOLON ) };
+    AstGenerator undeclaredGenerator( undeclaredTokens, NT::Block, m_arena,
+                                      std::make_shared< SymbolTableGenerator >() );
+    BOOST_CHECK_THROW( undeclaredGenerator.GenerateAst(), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // FusedSymbolTableTests
+
 BOOST_AUTO_TEST_SUITE_END() // AstGeneratorTests
\ No newline at end of file
@@ -1,5 +1,5 @@
 #include <boost/test/unit_test.hpp>
-#include "AstNode.h"
+#include "AstArena.h"
 
 class AstNodeTestsFixture
 {
@@ -12,33 +12,37 @@ public:
      *
      * \return  Created AST node.
      */
-    AstNode::Ptr
+    AstNode
     CreateFakeAstNode()
     {
         GrammarSymbols::Symbol fakeLabel { T::PLUS };
         AstNode::Children fakeChildren;
-        return std::make_shared< AstNode >( fakeLabel, fakeChildren );
+        return m_arena.CreateNode( fakeLabel, fakeChildren );
     }
 
     /**
-     * \brief  Checks AST node is storing a token, not children. Checks stored token is pointing to the
-     *         same instance passed to this method.
+     * \brief  Checks AST node is storing a token, not children. Checks stored token is equal to the token passed
+     *         to this method.
      */
     void
-    CheckNodeIsStoringToken( AstNode::Ptr node, Token::Ptr token )
+    CheckNodeIsStoringToken( AstNode node, Token token )
     {
-        BOOST_CHECK_EQUAL( true, node->IsStorageInUse() );
-        BOOST_CHECK( node->IsStoringToken() );
-        BOOST_CHECK_EQUAL( token.get(), node->GetToken().get() );
+        BOOST_CHECK_EQUAL( true, node.IsStorageInUse() );
+        BOOST_CHECK( node.IsStoringToken() );
+        BOOST_CHECK( token == node.GetToken() );
     }
 
     void
-    CheckNodeIsStoringChildren( AstNode::Ptr node, size_t expectedNumChildren )
+    CheckNodeIsStoringChildren( AstNode node, size_t expectedNumChildren )
     {
-        BOOST_CHECK_EQUAL( true, node->IsStorageInUse() );
-        BOOST_CHECK( !node->IsStoringToken() );
-        BOOST_CHECK_EQUAL( expectedNumChildren, node->GetChildren().size() );
+        BOOST_CHECK_EQUAL( true, node.IsStorageInUse() );
+        BOOST_CHECK( !node.IsStoringToken() );
+        BOOST_CHECK_EQUAL( expectedNumChildren, node.GetChildren().size() );
     }
+
+protected:
+    // Arena storing the nodes of the ASTs created by the test case.
+    AstArena m_arena;
 };
 
 BOOST_FIXTURE_TEST_SUITE( AstNodeTests, AstNodeTestsFixture )
@@ -52,7 +56,7 @@ BOOST_AUTO_TEST_CASE( EmptyElements )
 {
     GrammarSymbols::NT nonTerminalArg { Block };
     AstNode::Elements elements{};
-    BOOST_CHECK_THROW( AstNode::GetNodeFromRuleElements( elements, nonTerminalArg ), std::runtime_error );
+    BOOST_CHECK_THROW( AstNode::GetNodeFromRuleElements( m_arena, elements, nonTerminalArg ), std::runtime_error );
 }
 
 /**
@@ -63,16 +67,16 @@ BOOST_AUTO_TEST_CASE( SingleNodeLabelTypeTerminal )
 {
     TokenType nodeLabelTokenType = TokenType::IF;
 
-    AstNode::Elements elements { std::make_shared< Token >( nodeLabelTokenType ) };
+    AstNode::Elements elements { Token( nodeLabelTokenType ) };
     GrammarSymbols::NT nonTerminalArg { Block };
 
-    AstNode::Ptr returnedNode = AstNode::GetNodeFromRuleElements( elements, nonTerminalArg );
+    AstNode returnedNode = AstNode::GetNodeFromRuleElements( m_arena, elements, nonTerminalArg );
     BOOST_REQUIRE( nullptr != returnedNode );
 
-    BOOST_CHECK_EQUAL( false, returnedNode->IsStorageInUse() );
+    BOOST_CHECK_EQUAL( false, returnedNode.IsStorageInUse() );
     // Check the node label is a terminal symbol, and is equal to the type of the token passed to the method.
-    BOOST_CHECK_EQUAL( SymbolType::Terminal, GetSymbolType( returnedNode->m_nodeLabel ) );
-    BOOST_CHECK_EQUAL( nodeLabelTokenType, returnedNode->m_nodeLabel );
+    BOOST_CHECK_EQUAL( SymbolType::Terminal, GetSymbolType( returnedNode.GetNodeLabel() ) );
+    BOOST_CHECK_EQUAL( nodeLabelTokenType, returnedNode.GetNodeLabel() );
 }
 
 /**
@@ -84,14 +88,14 @@ BOOST_AUTO_TEST_CASE( OnlySkipTypeTerminals )
     // Create elements vector only consisting of skippable tokens.
     AstNode::Elements elements
     {
-        std::make_shared< Token >( TokenType::PAREN_OPEN ),
-        std::make_shared< Token >( TokenType::BRACE_CLOSE ),
-        std::make_shared< Token >( TokenType::SEMICOLON )
+        Token( TokenType::PAREN_OPEN ),
+        Token( TokenType::BRACE_CLOSE ),
+        Token( TokenType::SEMICOLON )
     };
 
     GrammarSymbols::NT nonTerminalArg { Block };
 
-    BOOST_CHECK_THROW( AstNode::GetNodeFromRuleElements( elements, nonTerminalArg ), std::runtime_error );
+    BOOST_CHECK_THROW( AstNode::GetNodeFromRuleElements( m_arena, elements, nonTerminalArg ), std::runtime_error );
 }
 
 /**
@@ -100,20 +104,20 @@ BOOST_AUTO_TEST_CASE( OnlySkipTypeTerminals )
  */
 BOOST_AUTO_TEST_CASE( SingleNonNodeLabelTerminal )
 {
-    Token::Ptr token = std::make_shared< Token >( TokenType::IDENTIFIER, "variableName" );
+    Token token = Token( TokenType::IDENTIFIER, "variableName" );
 
     AstNode::Elements elements { token };
     GrammarSymbols::NT nonTerminalArg { Block };
 
-    AstNode::Ptr returnedNode = AstNode::GetNodeFromRuleElements( elements, nonTerminalArg );
+    AstNode returnedNode = AstNode::GetNodeFromRuleElements( m_arena, elements, nonTerminalArg );
     BOOST_REQUIRE( nullptr != returnedNode );
 
     // Check node has our token as its stored token
     CheckNodeIsStoringToken( returnedNode, token );
 
     // Check the node label is a terminal symbol, and is equal to the token's type.
-    BOOST_CHECK_EQUAL( SymbolType::Terminal, GetSymbolType( returnedNode->m_nodeLabel ) );
-    BOOST_CHECK_EQUAL( token->m_type, returnedNode->m_nodeLabel );
+    BOOST_CHECK_EQUAL( SymbolType::Terminal, GetSymbolType( returnedNode.GetNodeLabel() ) );
+    BOOST_CHECK_EQUAL( token.m_type, returnedNode.GetNodeLabel() );
 }
 
 /**
@@ -123,16 +127,16 @@ BOOST_AUTO_TEST_CASE( SingleNonNodeLabelTerminal )
 BOOST_AUTO_TEST_CASE( SingleNonTerminal )
 {
     // Create fake AST node to pass as an element
-    AstNode::Ptr fakeAstNode = CreateFakeAstNode();
+    AstNode fakeAstNode = CreateFakeAstNode();
 
     AstNode::Elements elements { fakeAstNode };
     GrammarSymbols::NT nonTerminalArg { Block };
-    AstNode::Ptr returnedNode = AstNode::GetNodeFromRuleElements( elements, nonTerminalArg );
+    AstNode returnedNode = AstNode::GetNodeFromRuleElements( m_arena, elements, nonTerminalArg );
 
     BOOST_REQUIRE( nullptr != returnedNode );
 
     // Check returned node is the same as the node we passed in elements
-    BOOST_CHECK_EQUAL( fakeAstNode.get(), returnedNode.get() );
+    BOOST_CHECK( fakeAstNode == returnedNode );
 }
 
 /**
@@ -142,11 +146,11 @@ BOOST_AUTO_TEST_CASE( SingleNonTerminal )
  */
 BOOST_AUTO_TEST_CASE( MultipleChildren_SingleTerminalNodeLabel )
 {
-    AstNode::Ptr fakeAstNode1 = CreateFakeAstNode();
-    AstNode::Ptr fakeAstNode2 = CreateFakeAstNode();
-    Token::Ptr nodeLabelToken = std::make_shared< Token >( TokenType::WHILE );
-    Token::Ptr skipToken = std::make_shared< Token >( TokenType::BRACE_CLOSE );
-    Token::Ptr regularToken = std::make_shared< Token >( TokenType::IDENTIFIER, "variableName" );
+    AstNode fakeAstNode1 = CreateFakeAstNode();
+    AstNode fakeAstNode2 = CreateFakeAstNode();
+    Token nodeLabelToken = Token( TokenType::WHILE );
+    Token skipToken = Token( TokenType::BRACE_CLOSE );
+    Token regularToken = Token( TokenType::IDENTIFIER, "variableName" );
 
     AstNode::Elements elements
     {
@@ -158,21 +162,21 @@ BOOST_AUTO_TEST_CASE( MultipleChildren_SingleTerminalNodeLabel )
     };
 
     GrammarSymbols::NT nonTerminalArg { Block };
-    AstNode::Ptr returnedNode = AstNode::GetNodeFromRuleElements( elements, nonTerminalArg );
+    AstNode returnedNode = AstNode::GetNodeFromRuleElements( m_arena, elements, nonTerminalArg );
     BOOST_REQUIRE( nullptr != returnedNode );
 
     // Expect node label to be the node label token type
-    BOOST_CHECK_EQUAL( nodeLabelToken->m_type, returnedNode->m_nodeLabel );
+    BOOST_CHECK_EQUAL( nodeLabelToken.m_type, returnedNode.GetNodeLabel() );
 
     // Expect the children to contain the created AST nodes + a wrapper AST node around the regular token
     constexpr size_t expectedChildrenSize{ 3u };
     CheckNodeIsStoringChildren( returnedNode, expectedChildrenSize );
-    AstNode::Children returnedChildren = returnedNode->GetChildren();
+    AstNode::ChildRange returnedChildren = returnedNode.GetChildren();
 
-    BOOST_CHECK_EQUAL( fakeAstNode1.get(), returnedChildren[0].get() );
-    BOOST_CHECK_EQUAL( fakeAstNode2.get(), returnedChildren[1].get() );
+    BOOST_CHECK( fakeAstNode1 == returnedChildren[0] );
+    BOOST_CHECK( fakeAstNode2 == returnedChildren[1] );
 
-    AstNode::Ptr expectedTokenWrapperChild = returnedChildren[2];
+    AstNode expectedTokenWrapperChild = returnedChildren[2];
     CheckNodeIsStoringToken( expectedTokenWrapperChild, regularToken );
 }
 
@@ -182,12 +186,12 @@ BOOST_AUTO_TEST_CASE( MultipleChildren_SingleTerminalNodeLabel )
  */
 BOOST_AUTO_TEST_CASE( MultipleChildren_TwoNodeLabelTypes_Throws )
 {
-    AstNode::Ptr fakeAstNode1 = CreateFakeAstNode();
-    AstNode::Ptr fakeAstNode2 = CreateFakeAstNode();
-    Token::Ptr nodeLabelToken = std::make_shared< Token >( TokenType::WHILE );
-    Token::Ptr skipToken = std::make_shared< Token >( TokenType::BRACE_CLOSE );
-    Token::Ptr regularToken = std::make_shared< Token >( TokenType::IDENTIFIER, "variableName" );
-    Token::Ptr nodeLabelToken2 = std::make_shared< Token >( TokenType::OR );
+    AstNode fakeAstNode1 = CreateFakeAstNode();
+    AstNode fakeAstNode2 = CreateFakeAstNode();
+    Token nodeLabelToken = Token( TokenType::WHILE );
+    Token skipToken = Token( TokenType::BRACE_CLOSE );
+    Token regularToken = Token( TokenType::IDENTIFIER, "variableName" );
+    Token nodeLabelToken2 = Token( TokenType::OR );
 
     AstNode::Elements elements
     {
@@ -200,7 +204,7 @@ BOOST_AUTO_TEST_CASE( MultipleChildren_TwoNodeLabelTypes_Throws )
     };
 
     GrammarSymbols::NT nonTerminalArg { Block };
-    BOOST_CHECK_THROW( AstNode::GetNodeFromRuleElements( elements, nonTerminalArg ), std::runtime_error );
+    BOOST_CHECK_THROW( AstNode::GetNodeFromRuleElements( m_arena, elements, nonTerminalArg ), std::runtime_error );
 }
 
 /**
@@ -209,10 +213,10 @@ BOOST_AUTO_TEST_CASE( MultipleChildren_TwoNodeLabelTypes_Throws )
  */
 BOOST_AUTO_TEST_CASE( MultipleChildren_NoNodeLabel )
 {
-    AstNode::Ptr fakeAstNode1 = CreateFakeAstNode();
-    AstNode::Ptr fakeAstNode2 = CreateFakeAstNode();
-    Token::Ptr skipToken = std::make_shared< Token >( TokenType::BRACE_CLOSE );
-    Token::Ptr regularToken = std::make_shared< Token >( TokenType::IDENTIFIER, "variableName" );
+    AstNode fakeAstNode1 = CreateFakeAstNode();
+    AstNode fakeAstNode2 = CreateFakeAstNode();
+    Token skipToken = Token( TokenType::BRACE_CLOSE );
+    Token regularToken = Token( TokenType::IDENTIFIER, "variableName" );
 
     AstNode::Elements elements
     {
@@ -223,21 +227,21 @@ BOOST_AUTO_TEST_CASE( MultipleChildren_NoNodeLabel )
     };
 
     GrammarSymbols::NT nonTerminalArg { Block };
-    AstNode::Ptr returnedNode = AstNode::GetNodeFromRuleElements( elements, nonTerminalArg );
+    AstNode returnedNode = AstNode::GetNodeFromRuleElements( m_arena, elements, nonTerminalArg );
     BOOST_REQUIRE( nullptr != returnedNode );
 
     // Expect node label to be the non-terminal symbol argument since it can't find a node label element.
-    BOOST_CHECK_EQUAL( nonTerminalArg, returnedNode->m_nodeLabel );
+    BOOST_CHECK_EQUAL( nonTerminalArg, returnedNode.GetNodeLabel() );
 
     // Expect the children to contain the created AST nodes + a wrapper AST node around the regular token
     constexpr size_t expectedChildrenSize{ 3u };
     CheckNodeIsStoringChildren( returnedNode, expectedChildrenSize );
-    AstNode::Children returnedChildren = returnedNode->GetChildren();
+    AstNode::ChildRange returnedChildren = returnedNode.GetChildren();
 
-    BOOST_CHECK_EQUAL( fakeAstNode1.get(), returnedChildren[0].get() );
-    BOOST_CHECK_EQUAL( fakeAstNode2.get(), returnedChildren[1].get() );
+    BOOST_CHECK( fakeAstNode1 == returnedChildren[0] );
+    BOOST_CHECK( fakeAstNode2 == returnedChildren[1] );
 
-    AstNode::Ptr expectedTokenWrapperChild = returnedChildren[2];
+    AstNode expectedTokenWrapperChild = returnedChildren[2];
     CheckNodeIsStoringToken( expectedTokenWrapperChild, regularToken );
 }
 
@@ -250,10 +254,10 @@ BOOST_AUTO_TEST_CASE( GetChildren_IsStoringToken )
 {
     // Create node that is storing a token
     constexpr TokenType tokenType{ T::AND };
-    Token::Ptr storedToken = std::make_shared< Token >( tokenType );
-    AstNode::Ptr node = std::make_shared< AstNode >( tokenType, storedToken );
+    Token storedToken = Token( tokenType );
+    AstNode node = m_arena.CreateNode( tokenType, storedToken );
 
-    BOOST_CHECK_THROW( node->GetChildren(), std::invalid_argument );
+    BOOST_CHECK_THROW( node.GetChildren(), std::invalid_argument );
 }
 
 /**
@@ -264,9 +268,9 @@ BOOST_AUTO_TEST_CASE( GetChildren_StorageNotInUse )
     // Create node that is storing an empty children vector.
     constexpr GrammarSymbols::Symbol nodeLabel{ NT::Block };
     AstNode::Children children{};
-    AstNode::Ptr node = std::make_shared< AstNode >( nodeLabel, children );
+    AstNode node = m_arena.CreateNode( nodeLabel, children );
 
-    BOOST_CHECK_THROW( node->GetChildren(), std::runtime_error );
+    BOOST_CHECK_THROW( node.GetChildren(), std::runtime_error );
 }
 
 /**
@@ -276,13 +280,13 @@ BOOST_AUTO_TEST_CASE( GetChildren_Success )
 {
     // Create node that is storing children.
     constexpr GrammarSymbols::Symbol nodeLabel{ NT::Block };
-    AstNode::Ptr fakeChild = CreateFakeAstNode();
+    AstNode fakeChild = CreateFakeAstNode();
     AstNode::Children children{ fakeChild };
-    AstNode::Ptr node = std::make_shared< AstNode >( nodeLabel, children );
+    AstNode node = m_arena.CreateNode( nodeLabel, children );
 
-    AstNode::Children returnedChildren = node->GetChildren();
+    AstNode::ChildRange returnedChildren = node.GetChildren();
     BOOST_REQUIRE_EQUAL( 1u, returnedChildren.size() );
-    BOOST_CHECK_EQUAL( fakeChild.get(), returnedChildren[0].get() );
+    BOOST_CHECK( fakeChild == returnedChildren[0] );
 }
 
 /**
@@ -292,23 +296,11 @@ BOOST_AUTO_TEST_CASE( GetToken_IsStoringChildren )
 {
     // Create node that is storing children.
     constexpr GrammarSymbols::Symbol nodeLabel{ NT::Block };
-    AstNode::Ptr fakeChild = CreateFakeAstNode();
+    AstNode fakeChild = CreateFakeAstNode();
     AstNode::Children children{ fakeChild };
-    AstNode::Ptr node = std::make_shared< AstNode >( nodeLabel, children );
-
-    BOOST_CHECK_THROW( node->GetToken(), std::invalid_argument );
-}
-
-/**
- * Tests that method GetToken() will throw an error if the node is storing an nullptr token.
- */
-BOOST_AUTO_TEST_CASE( GetToken_StorageNotInUse )
-{
-    // Create node that is storing a nullptr token
-    constexpr TokenType tokenType{ T::AND };
-    AstNode::Ptr node = std::make_shared< AstNode >( tokenType, nullptr );
+    AstNode node = m_arena.CreateNode( nodeLabel, children );
 
-    BOOST_CHECK_THROW( node->GetToken(), std::runtime_error );
+    BOOST_CHECK_THROW( node.GetToken(), std::invalid_argument );
 }
 
 /**
@@ -318,11 +310,11 @@ BOOST_AUTO_TEST_CASE( GetToken_Success )
 {
     // Create node that is storing a token
     constexpr TokenType tokenType{ T::AND };
-    Token::Ptr storedToken = std::make_shared< Token >( tokenType );
-    AstNode::Ptr node = std::make_shared< AstNode >( tokenType, storedToken );
+    Token storedToken = Token( tokenType );
+    AstNode node = m_arena.CreateNode( tokenType, storedToken );
 
-    Token::Ptr returnedToken = node->GetToken();
-    BOOST_CHECK_EQUAL( storedToken.get(), returnedToken.get() );
+    Token returnedToken = node.GetToken();
+    BOOST_CHECK( storedToken == returnedToken );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // AstNodeTests
\ No newline at end of file
@@ -2,7 +2,7 @@
  * Contains utility methods for creating simulated ASTs for test cases.
  */
 
-#include "AstNode.h"
+#include "AstArena.h"
 
 #pragma once
 
@@ -13,15 +13,16 @@ namespace AstSimulator
         TRUE = true,
         FALSE = false
     };
-    AstNode::Ptr CreateAssignNodeFromByteValue( const std::string& varName, uint8_t value, IsDeclaration isDeclaration );
-    AstNode::Ptr CreateAssignNodeFromVar( const std::string& varName, const std::string& valueVar, IsDeclaration isDeclaration );
-    AstNode::Ptr CreateAssignStatementFromToken( const std::string& varName, Token::Ptr valueToken, IsDeclaration isDeclaration );
+    AstNode CreateAssignNodeFromByteValue( AstArena& arena, const std::string& varName, uint8_t value, IsDeclaration isDeclaration );
+    AstNode CreateAssignNodeFromVar( AstArena& arena, const std::string& varName, const std::string& valueVar, IsDeclaration isDeclaration );
+    AstNode CreateAssignStatementFromToken( AstArena& arena, const std::string& varName, Token valueToken, IsDeclaration isDeclaration );
 
-    AstNode::Ptr GetLhsIdNode( const std::string& varName, IsDeclaration isDeclaration );
+    AstNode GetLhsIdNode( AstArena& arena, const std::string& varName, IsDeclaration isDeclaration );
 
     /**
      * \brief  Constructs assign statement with a RHS two-operand expression.
      *
+     * \param[in]  arena          The arena in which to create the nodes.
      * \param[in]  lhs            The identifier of the LHS variable being written to.
      * \param[in]  isDeclaration  Whether the LHS variable is being declared for this first time.
      * \param[in]  operation      The expression operation type - this will be the node label.
@@ -31,8 +32,9 @@ namespace AstSimulator
      * \return  The created assign node.
      */
     template < typename A, typename B >
-    AstNode::Ptr
+    AstNode
     CreateTwoOperandStatement(
+        AstArena& arena,
         const std::string& lhs,
         IsDeclaration isDeclaration,
         T operation,
@@ -40,25 +42,25 @@ namespace AstSimulator
         B operand2
     )
     {
-        AstNode::Ptr lhsNode = GetLhsIdNode( lhs, isDeclaration );
-        AstNode::Ptr expressionNode = CreateTwoOpExpression( operation, operand1, operand2 );
+        AstNode lhsNode = GetLhsIdNode( arena, lhs, isDeclaration );
+        AstNode expressionNode = CreateTwoOpExpression( arena, operation, operand1, operand2 );
 
         AstNode::Children assignChildren{ lhsNode, expressionNode };
-        AstNode::Ptr assignNode = std::make_shared< AstNode >( T::ASSIGN, assignChildren );
+        AstNode assignNode = arena.CreateNode( T::ASSIGN, assignChildren );
         return assignNode;
     }
-    AstNode::Ptr CreateTwoOpExpression( T operation, uint8_t operand1, uint8_t operand2 );
-    AstNode::Ptr CreateTwoOpExpression( T operation, uint8_t operand1, const std::string& operand2 );
-    AstNode::Ptr CreateTwoOpExpression( T operation, const std::string& operand1, uint8_t operand2 );
-    AstNode::Ptr CreateTwoOpExpression( T operation, const std::string& operand1, const std::string& operand2 );
-    AstNode::Ptr CreateTwoOpExpression( T operation, uint8_t operand1, AstNode::Ptr operand2 );
-    AstNode::Ptr CreateTwoOpExpression( T operation, AstNode::Ptr operand1, uint8_t operand2 );
-    AstNode::Ptr CreateTwoOpExpression( T operation, const std::string& operand1, AstNode::Ptr operand2 );
-    AstNode::Ptr CreateTwoOpExpression( T operation, AstNode::Ptr operand1, const std::string& operand2 );
-    AstNode::Ptr CreateTwoOpExpression( T operation, AstNode::Ptr operand1, AstNode::Ptr operand2 );
+    AstNode CreateTwoOpExpression( AstArena& arena, T operation, uint8_t operand1, uint8_t operand2 );
+    AstNode CreateTwoOpExpression( AstArena& arena, T operation, uint8_t operand1, const std::string& operand2 );
+    AstNode CreateTwoOpExpression( AstArena& arena, T operation, const std::string& operand1, uint8_t operand2 );
+    AstNode CreateTwoOpExpression( AstArena& arena, T operation, const std::string& operand1, const std::string& operand2 );
+    AstNode CreateTwoOpExpression( AstArena& arena, T operation, uint8_t operand1, AstNode operand2 );
+    AstNode CreateTwoOpExpression( AstArena& arena, T operation, AstNode operand1, uint8_t operand2 );
+    AstNode CreateTwoOpExpression( AstArena& arena, T operation, const std::string& operand1, AstNode operand2 );
+    AstNode CreateTwoOpExpression( AstArena& arena, T operation, AstNode operand1, const std::string& operand2 );
+    AstNode CreateTwoOpExpression( AstArena& arena, T operation, AstNode operand1, AstNode operand2 );
 
-    AstNode::Ptr WrapNodesInBlocks( AstNode::Children nodes );
-    void CreateAndAttachFakeSymbolTable( AstNode::Ptr scopeNode,
+    AstNode WrapNodesInBlocks( AstArena& arena, AstNode::Children nodes );
+    void CreateAndAttachFakeSymbolTable( AstNode scopeNode,
                                          std::vector< std::string > identifiers,
                                          SymbolTable::Ptr parentTable = nullptr );
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include <boost/test/unit_test.hpp>
+#include "AstVisitor.h"
+#include "AstArena.h"
+
+/**
+ * \brief  Pass which counts the nodes it visits, handling PLUS and Block nodes and storing the label of the last
+ *         unhandled node.
+ */
+class CountingVisitor : public AstVisitor< CountingVisitor, size_t, size_t >
+{
+public:
+    // Number of PLUS nodes visited.
+    size_t m_numPlus{ 0u };
+    // Label of the last node visited which has no handler.
+    GrammarSymbols::Symbol m_lastUnhandledLabel{ T::INVALID_TOKEN };
+
+private:
+    friend class AstVisitor< CountingVisitor, size_t, size_t >;
+
+    using HandledLabels = AstLabelList< T::PLUS, NT::Block >;
+
+    size_t
+    VisitNode( AstLabel< T::PLUS >, AstNode, size_t depth )
+    {
+        ++m_numPlus;
+        return depth;
+    }
+
+    size_t
+    VisitNode( AstLabel< NT::Block >, AstNode node, size_t depth )
+    {
+        size_t maxDepth{ depth };
+        for ( AstNode child : node.GetChildren() )
+        {
+            maxDepth = std::max( maxDepth, Visit( child, depth + 1u ) );
+        }
+        return maxDepth;
+    }
+
+    size_t
+    VisitUnhandled( AstNode node, size_t depth )
+    {
+        m_lastUnhandledLabel = node.GetNodeLabel();
+        return depth;
+    }
+};
+
+/**
+ * \brief  Pass which handles no labels, and uses the default handler for unhandled nodes.
+ */
+class EmptyVisitor : public AstVisitor< EmptyVisitor >
+{
+private:
+    friend class AstVisitor< EmptyVisitor >;
+
+    using HandledLabels = AstLabelList<>;
+};
+
+class AstVisitorTestsFixture
+{
+public:
+    AstVisitorTestsFixture() = default;
+
+protected:
+    // Arena storing the nodes of the ASTs created by the test case.
+    AstArena m_arena;
+};
+
+BOOST_FIXTURE_TEST_SUITE( AstVisitorTests, AstVisitorTestsFixture )
+
+/**
+ * Tests that each node is passed to the handler for its label, or the unhandled handler if it has none, along with
+ * the extra arguments.
+ */
+BOOST_AUTO_TEST_CASE( DispatchByLabel )
+{
+    AstNode byteNode = m_arena.CreateNode( T::BYTE, Token( T::BYTE, 1u ) );
+    AstNode plusNode = m_arena.CreateNode( T::PLUS, AstNode::Children{ byteNode, byteNode } );
+    AstNode innerBlock = m_arena.CreateNode( NT::Block, AstNode::Children{ plusNode, byteNode } );
+    AstNode outerBlock = m_arena.CreateNode( NT::Block, AstNode::Children{ plusNode, innerBlock } );
+
+    CountingVisitor visitor;
+    BOOST_CHECK_EQUAL( 2u, visitor.Visit( outerBlock, 0u ) );
+    BOOST_CHECK_EQUAL( 2u, visitor.m_numPlus );
+    BOOST_CHECK_EQUAL( T::BYTE, visitor.m_lastUnhandledLabel );
+
+    AstNode variableNode = m_arena.CreateNode( NT::Variable, AstNode::Children{ byteNode } );
+    BOOST_CHECK_EQUAL( 5u, visitor.Visit( variableNode, 5u ) );
+    BOOST_CHECK_EQUAL( NT::Variable, visitor.m_lastUnhandledLabel );
+}
+
+/**
+ * Tests that the default handler for unhandled nodes throws, and that a node with an unrecognised symbol type can't
+ * be visited.
+ */
+BOOST_AUTO_TEST_CASE( UnhandledAndUnrecognisedLabels )
+{
+    AstNode byteNode = m_arena.CreateNode( T::BYTE, Token( T::BYTE, 1u ) );
+    EmptyVisitor visitor;
+    BOOST_CHECK_THROW( visitor.Visit( byteNode ), std::invalid_argument );
+
+    constexpr GrammarSymbols::Symbol unrecognisedSymbol{ 0x0300u };
+    AstNode unrecognisedNode = m_arena.CreateNode( unrecognisedSymbol, Token( T::BYTE, 1u ) );
+    CountingVisitor countingVisitor;
+    BOOST_CHECK_THROW( countingVisitor.Visit( unrecognisedNode, 0u ), std::runtime_error );
+    BOOST_CHECK_EQUAL( T::INVALID_TOKEN, countingVisitor.m_lastUnhandledLabel );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // AstVisitorTests
@@ -0,0 +1,100 @@
+#include <boost/test/unit_test.hpp>
+#include "BitVector.h"
+
+BOOST_AUTO_TEST_SUITE( BitVectorTests )
+
+/**
+ * Tests that bits can be set and reset individually, including either side of a word boundary.
+ */
+BOOST_AUTO_TEST_CASE( SetResetTest )
+{
+    BitVector bits( 130u );
+    BOOST_CHECK_EQUAL( 130u, bits.GetSize() );
+    BOOST_CHECK( bits.None() );
+
+    bits.Set( 0u );
+    bits.Set( 63u );
+    bits.Set( 64u );
+    bits.Set( 129u );
+    BOOST_CHECK( bits.Test( 0u ) );
+    BOOST_CHECK( bits.Test( 63u ) );
+    BOOST_CHECK( bits.Test( 64u ) );
+    BOOST_CHECK( bits.Test( 129u ) );
+    BOOST_CHECK( !bits.Test( 1u ) );
+    BOOST_CHECK_EQUAL( 4u, bits.Count() );
+
+    bits.Reset( 63u );
+    BOOST_CHECK( !bits.Test( 63u ) );
+    BOOST_CHECK_EQUAL( 3u, bits.Count() );
+
+    bits.Clear();
+    BOOST_CHECK( bits.None() );
+}
+
+/**
+ * Tests that accessing a bit outside the size of the vector throws, even if it is within the last word.
+ */
+BOOST_AUTO_TEST_CASE( Test_OutOfRange )
+{
+    BitVector bits( 10u );
+    BOOST_CHECK_THROW( bits.Set( 10u ), std::out_of_range );
+    BOOST_CHECK_THROW( bits.Test( 64u ), std::out_of_range );
+}
+
+/**
+ * Tests that a union reports whether any bits were added.
+ */
+BOOST_AUTO_TEST_CASE( UnionWith )
+{
+    BitVector bits( 100u );
+    BitVector other( 100u );
+    bits.Set( 1u );
+    other.Set( 1u );
+    other.Set( 99u );
+
+    BOOST_CHECK( bits.UnionWith( other ) );
+    BOOST_CHECK( bits.Test( 99u ) );
+    BOOST_CHECK( bits == other );
+    BOOST_CHECK( !bits.UnionWith( other ) );
+
+    BitVector differentSize( 50u );
+    BOOST_CHECK_THROW( bits.UnionWith( differentSize ), std::invalid_argument );
+}
+
+/**
+ * Tests that subtracting removes only the bits set in the other vector.
+ */
+BOOST_AUTO_TEST_CASE( Subtract )
+{
+    BitVector bits( 70u );
+    BitVector other( 70u );
+    bits.Set( 2u );
+    bits.Set( 68u );
+    other.Set( 68u );
+    other.Set( 3u );
+
+    bits.Subtract( other );
+    BOOST_CHECK( bits.Test( 2u ) );
+    BOOST_CHECK( !bits.Test( 68u ) );
+    BOOST_CHECK( !bits.Test( 3u ) );
+    BOOST_CHECK( bits != other );
+}
+
+/**
+ * Tests that iterating visits each set bit once, in ascending order.
+ */
+BOOST_AUTO_TEST_CASE( ForEach )
+{
+    BitVector bits( 200u );
+    const std::vector< size_t > expected{ 0u, 5u, 63u, 64u, 150u, 199u };
+    for ( size_t index : expected )
+    {
+        bits.Set( index );
+    }
+
+    std::vector< size_t > visited;
+    bits.ForEach( [&]( size_t index ) { visited.push_back( index ); } );
+    BOOST_CHECK_EQUAL_COLLECTIONS( expected.begin(), expected.end(), visited.begin(), visited.end() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
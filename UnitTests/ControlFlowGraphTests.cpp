@@ -0,0 +1,249 @@
+#include <algorithm>
+
+#include <boost/test/unit_test.hpp>
+
+#include "ControlFlowGraph.h"
+
+using namespace TAC;
+
+class ControlFlowGraphTestsFixture
+{
+public:
+    // Creates an instruction that doesn't affect control flow.
+    ThreeAddrInstruction MakeInstr( LabelId label = g_invalidLabelId )
+    {
+        return ThreeAddrInstruction( m_var1, Opcode::ADD, m_var1, m_var2, label );
+    }
+
+    // Creates a conditional branch instruction.
+    ThreeAddrInstruction MakeBranch( LabelId target )
+    {
+        return ThreeAddrInstruction( target, Opcode::BRLT, m_var1, m_var2 );
+    }
+
+    // Creates a branch instruction that is always taken.
+    ThreeAddrInstruction MakeUnconditionalBranch( LabelId target )
+    {
+        return ThreeAddrInstruction( target, Opcode::BRE, m_var1, m_var1 );
+    }
+
+    // Checks the successors and predecessors of a block, regardless of their order.
+    void CheckEdges(
+        const ControlFlowGraph& cfg,
+        size_t block,
+        std::vector< size_t > expectedSuccessors,
+        std::vector< size_t > expectedPredecessors
+    )
+    {
+        std::vector< size_t > successors = cfg.GetBlock( block ).successors;
+        std::vector< size_t > predecessors = cfg.GetBlock( block ).predecessors;
+        std::sort( successors.begin(), successors.end() );
+        std::sort( predecessors.begin(), predecessors.end() );
+        BOOST_CHECK_EQUAL_COLLECTIONS( expectedSuccessors.begin(), expectedSuccessors.end(),
+                                       successors.begin(), successors.end() );
+        BOOST_CHECK_EQUAL_COLLECTIONS( expectedPredecessors.begin(), expectedPredecessors.end(),
+                                       predecessors.begin(), predecessors.end() );
+    }
+
+    const VarId m_var1{ 0u };
+    const VarId m_var2{ 1u };
+
+    const LabelId m_label1{ 0u };
+    const LabelId m_label2{ 1u };
+    const LabelId m_label3{ 2u };
+};
+
+BOOST_FIXTURE_TEST_SUITE( ControlFlowGraphTests, ControlFlowGraphTestsFixture )
+
+/**
+ * Tests that a graph of no instructions has no blocks.
+ */
+BOOST_AUTO_TEST_CASE( NoInstructions )
+{
+    ControlFlowGraph cfg( {} );
+
+    BOOST_CHECK_EQUAL( 0u, cfg.GetNumBlocks() );
+    BOOST_CHECK_EQUAL( 0u, cfg.GetReversePostOrder().size() );
+    BOOST_CHECK_EQUAL( 0u, cfg.GetLoops().size() );
+    BOOST_CHECK_THROW( cfg.GetBlock( 0 ), std::out_of_range );
+}
+
+/**
+ * Tests that a program with no control flow is a single block, with no edges or loops.
+ */
+BOOST_AUTO_TEST_CASE( StraightLine )
+{
+    ControlFlowGraph::Instructions instructions{ MakeInstr(), MakeInstr(), MakeInstr() };
+    ControlFlowGraph cfg( instructions );
+
+    BOOST_REQUIRE_EQUAL( 1u, cfg.GetNumBlocks() );
+    BOOST_CHECK_EQUAL( 0u, cfg.GetBlock( 0 ).start );
+    BOOST_CHECK_EQUAL( 3u, cfg.GetBlock( 0 ).end );
+    CheckEdges( cfg, 0, {}, {} );
+
+    BOOST_CHECK_EQUAL( 0u, cfg.GetBlockOfInstruction( 2 ) );
+    BOOST_CHECK_THROW( cfg.GetBlockOfInstruction( 3 ), std::out_of_range );
+
+    BOOST_CHECK( cfg.IsReachable( 0 ) );
+    BOOST_CHECK_EQUAL( ControlFlowGraph::INVALID_INDEX, cfg.GetImmediateDominator( 0 ) );
+    BOOST_CHECK( cfg.Dominates( 0, 0 ) );
+    BOOST_CHECK_EQUAL( 0u, cfg.GetLoops().size() );
+    BOOST_CHECK_EQUAL( 0u, cfg.GetLoopDepth( 0 ) );
+}
+
+/**
+ * Tests the blocks and edges of an if-else statement, where both branches join back together, and that the block
+ * before the branch dominates the rest while the branches themselves don't.
+ */
+BOOST_AUTO_TEST_CASE( IfElse )
+{
+    ControlFlowGraph::Instructions instructions{
+        MakeInstr(),
+        MakeBranch( m_label1 ),                 // Block 0: branch to else
+        MakeInstr(),
+        MakeUnconditionalBranch( m_label2 ),    // Block 1: if body, then skip else
+        MakeInstr( m_label1 ),                  // Block 2: else body
+        MakeInstr( m_label2 )                   // Block 3: join
+    };
+    ControlFlowGraph cfg( instructions );
+
+    BOOST_REQUIRE_EQUAL( 4u, cfg.GetNumBlocks() );
+    CheckEdges( cfg, 0, { 1, 2 }, {} );
+    CheckEdges( cfg, 1, { 3 }, { 0 } );
+    CheckEdges( cfg, 2, { 3 }, { 0 } );
+    CheckEdges( cfg, 3, {}, { 1, 2 } );
+
+    BOOST_CHECK_EQUAL( 0u, cfg.GetImmediateDominator( 1 ) );
+    BOOST_CHECK_EQUAL( 0u, cfg.GetImmediateDominator( 2 ) );
+    BOOST_CHECK_EQUAL( 0u, cfg.GetImmediateDominator( 3 ) );
+    BOOST_CHECK( cfg.Dominates( 0, 3 ) );
+    BOOST_CHECK( !cfg.Dominates( 1, 3 ) );
+    BOOST_CHECK( !cfg.Dominates( 2, 3 ) );
+    BOOST_CHECK_EQUAL( 0u, cfg.GetLoops().size() );
+
+    // Every block comes before its successors in reverse post-order.
+    const std::vector< size_t >& order = cfg.GetReversePostOrder();
+    BOOST_REQUIRE_EQUAL( 4u, order.size() );
+    BOOST_CHECK_EQUAL( 0u, order.front() );
+    BOOST_CHECK_EQUAL( 3u, order.back() );
+}
+
+/**
+ * Tests that a while loop (as generated from the intermediate code) is found, with its back edge, body and header.
+ */
+BOOST_AUTO_TEST_CASE( WhileLoop )
+{
+    ControlFlowGraph::Instructions instructions{
+        MakeInstr(),                            // Block 0: before loop
+        MakeInstr( m_label1 ),
+        MakeBranch( m_label2 ),                 // Block 1: loop condition, exit if false
+        MakeInstr(),
+        MakeUnconditionalBranch( m_label1 ),    // Block 2: loop body, jump back to condition
+        MakeInstr( m_label2 )                   // Block 3: after loop
+    };
+    ControlFlowGraph cfg( instructions );
+
+    BOOST_REQUIRE_EQUAL( 4u, cfg.GetNumBlocks() );
+    CheckEdges( cfg, 0, { 1 }, {} );
+    CheckEdges( cfg, 1, { 2, 3 }, { 0, 2 } );
+    CheckEdges( cfg, 2, { 1 }, { 1 } );
+    CheckEdges( cfg, 3, {}, { 1 } );
+
+    BOOST_CHECK_EQUAL( 1u, cfg.GetImmediateDominator( 2 ) );
+    BOOST_CHECK_EQUAL( 1u, cfg.GetImmediateDominator( 3 ) );
+
+    BOOST_REQUIRE_EQUAL( 1u, cfg.GetLoops().size() );
+    const Loop& loop = cfg.GetLoops()[0];
+    BOOST_CHECK_EQUAL( 1u, loop.header );
+    const std::vector< size_t > expectedBlocks{ 1, 2 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( expectedBlocks.begin(), expectedBlocks.end(), loop.blocks.begin(),
+                                   loop.blocks.end() );
+    BOOST_CHECK_EQUAL( ControlFlowGraph::INVALID_INDEX, loop.parent );
+    BOOST_CHECK_EQUAL( 1u, loop.depth );
+
+    BOOST_CHECK_EQUAL( 0u, cfg.GetLoopDepth( 0 ) );
+    BOOST_CHECK_EQUAL( 1u, cfg.GetLoopDepth( 1 ) );
+    BOOST_CHECK_EQUAL( 1u, cfg.GetLoopDepth( 2 ) );
+    BOOST_CHECK_EQUAL( 0u, cfg.GetLoopDepth( 3 ) );
+}
+
+/**
+ * Tests that nested loops are found, with the inner loop after the outer one and pointing to it as its parent.
+ */
+BOOST_AUTO_TEST_CASE( NestedLoops )
+{
+    ControlFlowGraph::Instructions instructions{
+        MakeInstr( m_label1 ),                  // Block 0: outer loop header
+        MakeInstr( m_label2 ),
+        MakeBranch( m_label2 ),                 // Block 1: inner loop, branching to itself
+        MakeBranch( m_label1 ),                 // Block 2: outer loop latch
+        MakeInstr()                             // Block 3: after loops
+    };
+    ControlFlowGraph cfg( instructions );
+
+    BOOST_REQUIRE_EQUAL( 4u, cfg.GetNumBlocks() );
+    CheckEdges( cfg, 1, { 1, 2 }, { 0, 1 } );
+    CheckEdges( cfg, 2, { 0, 3 }, { 1 } );
+
+    BOOST_REQUIRE_EQUAL( 2u, cfg.GetLoops().size() );
+    const Loop& outer = cfg.GetLoops()[0];
+    const Loop& inner = cfg.GetLoops()[1];
+
+    BOOST_CHECK_EQUAL( 0u, outer.header );
+    const std::vector< size_t > expectedOuterBlocks{ 0, 1, 2 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( expectedOuterBlocks.begin(), expectedOuterBlocks.end(), outer.blocks.begin(),
+                                   outer.blocks.end() );
+    BOOST_CHECK_EQUAL( 1u, outer.depth );
+
+    BOOST_CHECK_EQUAL( 1u, inner.header );
+    const std::vector< size_t > expectedInnerBlocks{ 1 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( expectedInnerBlocks.begin(), expectedInnerBlocks.end(), inner.blocks.begin(),
+                                   inner.blocks.end() );
+    BOOST_CHECK_EQUAL( 0u, inner.parent );
+    BOOST_CHECK_EQUAL( 2u, inner.depth );
+
+    BOOST_CHECK_EQUAL( 1u, cfg.GetLoopDepth( 0 ) );
+    BOOST_CHECK_EQUAL( 2u, cfg.GetLoopDepth( 1 ) );
+    BOOST_CHECK_EQUAL( 1u, cfg.GetInnermostLoop( 1 ) );
+    BOOST_CHECK_EQUAL( 0u, cfg.GetInnermostLoop( 2 ) );
+    BOOST_CHECK_EQUAL( ControlFlowGraph::INVALID_INDEX, cfg.GetInnermostLoop( 3 ) );
+}
+
+/**
+ * Tests that blocks which can't be reached from the entry are left out of the reverse post-order, and have no
+ * dominators.
+ */
+BOOST_AUTO_TEST_CASE( UnreachableBlock )
+{
+    ControlFlowGraph::Instructions instructions{
+        MakeUnconditionalBranch( m_label1 ),    // Block 0: skip the next block
+        MakeInstr(),                            // Block 1: unreachable
+        MakeInstr( m_label1 )                   // Block 2
+    };
+    ControlFlowGraph cfg( instructions );
+
+    BOOST_REQUIRE_EQUAL( 3u, cfg.GetNumBlocks() );
+    CheckEdges( cfg, 0, { 2 }, {} );
+    CheckEdges( cfg, 1, { 2 }, {} );
+
+    BOOST_CHECK( !cfg.IsReachable( 1 ) );
+    BOOST_CHECK_EQUAL( 2u, cfg.GetReversePostOrder().size() );
+    BOOST_CHECK_EQUAL( ControlFlowGraph::INVALID_INDEX, cfg.GetImmediateDominator( 1 ) );
+    BOOST_CHECK_EQUAL( 0u, cfg.GetImmediateDominator( 2 ) );
+    BOOST_CHECK( !cfg.Dominates( 1, 2 ) );
+}
+
+/**
+ * Tests that building the graph throws if a branch targets a label that isn't attached to an instruction, e.g. a
+ * placeholder that was never replaced.
+ */
+BOOST_AUTO_TEST_CASE( UnresolvedBranchTarget )
+{
+    ControlFlowGraph::Instructions instructions{ MakeBranch( m_label3 ), MakeInstr( m_label1 ) };
+    BOOST_CHECK_THROW( ControlFlowGraph cfg( instructions ), std::runtime_error );
+
+    instructions = { MakeBranch( g_invalidLabelId ), MakeInstr() };
+    BOOST_CHECK_THROW( ControlFlowGraph cfg( instructions ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // ControlFlowGraphTests
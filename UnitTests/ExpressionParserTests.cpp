@@ -0,0 +1,194 @@
+#include <boost/test/unit_test.hpp>
+#include "ExpressionParser.h"
+
+class ExpressionParserTestsFixture
+{
+public:
+    ExpressionParserTestsFixture() = default;
+
+    /**
+     * \brief  Checks AST node is wrapper node around token.
+     */
+    void
+    CheckNodeIsTokenWrapper( AstNode node, Token token )
+    {
+        BOOST_REQUIRE( nullptr != node );
+        BOOST_CHECK_EQUAL( token.m_type, node.GetNodeLabel() );
+        BOOST_REQUIRE( node.IsStoringToken() );
+        BOOST_CHECK( token == node.GetToken() );
+    }
+
+    /**
+     * \brief  Checks AST node is an operator node with the given number of children, and returns the children.
+     */
+    AstNode::ChildRange
+    CheckOperatorNode( AstNode node, TokenType expectedOperator, size_t expectedNumChildren )
+    {
+        BOOST_REQUIRE( nullptr != node );
+        BOOST_CHECK_EQUAL( expectedOperator, node.GetNodeLabel() );
+        BOOST_REQUIRE( !node.IsStoringToken() );
+        AstNode::ChildRange children = node.GetChildren();
+        BOOST_REQUIRE_EQUAL( expectedNumChildren, children.size() );
+        return children;
+    }
+
+protected:
+    // Arena storing the nodes of the ASTs created by the test case.
+    AstArena m_arena;
+};
+
+BOOST_FIXTURE_TEST_SUITE( ExpressionParserTests, ExpressionParserTestsFixture )
+
+/**
+ * Tests that only the expression non-terminals are parsed by precedence.
+ */
+BOOST_AUTO_TEST_CASE( IsExpressionNt )
+{
+    for ( GrammarSymbols::NT nt : { Logical, Bitwise, Comparison, Shift, Negation, Expression, Term, Factor } )
+    {
+        BOOST_CHECK( ExpressionParser::IsExpressionNt( nt ) );
+    }
+    for ( GrammarSymbols::NT nt : { Block, Section, Statement, Variable, If_else } )
+    {
+        BOOST_CHECK( !ExpressionParser::IsExpressionNt( nt ) );
+    }
+}
+
+/**
+ * Tests that tighter binding operators become the children of looser ones, whichever order they appear in.
+ */
+BOOST_AUTO_TEST_CASE( Precedence )
+{
+    Token byte1 = Token( TokenType::BYTE, 1 );
+    Token byte2 = Token( TokenType::BYTE, 2 );
+    Token byte3 = Token( TokenType::BYTE, 3 );
+    Token byte4 = Token( TokenType::BYTE, 4 );
+
+    // 1 * 2 == 3 + 4
+    Tokens tokens{ byte1, Token( TokenType::MULTIPLY ), byte2, Token( TokenType::EQ ), byte3, Token( TokenType::PLUS ),
+                   byte4 };
+    ExpressionParser parser( tokens, m_arena );
+
+    size_t tokenIndex{ 0u };
+    AstNode root = parser.ParseExpression( tokenIndex, Logical );
+    BOOST_CHECK_EQUAL( tokens.size(), tokenIndex );
+
+    AstNode::ChildRange eqChildren = CheckOperatorNode( root, TokenType::EQ, 2u );
+    AstNode::ChildRange multiplyChildren = CheckOperatorNode( eqChildren[0], TokenType::MULTIPLY, 2u );
+    CheckNodeIsTokenWrapper( multiplyChildren[0], byte1 );
+    CheckNodeIsTokenWrapper( multiplyChildren[1], byte2 );
+    AstNode::ChildRange plusChildren = CheckOperatorNode( eqChildren[1], TokenType::PLUS, 2u );
+    CheckNodeIsTokenWrapper( plusChildren[0], byte3 );
+    CheckNodeIsTokenWrapper( plusChildren[1], byte4 );
+}
+
+/**
+ * Tests that a second operator on the same level is left unparsed, as parentheses are required.
+ */
+BOOST_AUTO_TEST_CASE( SameLevelOperators_StopsAtSecond )
+{
+    Token byte1 = Token( TokenType::BYTE, 1 );
+    Token byte2 = Token( TokenType::BYTE, 2 );
+
+    // 1 + 2 - 3
+    Tokens tokens{ byte1, Token( TokenType::PLUS ), byte2, Token( TokenType::MINUS ), Token( TokenType::BYTE, 3 ) };
+    ExpressionParser parser( tokens, m_arena );
+
+    size_t tokenIndex{ 0u };
+    AstNode root = parser.ParseExpression( tokenIndex, Logical );
+    BOOST_CHECK_EQUAL( 3u, tokenIndex );
+
+    AstNode::ChildRange plusChildren = CheckOperatorNode( root, TokenType::PLUS, 2u );
+    CheckNodeIsTokenWrapper( plusChildren[0], byte1 );
+    CheckNodeIsTokenWrapper( plusChildren[1], byte2 );
+}
+
+/**
+ * Tests that an operator with no valid operand after it is left unparsed.
+ */
+BOOST_AUTO_TEST_CASE( MissingRightOperand_StopsBeforeOperator )
+{
+    Token identifier = Token( TokenType::IDENTIFIER, "a" );
+
+    // a << )
+    Tokens tokens{ identifier, Token( TokenType::LSHIFT ), Token( TokenType::PAREN_CLOSE ) };
+    ExpressionParser parser( tokens, m_arena );
+
+    size_t tokenIndex{ 0u };
+    AstNode root = parser.ParseExpression( tokenIndex, Logical );
+    BOOST_CHECK_EQUAL( 1u, tokenIndex );
+    CheckNodeIsTokenWrapper( root, identifier );
+}
+
+/**
+ * Tests that a prefix operator applies to the whole of the next level down, and can be the operand of a looser
+ * operator but not a tighter one.
+ */
+BOOST_AUTO_TEST_CASE( PrefixOperator )
+{
+    Token byte1 = Token( TokenType::BYTE, 1 );
+    Token byte2 = Token( TokenType::BYTE, 2 );
+    Token byte3 = Token( TokenType::BYTE, 3 );
+
+    // NOT 1 + 2 >> 3
+    Tokens tokens{ Token( TokenType::NOT ), byte1, Token( TokenType::PLUS ), byte2, Token( TokenType::RSHIFT ),
+                   byte3 };
+    ExpressionParser parser( tokens, m_arena );
+
+    size_t tokenIndex{ 0u };
+    AstNode root = parser.ParseExpression( tokenIndex, Logical );
+    BOOST_CHECK_EQUAL( tokens.size(), tokenIndex );
+
+    AstNode::ChildRange shiftChildren = CheckOperatorNode( root, TokenType::RSHIFT, 2u );
+    AstNode::ChildRange notChildren = CheckOperatorNode( shiftChildren[0], TokenType::NOT, 1u );
+    AstNode::ChildRange plusChildren = CheckOperatorNode( notChildren[0], TokenType::PLUS, 2u );
+    CheckNodeIsTokenWrapper( plusChildren[0], byte1 );
+    CheckNodeIsTokenWrapper( plusChildren[1], byte2 );
+    CheckNodeIsTokenWrapper( shiftChildren[1], byte3 );
+
+    // 1 + NOT 2
+    Tokens invalidTokens{ byte1, Token( TokenType::PLUS ), Token( TokenType::NOT ), byte2 };
+    ExpressionParser invalidParser( invalidTokens, m_arena );
+
+    tokenIndex = 0u;
+    root = invalidParser.ParseExpression( tokenIndex, Logical );
+    BOOST_CHECK_EQUAL( 1u, tokenIndex );
+    CheckNodeIsTokenWrapper( root, byte1 );
+}
+
+/**
+ * Tests that parsing from a tighter level leaves looser operators unparsed.
+ */
+BOOST_AUTO_TEST_CASE( StartFromTighterLevel )
+{
+    Token byte1 = Token( TokenType::BYTE, 1 );
+
+    // 1 OR 2
+    Tokens tokens{ byte1, Token( TokenType::OR ), Token( TokenType::BYTE, 2 ) };
+    ExpressionParser parser( tokens, m_arena );
+
+    size_t tokenIndex{ 0u };
+    AstNode root = parser.ParseExpression( tokenIndex, Term );
+    BOOST_CHECK_EQUAL( 1u, tokenIndex );
+    CheckNodeIsTokenWrapper( root, byte1 );
+
+    tokenIndex = 0u;
+    BOOST_CHECK_THROW( parser.ParseExpression( tokenIndex, Statement ), std::invalid_argument );
+}
+
+/**
+ * Tests that an unclosed bracket fails to parse, and doesn't move the token index.
+ */
+BOOST_AUTO_TEST_CASE( UnclosedBracket )
+{
+    // ( 1 + 2
+    Tokens tokens{ Token( TokenType::PAREN_OPEN ), Token( TokenType::BYTE, 1 ), Token( TokenType::PLUS ),
+                   Token( TokenType::BYTE, 2 ) };
+    ExpressionParser parser( tokens, m_arena );
+
+    size_t tokenIndex{ 0u };
+    BOOST_CHECK( nullptr == parser.ParseExpression( tokenIndex, Logical ) );
+    BOOST_CHECK_EQUAL( 0u, tokenIndex );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
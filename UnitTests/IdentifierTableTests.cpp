@@ -0,0 +1,82 @@
+#include <boost/test/unit_test.hpp>
+#include "IdentifierTable.h"
+
+BOOST_AUTO_TEST_SUITE( IdentifierTableTests )
+
+/**
+ * Tests that interning the same string twice gives the same ID, even if the strings are stored in different places.
+ */
+BOOST_AUTO_TEST_CASE( Intern_SameStringSameId )
+{
+    IdentifierTable table{};
+    std::string sourceString = "abc abc";
+
+    IdentifierId id1 = table.Intern( std::string_view( sourceString ).substr( 0u, 3u ) );
+    IdentifierId id2 = table.Intern( std::string_view( sourceString ).substr( 4u ) );
+
+    BOOST_CHECK( id1 == id2 );
+    BOOST_CHECK_EQUAL( 1u, table.GetNumIdentifiers() );
+}
+
+/**
+ * Tests that distinct strings are given dense IDs in the order they were first interned.
+ */
+BOOST_AUTO_TEST_CASE( Intern_DifferentStringsDenseIds )
+{
+    IdentifierTable table{};
+
+    IdentifierId idA = table.Intern( "a" );
+    IdentifierId idB = table.Intern( "b" );
+    IdentifierId idAgain = table.Intern( "a" );
+
+    BOOST_CHECK_EQUAL( 0u, static_cast< uint32_t >( idA ) );
+    BOOST_CHECK_EQUAL( 1u, static_cast< uint32_t >( idB ) );
+    BOOST_CHECK( idA == idAgain );
+    BOOST_CHECK_EQUAL( 2u, table.GetNumIdentifiers() );
+}
+
+/**
+ * Tests that identifiers are not truncated, and that names stay valid as more identifiers are added.
+ */
+BOOST_AUTO_TEST_CASE( GetName_LongIdentifier )
+{
+    IdentifierTable table{};
+    const std::string longName( 100u, 'x' );
+
+    IdentifierId id = table.Intern( longName );
+    const std::string& storedName = table.GetName( id );
+    for ( size_t i = 0u; i < 1000u; ++i )
+    {
+        table.Intern( "var" + std::to_string( i ) );
+    }
+
+    BOOST_CHECK_EQUAL( longName, storedName );
+    BOOST_CHECK_EQUAL( longName, table.GetName( id ) );
+}
+
+/**
+ * Tests that looking up a string that hasn't been interned doesn't add it to the table.
+ */
+BOOST_AUTO_TEST_CASE( GetIdIfExists_NotInterned )
+{
+    IdentifierTable table{};
+    table.Intern( "a" );
+
+    BOOST_CHECK( g_invalidIdentifierId == table.GetIdIfExists( "b" ) );
+    BOOST_CHECK( table.Intern( "a" ) == table.GetIdIfExists( "a" ) );
+    BOOST_CHECK_EQUAL( 1u, table.GetNumIdentifiers() );
+}
+
+/**
+ * Tests that getting the name of an ID not allocated by the table throws an exception.
+ */
+BOOST_AUTO_TEST_CASE( GetName_UnknownId )
+{
+    IdentifierTable table{};
+    table.Intern( "a" );
+
+    BOOST_CHECK_THROW( table.GetName( IdentifierId{ 1u } ), std::out_of_range );
+    BOOST_CHECK_THROW( table.GetName( g_invalidIdentifierId ), std::out_of_range );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -18,15 +18,30 @@ public:
         m_codeGenerator = std::make_shared< IntermediateCode >( m_instrFactoryMock, m_exprGeneratorMock );
     }
 
-    ThreeAddrInstruction::Ptr MakeDummyUniqueTacInstr()
+    // Instructions are referred to by their index in the factory's buffer, so make each dummy index unique.
+    size_t MakeDummyUniqueInstrIndex()
     {
-        return std::make_shared< ThreeAddrInstruction >( "target", Opcode::INVALID, "op1", "op2" );
+        return m_nextDummyInstrIndex++;
+    }
+
+    // Gets the variable ID the symbol table of a scope has allocated to an identifier.
+    VarId GetVarId( AstNode scopeNode, const std::string& identifier )
+    {
+        SymbolTableEntry* entry
+            = scopeNode.GetSymbolTable()->GetEntryIfExists( IdentifierTable::GetInstance()->Intern( identifier ) );
+        BOOST_REQUIRE( nullptr != entry );
+        return entry->varId;
     }
 
     IntermediateCode::Ptr m_codeGenerator;
 
     TacExpressionGeneratorMock::Ptr m_exprGeneratorMock;
     TacInstructionFactoryMock::Ptr m_instrFactoryMock;
+    // Index to give the next dummy instruction.
+    size_t m_nextDummyInstrIndex{ 0u };
+
+    // Arena storing the nodes of the ASTs created by the test case.
+    AstArena m_arena;
 };
 
 BOOST_FIXTURE_TEST_SUITE( IntermediateCodeTests, IntermediateCodeTestsFixture )
@@ -47,8 +62,8 @@ BOOST_AUTO_TEST_CASE( NullptrAst )
  */
 BOOST_AUTO_TEST_CASE( AstStoresToken )
 {
-    Token::Ptr token = std::make_shared< Token >( T::MINUS );
-    AstNode::Ptr tokenNode = std::make_shared< AstNode >( T::MINUS, token );
+    Token token = Token( T::MINUS );
+    AstNode tokenNode = m_arena.CreateNode( T::MINUS, token );
     BOOST_CHECK_THROW( m_codeGenerator->GenerateIntermediateCode( tokenNode ), std::invalid_argument );
 }
 
@@ -58,7 +73,7 @@ BOOST_AUTO_TEST_CASE( AstStoresToken )
 BOOST_AUTO_TEST_CASE( AstNoChildren )
 {
     AstNode::Children children{}; // Empty children
-    AstNode::Ptr ast = std::make_shared< AstNode >( T::AND, children );
+    AstNode ast = m_arena.CreateNode( T::AND, children );
     BOOST_CHECK_THROW( m_codeGenerator->GenerateIntermediateCode( ast ), std::invalid_argument );
 }
 
@@ -69,8 +84,8 @@ BOOST_AUTO_TEST_CASE( AstNoSymbolTable )
 {
     // Create otherwise-valid program consisting of an assignment statement.
     const std::string varName{ "var" };
-    AstNode::Ptr assignNode = CreateAssignNodeFromByteValue( varName, 5u, IsDeclaration::TRUE );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { assignNode } );
+    AstNode assignNode = CreateAssignNodeFromByteValue( m_arena, varName, 5u, IsDeclaration::TRUE );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { assignNode } );
 
     BOOST_CHECK_THROW( m_codeGenerator->GenerateIntermediateCode( blockNode ), std::invalid_argument );
 }
@@ -83,8 +98,8 @@ BOOST_AUTO_TEST_CASE( VarNotInSymbolTable )
 {
     // Create otherwise-valid program consisting of an assignment statement.
     const std::string varName{ "var" };
-    AstNode::Ptr assignNode = CreateAssignNodeFromByteValue( varName, 5u, IsDeclaration::TRUE );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { assignNode } );
+    AstNode assignNode = CreateAssignNodeFromByteValue( m_arena, varName, 5u, IsDeclaration::TRUE );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { assignNode } );
 
     const std::string wrongVarName{ "wrongName" };
     CreateAndAttachFakeSymbolTable( blockNode, { wrongVarName } );
@@ -105,18 +120,18 @@ BOOST_AUTO_TEST_SUITE( Assign )
 BOOST_AUTO_TEST_CASE( WrongNumChildren )
 {
     const std::string varName{ "var" };
-    AstNode::Ptr varNode
-        = std::make_shared< AstNode >( T::IDENTIFIER, std::make_shared< Token >( T::IDENTIFIER, varName ) );
+    AstNode varNode
+        = m_arena.CreateNode( T::IDENTIFIER, Token( T::IDENTIFIER, varName ) );
 
     AstNode::Children oneChild{ varNode };
-    AstNode::Ptr invalidAssignNode_OneChild = std::make_shared< AstNode >( T::ASSIGN, oneChild );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { invalidAssignNode_OneChild } );
+    AstNode invalidAssignNode_OneChild = m_arena.CreateNode( T::ASSIGN, oneChild );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { invalidAssignNode_OneChild } );
     CreateAndAttachFakeSymbolTable( blockNode, {} );
     BOOST_CHECK_THROW( m_codeGenerator->GenerateIntermediateCode( blockNode ), std::invalid_argument );
 
     AstNode::Children tooManyChildren{ varNode, invalidAssignNode_OneChild, blockNode };
-    AstNode::Ptr invalidAssignNode_ThreeChildren = std::make_shared< AstNode >( T::ASSIGN, tooManyChildren );
-    AstNode::Ptr blockNode_TooManyChildren = WrapNodesInBlocks( { invalidAssignNode_ThreeChildren } );
+    AstNode invalidAssignNode_ThreeChildren = m_arena.CreateNode( T::ASSIGN, tooManyChildren );
+    AstNode blockNode_TooManyChildren = WrapNodesInBlocks( m_arena, { invalidAssignNode_ThreeChildren } );
     CreateAndAttachFakeSymbolTable( blockNode_TooManyChildren, {} );
     BOOST_CHECK_THROW( m_codeGenerator->GenerateIntermediateCode( blockNode_TooManyChildren ), std::invalid_argument );
 }
@@ -129,8 +144,8 @@ BOOST_AUTO_TEST_CASE( AssignsSingleLiteral )
 {
     const std::string varName{ "var" };
     constexpr uint8_t literalValue{ 3u };
-    AstNode::Ptr assign = CreateAssignNodeFromByteValue( varName, literalValue, IsDeclaration::TRUE );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { assign } );
+    AstNode assign = CreateAssignNodeFromByteValue( m_arena, varName, literalValue, IsDeclaration::TRUE );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { assign } );
     CreateAndAttachFakeSymbolTable( blockNode, { varName } );
 
     // Expect a single assignment TAC instruction to be added
@@ -155,8 +170,8 @@ BOOST_AUTO_TEST_CASE( AssignsSingleIdentifier )
 {
     const std::string varName{ "var" };
     const std::string rhsIdentifier{ "value" };
-    AstNode::Ptr assign = CreateAssignNodeFromVar( varName, rhsIdentifier, IsDeclaration::TRUE );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { assign } );
+    AstNode assign = CreateAssignNodeFromVar( m_arena, varName, rhsIdentifier, IsDeclaration::TRUE );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { assign } );
     CreateAndAttachFakeSymbolTable( blockNode, { varName, rhsIdentifier } );
 
     // Expect a single assignment TAC instruction to be added
@@ -168,8 +183,8 @@ BOOST_AUTO_TEST_CASE( AssignsSingleIdentifier )
 
     m_codeGenerator->GenerateIntermediateCode( blockNode );
 
-    BOOST_REQUIRE( std::holds_alternative< std::string >( rhsOperand ) );
-    // Can't check the operand contents because a new unique id is calculated.
+    BOOST_REQUIRE( std::holds_alternative< VarId >( rhsOperand ) );
+    BOOST_CHECK( GetVarId( blockNode, rhsIdentifier ) == std::get< VarId >( rhsOperand ) );
 }
 
 /**
@@ -182,24 +197,26 @@ BOOST_AUTO_TEST_CASE( AssignsExpression_MapsToTacOpcode )
     constexpr GrammarSymbols::T expressionLabel{ T::PLUS };
     const std::string rhsOperand1{ "operand1" };
     constexpr uint8_t rhsOperand2{ 10u };
-    AstNode::Ptr assign = CreateTwoOperandStatement< std::string, uint8_t >( varName,
+    AstNode assign = CreateTwoOperandStatement< std::string, uint8_t >( m_arena, varName,
                                                                              IsDeclaration::TRUE,
                                                                              expressionLabel,
                                                                              rhsOperand1,
                                                                              rhsOperand2 );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { assign } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { assign } );
     CreateAndAttachFakeSymbolTable( blockNode, { varName, rhsOperand1 } );
+    const VarId expectedTarget = GetVarId( blockNode, varName );
+    const VarId expectedOperand1 = GetVarId( blockNode, rhsOperand1 );
 
     // Expect a single TAC instruction to be added
     constexpr TAC::Opcode expectedTacOpcode{ ADD };
     MOCK_EXPECT( m_instrFactoryMock->AddInstruction )
         .once()
-        .with( mock::any, expectedTacOpcode, mock::any, mock::any )
+        .with( expectedTarget, expectedTacOpcode, mock::any, mock::any )
         .calls(
-            [&]( std::string, TAC::Opcode, TAC::Operand operand1, TAC::Operand operand2 )
+            [&]( VarId, TAC::Opcode, TAC::Operand operand1, TAC::Operand operand2 )
             {
-                BOOST_REQUIRE( std::holds_alternative< std::string >( operand1 ) );
-                // Can't check the operand contents because a new unique id is calculated.
+                BOOST_REQUIRE( std::holds_alternative< VarId >( operand1 ) );
+                BOOST_CHECK( expectedOperand1 == std::get< VarId >( operand1 ) );
 
                 BOOST_REQUIRE( std::holds_alternative< Literal >( operand2 ) );
                 BOOST_CHECK_EQUAL( rhsOperand2, std::get< Literal >( operand2 ) );
@@ -220,12 +237,12 @@ BOOST_AUTO_TEST_CASE( AssignsExpression_MapsToTacOpcode_TwoLiterals )
     constexpr GrammarSymbols::T expressionLabel{ T::PLUS };
     constexpr uint8_t rhsOperand1{ 2u };
     constexpr uint8_t rhsOperand2{ 10u };
-    AstNode::Ptr assign = CreateTwoOperandStatement< uint8_t, uint8_t >( varName,
+    AstNode assign = CreateTwoOperandStatement< uint8_t, uint8_t >( m_arena, varName,
                                                                          IsDeclaration::TRUE,
                                                                          expressionLabel,
                                                                          rhsOperand1,
                                                                          rhsOperand2 );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { assign } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { assign } );
     CreateAndAttachFakeSymbolTable( blockNode, { varName } );
 
     // Expect a single assignment TAC instruction to be added
@@ -233,7 +250,7 @@ BOOST_AUTO_TEST_CASE( AssignsExpression_MapsToTacOpcode_TwoLiterals )
     MOCK_EXPECT( m_instrFactoryMock->AddAssignmentInstruction )
         .once()
         .calls(
-            [&]( std::string, TAC::Operand rhs )
+            [&]( VarId, TAC::Operand rhs )
             {
                 BOOST_REQUIRE( std::holds_alternative< Literal >( rhs ) );
                 BOOST_CHECK_EQUAL( expectedRhs, std::get< Literal >( rhs ) );
@@ -254,26 +271,26 @@ BOOST_AUTO_TEST_CASE( AssignsExpression_DoesNotMapToTacOpcode )
     constexpr GrammarSymbols::T expressionLabel{ T::MOD }; // Not an accepted TAC opcode
     const std::string rhsOperand1{ "operand1" };
     constexpr uint8_t rhsOperand2{ 10u };
-    AstNode::Ptr assign = CreateTwoOperandStatement< std::string, uint8_t >( varName,
+    AstNode assign = CreateTwoOperandStatement< std::string, uint8_t >( m_arena, varName,
                                                                              IsDeclaration::TRUE,
                                                                              expressionLabel,
                                                                              rhsOperand1,
                                                                              rhsOperand2 );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { assign } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { assign } );
     CreateAndAttachFakeSymbolTable( blockNode, { varName, rhsOperand1 } );
 
     mock::sequence s;
 
     // Expect a call to the TAC generator to get the rhs operand
-    const Operand expressionOperandToReturn{ "expressionResult" };
+    const Operand expressionOperandToReturn{ VarId{ 100u } }; // Arbitrary temp ID, unused by the symbol table
     MOCK_EXPECT( m_exprGeneratorMock->Modulo )
         .once()
         .in( s )
         .calls(
             [&]( Operand operand1, Operand operand2 )
             {
-                BOOST_REQUIRE( std::holds_alternative< std::string >( operand1 ) );
-                // Can't check the operand contents because a new unique id is calculated.
+                BOOST_REQUIRE( std::holds_alternative< VarId >( operand1 ) );
+                BOOST_CHECK( GetVarId( blockNode, rhsOperand1 ) == std::get< VarId >( operand1 ) );
 
                 BOOST_REQUIRE( std::holds_alternative< Literal >( operand2 ) );
                 BOOST_CHECK_EQUAL( rhsOperand2, std::get< Literal >( operand2 ) );
@@ -288,7 +305,7 @@ BOOST_AUTO_TEST_CASE( AssignsExpression_DoesNotMapToTacOpcode )
         .once()
         .in( s )
         .calls(
-            [&]( std::string, TAC::Operand operand )
+            [&]( VarId, TAC::Operand operand )
             {
                 BOOST_CHECK( operand == expressionOperandToReturn );
             }
@@ -307,32 +324,32 @@ BOOST_AUTO_TEST_CASE( AssignsNestedExpression)
     const std::string varA{ "a" };
     constexpr uint8_t decrement{ 1u };
     constexpr T subExpr1NodeLabel{ MINUS };
-    AstNode::Ptr subExpr1 = CreateTwoOpExpression( subExpr1NodeLabel, varA, decrement );
+    AstNode subExpr1 = CreateTwoOpExpression( m_arena, subExpr1NodeLabel, varA, decrement );
 
     constexpr uint8_t dividend{ 6u };
     constexpr uint8_t quotient{ 2u };
     constexpr T subExpr2NodeLabel{ DIVIDE };
-    AstNode::Ptr subExpr2 = CreateTwoOpExpression( subExpr2NodeLabel, dividend, quotient );
+    AstNode subExpr2 = CreateTwoOpExpression( m_arena, subExpr2NodeLabel, dividend, quotient );
 
     const T jointSubExprNodeLabel{ GT };
-    AstNode::Ptr jointSubExpr = CreateTwoOpExpression( jointSubExprNodeLabel, subExpr1, subExpr2 );
+    AstNode jointSubExpr = CreateTwoOpExpression( m_arena, jointSubExprNodeLabel, subExpr1, subExpr2 );
 
     const std::string targetVar{ "var" };
     constexpr uint8_t rhsOperand2{ 5u };
     constexpr T exprNodeLabel{ BITWISE_AND };
-    AstNode::Ptr assign = CreateTwoOperandStatement< AstNode::Ptr, uint8_t >( targetVar,
+    AstNode assign = CreateTwoOperandStatement< AstNode, uint8_t >( m_arena, targetVar,
                                                                               IsDeclaration::TRUE,
                                                                               exprNodeLabel,
                                                                               jointSubExpr,
                                                                               rhsOperand2 );
 
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { assign } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { assign } );
     CreateAndAttachFakeSymbolTable( blockNode, { targetVar, varA } );
 
     mock::sequence s;
 
     // Expect an instruction to a temp var to store the first minus sub-expression.
-    const std::string minusTempVar{ "minus" };
+    const VarId minusTempVar{ 100u }; // Arbitrary temp ID, unused by the symbol table
     MOCK_EXPECT( m_instrFactoryMock->GetNewTempVar )
         .once()
         .in( s )
@@ -343,10 +360,10 @@ BOOST_AUTO_TEST_CASE( AssignsNestedExpression)
         .in( s )
         .with( minusTempVar, minusOpcode, mock::any, mock::any )
         .calls(
-            [&]( std::string, Opcode, Operand operand1, Operand operand2 )
+            [&]( VarId, Opcode, Operand operand1, Operand operand2 )
             {
-                BOOST_REQUIRE( std::holds_alternative< std::string >( operand1 ) );
-                // Can't check the operand contents because a new unique id is calculated.
+                BOOST_REQUIRE( std::holds_alternative< VarId >( operand1 ) );
+                BOOST_CHECK( GetVarId( blockNode, varA ) == std::get< VarId >( operand1 ) );
                 BOOST_REQUIRE( std::holds_alternative< Literal >( operand2 ) );
                 BOOST_CHECK_EQUAL( decrement, std::get< Literal >( operand2 ) );
             }
@@ -371,15 +388,15 @@ BOOST_AUTO_TEST_CASE( AssignsNestedExpression)
         );
 
     // Expect an instruction to a temp var to store the greater than sub-expression.
-    const Operand gtOperandToReturn{ "gtResult" };
+    const Operand gtOperandToReturn{ VarId{ 101u } };
     MOCK_EXPECT( m_exprGeneratorMock->GreaterThan )
         .once()
         .in( s )
         .calls(
             [&]( Operand operand1, Operand operand2 )
             {
-                BOOST_REQUIRE( std::holds_alternative< std::string >( operand1 ) );
-                BOOST_CHECK_EQUAL( minusTempVar, std::get< std::string >( operand1 ) );
+                BOOST_REQUIRE( std::holds_alternative< VarId >( operand1 ) );
+                BOOST_CHECK( minusTempVar == std::get< VarId >( operand1 ) );
                 BOOST_CHECK( divideOperandToReturn == operand2 );
 
                 return gtOperandToReturn;
@@ -393,7 +410,7 @@ BOOST_AUTO_TEST_CASE( AssignsNestedExpression)
         .in( s )
         .with( mock::any, bitwiseAndOpcode, mock::any, mock::any )
         .calls(
-            [&]( std::string, Opcode, Operand operand1, Operand operand2 )
+            [&]( VarId, Opcode, Operand operand1, Operand operand2 )
             {
                 BOOST_CHECK( gtOperandToReturn == operand1 );
                 BOOST_REQUIRE( std::holds_alternative< Literal >( operand2 ) );
@@ -415,12 +432,12 @@ BOOST_AUTO_TEST_SUITE( IfElse )
 BOOST_AUTO_TEST_CASE( WrongNumChildren )
 {
     constexpr uint8_t byteValue{ 1u };
-    AstNode::Ptr conditionNode = std::make_shared< AstNode >( T::BYTE, std::make_shared< Token >( T::BYTE, byteValue ) );
+    AstNode conditionNode = m_arena.CreateNode( T::BYTE, Token( T::BYTE, byteValue ) );
 
     AstNode::Children oneChild{ conditionNode };
-    AstNode::Ptr ifNode = std::make_shared< AstNode >( T::IF, oneChild );
+    AstNode ifNode = m_arena.CreateNode( T::IF, oneChild );
     CreateAndAttachFakeSymbolTable( ifNode, {} );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { ifNode } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { ifNode } );
     CreateAndAttachFakeSymbolTable( blockNode, {} );
     BOOST_CHECK_THROW( m_codeGenerator->GenerateIntermediateCode( blockNode ), std::invalid_argument );
 }
@@ -431,15 +448,15 @@ BOOST_AUTO_TEST_CASE( WrongNumChildren )
 BOOST_AUTO_TEST_CASE( NoSymbolTable )
 {
     constexpr uint8_t byteValue{ 1u };
-    AstNode::Ptr conditionNode = std::make_shared< AstNode >( T::BYTE, std::make_shared< Token >( T::BYTE, byteValue ) );
+    AstNode conditionNode = m_arena.CreateNode( T::BYTE, Token( T::BYTE, byteValue ) );
 
     const std::string dummyVarName{ "dummyVar" };
-    AstNode::Ptr dummyAssign = CreateAssignNodeFromByteValue( dummyVarName, 5u, IsDeclaration::TRUE );
+    AstNode dummyAssign = CreateAssignNodeFromByteValue( m_arena, dummyVarName, 5u, IsDeclaration::TRUE );
 
     AstNode::Children ifChildren{ conditionNode, dummyAssign };
-    AstNode::Ptr ifNode = std::make_shared< AstNode >( T::IF, ifChildren );
+    AstNode ifNode = m_arena.CreateNode( T::IF, ifChildren );
 
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { ifNode } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { ifNode } );
     // Give the outer block node a symbol table, but not the if node.
     CreateAndAttachFakeSymbolTable( blockNode, {} );
 
@@ -453,29 +470,29 @@ BOOST_AUTO_TEST_CASE( NoSymbolTable )
 BOOST_AUTO_TEST_CASE( SingleOperandCondition )
 {
     constexpr uint8_t conditionValue{ 1u };
-    AstNode::Ptr conditionNode = std::make_shared< AstNode >( T::BYTE,
-                                                              std::make_shared< Token >( T::BYTE, conditionValue ) );
+    AstNode conditionNode = m_arena.CreateNode( T::BYTE,
+                                                              Token( T::BYTE, conditionValue ) );
 
     const std::string dummyVarName{ "dummyVar" };
-    AstNode::Ptr dummyAssign = CreateAssignNodeFromByteValue( dummyVarName, 5u, IsDeclaration::TRUE );
+    AstNode dummyAssign = CreateAssignNodeFromByteValue( m_arena, dummyVarName, 5u, IsDeclaration::TRUE );
 
     AstNode::Children ifChildren{ conditionNode, dummyAssign };
-    AstNode::Ptr ifNode = std::make_shared< AstNode >( T::IF, ifChildren );
+    AstNode ifNode = m_arena.CreateNode( T::IF, ifChildren );
     CreateAndAttachFakeSymbolTable( ifNode, { dummyVarName } );
 
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { ifNode } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { ifNode } );
     CreateAndAttachFakeSymbolTable( blockNode, {} );
 
     mock::sequence s;
 
     // Expect a branch instruction to the end, if condition == 0.
     // The label is not yet known at this time so expect a placeholder.
-    MOCK_EXPECT( m_instrFactoryMock->AddInstruction )
+    MOCK_EXPECT( m_instrFactoryMock->AddBranchInstruction )
         .once()
         .in( s )
         .with( TacInstructionFactory::PLACEHOLDER, Opcode::BRE, mock::any, mock::any )
         .calls(
-            [&]( std::string, Opcode, Operand operand1, Operand operand2 )
+            [&]( LabelId, Opcode, Operand operand1, Operand operand2 )
             {
                 BOOST_REQUIRE( std::holds_alternative< Literal >( operand1 ) );
                 BOOST_CHECK_EQUAL( conditionValue, std::get< Literal >( operand1 ) );
@@ -484,11 +501,11 @@ BOOST_AUTO_TEST_CASE( SingleOperandCondition )
             }
         );
     // Expect a get request for this instruction so it can go back later and assign the target label - return mock.
-    ThreeAddrInstruction::Ptr branchToElseInstr = MakeDummyUniqueTacInstr();
-    MOCK_EXPECT( m_instrFactoryMock->GetLatestInstruction )
+    size_t branchToElseIndex = MakeDummyUniqueInstrIndex();
+    MOCK_EXPECT( m_instrFactoryMock->GetLatestInstructionIndex )
         .once()
         .in( s )
-        .returns( branchToElseInstr );
+        .returns( branchToElseIndex );
 
     // Expect the assign statement to be added - this is already tested so we're not interested in 100% validation.
     MOCK_EXPECT( m_instrFactoryMock->AddAssignmentInstruction )
@@ -499,7 +516,7 @@ BOOST_AUTO_TEST_CASE( SingleOperandCondition )
     MOCK_EXPECT( m_instrFactoryMock->SetInstructionBranchToNextLabel )
         .once()
         .in( s )
-        .with( branchToElseInstr, mock::any );
+        .with( branchToElseIndex, mock::any );
 
     m_codeGenerator->GenerateIntermediateCode( blockNode );
 }
@@ -514,43 +531,45 @@ BOOST_AUTO_TEST_CASE( ExpressionCondition )
     const std::string varA{ "a" };
     const std::string varB{ "b" };
     const T conditionNodeLabel{ T::LEQ };
-    AstNode::Ptr conditionNode = CreateTwoOpExpression( conditionNodeLabel, varA, varB );
+    AstNode conditionNode = CreateTwoOpExpression( m_arena, conditionNodeLabel, varA, varB );
 
     const std::string dummyVarName{ "dummyVar" };
-    AstNode::Ptr dummyAssign = CreateAssignNodeFromByteValue( dummyVarName, 5u, IsDeclaration::TRUE );
+    AstNode dummyAssign = CreateAssignNodeFromByteValue( m_arena, dummyVarName, 5u, IsDeclaration::TRUE );
 
     AstNode::Children ifChildren{ conditionNode, dummyAssign };
-    AstNode::Ptr ifNode = std::make_shared< AstNode >( T::IF, ifChildren );
+    AstNode ifNode = m_arena.CreateNode( T::IF, ifChildren );
 
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { ifNode } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { ifNode } );
     CreateAndAttachFakeSymbolTable( blockNode, { varA, varB } );
 
-    CreateAndAttachFakeSymbolTable( ifNode, { dummyVarName }, blockNode->m_symbolTable );
+    CreateAndAttachFakeSymbolTable( ifNode, { dummyVarName }, blockNode.GetSymbolTable() );
 
     mock::sequence s;
 
     // Expect call to get condition operand
-    const Operand conditionOperandToReturn{ "condition" };
+    const Operand conditionOperandToReturn{ VarId{ 100u } }; // Arbitrary temp ID, unused by the symbol table
     MOCK_EXPECT( m_exprGeneratorMock->Leq )
         .once()
         .in( s )
         .calls(
             [&]( Operand operand1, Operand operand2 )
             {
-                BOOST_REQUIRE( std::holds_alternative< std::string >( operand1 ) );
-                BOOST_REQUIRE( std::holds_alternative< std::string >( operand2 ) );
+                BOOST_REQUIRE( std::holds_alternative< VarId >( operand1 ) );
+                BOOST_CHECK( GetVarId( blockNode, varA ) == std::get< VarId >( operand1 ) );
+                BOOST_REQUIRE( std::holds_alternative< VarId >( operand2 ) );
+                BOOST_CHECK( GetVarId( blockNode, varB ) == std::get< VarId >( operand2 ) );
                 return conditionOperandToReturn;
             }
         );
 
     // Expect a branch instruction to the end, if condition == 0.
     // The label is not yet known at this time so expect a placeholder.
-    MOCK_EXPECT( m_instrFactoryMock->AddInstruction )
+    MOCK_EXPECT( m_instrFactoryMock->AddBranchInstruction )
         .once()
         .in( s )
         .with( TacInstructionFactory::PLACEHOLDER, Opcode::BRE, mock::any, mock::any )
         .calls(
-            [&]( std::string, Opcode, Operand operand1, Operand operand2 )
+            [&]( LabelId, Opcode, Operand operand1, Operand operand2 )
             {
                 BOOST_CHECK( conditionOperandToReturn == operand1 );
                 BOOST_REQUIRE( std::holds_alternative< Literal >( operand2 ) );
@@ -558,11 +577,11 @@ BOOST_AUTO_TEST_CASE( ExpressionCondition )
             }
         );
     // Expect a get request for this instruction so it can go back later and assign the target label - return mock.
-    ThreeAddrInstruction::Ptr branchToElseInstr = MakeDummyUniqueTacInstr();
-    MOCK_EXPECT( m_instrFactoryMock->GetLatestInstruction )
+    size_t branchToElseIndex = MakeDummyUniqueInstrIndex();
+    MOCK_EXPECT( m_instrFactoryMock->GetLatestInstructionIndex )
         .once()
         .in( s )
-        .returns( branchToElseInstr );
+        .returns( branchToElseIndex );
 
     // Expect the assign statement to be added - this is already tested so we're not interested in 100% validation.
     MOCK_EXPECT( m_instrFactoryMock->AddAssignmentInstruction )
@@ -573,7 +592,7 @@ BOOST_AUTO_TEST_CASE( ExpressionCondition )
     MOCK_EXPECT( m_instrFactoryMock->SetInstructionBranchToNextLabel )
         .once()
         .in( s )
-        .with( branchToElseInstr, mock::any );
+        .with( branchToElseIndex, mock::any );
 
     m_codeGenerator->GenerateIntermediateCode( blockNode );
 }
@@ -585,19 +604,19 @@ BOOST_AUTO_TEST_CASE( ExpressionCondition )
 BOOST_AUTO_TEST_CASE( ThirdChildNotElse )
 {
     constexpr uint8_t conditionValue{ 1u };
-    AstNode::Ptr conditionNode = std::make_shared< AstNode >( T::BYTE,
-                                                              std::make_shared< Token >( T::BYTE, conditionValue ) );
+    AstNode conditionNode = m_arena.CreateNode( T::BYTE,
+                                                              Token( T::BYTE, conditionValue ) );
 
     const std::string dummyVarName{ "dummyVar" };
-    AstNode::Ptr dummyAssign = CreateAssignNodeFromByteValue( dummyVarName, 5u, IsDeclaration::TRUE );
+    AstNode dummyAssign = CreateAssignNodeFromByteValue( m_arena, dummyVarName, 5u, IsDeclaration::TRUE );
 
-    AstNode::Ptr thirdChild = CreateAssignNodeFromByteValue( dummyVarName, 5u, IsDeclaration::TRUE );
+    AstNode thirdChild = CreateAssignNodeFromByteValue( m_arena, dummyVarName, 5u, IsDeclaration::TRUE );
 
     AstNode::Children ifChildren{ conditionNode, dummyAssign, thirdChild };
-    AstNode::Ptr ifNode = std::make_shared< AstNode >( T::IF, ifChildren );
+    AstNode ifNode = m_arena.CreateNode( T::IF, ifChildren );
     CreateAndAttachFakeSymbolTable( ifNode, { dummyVarName } );
 
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { ifNode } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { ifNode } );
     CreateAndAttachFakeSymbolTable( blockNode, {} );
 
     BOOST_CHECK_THROW( m_codeGenerator->GenerateIntermediateCode( blockNode ), std::invalid_argument );
@@ -609,34 +628,34 @@ BOOST_AUTO_TEST_CASE( ThirdChildNotElse )
 BOOST_AUTO_TEST_CASE( ValidElse )
 {
     constexpr uint8_t conditionValue{ 1u };
-    AstNode::Ptr conditionNode = std::make_shared< AstNode >( T::BYTE,
-                                                              std::make_shared< Token >( T::BYTE, conditionValue ) );
+    AstNode conditionNode = m_arena.CreateNode( T::BYTE,
+                                                              Token( T::BYTE, conditionValue ) );
 
     const std::string dummyIfVarName{ "dummyIfVar" };
-    AstNode::Ptr dummyIfAssign = CreateAssignNodeFromByteValue( dummyIfVarName, 5u, IsDeclaration::TRUE );
+    AstNode dummyIfAssign = CreateAssignNodeFromByteValue( m_arena, dummyIfVarName, 5u, IsDeclaration::TRUE );
 
     const std::string dummyElseVarName{ "dummyElseVar" };
-    AstNode::Ptr dummyElseAssign = CreateAssignNodeFromByteValue( dummyElseVarName, 5u, IsDeclaration::TRUE );
+    AstNode dummyElseAssign = CreateAssignNodeFromByteValue( m_arena, dummyElseVarName, 5u, IsDeclaration::TRUE );
     AstNode::Children elseChildren{ dummyElseAssign };
-    AstNode::Ptr elseNode = std::make_shared< AstNode >( T::ELSE, elseChildren );
+    AstNode elseNode = m_arena.CreateNode( T::ELSE, elseChildren );
 
     AstNode::Children ifChildren{ conditionNode, dummyIfAssign, elseNode };
-    AstNode::Ptr ifNode = std::make_shared< AstNode >( T::IF, ifChildren );
+    AstNode ifNode = m_arena.CreateNode( T::IF, ifChildren );
     CreateAndAttachFakeSymbolTable( ifNode, { dummyIfVarName, dummyElseVarName } );
 
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { ifNode } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { ifNode } );
     CreateAndAttachFakeSymbolTable( blockNode, {} );
 
     mock::sequence s;
 
     // Expect a branch instruction to the end, if condition == 0.
     // The label is not yet known at this time so expect a placeholder.
-    MOCK_EXPECT( m_instrFactoryMock->AddInstruction )
+    MOCK_EXPECT( m_instrFactoryMock->AddBranchInstruction )
         .once()
         .in( s )
         .with( TacInstructionFactory::PLACEHOLDER, Opcode::BRE, mock::any, mock::any )
         .calls(
-            [&]( std::string, Opcode, Operand operand1, Operand operand2 )
+            [&]( LabelId, Opcode, Operand operand1, Operand operand2 )
             {
                 BOOST_REQUIRE( std::holds_alternative< Literal >( operand1 ) );
                 BOOST_CHECK_EQUAL( conditionValue, std::get< Literal >( operand1 ) );
@@ -645,11 +664,11 @@ BOOST_AUTO_TEST_CASE( ValidElse )
             }
         );
     // Expect a get request for this instruction so it can go back later and assign the target label - return mock.
-    ThreeAddrInstruction::Ptr branchToElseInstr = MakeDummyUniqueTacInstr();
-    MOCK_EXPECT( m_instrFactoryMock->GetLatestInstruction )
+    size_t branchToElseIndex = MakeDummyUniqueInstrIndex();
+    MOCK_EXPECT( m_instrFactoryMock->GetLatestInstructionIndex )
         .once()
         .in( s )
-        .returns( branchToElseInstr );
+        .returns( branchToElseIndex );
 
     // Expect the assign statement to be added - this is already tested so we're not interested in 100% validation.
     MOCK_EXPECT( m_instrFactoryMock->AddAssignmentInstruction )
@@ -657,23 +676,23 @@ BOOST_AUTO_TEST_CASE( ValidElse )
         .in( s );
 
     // Expect an unconditional branch to the end, skipping past the else block
-    MOCK_EXPECT( m_instrFactoryMock->AddInstruction )
+    MOCK_EXPECT( m_instrFactoryMock->AddBranchInstruction )
         .once()
         .in( s )
         .with( TacInstructionFactory::PLACEHOLDER, Opcode::BRE, mock::any, mock::any )
         .calls(
-            [&]( std::string, Opcode, Operand operand1, Operand operand2 )
+            [&]( LabelId, Opcode, Operand operand1, Operand operand2 )
             {
                 // The contents of the operands don't matter, only that they are equal.
                 BOOST_CHECK( operand1 == operand2 );
             }
         );
     // Expect a get request for this instruction so it can go back later and assign the target label - return mock.
-    ThreeAddrInstruction::Ptr branchToEndInstr = MakeDummyUniqueTacInstr();
-    MOCK_EXPECT( m_instrFactoryMock->GetLatestInstruction )
+    size_t branchToEndIndex = MakeDummyUniqueInstrIndex();
+    MOCK_EXPECT( m_instrFactoryMock->GetLatestInstructionIndex )
         .once()
         .in( s )
-        .returns( branchToEndInstr );
+        .returns( branchToEndIndex );
 
     // The ELSE section:
 
@@ -681,7 +700,7 @@ BOOST_AUTO_TEST_CASE( ValidElse )
     MOCK_EXPECT( m_instrFactoryMock->SetInstructionBranchToNextLabel )
         .once()
         .in( s )
-        .with( branchToElseInstr, mock::any );
+        .with( branchToElseIndex, mock::any );
 
     // Expect the else assign statement to be added - this is already tested so we're not interested in 100% validation.
     MOCK_EXPECT( m_instrFactoryMock->AddAssignmentInstruction )
@@ -692,7 +711,7 @@ BOOST_AUTO_TEST_CASE( ValidElse )
     MOCK_EXPECT( m_instrFactoryMock->SetInstructionBranchToNextLabel )
         .once()
         .in( s )
-        .with( branchToEndInstr, mock::any );
+        .with( branchToEndIndex, mock::any );
 
     m_codeGenerator->GenerateIntermediateCode( blockNode );
 }
@@ -708,12 +727,12 @@ BOOST_AUTO_TEST_SUITE( For )
 BOOST_AUTO_TEST_CASE( WrongNumChildren )
 {
     constexpr uint8_t byteValue{ 1u };
-    AstNode::Ptr conditionNode = std::make_shared< AstNode >( T::BYTE, std::make_shared< Token >( T::BYTE, byteValue ) );
+    AstNode conditionNode = m_arena.CreateNode( T::BYTE, Token( T::BYTE, byteValue ) );
 
     AstNode::Children oneChild{ conditionNode };
-    AstNode::Ptr forNode = std::make_shared< AstNode >( T::FOR, oneChild );
+    AstNode forNode = m_arena.CreateNode( T::FOR, oneChild );
     CreateAndAttachFakeSymbolTable( forNode, {} );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { forNode } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { forNode } );
     CreateAndAttachFakeSymbolTable( blockNode, {} );
     BOOST_CHECK_THROW( m_codeGenerator->GenerateIntermediateCode( blockNode ), std::invalid_argument );
 }
@@ -725,17 +744,17 @@ BOOST_AUTO_TEST_CASE( WrongNumChildren )
 BOOST_AUTO_TEST_CASE( ForInit_WrongNumChildren )
 {
     const std::string initVar{ "initVar" };
-    AstNode::Ptr initAssign = CreateAssignNodeFromByteValue( initVar, 0u, IsDeclaration::TRUE );
+    AstNode initAssign = CreateAssignNodeFromByteValue( m_arena, initVar, 0u, IsDeclaration::TRUE );
     AstNode::Children initChildren{ initAssign }; // Missing the other 2 parts of the init
-    AstNode::Ptr initNode = std::make_shared< AstNode >( NT::For_init, initChildren );
+    AstNode initNode = m_arena.CreateNode( NT::For_init, initChildren );
 
     const std::string dummyVar{ "dummyVar" };
-    AstNode::Ptr dummyAssign = CreateAssignNodeFromByteValue( dummyVar, 5u, IsDeclaration::TRUE );
+    AstNode dummyAssign = CreateAssignNodeFromByteValue( m_arena, dummyVar, 5u, IsDeclaration::TRUE );
 
     AstNode::Children forChildren{ initNode, dummyAssign };
-    AstNode::Ptr forNode = std::make_shared< AstNode >( T::FOR, forChildren );
+    AstNode forNode = m_arena.CreateNode( T::FOR, forChildren );
     CreateAndAttachFakeSymbolTable( forNode, { initVar, dummyVar } );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { forNode } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { forNode } );
     CreateAndAttachFakeSymbolTable( blockNode, {} );
     BOOST_CHECK_THROW( m_codeGenerator->GenerateIntermediateCode( blockNode ), std::invalid_argument );
 }
@@ -747,22 +766,22 @@ BOOST_AUTO_TEST_CASE( ForInit_WrongNumChildren )
 BOOST_AUTO_TEST_CASE( NoSymbolTable )
 {
     const std::string initVar{ "initVar" };
-    AstNode::Ptr initAssign = CreateAssignNodeFromByteValue( initVar, 0u, IsDeclaration::TRUE );
+    AstNode initAssign = CreateAssignNodeFromByteValue( m_arena, initVar, 0u, IsDeclaration::TRUE );
     constexpr uint8_t conditionValue{ 1u };
-    AstNode::Ptr conditionNode = std::make_shared< AstNode >( T::BYTE,
-                                                              std::make_shared< Token >( T::BYTE, conditionValue ) );
+    AstNode conditionNode = m_arena.CreateNode( T::BYTE,
+                                                              Token( T::BYTE, conditionValue ) );
     constexpr uint8_t increment{ 1u };
-    AstNode::Ptr initIncrement = CreateTwoOperandStatement( initVar, IsDeclaration::FALSE, T::PLUS, initVar, increment );
+    AstNode initIncrement = CreateTwoOperandStatement( m_arena, initVar, IsDeclaration::FALSE, T::PLUS, initVar, increment );
     AstNode::Children initChildren{ initAssign, conditionNode, initIncrement };
-    AstNode::Ptr initNode = std::make_shared< AstNode >( NT::For_init, initChildren );
+    AstNode initNode = m_arena.CreateNode( NT::For_init, initChildren );
 
     const std::string dummyVar{ "dummyVar" };
-    AstNode::Ptr dummyAssign = CreateAssignNodeFromByteValue( dummyVar, 5u, IsDeclaration::TRUE );
+    AstNode dummyAssign = CreateAssignNodeFromByteValue( m_arena, dummyVar, 5u, IsDeclaration::TRUE );
 
     AstNode::Children forChildren{ initNode, dummyAssign };
-    AstNode::Ptr forNode = std::make_shared< AstNode >( T::FOR, forChildren );
+    AstNode forNode = m_arena.CreateNode( T::FOR, forChildren );
 
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { forNode } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { forNode } );
     // Give the block node a symbol table, but not the for node.
     CreateAndAttachFakeSymbolTable( blockNode, {} );
     BOOST_CHECK_THROW( m_codeGenerator->GenerateIntermediateCode( blockNode ), std::invalid_argument );
@@ -775,23 +794,23 @@ BOOST_AUTO_TEST_CASE( For_Success )
 {
     const std::string initVar{ "initVar" };
     constexpr uint8_t initValue{ 0u };
-    AstNode::Ptr initAssign = CreateAssignNodeFromByteValue( initVar, initValue, IsDeclaration::TRUE );
+    AstNode initAssign = CreateAssignNodeFromByteValue( m_arena, initVar, initValue, IsDeclaration::TRUE );
     constexpr uint8_t conditionValue{ 1u };
-    AstNode::Ptr conditionNode = std::make_shared< AstNode >( T::BYTE,
-                                                              std::make_shared< Token >( T::BYTE, conditionValue ) );
+    AstNode conditionNode = m_arena.CreateNode( T::BYTE,
+                                                              Token( T::BYTE, conditionValue ) );
     constexpr uint8_t increment{ 1u };
-    AstNode::Ptr incrementNode = CreateTwoOperandStatement( initVar, IsDeclaration::FALSE, T::PLUS, initVar, increment );
+    AstNode incrementNode = CreateTwoOperandStatement( m_arena, initVar, IsDeclaration::FALSE, T::PLUS, initVar, increment );
     AstNode::Children initChildren{ initAssign, conditionNode, incrementNode };
-    AstNode::Ptr initNode = std::make_shared< AstNode >( NT::For_init, initChildren );
+    AstNode initNode = m_arena.CreateNode( NT::For_init, initChildren );
 
     const std::string dummyVar{ "dummyVar" };
     constexpr uint8_t dummyValue{ 5u };
-    AstNode::Ptr dummyAssign = CreateAssignNodeFromByteValue( dummyVar, 5u, IsDeclaration::TRUE );
+    AstNode dummyAssign = CreateAssignNodeFromByteValue( m_arena, dummyVar, 5u, IsDeclaration::TRUE );
 
     AstNode::Children forChildren{ initNode, dummyAssign };
-    AstNode::Ptr forNode = std::make_shared< AstNode >( T::FOR, forChildren );
+    AstNode forNode = m_arena.CreateNode( T::FOR, forChildren );
     CreateAndAttachFakeSymbolTable( forNode, { initVar, dummyVar } );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { forNode } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { forNode } );
     CreateAndAttachFakeSymbolTable( blockNode, {} );
 
 
@@ -802,7 +821,7 @@ BOOST_AUTO_TEST_CASE( For_Success )
         .once()
         .in( s )
         .calls(
-            [&]( std::string, Operand operand )
+            [&]( VarId, Operand operand )
             {
                 BOOST_REQUIRE( std::holds_alternative< Literal >( operand ) );
                 BOOST_CHECK_EQUAL( initValue, std::get< Literal >( operand ) );
@@ -811,7 +830,7 @@ BOOST_AUTO_TEST_CASE( For_Success )
 
     // Expect conditional branch - if condition == 0, branch to end.
     // Expect it to have a label so it can be jumped to after one loop is done.
-    const std::string conditionLabelToReturn{ "conditionLabel" };
+    constexpr LabelId conditionLabelToReturn{ 0u };
     MOCK_EXPECT( m_instrFactoryMock->GetNewLabel )
         .once()
         .in( s )
@@ -820,12 +839,12 @@ BOOST_AUTO_TEST_CASE( For_Success )
         .once()
         .in( s )
         .with( conditionLabelToReturn );
-    MOCK_EXPECT( m_instrFactoryMock->AddInstruction )
+    MOCK_EXPECT( m_instrFactoryMock->AddBranchInstruction )
         .once()
         .in( s )
         .with( TacInstructionFactory::PLACEHOLDER, Opcode::BRE, mock::any, mock::any )
         .calls(
-            [&]( std::string, Opcode, Operand operand1, Operand operand2 )
+            [&]( LabelId, Opcode, Operand operand1, Operand operand2 )
             {
                 BOOST_REQUIRE( std::holds_alternative< Literal >( operand1 ) );
                 BOOST_CHECK_EQUAL( conditionValue, std::get< Literal >( operand1 ) );
@@ -834,18 +853,18 @@ BOOST_AUTO_TEST_CASE( For_Success )
             }
         );
     // Expect a get request for this instruction so it can go back later and assign the target label - return mock.
-    ThreeAddrInstruction::Ptr branchToEndInstr = MakeDummyUniqueTacInstr();
-    MOCK_EXPECT( m_instrFactoryMock->GetLatestInstruction )
+    size_t branchToEndIndex = MakeDummyUniqueInstrIndex();
+    MOCK_EXPECT( m_instrFactoryMock->GetLatestInstructionIndex )
         .once()
         .in( s )
-        .returns( branchToEndInstr );
+        .returns( branchToEndIndex );
 
     // Expect the for block contents to be added, i.e. the dummy assign
     MOCK_EXPECT( m_instrFactoryMock->AddAssignmentInstruction )
         .once()
         .in( s )
         .calls(
-            [&]( std::string, Operand operand )
+            [&]( VarId, Operand operand )
             {
                 BOOST_REQUIRE( std::holds_alternative< Literal >( operand ) );
                 BOOST_CHECK_EQUAL( dummyValue, std::get< Literal >( operand ) );
@@ -858,10 +877,10 @@ BOOST_AUTO_TEST_CASE( For_Success )
         .once()
         .with( mock::any, expectedTacOpcode, mock::any, mock::any )
         .calls(
-            [&]( std::string, TAC::Opcode, TAC::Operand operand1, TAC::Operand operand2 )
+            [&]( VarId, TAC::Opcode, TAC::Operand operand1, TAC::Operand operand2 )
             {
-                BOOST_REQUIRE( std::holds_alternative< std::string >( operand1 ) );
-                // Can't check the operand contents because a new unique id is calculated.
+                BOOST_REQUIRE( std::holds_alternative< VarId >( operand1 ) );
+                BOOST_CHECK( GetVarId( forNode, initVar ) == std::get< VarId >( operand1 ) );
 
                 BOOST_REQUIRE( std::holds_alternative< Literal >( operand2 ) );
                 BOOST_CHECK_EQUAL( increment, std::get< Literal >( operand2 ) );
@@ -869,12 +888,12 @@ BOOST_AUTO_TEST_CASE( For_Success )
     );
 
     // Expect an unconditional jump to the condition label
-    MOCK_EXPECT( m_instrFactoryMock->AddInstruction )
+    MOCK_EXPECT( m_instrFactoryMock->AddBranchInstruction )
         .once()
         .in( s )
         .with( conditionLabelToReturn, Opcode::BRE, mock::any, mock::any )
         .calls(
-            [&]( std::string, Opcode, Operand operand1, Operand operand2 )
+            [&]( LabelId, Opcode, Operand operand1, Operand operand2 )
             {
                 // The contents of the operands don't matter, only that they are equal.
                 BOOST_CHECK( operand1 == operand2 );
@@ -885,7 +904,7 @@ BOOST_AUTO_TEST_CASE( For_Success )
     MOCK_EXPECT( m_instrFactoryMock->SetInstructionBranchToNextLabel )
         .once()
         .in( s )
-        .with( branchToEndInstr, mock::any );
+        .with( branchToEndIndex, mock::any );
 
 
     m_codeGenerator->GenerateIntermediateCode( blockNode );
@@ -902,12 +921,12 @@ BOOST_AUTO_TEST_SUITE( While )
 BOOST_AUTO_TEST_CASE( WrongNumChildren )
 {
     constexpr uint8_t byteValue{ 1u };
-    AstNode::Ptr conditionNode = std::make_shared< AstNode >( T::BYTE, std::make_shared< Token >( T::BYTE, byteValue ) );
+    AstNode conditionNode = m_arena.CreateNode( T::BYTE, Token( T::BYTE, byteValue ) );
 
     AstNode::Children oneChild{ conditionNode };
-    AstNode::Ptr whileNode = std::make_shared< AstNode >( T::WHILE, oneChild );
+    AstNode whileNode = m_arena.CreateNode( T::WHILE, oneChild );
     CreateAndAttachFakeSymbolTable( whileNode, {} );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { whileNode } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { whileNode } );
     CreateAndAttachFakeSymbolTable( blockNode, {} );
     BOOST_CHECK_THROW( m_codeGenerator->GenerateIntermediateCode( blockNode ), std::invalid_argument );
 }
@@ -922,15 +941,15 @@ BOOST_AUTO_TEST_CASE( NoSymbolTable )
     const std::string varA{ "a" };
     const std::string varB{ "b" };
     const T conditionNodeLabel{ T::LEQ };
-    AstNode::Ptr conditionNode = CreateTwoOpExpression( conditionNodeLabel, varA, varB );
+    AstNode conditionNode = CreateTwoOpExpression( m_arena, conditionNodeLabel, varA, varB );
 
     const std::string dummyVar{ "dummyVar" };
-    AstNode::Ptr dummyAssign = CreateAssignNodeFromByteValue( dummyVar, 5u, IsDeclaration::TRUE );
+    AstNode dummyAssign = CreateAssignNodeFromByteValue( m_arena, dummyVar, 5u, IsDeclaration::TRUE );
 
     AstNode::Children whileChildren{ conditionNode, dummyAssign };
-    AstNode::Ptr whileNode = std::make_shared< AstNode >( T::WHILE, whileChildren );
+    AstNode whileNode = m_arena.CreateNode( T::WHILE, whileChildren );
 
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { whileNode } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { whileNode } );
     // Give the block node a symbol table, but not the for node.
     CreateAndAttachFakeSymbolTable( blockNode, {} );
     BOOST_CHECK_THROW( m_codeGenerator->GenerateIntermediateCode( blockNode ), std::invalid_argument );
@@ -945,16 +964,16 @@ BOOST_AUTO_TEST_CASE( While_Success )
     const std::string varA{ "a" };
     const std::string varB{ "b" };
     const T conditionNodeLabel{ T::LEQ };
-    AstNode::Ptr conditionNode = CreateTwoOpExpression( conditionNodeLabel, varA, varB );
+    AstNode conditionNode = CreateTwoOpExpression( m_arena, conditionNodeLabel, varA, varB );
 
     const std::string dummyVar{ "dummyVar" };
     constexpr uint8_t dummyValue{ 5u };
-    AstNode::Ptr dummyAssign = CreateAssignNodeFromByteValue( dummyVar, 5u, IsDeclaration::TRUE );
+    AstNode dummyAssign = CreateAssignNodeFromByteValue( m_arena, dummyVar, 5u, IsDeclaration::TRUE );
 
     AstNode::Children whileChildren{ conditionNode, dummyAssign };
-    AstNode::Ptr whileNode = std::make_shared< AstNode >( T::WHILE, whileChildren );
+    AstNode whileNode = m_arena.CreateNode( T::WHILE, whileChildren );
     CreateAndAttachFakeSymbolTable( whileNode, { varA, varB, dummyVar } );
-    AstNode::Ptr blockNode = WrapNodesInBlocks( { whileNode } );
+    AstNode blockNode = WrapNodesInBlocks( m_arena, { whileNode } );
     // Give the block node a symbol table, but not the for node.
     CreateAndAttachFakeSymbolTable( blockNode, {} );
 
@@ -962,7 +981,7 @@ BOOST_AUTO_TEST_CASE( While_Success )
 
     // Expect conditional branch - if condition == 0, branch to end.
     // Expect it to have a label so it can be jumped to after one loop is done.
-    const std::string conditionLabelToReturn{ "conditionLabel" };
+    constexpr LabelId conditionLabelToReturn{ 0u };
     MOCK_EXPECT( m_instrFactoryMock->GetNewLabel )
         .once()
         .in( s )
@@ -972,25 +991,27 @@ BOOST_AUTO_TEST_CASE( While_Success )
         .in( s )
         .with( conditionLabelToReturn );
     // Expect the condition operand to be fetched
-    const Operand conditionOperandToReturn{ "conditionOperand" };
+    const Operand conditionOperandToReturn{ VarId{ 100u } }; // Arbitrary temp ID, unused by the symbol table
     MOCK_EXPECT( m_exprGeneratorMock->Leq )
         .once()
         .in( s )
         .calls(
             [&]( Operand operand1, Operand operand2 )
             {
-                BOOST_REQUIRE( std::holds_alternative< std::string >( operand1 ) );
-                BOOST_REQUIRE( std::holds_alternative< std::string >( operand2 ) );
+                BOOST_REQUIRE( std::holds_alternative< VarId >( operand1 ) );
+                BOOST_CHECK( GetVarId( whileNode, varA ) == std::get< VarId >( operand1 ) );
+                BOOST_REQUIRE( std::holds_alternative< VarId >( operand2 ) );
+                BOOST_CHECK( GetVarId( whileNode, varB ) == std::get< VarId >( operand2 ) );
 
                 return conditionOperandToReturn;
             }
         );
-    MOCK_EXPECT( m_instrFactoryMock->AddInstruction )
+    MOCK_EXPECT( m_instrFactoryMock->AddBranchInstruction )
         .once()
         .in( s )
         .with( TacInstructionFactory::PLACEHOLDER, Opcode::BRE, mock::any, mock::any )
         .calls(
-            [&]( std::string, Opcode, Operand operand1, Operand operand2 )
+            [&]( LabelId, Opcode, Operand operand1, Operand operand2 )
             {
                 BOOST_CHECK( conditionOperandToReturn == operand1 );
                 BOOST_REQUIRE( std::holds_alternative< Literal >( operand2 ) );
@@ -998,18 +1019,18 @@ BOOST_AUTO_TEST_CASE( While_Success )
             }
         );
     // Expect a get request for this instruction so it can go back later and assign the target label - return mock.
-    ThreeAddrInstruction::Ptr branchToEndInstr = MakeDummyUniqueTacInstr();
-    MOCK_EXPECT( m_instrFactoryMock->GetLatestInstruction )
+    size_t branchToEndIndex = MakeDummyUniqueInstrIndex();
+    MOCK_EXPECT( m_instrFactoryMock->GetLatestInstructionIndex )
         .once()
         .in( s )
-        .returns( branchToEndInstr );
+        .returns( branchToEndIndex );
 
     // Expect the for block contents to be added, i.e. the dummy assign
     MOCK_EXPECT( m_instrFactoryMock->AddAssignmentInstruction )
         .once()
         .in( s )
         .calls(
-            [&]( std::string, Operand operand )
+            [&]( VarId, Operand operand )
             {
                 BOOST_REQUIRE( std::holds_alternative< Literal >( operand ) );
                 BOOST_CHECK_EQUAL( dummyValue, std::get< Literal >( operand ) );
@@ -1017,12 +1038,12 @@ BOOST_AUTO_TEST_CASE( While_Success )
         );
 
     // Expect an unconditional jump to the condition label
-    MOCK_EXPECT( m_instrFactoryMock->AddInstruction )
+    MOCK_EXPECT( m_instrFactoryMock->AddBranchInstruction )
         .once()
         .in( s )
         .with( conditionLabelToReturn, Opcode::BRE, mock::any, mock::any )
         .calls(
-            [&]( std::string, Opcode, Operand operand1, Operand operand2 )
+            [&]( LabelId, Opcode, Operand operand1, Operand operand2 )
             {
                 // The contents of the operands don't matter, only that they are equal.
                 BOOST_CHECK( operand1 == operand2 );
@@ -1033,7 +1054,7 @@ BOOST_AUTO_TEST_CASE( While_Success )
     MOCK_EXPECT( m_instrFactoryMock->SetInstructionBranchToNextLabel )
         .once()
         .in( s )
-        .with( branchToEndInstr, mock::any );
+        .with( branchToEndIndex, mock::any );
 
     m_codeGenerator->GenerateIntermediateCode( blockNode );
 }
@@ -1050,9 +1071,10 @@ BOOST_AUTO_TEST_SUITE( NonTerminalSymbolTests )
  */
 BOOST_AUTO_TEST_CASE( InvalidNodeSymbol )
 {
-    AstNode::Children fakeChildren{ nullptr };
+    // The arena only stores real nodes, so use a token wrapper as the fake child.
+    AstNode::Children fakeChildren{ m_arena.CreateNode( TokenType::BYTE, Token( TokenType::BYTE, 0u ) ) };
     constexpr NT invalidNodeLabel{ NT::Negation }; // Not block
-    AstNode::Ptr invalidNode = std::make_shared< AstNode >( invalidNodeLabel, fakeChildren );
+    AstNode invalidNode = m_arena.CreateNode( invalidNodeLabel, fakeChildren );
     CreateAndAttachFakeSymbolTable( invalidNode, {} );
     BOOST_CHECK_THROW( m_codeGenerator->GenerateIntermediateCode( invalidNode ), std::invalid_argument );
 }
@@ -0,0 +1,122 @@
+#include <boost/test/unit_test.hpp>
+
+#include "LivenessAnalysis.h"
+
+using namespace TAC;
+
+class LivenessAnalysisTestsFixture
+{
+public:
+    const VarId m_varA{ 0u };
+    const VarId m_varB{ 1u };
+    const VarId m_varC{ 2u };
+    const size_t m_numVariables{ 3u };
+
+    const LabelId m_label1{ 0u };
+    const LabelId m_label2{ 1u };
+};
+
+BOOST_FIXTURE_TEST_SUITE( LivenessAnalysisTests, LivenessAnalysisTestsFixture )
+
+/**
+ * Tests that in a single block, only variables read before being written to are live on entry, and nothing is live on
+ * exit.
+ */
+BOOST_AUTO_TEST_CASE( SingleBlock )
+{
+    ControlFlowGraph::Instructions instructions{
+        ThreeAddrInstruction( m_varB, Opcode::ADD, m_varA, m_varA ),
+        ThreeAddrInstruction( m_varC, Opcode::SUB, m_varB, m_varA )
+    };
+    ControlFlowGraph cfg( instructions );
+    LivenessAnalysis liveness( instructions, cfg, m_numVariables );
+
+    BOOST_CHECK( liveness.IsLiveIn( 0, m_varA ) );
+    BOOST_CHECK( !liveness.IsLiveIn( 0, m_varB ) );
+    BOOST_CHECK( !liveness.IsLiveIn( 0, m_varC ) );
+    BOOST_CHECK( liveness.GetLiveOut( 0 ).None() );
+}
+
+/**
+ * Tests that a variable read by an instruction before it writes to the same variable is live on entry.
+ */
+BOOST_AUTO_TEST_CASE( ReadAndWriteSameVar )
+{
+    ControlFlowGraph::Instructions instructions{
+        ThreeAddrInstruction( m_varA, Opcode::ADD, m_varA, m_varB )
+    };
+    ControlFlowGraph cfg( instructions );
+    LivenessAnalysis liveness( instructions, cfg, m_numVariables );
+
+    BOOST_CHECK( liveness.IsLiveIn( 0, m_varA ) );
+    BOOST_CHECK( liveness.IsLiveIn( 0, m_varB ) );
+}
+
+/**
+ * Tests that a value read at the head of a loop is live around the back edge, even after its last reference in the
+ * program, while a value only used within one iteration is not.
+ */
+BOOST_AUTO_TEST_CASE( Loop )
+{
+    ControlFlowGraph::Instructions instructions{
+        ThreeAddrInstruction( m_varA, Literal{ 1u } ),                            // Block 0
+        ThreeAddrInstruction( m_varB, Opcode::ADD, m_varA, m_varA, m_label1 ),    // Block 1: loop
+        ThreeAddrInstruction( m_varC, Opcode::ADD, m_varB, m_varB ),
+        ThreeAddrInstruction( m_label1, Opcode::BRLT, m_varC, m_varB ),
+        ThreeAddrInstruction( m_varB, Literal{ 0u } )                             // Block 2
+    };
+    ControlFlowGraph cfg( instructions );
+    LivenessAnalysis liveness( instructions, cfg, m_numVariables );
+
+    BOOST_REQUIRE_EQUAL( 3u, cfg.GetNumBlocks() );
+    BOOST_CHECK( liveness.IsLiveOut( 0, m_varA ) );
+    BOOST_CHECK( liveness.IsLiveIn( 1, m_varA ) );
+    BOOST_CHECK( liveness.IsLiveOut( 1, m_varA ) );
+    BOOST_CHECK( !liveness.IsLiveOut( 1, m_varB ) );
+    BOOST_CHECK( !liveness.IsLiveOut( 1, m_varC ) );
+    BOOST_CHECK( liveness.GetLiveIn( 2 ).None() );
+
+    // Needs more than one pass, as the back edge is only followed after the loop body is visited.
+    BOOST_CHECK( liveness.GetNumIterations() > 1u );
+}
+
+/**
+ * Tests that a variable is live out of a branch if it is used on either path, but only live into the path using it.
+ */
+BOOST_AUTO_TEST_CASE( Branches )
+{
+    ControlFlowGraph::Instructions instructions{
+        ThreeAddrInstruction( m_label1, Opcode::BRE, m_varC, g_invalidVarId ),    // Block 0
+        ThreeAddrInstruction( m_varB, Opcode::ADD, m_varA, m_varA ),               // Block 1
+        ThreeAddrInstruction( m_label2, Opcode::BRE, m_varC, m_varC ),
+        ThreeAddrInstruction( m_varB, Literal{ 1u }, m_label1 ),                   // Block 2
+        ThreeAddrInstruction( m_varC, m_varB, m_label2 )                           // Block 3
+    };
+    ControlFlowGraph cfg( instructions );
+    LivenessAnalysis liveness( instructions, cfg, m_numVariables );
+
+    BOOST_REQUIRE_EQUAL( 4u, cfg.GetNumBlocks() );
+    BOOST_CHECK( liveness.IsLiveIn( 0, m_varA ) );
+    BOOST_CHECK( liveness.IsLiveIn( 0, m_varC ) );
+    BOOST_CHECK( liveness.IsLiveOut( 0, m_varA ) );
+    BOOST_CHECK( liveness.IsLiveIn( 1, m_varA ) );
+    BOOST_CHECK( !liveness.IsLiveIn( 2, m_varA ) );
+    BOOST_CHECK( liveness.IsLiveOut( 1, m_varB ) );
+    BOOST_CHECK( liveness.IsLiveOut( 2, m_varB ) );
+    BOOST_CHECK( !liveness.IsLiveOut( 1, m_varC ) );
+}
+
+/**
+ * Tests that getting the live sets of a block outside the graph throws.
+ */
+BOOST_AUTO_TEST_CASE( BlockOutOfRange )
+{
+    ControlFlowGraph::Instructions instructions{ ThreeAddrInstruction( m_varA, Literal{ 1u } ) };
+    ControlFlowGraph cfg( instructions );
+    LivenessAnalysis liveness( instructions, cfg, m_numVariables );
+
+    BOOST_CHECK_THROW( liveness.GetLiveIn( 1 ), std::out_of_range );
+    BOOST_CHECK_THROW( liveness.IsLiveOut( 1, m_varA ), std::out_of_range );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // LivenessAnalysisTests
@@ -0,0 +1,182 @@
+#include <boost/test/unit_test.hpp>
+#include "Logger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixture which restores the default log level after each test, and deletes any log file written by a test logger.
+ */
+class LoggerTestsFixture
+{
+public:
+    LoggerTestsFixture() = default;
+    ~LoggerTestsFixture()
+    {
+        Logger::GetInstance()->SetLogLevel( LogLevel::INFO );
+        std::remove( m_logFilePath.c_str() );
+    }
+
+    /**
+     * Reads each line of the test log file.
+     */
+    std::vector< std::string >
+    ReadLogLines()
+    {
+        std::vector< std::string > lines;
+        std::ifstream file( m_logFilePath );
+        std::string line;
+        while ( std::getline( file, line ) )
+        {
+            lines.push_back( line );
+        }
+        return lines;
+    }
+
+    const std::string m_logFilePath = "LoggerTests_log.txt";
+
+    /**
+     * Builds a log message, recording that it was evaluated.
+     */
+    std::string
+    BuildMessage()
+    {
+        ++m_numMessagesBuilt;
+        return "Test message";
+    }
+
+    size_t m_numMessagesBuilt{ 0u };
+};
+
+BOOST_FIXTURE_TEST_SUITE( LoggerTests, LoggerTestsFixture )
+
+/**
+ * Tests that a log message isn't built if its level is above the current log level.
+ */
+BOOST_AUTO_TEST_CASE( Log_DisabledLevelNotEvaluated )
+{
+    Logger::GetInstance()->SetLogLevel( LogLevel::INFO );
+
+    LOG_INFO_MEDIUM_LEVEL( BuildMessage() );
+    LOG_INFO_LOW_LEVEL( BuildMessage() );
+
+    BOOST_CHECK_EQUAL( 0u, m_numMessagesBuilt );
+}
+
+/**
+ * Tests that a log message is built if its level is enabled.
+ */
+BOOST_AUTO_TEST_CASE( Log_EnabledLevelEvaluated )
+{
+    Logger::GetInstance()->SetLogLevel( LogLevel::WARN );
+
+    LOG_WARN( BuildMessage() );
+    LOG_INFO( BuildMessage() );
+
+    BOOST_CHECK_EQUAL( 1u, m_numMessagesBuilt );
+}
+
+/**
+ * Tests that a logging call can be used as the single statement of an if/else branch.
+ */
+BOOST_AUTO_TEST_CASE( Log_InsideIfElse )
+{
+    Logger::GetInstance()->SetLogLevel( LogLevel::INFO );
+
+    const bool condition{ false };
+    if ( condition )
+        LOG_INFO( BuildMessage() );
+    else
+        LOG_INFO( BuildMessage() + "!" );
+
+    BOOST_CHECK_EQUAL( 1u, m_numMessagesBuilt );
+}
+
+/**
+ * Tests that flushing writes every message logged so far, in order, when there are more messages than fit in the
+ * buffer at once.
+ */
+BOOST_AUTO_TEST_CASE( Flush_WritesAllMessages )
+{
+    Logger logger( LogLevel::INFO, m_logFilePath );
+
+    const int numMessages{ 20000 };
+    for ( int i = 0; i < numMessages; ++i )
+    {
+        logger.LogMessage( LogLevel::INFO, "Message " + std::to_string( i ), __FILE__, __FUNCTION__, __LINE__ );
+    }
+    logger.Flush();
+
+    std::vector< std::string > lines = ReadLogLines();
+    BOOST_REQUIRE_EQUAL( static_cast< size_t >( numMessages ), lines.size() );
+    for ( int i = 0; i < numMessages; ++i )
+    {
+        const std::string expectedEnd = ": Message " + std::to_string( i );
+        BOOST_REQUIRE( lines[i].size() > expectedEnd.size() );
+        BOOST_CHECK_EQUAL( expectedEnd, lines[i].substr( lines[i].size() - expectedEnd.size() ) );
+        BOOST_CHECK( std::string::npos != lines[i].find( "INFO: " ) );
+    }
+}
+
+/**
+ * Tests that logging more messages than fit in the buffer at once only waits for the writer to make space, rather than
+ * for it to wake up on its own each time the buffer fills.
+ */
+BOOST_AUTO_TEST_CASE( Log_FullBufferWakesWriter )
+{
+    Logger logger( LogLevel::INFO, m_logFilePath );
+
+    const size_t numMessages{ 2u * g_logBufferCapacity };
+    auto start = std::chrono::steady_clock::now();
+    for ( size_t i = 0u; i < numMessages; ++i )
+    {
+        logger.LogMessage( LogLevel::INFO, "Message", __FILE__, __FUNCTION__, __LINE__ );
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // The buffer fills at least once, so this would take at least a poll interval if the writer weren't woken.
+    BOOST_CHECK( elapsed < g_writerPollInterval );
+    logger.Flush();
+    BOOST_CHECK_EQUAL( numMessages, ReadLogLines().size() );
+}
+
+/**
+ * Tests that messages logged from several threads at once are all written, and messages above the log level are not.
+ */
+BOOST_AUTO_TEST_CASE( Flush_MultipleThreads )
+{
+    const size_t numThreads{ 4u };
+    const size_t numMessagesPerThread{ 5000u };
+    {
+        Logger logger( LogLevel::WARN, m_logFilePath );
+
+        std::vector< std::thread > threads;
+        for ( size_t threadIndex = 0u; threadIndex < numThreads; ++threadIndex )
+        {
+            threads.emplace_back( [ &logger, numMessagesPerThread ] {
+                for ( size_t i = 0u; i < numMessagesPerThread; ++i )
+                {
+                    logger.LogMessage( LogLevel::WARN, "Enabled", __FILE__, __FUNCTION__, __LINE__ );
+                    logger.LogMessage( LogLevel::INFO, "Disabled", __FILE__, __FUNCTION__, __LINE__ );
+                }
+            } );
+        }
+        for ( std::thread& thread : threads )
+        {
+            thread.join();
+        }
+        // Not flushed explicitly: destroying the logger must write the remaining messages.
+    }
+
+    std::vector< std::string > lines = ReadLogLines();
+    BOOST_CHECK_EQUAL( numThreads * numMessagesPerThread, lines.size() );
+    for ( const std::string& line : lines )
+    {
+        BOOST_CHECK( std::string::npos != line.find( "WARN: " ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
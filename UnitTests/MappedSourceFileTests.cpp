@@ -0,0 +1,63 @@
+#include <boost/test/unit_test.hpp>
+#include "MappedSourceFile.h"
+
+#include <cstdio>
+#include <fstream>
+
+/**
+ * Fixture which creates a file for the test to read, and deletes it afterwards.
+ */
+class MappedSourceFileTestsFixture
+{
+public:
+    MappedSourceFileTestsFixture() = default;
+    ~MappedSourceFileTestsFixture()
+    {
+        std::remove( m_filePath.c_str() );
+    }
+
+    void
+    WriteTestFile( const std::string& contents )
+    {
+        std::ofstream file( m_filePath, std::ios::binary | std::ios::trunc );
+        file << contents;
+    }
+
+    const std::string m_filePath = "MappedSourceFileTests_input.txt";
+};
+
+BOOST_FIXTURE_TEST_SUITE( MappedSourceFileTests, MappedSourceFileTestsFixture )
+
+/**
+ * Tests that the contents of a file are mapped exactly, without line endings being converted or added.
+ */
+BOOST_AUTO_TEST_CASE( GetContents_MatchesFile )
+{
+    const std::string contents = "byte a = 1;\r\nbyte b = a;\n// no newline at end";
+    WriteTestFile( contents );
+
+    MappedSourceFile sourceFile( m_filePath );
+    BOOST_CHECK( sourceFile.IsMapped() );
+    BOOST_CHECK_EQUAL( contents, std::string( sourceFile.GetContents() ) );
+}
+
+/**
+ * Tests that an empty file gives an empty view.
+ */
+BOOST_AUTO_TEST_CASE( GetContents_EmptyFile )
+{
+    WriteTestFile( "" );
+
+    MappedSourceFile sourceFile( m_filePath );
+    BOOST_CHECK( sourceFile.GetContents().empty() );
+}
+
+/**
+ * Tests that an exception is thrown if the file doesn't exist.
+ */
+BOOST_AUTO_TEST_CASE( Constructor_FileDoesNotExist )
+{
+    BOOST_CHECK_THROW( MappedSourceFile( "MappedSourceFileTests_missing.txt" ), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
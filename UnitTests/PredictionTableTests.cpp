@@ -0,0 +1,105 @@
+#include <boost/test/unit_test.hpp>
+#include "PredictionTable.h"
+
+#include <algorithm>
+
+BOOST_AUTO_TEST_SUITE( PredictionTableTests )
+
+/**
+ * Tests FIRST and FOLLOW sets for non-terminals of the language grammar.
+ */
+BOOST_AUTO_TEST_CASE( LanguageGrammar_FirstAndFollowSets )
+{
+    const PredictionTable& table = PredictionTable::GetInstance();
+
+    PredictionTable::TerminalSet expectedVariableFirst{ T::DATA_TYPE, T::IDENTIFIER };
+    BOOST_CHECK( expectedVariableFirst == table.GetFirstSet( Variable ) );
+
+    PredictionTable::TerminalSet expectedSectionFirst{ T::DATA_TYPE, T::IDENTIFIER, T::FOR, T::IF, T::WHILE };
+    BOOST_CHECK( expectedSectionFirst == table.GetFirstSet( Section ) );
+
+    const PredictionTable::TerminalSet& variableFollow = table.GetFollowSet( Variable );
+    BOOST_CHECK( variableFollow.end() != variableFollow.find( T::ASSIGN ) );
+    BOOST_CHECK( variableFollow.end() != variableFollow.find( T::INVALID_TOKEN ) );
+
+    BOOST_CHECK( !table.IsNullable( Block ) );
+}
+
+/**
+ * Tests that only rules which can start with the next token are candidates.
+ */
+BOOST_AUTO_TEST_CASE( LanguageGrammar_CandidateRules )
+{
+    const PredictionTable& table = PredictionTable::GetInstance();
+
+    // Variable: { DATA_TYPE IDENTIFIER }, { IDENTIFIER }
+    PredictionTable::Candidates candidates = table.GetCandidateRules( Variable, T::IDENTIFIER );
+    BOOST_REQUIRE_EQUAL( 1u, candidates.size() );
+    BOOST_CHECK_EQUAL( 1u, *candidates.begin() );
+
+    // Section: { Statement ; }, { For_loop ; }, { If_else ; }, { While_loop ; }
+    candidates = table.GetCandidateRules( Section, T::IF );
+    BOOST_REQUIRE_EQUAL( 1u, candidates.size() );
+    BOOST_CHECK_EQUAL( 2u, *candidates.begin() );
+
+    BOOST_CHECK( table.GetCandidateRules( Section, T::PLUS ).empty() );
+    BOOST_CHECK( table.GetCandidateRules( Section, T::INVALID_TOKEN ).empty() );
+
+    // Block: { Section Block }, { Section } both start with a section, so are tried in order.
+    candidates = table.GetCandidateRules( Block, T::WHILE );
+    BOOST_REQUIRE_EQUAL( 2u, candidates.size() );
+    BOOST_CHECK_EQUAL( 0u, candidates.begin()[0] );
+    BOOST_CHECK_EQUAL( 1u, candidates.begin()[1] );
+}
+
+/**
+ * Tests that entries with more than one candidate are reported as conflicts.
+ */
+BOOST_AUTO_TEST_CASE( LanguageGrammar_Conflicts )
+{
+    const std::vector< std::string >& conflicts = PredictionTable::GetInstance().GetConflicts();
+
+    auto hasConflict = [ &conflicts ]( const std::string& prefix ) {
+        return conflicts.end() != std::find_if( conflicts.begin(), conflicts.end(), [ &prefix ]( const std::string& c ) {
+            return 0u == c.rfind( prefix, 0u );
+        } );
+    };
+    BOOST_CHECK( hasConflict( "Block on " ) );
+    BOOST_CHECK( hasConflict( "If_else on " ) );
+    BOOST_CHECK( !hasConflict( "Variable on " ) );
+    BOOST_CHECK( !hasConflict( "Section on " ) );
+}
+
+/**
+ * Tests a grammar with a nullable non-terminal, whose empty rule is predicted by what can follow it.
+ */
+BOOST_AUTO_TEST_CASE( NullableNonTerminal )
+{
+    // Block -> Section PLUS | MINUS
+    // Section -> (empty) | MULTIPLY
+    const std::unordered_map< NT, Rules > ruleSets{
+        { Block, { { Section, T::PLUS }, { T::MINUS } } },
+        { Section, { {}, { T::MULTIPLY } } },
+    };
+    PredictionTable table( ruleSets );
+
+    BOOST_CHECK( table.IsNullable( Section ) );
+    BOOST_CHECK( !table.IsNullable( Block ) );
+
+    PredictionTable::TerminalSet expectedBlockFirst{ T::PLUS, T::MINUS, T::MULTIPLY };
+    BOOST_CHECK( expectedBlockFirst == table.GetFirstSet( Block ) );
+    PredictionTable::TerminalSet expectedSectionFollow{ T::PLUS, T::INVALID_TOKEN };
+    BOOST_CHECK( expectedSectionFollow == table.GetFollowSet( Section ) );
+
+    PredictionTable::Candidates candidates = table.GetCandidateRules( Section, T::PLUS );
+    BOOST_REQUIRE_EQUAL( 1u, candidates.size() );
+    BOOST_CHECK_EQUAL( 0u, *candidates.begin() );
+
+    candidates = table.GetCandidateRules( Block, T::PLUS );
+    BOOST_REQUIRE_EQUAL( 1u, candidates.size() );
+    BOOST_CHECK_EQUAL( 0u, *candidates.begin() );
+
+    BOOST_CHECK( table.GetConflicts().empty() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
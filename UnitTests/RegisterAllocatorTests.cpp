@@ -0,0 +1,168 @@
+#include <boost/test/unit_test.hpp>
+
+#include "RegisterAllocator.h"
+
+using namespace Assembly;
+
+class RegisterAllocatorTestsFixture
+{
+public:
+    const VarId m_varA{ 0u };
+    const VarId m_varB{ 1u };
+    const VarId m_varC{ 2u };
+
+    const uint8_t m_firstRegister{ 5u };
+
+    // Costs for when the choice of spill should only depend on the live ranges.
+    const RegisterAllocator::SpillCosts m_equalCosts{ { m_varA, 1.0 }, { m_varB, 1.0 }, { m_varC, 1.0 } };
+};
+
+BOOST_FIXTURE_TEST_SUITE( RegisterAllocatorTests, RegisterAllocatorTestsFixture )
+
+/**
+ * Tests whether a live range covers, continues after and intersects instructions, including in the holes between its
+ * segments.
+ */
+BOOST_AUTO_TEST_CASE( LiveRange_CoversAndIntersects )
+{
+    LiveRange range{ { { 2u, 4u }, { 8u, 9u } } };
+    BOOST_CHECK_EQUAL( 2u, range.GetStart() );
+    BOOST_CHECK_EQUAL( 9u, range.GetEnd() );
+    BOOST_CHECK( !range.Covers( 1u ) );
+    BOOST_CHECK( range.Covers( 4u ) );
+    BOOST_CHECK( !range.Covers( 6u ) );
+    BOOST_CHECK( range.Covers( 8u ) );
+    BOOST_CHECK( !range.Covers( 10u ) );
+    BOOST_CHECK( range.ContinuesAfter( 3u ) );
+    BOOST_CHECK( !range.ContinuesAfter( 4u ) );
+    BOOST_CHECK( !range.ContinuesAfter( 6u ) );
+    // A value never read, immediately followed by another write.
+    LiveRange adjacent{ { { 3u, 3u }, { 4u, 6u } } };
+    BOOST_CHECK( adjacent.Covers( 4u ) );
+    BOOST_CHECK( !adjacent.ContinuesAfter( 3u ) );
+    BOOST_CHECK( adjacent.ContinuesAfter( 4u ) );
+
+    LiveRange inHole{ { { 5u, 7u } } };
+    LiveRange overlapping{ { { 0u, 1u }, { 6u, 8u } } };
+    BOOST_CHECK( !range.Intersects( inHole ) );
+    BOOST_CHECK( range.Intersects( overlapping ) );
+    BOOST_CHECK( overlapping.Intersects( range ) );
+}
+
+/**
+ * Tests that variables whose live ranges don't overlap share a register, while those that do are given different
+ * registers.
+ */
+BOOST_AUTO_TEST_CASE( OverlappingRanges )
+{
+    RegisterAllocator::LiveRanges liveRanges{
+        { m_varA, LiveRange{ { { 0u, 2u } } } },
+        { m_varB, LiveRange{ { { 1u, 3u } } } },
+        { m_varC, LiveRange{ { { 3u, 4u } } } }
+    };
+    RegisterAllocator allocator( liveRanges, m_equalCosts, m_firstRegister, 2u );
+
+    BOOST_CHECK( allocator.GetSpilledVars().empty() );
+    BOOST_CHECK_EQUAL( m_firstRegister, allocator.GetRegister( m_varA ) );
+    BOOST_CHECK_NE( allocator.GetRegister( m_varA ), allocator.GetRegister( m_varB ) );
+    BOOST_CHECK_EQUAL( allocator.GetRegister( m_varA ), allocator.GetRegister( m_varC ) );
+    BOOST_CHECK_EQUAL( 2u, allocator.GetNumRegistersUsed() );
+}
+
+/**
+ * Tests that a variable can be given the register of another whose live range has a hole covering it, even though it
+ * starts and ends either side of it.
+ */
+BOOST_AUTO_TEST_CASE( LifetimeHole )
+{
+    RegisterAllocator::LiveRanges liveRanges{
+        { m_varA, LiveRange{ { { 0u, 1u }, { 5u, 6u } } } },
+        { m_varB, LiveRange{ { { 2u, 4u } } } }
+    };
+    RegisterAllocator allocator( liveRanges, m_equalCosts, m_firstRegister, 1u );
+
+    BOOST_CHECK( allocator.GetSpilledVars().empty() );
+    BOOST_CHECK_EQUAL( allocator.GetRegister( m_varA ), allocator.GetRegister( m_varB ) );
+}
+
+/**
+ * Tests that a register isn't given to a variable that overlaps a later segment of the variable holding it.
+ */
+BOOST_AUTO_TEST_CASE( HoleTooSmall )
+{
+    RegisterAllocator::LiveRanges liveRanges{
+        { m_varA, LiveRange{ { { 0u, 1u }, { 4u, 5u } } } },
+        { m_varB, LiveRange{ { { 2u, 6u } } } }
+    };
+    RegisterAllocator allocator( liveRanges, m_equalCosts, m_firstRegister, 1u );
+
+    BOOST_CHECK( !allocator.IsSpilled( m_varA ) );
+    BOOST_CHECK( allocator.IsSpilled( m_varB ) );
+    BOOST_CHECK_THROW( allocator.GetRegister( m_varB ), std::out_of_range );
+}
+
+/**
+ * Tests that when no register is free, the variable cheapest to spill is spilled, even if it ends sooner.
+ */
+BOOST_AUTO_TEST_CASE( SpillsCheapest )
+{
+    RegisterAllocator::LiveRanges liveRanges{
+        { m_varA, LiveRange{ { { 0u, 10u } } } },
+        { m_varB, LiveRange{ { { 1u, 3u } } } }
+    };
+    const RegisterAllocator::SpillCosts spillCosts{ { m_varA, 40.0 }, { m_varB, 4.0 } };
+    RegisterAllocator allocator( liveRanges, spillCosts, m_firstRegister, 1u );
+
+    BOOST_CHECK( !allocator.IsSpilled( m_varA ) );
+    BOOST_CHECK( allocator.IsSpilled( m_varB ) );
+
+    // With the costs the other way around, the variable allocated first gives up its register.
+    const RegisterAllocator::SpillCosts reversedCosts{ { m_varA, 4.0 }, { m_varB, 40.0 } };
+    RegisterAllocator reversedAllocator( liveRanges, reversedCosts, m_firstRegister, 1u );
+
+    BOOST_CHECK( reversedAllocator.IsSpilled( m_varA ) );
+    BOOST_CHECK_EQUAL( m_firstRegister, reversedAllocator.GetRegister( m_varB ) );
+}
+
+/**
+ * Tests that when no register is free and the spill costs are equal, the variable whose live range ends last is
+ * spilled, and its register given to the variable being allocated.
+ */
+BOOST_AUTO_TEST_CASE( SpillsFurthestEnd )
+{
+    RegisterAllocator::LiveRanges liveRanges{
+        { m_varA, LiveRange{ { { 0u, 10u } } } },
+        { m_varB, LiveRange{ { { 1u, 2u } } } },
+        { m_varC, LiveRange{ { { 2u, 3u } } } }
+    };
+    RegisterAllocator allocator( liveRanges, m_equalCosts, m_firstRegister, 2u );
+
+    BOOST_REQUIRE_EQUAL( 1u, allocator.GetSpilledVars().size() );
+    BOOST_CHECK( allocator.IsSpilled( m_varA ) );
+    BOOST_CHECK_EQUAL( m_firstRegister, allocator.GetRegister( m_varC ) );
+    BOOST_CHECK_NE( allocator.GetRegister( m_varB ), allocator.GetRegister( m_varC ) );
+}
+
+/**
+ * Tests that allocating with no registers throws.
+ */
+BOOST_AUTO_TEST_CASE( NoRegisters )
+{
+    RegisterAllocator::LiveRanges liveRanges;
+    BOOST_CHECK_THROW( RegisterAllocator( liveRanges, m_equalCosts, m_firstRegister, 0u ), std::invalid_argument );
+}
+
+/**
+ * Tests that choosing a variable to spill throws if one of the candidates has no spill cost.
+ */
+BOOST_AUTO_TEST_CASE( MissingSpillCost )
+{
+    RegisterAllocator::LiveRanges liveRanges{
+        { m_varA, LiveRange{ { { 0u, 2u } } } },
+        { m_varB, LiveRange{ { { 1u, 3u } } } }
+    };
+    const RegisterAllocator::SpillCosts spillCosts{ { m_varA, 1.0 } };
+    BOOST_CHECK_THROW( RegisterAllocator( liveRanges, spillCosts, m_firstRegister, 1u ), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // RegisterAllocatorTests
@@ -0,0 +1,61 @@
+#include <boost/test/unit_test.hpp>
+#include "RingBuffer.h"
+
+BOOST_AUTO_TEST_SUITE( RingBufferTests )
+
+/**
+ * Tests that values are popped in the order they were pushed.
+ */
+BOOST_AUTO_TEST_CASE( PushPop_FirstInFirstOut )
+{
+    RingBuffer< std::string > buffer( 4u );
+
+    std::string value = "first";
+    BOOST_REQUIRE( buffer.TryPush( value ) );
+    value = "second";
+    BOOST_REQUIRE( buffer.TryPush( value ) );
+
+    std::string popped;
+    BOOST_REQUIRE( buffer.TryPop( popped ) );
+    BOOST_CHECK_EQUAL( "first", popped );
+    BOOST_REQUIRE( buffer.TryPop( popped ) );
+    BOOST_CHECK_EQUAL( "second", popped );
+    BOOST_CHECK( !buffer.TryPop( popped ) );
+}
+
+/**
+ * Tests that pushing fails once the buffer is full, and succeeds again once a value has been popped.
+ */
+BOOST_AUTO_TEST_CASE( Push_Full )
+{
+    RingBuffer< int > buffer( 2u );
+
+    int value = 1;
+    BOOST_REQUIRE( buffer.TryPush( value ) );
+    value = 2;
+    BOOST_REQUIRE( buffer.TryPush( value ) );
+    value = 3;
+    BOOST_CHECK( !buffer.TryPush( value ) );
+
+    int popped = 0;
+    BOOST_REQUIRE( buffer.TryPop( popped ) );
+    BOOST_CHECK_EQUAL( 1, popped );
+    BOOST_CHECK( buffer.TryPush( value ) );
+
+    BOOST_REQUIRE( buffer.TryPop( popped ) );
+    BOOST_CHECK_EQUAL( 2, popped );
+    BOOST_REQUIRE( buffer.TryPop( popped ) );
+    BOOST_CHECK_EQUAL( 3, popped );
+}
+
+/**
+ * Tests that the capacity must be a power of 2.
+ */
+BOOST_AUTO_TEST_CASE( Constructor_InvalidCapacity )
+{
+    BOOST_CHECK_THROW( RingBuffer< int >( 0u ), std::invalid_argument );
+    BOOST_CHECK_THROW( RingBuffer< int >( 6u ), std::invalid_argument );
+    BOOST_CHECK_EQUAL( 8u, RingBuffer< int >( 8u ).GetCapacity() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -25,15 +25,15 @@ public:
      */
     SymbolTable::Ptr
     GenerateTableAndValidate(
-        AstNode::Ptr scopeNode,
+        AstNode scopeNode,
         size_t expectedNumEntries
     )
     {
-        BOOST_CHECK_EQUAL( nullptr, scopeNode->m_symbolTable );
+        BOOST_CHECK_EQUAL( nullptr, scopeNode.GetSymbolTable() );
         m_generator->GenerateSymbolTableForAst( scopeNode );
-        BOOST_REQUIRE_NE( nullptr, scopeNode->m_symbolTable );
-        BOOST_CHECK_EQUAL( expectedNumEntries, scopeNode->m_symbolTable->GetNumEntries() );
-        return scopeNode->m_symbolTable;
+        BOOST_REQUIRE_NE( nullptr, scopeNode.GetSymbolTable() );
+        BOOST_CHECK_EQUAL( expectedNumEntries, scopeNode.GetSymbolTable()->GetNumEntries() );
+        return scopeNode.GetSymbolTable();
     }
 
     /**
@@ -42,12 +42,12 @@ public:
      *
      * \return  Created AST scoped block node.
      */
-    AstNode::Ptr
+    AstNode
     CreateScopedNodeFromChildren(
         AstNode::Children childNodes
     )
     {
-        return std::make_shared< AstNode >( NT::Scoped_block, childNodes );
+        return m_arena.CreateNode( NT::Scoped_block, childNodes );
     }
 
     /**
@@ -66,7 +66,7 @@ public:
         bool writtenTo
     )
     {
-        SymbolTableEntry::Ptr fetchedEntry = table->GetEntryIfExists( symbolName );
+        SymbolTableEntry* fetchedEntry = table->GetEntryIfExists( IdentifierTable::GetInstance()->Intern( symbolName ) );
         BOOST_REQUIRE_NE( nullptr, fetchedEntry );
 
         BOOST_CHECK_EQUAL( DataType::DT_BYTE, fetchedEntry->dataType );
@@ -76,6 +76,9 @@ public:
 
 protected:
     SymbolTableGenerator::Ptr m_generator;
+
+    // Arena storing the nodes of the ASTs created by the test case.
+    AstArena m_arena;
 };
 
 BOOST_FIXTURE_TEST_SUITE( SymbolTableGeneratorTests, SymbolTableGeneratorTestsFixture )
@@ -96,9 +99,9 @@ BOOST_AUTO_TEST_CASE( NullptrAstNode )
  */
 BOOST_AUTO_TEST_CASE( AstNodeAlreadyHasTable )
 {
-    AstNode::Ptr node = std::make_shared< AstNode >( 0u, nullptr ); // Filler values to satisfy constructor
+    AstNode node = m_arena.CreateNode( 0u, Token() ); // Filler values to satisfy constructor
     SymbolTable::Ptr existingTable = std::make_shared< SymbolTable >( nullptr );
-    node->m_symbolTable = existingTable;
+    m_arena.SetSymbolTable( node, existingTable );
 
     BOOST_CHECK_THROW( m_generator->GenerateSymbolTableForAst( node ), std::runtime_error );
 }
@@ -116,12 +119,12 @@ BOOST_AUTO_TEST_CASE( AstHasNoSymbols )
     // Fake child nodes of the AST. Use fake tokens as the generator method should only check node types.
     // With this in mind, we can also fake NT subtree nodes by using the "Token" constructor, for convenience.
 
-    Token::Ptr fakeToken = std::make_shared< Token >( TokenType::INVALID_TOKEN );
+    Token fakeToken = Token( TokenType::INVALID_TOKEN );
 
-    AstNode::Children children{ std::make_shared< AstNode >( T::BYTE, fakeToken ),
-                                std::make_shared< AstNode >( T::AND, fakeToken ),
-                                std::make_shared< AstNode >( NT::For_init, fakeToken ) };
-    AstNode::Ptr scopeNode = std::make_shared< AstNode >( NT::Block, children );
+    AstNode::Children children{ m_arena.CreateNode( T::BYTE, fakeToken ),
+                                m_arena.CreateNode( T::AND, fakeToken ),
+                                m_arena.CreateNode( NT::For_init, fakeToken ) };
+    AstNode scopeNode = m_arena.CreateNode( NT::Block, children );
 
     constexpr size_t expectedNumEntries{ 0u };
     SymbolTable::Ptr table = GenerateTableAndValidate( scopeNode, expectedNumEntries );
@@ -136,7 +139,7 @@ BOOST_AUTO_TEST_CASE( UndeclaredIdentifier )
     // Create assignment statement that reads from undeclared variable.
     std::string varName1 = "foo";
     std::string varName2 = "bar";
-    AstNode::Ptr assignNode = AstSimulator::CreateAssignNodeFromVar( varName2, varName1, IsDeclaration::TRUE );
+    AstNode assignNode = AstSimulator::CreateAssignNodeFromVar( m_arena, varName2, varName1, IsDeclaration::TRUE );
 
     BOOST_CHECK_THROW( m_generator->GenerateSymbolTableForAst( assignNode ), std::runtime_error );
 }
@@ -151,7 +154,7 @@ BOOST_AUTO_TEST_CASE( SingleIdentifier_Unreferenced )
     std::string varName = "foo";
     constexpr uint8_t numValue{ 5u };
     // Use single assign statement as the scope
-    AstNode::Ptr assignNode = AstSimulator::CreateAssignNodeFromByteValue( varName, numValue, IsDeclaration::TRUE );
+    AstNode assignNode = AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName, numValue, IsDeclaration::TRUE );
 
     constexpr size_t expectedNumEntries{ 1u };
     SymbolTable::Ptr table = GenerateTableAndValidate( assignNode, expectedNumEntries );
@@ -171,15 +174,15 @@ BOOST_AUTO_TEST_CASE( Identifier_ReadFrom )
     // Create first declaration statement.
     std::string varName = "foo";
     constexpr uint8_t numValue{ 5u };
-    AstNode::Ptr assignNode1 = AstSimulator::CreateAssignNodeFromByteValue( varName, numValue, IsDeclaration::TRUE );
+    AstNode assignNode1 = AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName, numValue, IsDeclaration::TRUE );
 
     // Create second assign statement which reads from the first.
     std::string varName2 = "bar";
-    AstNode::Ptr assignNode2 = AstSimulator::CreateAssignNodeFromVar( varName2, varName, IsDeclaration::TRUE );
+    AstNode assignNode2 = AstSimulator::CreateAssignNodeFromVar( m_arena, varName2, varName, IsDeclaration::TRUE );
 
     // Create node to hold both assignment statements.
     AstNode::Children children{ assignNode1, assignNode2 };
-    AstNode::Ptr scopeNode = std::make_shared< AstNode >( NT::Block, children );
+    AstNode scopeNode = m_arena.CreateNode( NT::Block, children );
 
     // Expect two entries as 2 vars were declared.
     constexpr size_t expectedNumEntries{ 2u };
@@ -206,15 +209,15 @@ BOOST_AUTO_TEST_CASE( SingleIdentifier_WrittenTo )
     // Create first declaration statement.
     std::string varName = "foo";
     constexpr uint8_t numValue{ 5u };
-    AstNode::Ptr assignNode1 = AstSimulator::CreateAssignNodeFromByteValue( varName, numValue, IsDeclaration::TRUE );
+    AstNode assignNode1 = AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName, numValue, IsDeclaration::TRUE );
 
     // Create second assign statement which writes to the first.
     constexpr uint8_t numValue2{ 3u };
-    AstNode::Ptr assignNode2 = AstSimulator::CreateAssignNodeFromByteValue( varName, numValue2, IsDeclaration::FALSE );
+    AstNode assignNode2 = AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName, numValue2, IsDeclaration::FALSE );
 
     // Create node to hold both assignment statements.
     AstNode::Children children{ assignNode1, assignNode2 };
-    AstNode::Ptr scopeNode = std::make_shared< AstNode >( NT::Block, children );
+    AstNode scopeNode = m_arena.CreateNode( NT::Block, children );
 
     constexpr size_t expectedNumEntries{ 1u };
     SymbolTable::Ptr table = GenerateTableAndValidate( scopeNode, expectedNumEntries );
@@ -234,19 +237,19 @@ BOOST_AUTO_TEST_CASE( Identifier_ReadFromAndWrittenTo )
     // Create first declaration statement.
     std::string varName1 = "foo";
     constexpr uint8_t numValue1{ 5u };
-    AstNode::Ptr assignNode1 = AstSimulator::CreateAssignNodeFromByteValue( varName1, numValue1, IsDeclaration::TRUE );
+    AstNode assignNode1 = AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName1, numValue1, IsDeclaration::TRUE );
 
     // Create second assign statement which writes to the first.
     constexpr uint8_t numValue2{ 3u };
-    AstNode::Ptr assignNode2 = AstSimulator::CreateAssignNodeFromByteValue( varName1, numValue2, IsDeclaration::FALSE );
+    AstNode assignNode2 = AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName1, numValue2, IsDeclaration::FALSE );
 
     // Create third assign statement which reads from the first.
     std::string varName2 = "bar";
-    AstNode::Ptr assignNode3 = AstSimulator::CreateAssignNodeFromVar( varName2, varName1, IsDeclaration::TRUE );
+    AstNode assignNode3 = AstSimulator::CreateAssignNodeFromVar( m_arena, varName2, varName1, IsDeclaration::TRUE );
 
     // Create node to hold all assignment statements.
     AstNode::Children children{ assignNode1, assignNode2, assignNode3 };
-    AstNode::Ptr scopeNode = std::make_shared< AstNode >( NT::Block, children );
+    AstNode scopeNode = m_arena.CreateNode( NT::Block, children );
 
     constexpr size_t expectedNumEntries{ 2u };
     SymbolTable::Ptr table = GenerateTableAndValidate( scopeNode, expectedNumEntries );
@@ -272,18 +275,18 @@ BOOST_AUTO_TEST_CASE( NestedScopeCreatesNewTable )
 {
     // Create fake child scope-defining node to test a new table is created.
     constexpr TokenType scopeDefiningTokenType{ TokenType::WHILE };
-    Token::Ptr fakeToken = std::make_shared< Token >( TokenType::INVALID_TOKEN );
-    AstNode::Ptr fakeTokenWrapper = std::make_shared< AstNode >( TokenType::AND, fakeToken );
+    Token fakeToken = Token( TokenType::INVALID_TOKEN );
+    AstNode fakeTokenWrapper = m_arena.CreateNode( TokenType::AND, fakeToken );
     AstNode::Children scopeChildren{ fakeTokenWrapper };
-    AstNode::Ptr childNode = std::make_shared< AstNode >( scopeDefiningTokenType, scopeChildren );
+    AstNode childNode = m_arena.CreateNode( scopeDefiningTokenType, scopeChildren );
 
     AstNode::Children children{ childNode };
-    AstNode::Ptr parentNode = std::make_shared< AstNode >( NT::Block, children );
+    AstNode parentNode = m_arena.CreateNode( NT::Block, children );
 
     constexpr size_t expectedNumEntries{ 0u };
     SymbolTable::Ptr parentTable = GenerateTableAndValidate( parentNode, expectedNumEntries );
 
-    SymbolTable::Ptr childTable = childNode->m_symbolTable;
+    SymbolTable::Ptr childTable = childNode.GetSymbolTable();
     BOOST_REQUIRE_NE( nullptr, childTable );
     BOOST_CHECK_EQUAL( 0u, childTable->GetNumEntries() );
 }
@@ -297,18 +300,18 @@ BOOST_AUTO_TEST_CASE( VarReferencesInNestedScope )
     // Declaration statement for the parent scope
     std::string varName = "foo";
     constexpr uint8_t numValue{ 5u };
-    AstNode::Ptr declarationNode = AstSimulator::CreateAssignNodeFromByteValue( varName, numValue, IsDeclaration::TRUE );
+    AstNode declarationNode = AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName, numValue, IsDeclaration::TRUE );
 
     // Assign to the var name, this statement goes in the child scope
     constexpr uint8_t numValue2{ 5u };
-    AstNode::Ptr assignNode = AstSimulator::CreateAssignNodeFromByteValue( varName, numValue2, IsDeclaration::FALSE );
+    AstNode assignNode = AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName, numValue2, IsDeclaration::FALSE );
 
     constexpr TokenType scopeDefiningTokenType{ TokenType::IF };
     AstNode::Children childScopeChildren{ assignNode };
-    AstNode::Ptr childScope = std::make_shared< AstNode >( scopeDefiningTokenType, childScopeChildren );
+    AstNode childScope = m_arena.CreateNode( scopeDefiningTokenType, childScopeChildren );
 
     AstNode::Children parentScopeChildren{ declarationNode, childScope };
-    AstNode::Ptr parentScope = std::make_shared< AstNode >( NT::Block, parentScopeChildren );
+    AstNode parentScope = m_arena.CreateNode( NT::Block, parentScopeChildren );
 
     constexpr size_t expectedNumParentEntries{ 1u };
     SymbolTable::Ptr parentTable = GenerateTableAndValidate( parentScope, expectedNumParentEntries );
@@ -317,7 +320,7 @@ BOOST_AUTO_TEST_CASE( VarReferencesInNestedScope )
     constexpr bool expectWrittenTo{ true };
     CheckForByteEntry( parentTable, varName, expectReadFrom, expectWrittenTo );
 
-    SymbolTable::Ptr childTable = childScope->m_symbolTable;
+    SymbolTable::Ptr childTable = childScope.GetSymbolTable();
     BOOST_REQUIRE_NE( nullptr, childTable );
     BOOST_CHECK_EQUAL( 0u, childTable->GetNumEntries() );
 }
@@ -335,31 +338,31 @@ BOOST_AUTO_TEST_CASE( SiblingScopesSameIdentifier )
     // Scope 1:
     // Declare identifier and then write to it.
     constexpr uint8_t numValue{ 5u };
-    AstNode::Ptr declarationNode = AstSimulator::CreateAssignNodeFromByteValue( varName, numValue, IsDeclaration::TRUE );
+    AstNode declarationNode = AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName, numValue, IsDeclaration::TRUE );
 
     constexpr uint8_t numValue2{ 3u };
-    AstNode::Ptr assignNode = AstSimulator::CreateAssignNodeFromByteValue( varName, numValue2, IsDeclaration::FALSE );
+    AstNode assignNode = AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName, numValue2, IsDeclaration::FALSE );
 
     AstNode::Children scope1Children{ declarationNode, assignNode };
-    AstNode::Ptr scope1 = std::make_shared< AstNode >( scopeDefiningTokenType, scope1Children );
+    AstNode scope1 = m_arena.CreateNode( scopeDefiningTokenType, scope1Children );
 
     // Scope 2:
     // Declare identifier, and do not reference it.
     constexpr uint8_t numValue3{ 1u };
-    AstNode::Ptr declarationNode2 = AstSimulator::CreateAssignNodeFromByteValue( varName, numValue3, IsDeclaration::TRUE );
+    AstNode declarationNode2 = AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName, numValue3, IsDeclaration::TRUE );
 
     AstNode::Children scope2Children{ declarationNode2 };
-    AstNode::Ptr scope2 = std::make_shared< AstNode >( scopeDefiningTokenType, scope2Children );
+    AstNode scope2 = m_arena.CreateNode( scopeDefiningTokenType, scope2Children );
 
     // Parent scope containing both sibling scopes
     AstNode::Children parentChildren{ scope1, scope2 };
-    AstNode::Ptr parentScope = std::make_shared< AstNode >( NT::Block, parentChildren );
+    AstNode parentScope = m_arena.CreateNode( NT::Block, parentChildren );
 
     constexpr size_t expectedNumParentEntries{ 0u };
     SymbolTable::Ptr parentTable = GenerateTableAndValidate( parentScope, expectedNumParentEntries );
 
     // Scope 1 table
-    SymbolTable::Ptr table1 = scope1->m_symbolTable;
+    SymbolTable::Ptr table1 = scope1.GetSymbolTable();
     BOOST_REQUIRE_NE( nullptr, table1 );
     BOOST_CHECK_EQUAL( 1u, table1->GetNumEntries() );
     constexpr bool expectReadFrom{ false };
@@ -367,7 +370,7 @@ BOOST_AUTO_TEST_CASE( SiblingScopesSameIdentifier )
     CheckForByteEntry( table1, varName, expectReadFrom, expectWrittenTo );
 
     // Scope 2 table
-    SymbolTable::Ptr table2 = scope2->m_symbolTable;
+    SymbolTable::Ptr table2 = scope2.GetSymbolTable();
     BOOST_REQUIRE_NE( nullptr, table2 );
     BOOST_CHECK_EQUAL( 1u, table2->GetNumEntries() );
     constexpr bool expectReadFrom2{ false };
@@ -385,24 +388,24 @@ BOOST_AUTO_TEST_CASE( GrandchildNestedScope )
 
     // In the parent scope: declare identifier
     constexpr uint8_t numValue{ 5u };
-    AstNode::Ptr declarationNode = AstSimulator::CreateAssignNodeFromByteValue( varName, numValue, IsDeclaration::TRUE );
+    AstNode declarationNode = AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName, numValue, IsDeclaration::TRUE );
 
     // In the grandchild scope, write to identifier
     constexpr uint8_t numValue2{ 3u };
-    AstNode::Ptr assignNode = AstSimulator::CreateAssignNodeFromByteValue( varName, numValue2, IsDeclaration::FALSE );
+    AstNode assignNode = AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName, numValue2, IsDeclaration::FALSE );
 
     // Populate scopes
     AstNode::Children grandchildScopeChildren{ assignNode };
     constexpr TokenType scopeDefiningTokenType1{ TokenType::FOR };
-    AstNode::Ptr grandchildScope = std::make_shared< AstNode >( scopeDefiningTokenType1, grandchildScopeChildren );
+    AstNode grandchildScope = m_arena.CreateNode( scopeDefiningTokenType1, grandchildScopeChildren );
 
     AstNode::Children childScopeChildren{ grandchildScope };
     constexpr TokenType scopeDefiningTokenType2{ TokenType::WHILE };
-    AstNode::Ptr childScope = std::make_shared< AstNode >( scopeDefiningTokenType2, childScopeChildren );
+    AstNode childScope = m_arena.CreateNode( scopeDefiningTokenType2, childScopeChildren );
 
     AstNode::Children parentScopeChildren{ declarationNode, childScope };
     constexpr TokenType scopeDefiningTokenType3{ TokenType::IF };
-    AstNode::Ptr parentScope = std::make_shared< AstNode >( scopeDefiningTokenType3, parentScopeChildren );
+    AstNode parentScope = m_arena.CreateNode( scopeDefiningTokenType3, parentScopeChildren );
 
     // Expect the entry to belong to the parent table as it was declared in that scope.
     constexpr size_t expectedNumParentEntries{ 1u };
@@ -414,16 +417,42 @@ BOOST_AUTO_TEST_CASE( GrandchildNestedScope )
     CheckForByteEntry( parentTable, varName, expectReadFrom, expectWrittenTo );
 
     // Validate child table
-    SymbolTable::Ptr childTable = childScope->m_symbolTable;
+    SymbolTable::Ptr childTable = childScope.GetSymbolTable();
     BOOST_REQUIRE_NE( nullptr, childTable );
     BOOST_CHECK_EQUAL( 0u, childTable->GetNumEntries() );
 
     // Validate grandchild table
-    SymbolTable::Ptr grandchildTable = grandchildScope->m_symbolTable;
+    SymbolTable::Ptr grandchildTable = grandchildScope.GetSymbolTable();
     BOOST_REQUIRE_NE( nullptr, grandchildTable );
     BOOST_CHECK_EQUAL( 0u, grandchildTable->GetNumEntries() );
 }
 
+/**
+ * Tests that a long chain of nested blocks, as built by a right-recursive Block rule, is populated into a single table,
+ * with declarations seen before the uses further down the chain.
+ */
+BOOST_AUTO_TEST_CASE( DeeplyNestedBlocks )
+{
+    std::string varName = "foo";
+    constexpr size_t numStatements{ 5000u };
+
+    AstNode::Children statements;
+    constexpr uint8_t numValue{ 5u };
+    statements.push_back( AstSimulator::CreateAssignNodeFromByteValue( m_arena, varName, numValue, IsDeclaration::TRUE ) );
+    for ( size_t i = 1u; i < numStatements; ++i )
+    {
+        statements.push_back( AstSimulator::CreateAssignNodeFromVar( m_arena, varName, varName, IsDeclaration::FALSE ) );
+    }
+    AstNode blockNode = AstSimulator::WrapNodesInBlocks( m_arena, statements );
+
+    constexpr size_t expectedNumEntries{ 1u };
+    SymbolTable::Ptr table = GenerateTableAndValidate( blockNode, expectedNumEntries );
+
+    constexpr bool expectReadFrom{ true };
+    constexpr bool expectWrittenTo{ true };
+    CheckForByteEntry( table, varName, expectReadFrom, expectWrittenTo );
+}
+
 BOOST_AUTO_TEST_SUITE_END() // MultiScopeTests
 
 BOOST_AUTO_TEST_SUITE( RealExamples )
@@ -442,31 +471,31 @@ BOOST_AUTO_TEST_CASE( StartingSymbolBlock_WhileLoop )
     // Create first declaration statement.
     std::string insideScopeVar = "insideScope";
     constexpr uint8_t insideScopeValue{ 5u };
-    AstNode::Ptr insideScopeAssign = AstSimulator::CreateAssignNodeFromByteValue( insideScopeVar,
+    AstNode insideScopeAssign = AstSimulator::CreateAssignNodeFromByteValue( m_arena, insideScopeVar,
                                                                                   insideScopeValue,
                                                                                   IsDeclaration::TRUE );
 
-    Token::Ptr conditionByteToken = std::make_shared< Token >( TokenType::BYTE, 1u );
-    AstNode::Ptr conditionNode = std::make_shared< AstNode >( TokenType::BYTE, conditionByteToken );
+    Token conditionByteToken = Token( TokenType::BYTE, 1u );
+    AstNode conditionNode = m_arena.CreateNode( TokenType::BYTE, conditionByteToken );
 
     AstNode::Children whileChildren = { conditionNode, insideScopeAssign };
-    AstNode::Ptr whileNode = std::make_shared< AstNode >( TokenType::WHILE, whileChildren );
+    AstNode whileNode = m_arena.CreateNode( TokenType::WHILE, whileChildren );
 
     // Create second, outside-scope declaration statement.
     std::string outsideScopeVar = "outsideScope";
     constexpr uint8_t outsideScopeValue{ 10u };
-    AstNode::Ptr outsideScopeAssign = AstSimulator::CreateAssignNodeFromByteValue( outsideScopeVar,
+    AstNode outsideScopeAssign = AstSimulator::CreateAssignNodeFromByteValue( m_arena, outsideScopeVar,
                                                                                    outsideScopeValue,
                                                                                    IsDeclaration::TRUE );
 
     AstNode::Children blockChildren{ whileNode, outsideScopeAssign};
-    AstNode::Ptr blockNode = std::make_shared< AstNode >( NT::Block, blockChildren );
+    AstNode blockNode = m_arena.CreateNode( NT::Block, blockChildren );
 
     constexpr size_t expectedBlockTableSize{ 1u };
     SymbolTable::Ptr blockSt = GenerateTableAndValidate( blockNode, expectedBlockTableSize );
     CheckForByteEntry( blockSt, outsideScopeVar, false, false );
 
-    SymbolTable::Ptr whileSt = whileNode->m_symbolTable;
+    SymbolTable::Ptr whileSt = whileNode.GetSymbolTable();
     BOOST_REQUIRE_NE( nullptr, whileSt );
     BOOST_REQUIRE_EQUAL( 1u, whileSt->GetNumEntries() );
     CheckForByteEntry( whileSt, insideScopeVar, false, false );
@@ -1,64 +1,53 @@
 #include <boost/test/unit_test.hpp>
 #include "SymbolTable.h"
 
-/**
- * Derived copy of SymbolTable class, with extended access for testing.
- */
-class SymbolTable_Test : public SymbolTable
-{
-public:
-    using Ptr = std::shared_ptr< SymbolTable_Test >;
-    using SymbolTable::SymbolTable;
-    using SymbolTable::m_table;
-};
-
 BOOST_AUTO_TEST_SUITE( SymbolTableTests )
 
 /**
- * Tests that GetEntryIfExists will throw an exception if AddEntry is called with a nullptr entry.
+ * Tests that AddEntry will throw an exception if called with an invalid identifier.
  */
-BOOST_AUTO_TEST_CASE( AddEntry_NullptrEntry )
+BOOST_AUTO_TEST_CASE( AddEntry_InvalidIdentifier )
 {
-    const std::string entryIdentifier = "idName";
-
-    SymbolTable_Test::Ptr currentTable = std::make_shared< SymbolTable_Test >( nullptr );
-    BOOST_CHECK_THROW( currentTable->AddEntry( entryIdentifier, nullptr ), std::runtime_error );
+    SymbolTable::Ptr currentTable = std::make_shared< SymbolTable >( nullptr );
+    BOOST_CHECK_THROW( currentTable->AddEntry( g_invalidIdentifierId, SymbolTableEntry() ), std::invalid_argument );
 }
 
 /**
- * Tests that GetEntryIfExists successfully add the given entry to its map member.
+ * Tests that AddEntry successfully adds a copy of the given entry to the table.
  */
 BOOST_AUTO_TEST_CASE( AddEntry_Success )
 {
-    SymbolTableEntry::Ptr entry = std::make_shared< SymbolTableEntry >();
-    const std::string entryIdentifier = "idName";
-
-    SymbolTable_Test::Ptr currentTable = std::make_shared< SymbolTable_Test >( nullptr );
-    BOOST_CHECK( currentTable->m_table.empty() );
-    currentTable->AddEntry( entryIdentifier, entry );
+    SymbolTableEntry entry;
+    entry.dataType = DataType::DT_BYTE;
+    entry.isReadFrom = true;
+    const IdentifierId entryIdentifier = IdentifierTable::GetInstance()->Intern( "idName" );
 
-    BOOST_CHECK_EQUAL( 1u, currentTable->m_table.size() );
-    SymbolTableEntry::Ptr foundEntry = currentTable->m_table.find( entryIdentifier )->second;
-    BOOST_CHECK_EQUAL( entry.get(), foundEntry.get() );
+    SymbolTable::Ptr currentTable = std::make_shared< SymbolTable >( nullptr );
+    BOOST_CHECK_EQUAL( 0u, currentTable->GetNumEntries() );
+    SymbolTableEntry& storedEntry = currentTable->AddEntry( entryIdentifier, entry );
+
+    BOOST_CHECK_EQUAL( 1u, currentTable->GetNumEntries() );
+    SymbolTableEntry* foundEntry = currentTable->GetEntryIfExists( entryIdentifier );
+    BOOST_REQUIRE( nullptr != foundEntry );
+    BOOST_CHECK_EQUAL( &storedEntry, foundEntry );
+    BOOST_CHECK_EQUAL( DataType::DT_BYTE, foundEntry->dataType );
+    BOOST_CHECK( foundEntry->isReadFrom );
+    BOOST_CHECK( !foundEntry->isWrittenTo );
 }
 
 /**
- * Tests that GetEntryIfExists will throw an exception if AddEntry is called with an identifier for which an entry
- * already exists.
+ * Tests that AddEntry will throw an exception if called with an identifier for which an entry already exists.
  */
 BOOST_AUTO_TEST_CASE( AddEntry_EntryAlreadyExists )
 {
-    SymbolTableEntry::Ptr entry = std::make_shared< SymbolTableEntry >();
-    const std::string entryIdentifier = "idName";
+    const IdentifierId entryIdentifier = IdentifierTable::GetInstance()->Intern( "idName" );
 
-    SymbolTable_Test::Ptr currentTable = std::make_shared< SymbolTable_Test >( nullptr );
-    BOOST_CHECK( currentTable->m_table.empty() );
-    currentTable->AddEntry( entryIdentifier, entry );
+    SymbolTable::Ptr currentTable = std::make_shared< SymbolTable >( nullptr );
+    currentTable->AddEntry( entryIdentifier, SymbolTableEntry() );
 
-    BOOST_CHECK_EQUAL( 1u, currentTable->m_table.size() );
+    BOOST_CHECK_EQUAL( 1u, currentTable->GetNumEntries() );
 
-    SymbolTableEntry::Ptr entry2 = std::make_shared< SymbolTableEntry >();
-    BOOST_CHECK_THROW( currentTable->AddEntry( entryIdentifier, entry2 ), std::runtime_error );
+    BOOST_CHECK_THROW( currentTable->AddEntry( entryIdentifier, SymbolTableEntry() ), std::runtime_error );
 }
 
 /**
@@ -66,14 +55,13 @@ BOOST_AUTO_TEST_CASE( AddEntry_EntryAlreadyExists )
  */
 BOOST_AUTO_TEST_CASE( GetEntry_ExistsInCurrentTable )
 {
-    SymbolTableEntry::Ptr entry = std::make_shared< SymbolTableEntry >();
-    const std::string entryIdentifier = "idName";
+    const IdentifierId entryIdentifier = IdentifierTable::GetInstance()->Intern( "idName" );
 
-    SymbolTable_Test::Ptr currentTable = std::make_shared< SymbolTable_Test >( nullptr );
-    currentTable->AddEntry( entryIdentifier, entry );
+    SymbolTable::Ptr currentTable = std::make_shared< SymbolTable >( nullptr );
+    SymbolTableEntry& entry = currentTable->AddEntry( entryIdentifier, SymbolTableEntry() );
 
-    SymbolTableEntry::Ptr foundEntry = currentTable->GetEntryIfExists( entryIdentifier );
-    BOOST_CHECK_EQUAL( foundEntry.get(), entry.get() );
+    SymbolTableEntry* foundEntry = currentTable->GetEntryIfExists( entryIdentifier );
+    BOOST_CHECK_EQUAL( foundEntry, &entry );
 }
 
 /**
@@ -81,16 +69,15 @@ BOOST_AUTO_TEST_CASE( GetEntry_ExistsInCurrentTable )
  */
 BOOST_AUTO_TEST_CASE( GetEntry_ExistsInParentTable )
 {
-    SymbolTableEntry::Ptr entry = std::make_shared< SymbolTableEntry >();
-    const std::string entryIdentifier = "idName";
+    const IdentifierId entryIdentifier = IdentifierTable::GetInstance()->Intern( "idName" );
 
-    SymbolTable_Test::Ptr parentTable = std::make_shared< SymbolTable_Test >( nullptr );
-    parentTable->AddEntry( entryIdentifier, entry );
+    SymbolTable::Ptr parentTable = std::make_shared< SymbolTable >( nullptr );
+    SymbolTableEntry& entry = parentTable->AddEntry( entryIdentifier, SymbolTableEntry() );
 
-    SymbolTable_Test::Ptr currentTable = std::make_shared< SymbolTable_Test >( parentTable );
+    SymbolTable::Ptr currentTable = std::make_shared< SymbolTable >( parentTable );
 
-    SymbolTableEntry::Ptr foundEntry = currentTable->GetEntryIfExists( entryIdentifier );
-    BOOST_CHECK_EQUAL( foundEntry.get(), entry.get() );
+    SymbolTableEntry* foundEntry = currentTable->GetEntryIfExists( entryIdentifier );
+    BOOST_CHECK_EQUAL( foundEntry, &entry );
 }
 
 /**
@@ -98,13 +85,84 @@ BOOST_AUTO_TEST_CASE( GetEntry_ExistsInParentTable )
  */
 BOOST_AUTO_TEST_CASE( GetEntry_NoMatch )
 {
-    const std::string entryIdentifier = "idName";
+    const IdentifierId entryIdentifier = IdentifierTable::GetInstance()->Intern( "idName" );
+
+    SymbolTable::Ptr parentTable = std::make_shared< SymbolTable >( nullptr );
+    SymbolTable::Ptr currentTable = std::make_shared< SymbolTable >( parentTable );
+
+    SymbolTableEntry* foundEntry = currentTable->GetEntryIfExists( entryIdentifier );
+    BOOST_CHECK( nullptr == foundEntry );
+}
+
+/**
+ * Tests that an entry in a table shadows an entry for the same identifier in a parent table, and is only visible from
+ * the table and its children.
+ */
+BOOST_AUTO_TEST_CASE( GetEntry_Shadowing )
+{
+    const IdentifierId entryIdentifier = IdentifierTable::GetInstance()->Intern( "idName" );
+
+    SymbolTable::Ptr rootTable = std::make_shared< SymbolTable >( nullptr );
+    SymbolTableEntry& rootEntry = rootTable->AddEntry( entryIdentifier, SymbolTableEntry() );
+
+    SymbolTable::Ptr shadowingTable = std::make_shared< SymbolTable >( rootTable );
+    SymbolTableEntry& shadowingEntry = shadowingTable->AddEntry( entryIdentifier, SymbolTableEntry() );
+    SymbolTable::Ptr shadowingChildTable = std::make_shared< SymbolTable >( shadowingTable );
+    SymbolTable::Ptr siblingTable = std::make_shared< SymbolTable >( rootTable );
+
+    BOOST_CHECK_EQUAL( &rootEntry, rootTable->GetEntryIfExists( entryIdentifier ) );
+    BOOST_CHECK_EQUAL( &shadowingEntry, shadowingTable->GetEntryIfExists( entryIdentifier ) );
+    BOOST_CHECK_EQUAL( &shadowingEntry, shadowingChildTable->GetEntryIfExists( entryIdentifier ) );
+    BOOST_CHECK_EQUAL( &rootEntry, siblingTable->GetEntryIfExists( entryIdentifier ) );
+    BOOST_CHECK_EQUAL( 1u, shadowingTable->GetNumEntries() );
+    BOOST_CHECK_EQUAL( 0u, shadowingChildTable->GetNumEntries() );
+}
+
+/**
+ * Tests that entries are found correctly when child tables aren't created in the order of a depth-first traversal,
+ * i.e. a table is given a child after a table outside it has been created.
+ */
+BOOST_AUTO_TEST_CASE( GetEntry_TablesNotInTraversalOrder )
+{
+    const IdentifierId entryIdentifier = IdentifierTable::GetInstance()->Intern( "idName" );
+
+    SymbolTable::Ptr rootTable = std::make_shared< SymbolTable >( nullptr );
+    SymbolTable::Ptr firstTable = std::make_shared< SymbolTable >( rootTable );
+    SymbolTableEntry& firstEntry = firstTable->AddEntry( entryIdentifier, SymbolTableEntry() );
+    SymbolTable::Ptr secondTable = std::make_shared< SymbolTable >( rootTable );
+    SymbolTableEntry& secondEntry = secondTable->AddEntry( entryIdentifier, SymbolTableEntry() );
 
-    SymbolTable_Test::Ptr parentTable = std::make_shared< SymbolTable_Test >( nullptr );
-    SymbolTable_Test::Ptr currentTable = std::make_shared< SymbolTable_Test >( parentTable );
+    // Created after the second table, which is outside the first.
+    SymbolTable::Ptr firstChildTable = std::make_shared< SymbolTable >( firstTable );
 
-    SymbolTableEntry::Ptr foundEntry = currentTable->GetEntryIfExists( entryIdentifier );
-    BOOST_CHECK_EQUAL( nullptr, foundEntry );
+    BOOST_CHECK_EQUAL( &firstEntry, firstChildTable->GetEntryIfExists( entryIdentifier ) );
+    BOOST_CHECK_EQUAL( &secondEntry, secondTable->GetEntryIfExists( entryIdentifier ) );
+    BOOST_CHECK( nullptr == rootTable->GetEntryIfExists( entryIdentifier ) );
+}
+
+/**
+ * Tests that each entry is given a distinct variable ID in the order it was added, shared across the tables of all
+ * scopes, and that the variable table stores its name.
+ */
+BOOST_AUTO_TEST_CASE( AddEntry_AllocatesVarIds )
+{
+    const IdentifierId entryIdentifier = IdentifierTable::GetInstance()->Intern( "idName" );
+    const IdentifierId otherIdentifier = IdentifierTable::GetInstance()->Intern( "otherName" );
+
+    SymbolTable::Ptr rootTable = std::make_shared< SymbolTable >( nullptr );
+    SymbolTable::Ptr childTable = std::make_shared< SymbolTable >( rootTable );
+    SymbolTableEntry& rootEntry = rootTable->AddEntry( entryIdentifier, SymbolTableEntry() );
+    SymbolTableEntry& otherEntry = rootTable->AddEntry( otherIdentifier, SymbolTableEntry() );
+    SymbolTableEntry& shadowingEntry = childTable->AddEntry( entryIdentifier, SymbolTableEntry() );
+
+    BOOST_CHECK_EQUAL( 0u, static_cast< uint32_t >( rootEntry.varId ) );
+    BOOST_CHECK_EQUAL( 1u, static_cast< uint32_t >( otherEntry.varId ) );
+    BOOST_CHECK_EQUAL( 2u, static_cast< uint32_t >( shadowingEntry.varId ) );
+
+    const VariableTable::Ptr& variableTable = childTable->GetVariableTable();
+    BOOST_CHECK( rootTable->GetVariableTable() == variableTable );
+    BOOST_CHECK_EQUAL( 3u, variableTable->GetNumVariables() );
+    BOOST_CHECK_EQUAL( "idName", variableTable->GetName( shadowingEntry.varId ) );
 }
 
 /**
@@ -113,7 +171,7 @@ BOOST_AUTO_TEST_CASE( GetEntry_NoMatch )
 BOOST_AUTO_TEST_CASE( GetNumEntries_Zero )
 {
 
-    SymbolTable_Test::Ptr currentTable = std::make_shared< SymbolTable_Test >( nullptr );
+    SymbolTable::Ptr currentTable = std::make_shared< SymbolTable >( nullptr );
     BOOST_CHECK_EQUAL( 0u, currentTable->GetNumEntries() );
 }
 
@@ -122,16 +180,12 @@ BOOST_AUTO_TEST_CASE( GetNumEntries_Zero )
  */
 BOOST_AUTO_TEST_CASE( GetNumEntries_NonZero )
 {
-    SymbolTableEntry::Ptr entry1 = std::make_shared< SymbolTableEntry >();
-    SymbolTableEntry::Ptr entry2 = std::make_shared< SymbolTableEntry >();
-
-    SymbolTable_Test::Ptr currentTable = std::make_shared< SymbolTable_Test >( nullptr );
-    currentTable->AddEntry( "idName1", entry1 );
-    currentTable->AddEntry( "idName2", entry2 );
+    SymbolTable::Ptr currentTable = std::make_shared< SymbolTable >( nullptr );
+    currentTable->AddEntry( IdentifierTable::GetInstance()->Intern( "idName1" ), SymbolTableEntry() );
+    currentTable->AddEntry( IdentifierTable::GetInstance()->Intern( "idName2" ), SymbolTableEntry() );
 
     constexpr size_t expectedSize{ 2u };
-    BOOST_CHECK_EQUAL( expectedSize, currentTable->m_table.size() );
     BOOST_CHECK_EQUAL( expectedSize, currentTable->GetNumEntries() );
 }
 
-BOOST_AUTO_TEST_SUITE_END() // SymbolTableTests
\ No newline at end of file
+BOOST_AUTO_TEST_SUITE_END() // SymbolTableTests
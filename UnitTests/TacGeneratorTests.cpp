@@ -23,10 +23,16 @@ public:
         RES_TRUE
     };
 
+    // Instructions are referred to by their index in the factory's buffer, so make each dummy index unique.
+    size_t MakeDummyUniqueInstrIndex()
+    {
+        return m_nextDummyInstrIndex++;
+    }
+
     // Wrapper around the mock expect call for AddInstruction()
     void
     ExpectAddInstruction(
-        const std::string& expectedTarget,
+        VarId expectedTarget,
         Opcode opcode,
         Operand operand1,
         Operand operand2,
@@ -38,10 +44,25 @@ public:
             .in( sequence )
             .with( expectedTarget, opcode, operand1, operand2 );
     }
+    // Wrapper around the mock expect call for AddBranchInstruction()
+    void
+    ExpectAddBranchInstruction(
+        LabelId expectedTarget,
+        Opcode opcode,
+        Operand operand1,
+        Operand operand2,
+        mock::sequence sequence
+    )
+    {
+        MOCK_EXPECT( m_instructionFactoryMock->AddBranchInstruction )
+            .once()
+            .in( sequence )
+            .with( expectedTarget, opcode, operand1, operand2 );
+    }
     // Wrapper around the mock expect call for AddSingleOperandInstruction()
     void
     ExpectAddSingleOperandInstruction(
-        const std::string& expectedTarget,
+        VarId expectedTarget,
         Opcode opcode,
         Operand operand,
         mock::sequence sequence
@@ -55,7 +76,7 @@ public:
     // Wrapper around the mock expect call for AddAssignmentInstruction()
     void
     ExpectAddAssignmentInstruction(
-        const std::string& expectedTarget,
+        VarId expectedTarget,
         Operand operand,
         mock::sequence sequence
     )
@@ -75,7 +96,7 @@ public:
      */
     void
     CheckNewTempVarCalls(
-        const std::string& idToReturn,
+        VarId idToReturn,
         Operand expectedLhs,
         mock::sequence sequence
     )
@@ -98,7 +119,7 @@ public:
      */
     void
     CheckGetAndSetLabelCalls(
-        const std::string& labelToReturn,
+        LabelId labelToReturn,
         mock::sequence sequence
     )
     {
@@ -116,7 +137,7 @@ public:
      * \brief  Checks the instructions generated for a comparison operation. This is a shared set of checks as they
      *         all share the same pattern.
      *
-     * \param[in]  resultIdToReturn   The mock temp var string to return when a result ID is requested.
+     * \param[in]  resultIdToReturn   The mock temp var to return when a result ID is requested.
      * \param[in]  branchOpcode       The opcode of the expected branch instruction.
      * \param[in]  branchOperand1     The first expected branch operand.
      * \param[in]  branchOperand2     The second expected branch operand.
@@ -125,7 +146,7 @@ public:
      */
     void
     ExpectComparisonInstructions(
-        const std::string& resultIdToReturn,
+        VarId resultIdToReturn,
         Opcode branchOpcode,
         Operand branchOperand1,
         Operand branchOperand2,
@@ -137,11 +158,11 @@ public:
         uint8_t initialValue{ valueIfBranchTrue };
         CheckNewTempVarCalls( resultIdToReturn, initialValue, sequence );
 
-        ExpectAddInstruction( TacInstructionFactory::PLACEHOLDER, branchOpcode, branchOperand1, branchOperand2, sequence );
-        // Expect a call to retrieve a copy of this instruction pointer, so that the target label may be replaced at the end.
-        // Return dummy instruction to verify the later call.
-        ThreeAddrInstruction::Ptr dummyInstr = std::make_shared< ThreeAddrInstruction >( "target", Opcode::OR, "var1", "var2" );
-        MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstruction ).once().in( sequence ).returns( dummyInstr );
+        ExpectAddBranchInstruction( TacInstructionFactory::PLACEHOLDER, branchOpcode, branchOperand1, branchOperand2, sequence );
+        // Expect a call to retrieve the index of this instruction, so that the target label may be replaced at the end.
+        // Return a dummy index to verify the later call.
+        size_t dummyIndex = MakeDummyUniqueInstrIndex();
+        MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstructionIndex ).once().in( sequence ).returns( dummyIndex );
 
         uint8_t nonBranchValue{ static_cast< bool >( !valueIfBranchTrue ) };
         ExpectAddAssignmentInstruction( resultIdToReturn, nonBranchValue, sequence );
@@ -149,20 +170,22 @@ public:
         MOCK_EXPECT( m_instructionFactoryMock->SetInstructionBranchToNextLabel )
             .once()
             .in( sequence )
-            .with( dummyInstr, mock::any );
+            .with( dummyIndex, mock::any );
     }
 
 protected:
 
     TacInstructionFactoryMock::Ptr m_instructionFactoryMock;
+    // Index to give the next dummy instruction.
+    size_t m_nextDummyInstrIndex{ 0u };
 
     // Unit under test
     TacExpressionGenerator::Ptr m_generator;
 
     // Some pre-defined example operands to be used in tests.
-    const Operand c_emptyOp{};
-    const Operand c_stringOp{ "identifier" };
-    const Operand c_stringOp2{ "identifier2" };
+    const Operand c_emptyOp{ g_invalidVarId };
+    const Operand c_varOp{ VarId{ 0u } };
+    const Operand c_varOp2{ VarId{ 1u } };
     const Operand c_literalOp_Five{ 5u };
     const Operand c_literalOp_Two{ 2u };
     const Operand c_zeroOperand{ 0u };
@@ -179,8 +202,8 @@ BOOST_AUTO_TEST_SUITE( MultiplyTests )
  */
 BOOST_AUTO_TEST_CASE( Multiply_InvalidOperands )
 {
-    BOOST_CHECK_THROW( m_generator->Multiply( c_emptyOp, c_stringOp ), std::invalid_argument );
-    BOOST_CHECK_THROW( m_generator->Multiply( c_stringOp, c_emptyOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Multiply( c_emptyOp, c_varOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Multiply( c_varOp, c_emptyOp ), std::invalid_argument );
     BOOST_CHECK_THROW( m_generator->Multiply( c_emptyOp, c_emptyOp ), std::invalid_argument );
 }
 
@@ -228,41 +251,41 @@ BOOST_AUTO_TEST_CASE( Multiply_Identifier )
      */
 
     const Operand operand1{ c_literalOp_Five };
-    const Operand operand2{ c_stringOp };
+    const Operand operand2{ c_varOp };
 
     mock::sequence sequence;
 
     // First four instructions should be initialising the temp vars.
 
-    const std::string resultId{ "result" };
+    const VarId resultId{ 10u };
     constexpr uint8_t expectedResultInit{ 0u };
     CheckNewTempVarCalls( resultId, expectedResultInit, sequence );
 
-    const std::string multiplierId{ "multiplier" };
+    const VarId multiplierId{ 11u };
     CheckNewTempVarCalls( multiplierId, operand1, sequence );
 
-    std::string multiplicandId{ "multiplicand" };
+    const VarId multiplicandId{ 12u };
     CheckNewTempVarCalls( multiplicandId, operand2, sequence );
 
-    const std::string bitCounterId{ "bitCounter" };
+    const VarId bitCounterId{ 13u };
     constexpr uint8_t expectedBitCounterInit{ 8u };
     CheckNewTempVarCalls( bitCounterId, expectedBitCounterInit, sequence );
 
     // Main loop:
 
-    const std::string mainLoopLabel{ "mainLoopLabel" };
+    constexpr LabelId mainLoopLabel{ 0u };
     CheckGetAndSetLabelCalls( mainLoopLabel, sequence );
-    const std::string andTargetId{ "andTarget" };
+    const VarId andTargetId{ 14u };
     MOCK_EXPECT( m_instructionFactoryMock->GetNewTempVar ).once().in( sequence ).returns( andTargetId );
     constexpr uint8_t expectedAndBitmask{ 0xFE }; // Bitmask to get the LSB
     ExpectAddInstruction( andTargetId, Opcode::AND, multiplierId, expectedAndBitmask, sequence );
 
     // Pre-fetch the label for the shift operation, so we can check its value for the next branch instruction.
-    const std::string shiftLabel{ "shiftLabel" };
+    constexpr LabelId shiftLabel{ 1u };
     MOCK_EXPECT( m_instructionFactoryMock->GetNewLabel ).once().in( sequence ).returns( shiftLabel );
 
     // Check is branching to the shift instructions.
-    ExpectAddInstruction( shiftLabel, Opcode::BRE, andTargetId, 0u, sequence );
+    ExpectAddBranchInstruction( shiftLabel, Opcode::BRE, andTargetId, 0u, sequence );
 
     ExpectAddInstruction( resultId, Opcode::ADD, resultId, multiplicandId, sequence );
 
@@ -276,14 +299,14 @@ BOOST_AUTO_TEST_CASE( Multiply_Identifier )
     ExpectAddInstruction( bitCounterId, Opcode::SUB, bitCounterId, expectedSubAmount, sequence );
 
     constexpr uint8_t expectedCompValue{ 0u };
-    ExpectAddInstruction( mainLoopLabel, Opcode::BRLT, expectedCompValue, bitCounterId, sequence );
+    ExpectAddBranchInstruction( mainLoopLabel, Opcode::BRLT, expectedCompValue, bitCounterId, sequence );
 
 
     Operand result = m_generator->Multiply( operand1, operand2 );
 
-    // Check the returned operand is pointing to the result id string
-    BOOST_REQUIRE( std::holds_alternative< std::string >( result ) );
-    BOOST_CHECK_EQUAL( resultId, std::get< std::string >( result ) );
+    // Check the returned operand is pointing to the result id
+    BOOST_REQUIRE( std::holds_alternative< VarId >( result ) );
+    BOOST_CHECK( resultId == std::get< VarId >( result ) );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // MultiplyTests
@@ -295,8 +318,8 @@ BOOST_AUTO_TEST_SUITE( DivideTests )
  */
 BOOST_AUTO_TEST_CASE( Divide_InvalidOperands )
 {
-    BOOST_CHECK_THROW( m_generator->Divide( c_emptyOp, c_stringOp ), std::invalid_argument );
-    BOOST_CHECK_THROW( m_generator->Divide( c_stringOp, c_emptyOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Divide( c_emptyOp, c_varOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Divide( c_varOp, c_emptyOp ), std::invalid_argument );
     BOOST_CHECK_THROW( m_generator->Divide( c_emptyOp, c_emptyOp ), std::invalid_argument );
 }
 
@@ -305,7 +328,7 @@ BOOST_AUTO_TEST_CASE( Divide_InvalidOperands )
  */
 BOOST_AUTO_TEST_CASE( DivideByZero )
 {
-    BOOST_CHECK_THROW( m_generator->Divide( c_stringOp, c_zeroOperand ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Divide( c_varOp, c_zeroOperand ), std::invalid_argument );
 }
 
 /**
@@ -348,32 +371,32 @@ BOOST_AUTO_TEST_CASE( Divide_Identifier )
      */
 
     const Operand operand1{ c_literalOp_Five };
-    const Operand operand2{ c_stringOp };
+    const Operand operand2{ c_varOp };
 
     mock::sequence sequence;
 
     // First 3 instructions should be initialising the temp vars.
 
-    const std::string resultId{ "result" };
+    const VarId resultId{ 15u };
     constexpr uint8_t expectedResultInit{ 0u };
     CheckNewTempVarCalls( resultId, expectedResultInit, sequence );
 
-    const std::string dividendId{ "dividend" };
+    const VarId dividendId{ 16u };
     CheckNewTempVarCalls( dividendId, operand1, sequence );
 
-    const std::string quotientId{ "quotient" };
+    const VarId quotientId{ 17u };
     CheckNewTempVarCalls( quotientId, operand2, sequence );
 
     // Main loop:
 
     // Expect to be branching to the end label, using a placeholder for the initial creation.
-    const std::string mainLoopLabel{ "mainLoopLabel" };
+    constexpr LabelId mainLoopLabel{ 2u };
     CheckGetAndSetLabelCalls( mainLoopLabel, sequence );
-    ExpectAddInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, dividendId, quotientId, sequence );
-    // Expect a call to retrieve a copy of this instruction pointer, so that the target label may be replaced at the end.
-    // Return dummy instruction to verify the later call.
-    ThreeAddrInstruction::Ptr dummyInstr = std::make_shared< ThreeAddrInstruction >( "target", Opcode::OR, "var1", "var2" );
-    MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstruction ).once().in( sequence ).returns( dummyInstr );
+    ExpectAddBranchInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, dividendId, quotientId, sequence );
+    // Expect a call to retrieve the index of this instruction, so that the target label may be replaced at the end.
+    // Return a dummy index to verify the later call.
+    size_t dummyIndex = MakeDummyUniqueInstrIndex();
+    MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstructionIndex ).once().in( sequence ).returns( dummyIndex );
 
     const uint8_t increment{ 1u };
     ExpectAddInstruction( resultId, Opcode::ADD, resultId, increment, sequence );
@@ -381,20 +404,20 @@ BOOST_AUTO_TEST_CASE( Divide_Identifier )
     ExpectAddInstruction( dividendId, Opcode::SUB, dividendId, quotientId, sequence );
 
     // Check is branching to main loop
-    ExpectAddInstruction( mainLoopLabel, Opcode::BRE, resultId, resultId, sequence );
+    ExpectAddBranchInstruction( mainLoopLabel, Opcode::BRE, resultId, resultId, sequence );
 
     // Expect call to direct the branching instruction from earlier to the end.
     MOCK_EXPECT( m_instructionFactoryMock->SetInstructionBranchToNextLabel )
         .once()
         .in( sequence )
-        .with( dummyInstr, mock::any );
+        .with( dummyIndex, mock::any );
 
 
     Operand result = m_generator->Divide( operand1, operand2 );
 
-    // Check the returned operand is pointing to the result id string
-    BOOST_REQUIRE( std::holds_alternative< std::string >( result ) );
-    BOOST_CHECK_EQUAL( resultId, std::get< std::string >( result ) );
+    // Check the returned operand is pointing to the result id
+    BOOST_REQUIRE( std::holds_alternative< VarId >( result ) );
+    BOOST_CHECK( resultId == std::get< VarId >( result ) );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // DivideTests
@@ -406,8 +429,8 @@ BOOST_AUTO_TEST_SUITE( ModuloTests )
  */
 BOOST_AUTO_TEST_CASE( Modulo_InvalidOperands )
 {
-    BOOST_CHECK_THROW( m_generator->Modulo( c_emptyOp, c_stringOp ), std::invalid_argument );
-    BOOST_CHECK_THROW( m_generator->Modulo( c_stringOp, c_emptyOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Modulo( c_emptyOp, c_varOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Modulo( c_varOp, c_emptyOp ), std::invalid_argument );
     BOOST_CHECK_THROW( m_generator->Modulo( c_emptyOp, c_emptyOp ), std::invalid_argument );
 }
 
@@ -416,7 +439,7 @@ BOOST_AUTO_TEST_CASE( Modulo_InvalidOperands )
  */
 BOOST_AUTO_TEST_CASE( ModuloByZero )
 {
-    BOOST_CHECK_THROW( m_generator->Modulo( c_stringOp, c_zeroOperand ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Modulo( c_varOp, c_zeroOperand ), std::invalid_argument );
 }
 
 /**
@@ -459,32 +482,32 @@ BOOST_AUTO_TEST_CASE( Modulo_Identifier )
      */
 
     const Operand operand1{ c_literalOp_Five };
-    const Operand operand2{ c_stringOp };
+    const Operand operand2{ c_varOp };
 
     mock::sequence sequence;
 
     // First 3 instructions should be initialising the temp vars.
 
-    const std::string resultId{ "result" };
+    const VarId resultId{ 18u };
     constexpr uint8_t expectedResultInit{ 0u };
     CheckNewTempVarCalls( resultId, expectedResultInit, sequence );
 
-    const std::string dividendId{ "dividend" };
+    const VarId dividendId{ 19u };
     CheckNewTempVarCalls( dividendId, operand1, sequence );
 
-    const std::string quotientId{ "quotient" };
+    const VarId quotientId{ 20u };
     CheckNewTempVarCalls( quotientId, operand2, sequence );
 
     // Main loop:
 
     // Expect to be branching to the end label, using a placeholder for the initial creation.
-    const std::string mainLoopLabel{ "mainLoopLabel" };
+    constexpr LabelId mainLoopLabel{ 3u };
     CheckGetAndSetLabelCalls( mainLoopLabel, sequence );
-    ExpectAddInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, dividendId, quotientId, sequence );
-    // Expect a call to retrieve a copy of this instruction pointer, so that the target label may be replaced at the end.
-    // Return dummy instruction to verify the later call.
-    ThreeAddrInstruction::Ptr dummyInstr = std::make_shared< ThreeAddrInstruction >( "target", Opcode::OR, "var1", "var2" );
-    MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstruction ).once().in( sequence ).returns( dummyInstr );
+    ExpectAddBranchInstruction( TacInstructionFactory::PLACEHOLDER, Opcode::BRLT, dividendId, quotientId, sequence );
+    // Expect a call to retrieve the index of this instruction, so that the target label may be replaced at the end.
+    // Return a dummy index to verify the later call.
+    size_t dummyIndex = MakeDummyUniqueInstrIndex();
+    MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstructionIndex ).once().in( sequence ).returns( dummyIndex );
 
     const uint8_t increment{ 1u };
     ExpectAddInstruction( resultId, Opcode::ADD, resultId, increment, sequence );
@@ -492,20 +515,20 @@ BOOST_AUTO_TEST_CASE( Modulo_Identifier )
     ExpectAddInstruction( dividendId, Opcode::SUB, dividendId, quotientId, sequence );
 
     // Check is branching to main loop
-    ExpectAddInstruction( mainLoopLabel, Opcode::BRE, resultId, resultId, sequence );
+    ExpectAddBranchInstruction( mainLoopLabel, Opcode::BRE, resultId, resultId, sequence );
 
     // Expect call to direct the branching instruction from earlier to the end.
     MOCK_EXPECT( m_instructionFactoryMock->SetInstructionBranchToNextLabel )
         .once()
         .in( sequence )
-        .with( dummyInstr, mock::any );
+        .with( dummyIndex, mock::any );
 
 
     Operand result = m_generator->Modulo( operand1, operand2 );
 
-    // Check the returned operand is pointing to the result id string
-    BOOST_REQUIRE( std::holds_alternative< std::string >( result ) );
-    BOOST_CHECK_EQUAL( dividendId, std::get< std::string >( result ) );
+    // Check the returned operand is pointing to the result id
+    BOOST_REQUIRE( std::holds_alternative< VarId >( result ) );
+    BOOST_CHECK( dividendId == std::get< VarId >( result ) );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // ModuloTests
@@ -519,8 +542,8 @@ BOOST_AUTO_TEST_SUITE( EqualsTests )
  */
 BOOST_AUTO_TEST_CASE( Equals_InvalidOperands )
 {
-    BOOST_CHECK_THROW( m_generator->Equals( c_emptyOp, c_stringOp ), std::invalid_argument );
-    BOOST_CHECK_THROW( m_generator->Equals( c_stringOp, c_emptyOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Equals( c_emptyOp, c_varOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Equals( c_varOp, c_emptyOp ), std::invalid_argument );
     BOOST_CHECK_THROW( m_generator->Equals( c_emptyOp, c_emptyOp ), std::invalid_argument );
 }
 
@@ -547,18 +570,18 @@ BOOST_AUTO_TEST_CASE( Equals_TwoLiterals )
  */
 BOOST_AUTO_TEST_CASE( Equals_Identifier )
 {
-    const std::string resultIdToReturn{ "result" };
+    const VarId resultIdToReturn{ 21u };
     const Operand operand1{ c_literalOp_Five };
-    const Operand operand2{ c_stringOp };
+    const Operand operand2{ c_varOp };
     const Literal valueIfTrue = c_trueLiteral;
 
     ExpectComparisonInstructions( resultIdToReturn, Opcode::BRE, operand1, operand2, valueIfTrue );
 
     Operand result = m_generator->Equals( operand1, operand2 );
 
-    // Check the returned operand is pointing to the result id string
-    BOOST_REQUIRE( std::holds_alternative< std::string >( result ) );
-    BOOST_CHECK_EQUAL( resultIdToReturn, std::get< std::string >( result ) );
+    // Check the returned operand is pointing to the result id
+    BOOST_REQUIRE( std::holds_alternative< VarId >( result ) );
+    BOOST_CHECK( resultIdToReturn == std::get< VarId >( result ) );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // EqualsTests
@@ -570,8 +593,8 @@ BOOST_AUTO_TEST_SUITE( NotEqualsTests )
  */
 BOOST_AUTO_TEST_CASE( NotEquals_InvalidOperands )
 {
-    BOOST_CHECK_THROW( m_generator->NotEquals( c_emptyOp, c_stringOp ), std::invalid_argument );
-    BOOST_CHECK_THROW( m_generator->NotEquals( c_stringOp, c_emptyOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->NotEquals( c_emptyOp, c_varOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->NotEquals( c_varOp, c_emptyOp ), std::invalid_argument );
     BOOST_CHECK_THROW( m_generator->NotEquals( c_emptyOp, c_emptyOp ), std::invalid_argument );
 }
 
@@ -598,18 +621,18 @@ BOOST_AUTO_TEST_CASE( NotEquals_TwoLiterals )
  */
 BOOST_AUTO_TEST_CASE( NotEquals_Identifier )
 {
-    const std::string resultIdToReturn{ "result" };
+    const VarId resultIdToReturn{ 22u };
     const Operand operand1{ c_literalOp_Five };
-    const Operand operand2{ c_stringOp };
+    const Operand operand2{ c_varOp };
     const Literal valueIfTrue = c_falseLiteral;
 
     ExpectComparisonInstructions( resultIdToReturn, Opcode::BRE, operand1, operand2, valueIfTrue );
 
     Operand result = m_generator->NotEquals( operand1, operand2 );
 
-    // Check the returned operand is pointing to the result id string
-    BOOST_REQUIRE( std::holds_alternative< std::string >( result ) );
-    BOOST_CHECK_EQUAL( resultIdToReturn, std::get< std::string >( result ) );
+    // Check the returned operand is pointing to the result id
+    BOOST_REQUIRE( std::holds_alternative< VarId >( result ) );
+    BOOST_CHECK( resultIdToReturn == std::get< VarId >( result ) );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // NotEqualsTests
@@ -621,8 +644,8 @@ BOOST_AUTO_TEST_SUITE( LeqTests )
  */
 BOOST_AUTO_TEST_CASE( Leq_InvalidOperands )
 {
-    BOOST_CHECK_THROW( m_generator->Leq( c_emptyOp, c_stringOp ), std::invalid_argument );
-    BOOST_CHECK_THROW( m_generator->Leq( c_stringOp, c_emptyOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Leq( c_emptyOp, c_varOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Leq( c_varOp, c_emptyOp ), std::invalid_argument );
     BOOST_CHECK_THROW( m_generator->Leq( c_emptyOp, c_emptyOp ), std::invalid_argument );
 }
 
@@ -654,18 +677,18 @@ BOOST_AUTO_TEST_CASE( Leq_TwoLiterals )
  */
 BOOST_AUTO_TEST_CASE( Leq_Identifier )
 {
-    const std::string resultIdToReturn{ "result" };
+    const VarId resultIdToReturn{ 23u };
     const Operand operand1{ c_literalOp_Five };
-    const Operand operand2{ c_stringOp };
+    const Operand operand2{ c_varOp };
     const Literal valueIfTrue = c_falseLiteral;
 
     ExpectComparisonInstructions( resultIdToReturn, Opcode::BRLT, operand2, operand1, valueIfTrue );
 
     Operand result = m_generator->Leq( operand1, operand2 );
 
-    // Check the returned operand is pointing to the result id string
-    BOOST_REQUIRE( std::holds_alternative< std::string >( result ) );
-    BOOST_CHECK_EQUAL( resultIdToReturn, std::get< std::string >( result ) );
+    // Check the returned operand is pointing to the result id
+    BOOST_REQUIRE( std::holds_alternative< VarId >( result ) );
+    BOOST_CHECK( resultIdToReturn == std::get< VarId >( result ) );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // LeqTests
@@ -677,8 +700,8 @@ BOOST_AUTO_TEST_SUITE( GeqTests )
  */
 BOOST_AUTO_TEST_CASE( Geq_InvalidOperands )
 {
-    BOOST_CHECK_THROW( m_generator->Geq( c_emptyOp, c_stringOp ), std::invalid_argument );
-    BOOST_CHECK_THROW( m_generator->Geq( c_stringOp, c_emptyOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Geq( c_emptyOp, c_varOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->Geq( c_varOp, c_emptyOp ), std::invalid_argument );
     BOOST_CHECK_THROW( m_generator->Geq( c_emptyOp, c_emptyOp ), std::invalid_argument );
 }
 
@@ -710,18 +733,18 @@ BOOST_AUTO_TEST_CASE( Geq_TwoLiterals )
  */
 BOOST_AUTO_TEST_CASE( Geq_Identifier )
 {
-    const std::string resultIdToReturn{ "result" };
+    const VarId resultIdToReturn{ 24u };
     const Operand operand1{ c_literalOp_Five };
-    const Operand operand2{ c_stringOp };
+    const Operand operand2{ c_varOp };
     const Literal valueIfTrue = c_falseLiteral; // False if op1 < op2
 
     ExpectComparisonInstructions( resultIdToReturn, Opcode::BRLT, operand1, operand2, valueIfTrue );
 
     Operand result = m_generator->Geq( operand1, operand2 );
 
-    // Check the returned operand is pointing to the result id string
-    BOOST_REQUIRE( std::holds_alternative< std::string >( result ) );
-    BOOST_CHECK_EQUAL( resultIdToReturn, std::get< std::string >( result ) );
+    // Check the returned operand is pointing to the result id
+    BOOST_REQUIRE( std::holds_alternative< VarId >( result ) );
+    BOOST_CHECK( resultIdToReturn == std::get< VarId >( result ) );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // GeqTests
@@ -733,8 +756,8 @@ BOOST_AUTO_TEST_SUITE( LessThanTests )
  */
 BOOST_AUTO_TEST_CASE( LessThan_InvalidOperands )
 {
-    BOOST_CHECK_THROW( m_generator->LessThan( c_emptyOp, c_stringOp ), std::invalid_argument );
-    BOOST_CHECK_THROW( m_generator->LessThan( c_stringOp, c_emptyOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->LessThan( c_emptyOp, c_varOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->LessThan( c_varOp, c_emptyOp ), std::invalid_argument );
     BOOST_CHECK_THROW( m_generator->LessThan( c_emptyOp, c_emptyOp ), std::invalid_argument );
 }
 
@@ -766,18 +789,18 @@ BOOST_AUTO_TEST_CASE( LessThan_TwoLiterals )
  */
 BOOST_AUTO_TEST_CASE( LessThan_Identifier )
 {
-    const std::string resultIdToReturn{ "result" };
+    const VarId resultIdToReturn{ 25u };
     const Operand operand1{ c_literalOp_Five };
-    const Operand operand2{ c_stringOp };
+    const Operand operand2{ c_varOp };
     const Literal valueIfTrue = c_trueLiteral;
 
     ExpectComparisonInstructions( resultIdToReturn, Opcode::BRLT, operand1, operand2, valueIfTrue );
 
     Operand result = m_generator->LessThan( operand1, operand2 );
 
-    // Check the returned operand is pointing to the result id string
-    BOOST_REQUIRE( std::holds_alternative< std::string >( result ) );
-    BOOST_CHECK_EQUAL( resultIdToReturn, std::get< std::string >( result ) );
+    // Check the returned operand is pointing to the result id
+    BOOST_REQUIRE( std::holds_alternative< VarId >( result ) );
+    BOOST_CHECK( resultIdToReturn == std::get< VarId >( result ) );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // LessThanTests
@@ -789,8 +812,8 @@ BOOST_AUTO_TEST_SUITE( GreaterThanTests )
  */
 BOOST_AUTO_TEST_CASE( GreaterThan_InvalidOperands )
 {
-    BOOST_CHECK_THROW( m_generator->GreaterThan( c_emptyOp, c_stringOp ), std::invalid_argument );
-    BOOST_CHECK_THROW( m_generator->GreaterThan( c_stringOp, c_emptyOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->GreaterThan( c_emptyOp, c_varOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->GreaterThan( c_varOp, c_emptyOp ), std::invalid_argument );
     BOOST_CHECK_THROW( m_generator->GreaterThan( c_emptyOp, c_emptyOp ), std::invalid_argument );
 }
 
@@ -822,18 +845,18 @@ BOOST_AUTO_TEST_CASE( GreaterThan_TwoLiterals )
  */
 BOOST_AUTO_TEST_CASE( GreaterThan_Identifier )
 {
-    const std::string resultIdToReturn{ "result" };
+    const VarId resultIdToReturn{ 26u };
     const Operand operand1{ c_literalOp_Five };
-    const Operand operand2{ c_stringOp };
+    const Operand operand2{ c_varOp };
     const Literal valueIfTrue = c_trueLiteral;
 
     ExpectComparisonInstructions( resultIdToReturn, Opcode::BRLT, operand2, operand1, valueIfTrue );
 
     Operand result = m_generator->GreaterThan( operand1, operand2 );
 
-    // Check the returned operand is pointing to the result id string
-    BOOST_REQUIRE( std::holds_alternative< std::string >( result ) );
-    BOOST_CHECK_EQUAL( resultIdToReturn, std::get< std::string >( result ) );
+    // Check the returned operand is pointing to the result id
+    BOOST_REQUIRE( std::holds_alternative< VarId >( result ) );
+    BOOST_CHECK( resultIdToReturn == std::get< VarId >( result ) );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // GreaterThanTests
@@ -871,17 +894,17 @@ BOOST_AUTO_TEST_CASE( LogicalNot_Literal )
  */
 BOOST_AUTO_TEST_CASE( LogicalNot_Identifier )
 {
-    const std::string resultIdToReturn{ "result" };
-    const Operand operand{ c_stringOp };
+    const VarId resultIdToReturn{ 27u };
+    const Operand operand{ c_varOp };
     const Literal valueIfTrue = c_trueLiteral;
 
     ExpectComparisonInstructions( resultIdToReturn, Opcode::BRLT, c_zeroOperand, operand, valueIfTrue );
 
     Operand result = m_generator->LogicalNot( operand );
 
-    // Check the returned operand is pointing to the result id string
-    BOOST_REQUIRE( std::holds_alternative< std::string >( result ) );
-    BOOST_CHECK_EQUAL( resultIdToReturn, std::get< std::string >( result ) );
+    // Check the returned operand is pointing to the result id
+    BOOST_REQUIRE( std::holds_alternative< VarId >( result ) );
+    BOOST_CHECK( resultIdToReturn == std::get< VarId >( result ) );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // LogicalNotTests
@@ -893,8 +916,8 @@ BOOST_AUTO_TEST_SUITE( LogicalOrTests )
  */
 BOOST_AUTO_TEST_CASE( LogicalOr_InvalidOperands )
 {
-    BOOST_CHECK_THROW( m_generator->LogicalOr( c_emptyOp, c_stringOp ), std::invalid_argument );
-    BOOST_CHECK_THROW( m_generator->LogicalOr( c_stringOp, c_emptyOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->LogicalOr( c_emptyOp, c_varOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->LogicalOr( c_varOp, c_emptyOp ), std::invalid_argument );
     BOOST_CHECK_THROW( m_generator->LogicalOr( c_emptyOp, c_emptyOp ), std::invalid_argument );
 }
 
@@ -928,26 +951,26 @@ BOOST_AUTO_TEST_CASE( LogicalOr_OneLiteral )
 {
     // True cases - the literal is >0
 
-    Operand trueResult1 = m_generator->LogicalOr( c_literalOp_Five, c_stringOp );
+    Operand trueResult1 = m_generator->LogicalOr( c_literalOp_Five, c_varOp );
     BOOST_REQUIRE( std::holds_alternative< Literal >( trueResult1 ) );
     BOOST_CHECK_EQUAL( c_trueLiteral, std::get< Literal >( trueResult1 ) );
 
-    Operand trueResult2 = m_generator->LogicalOr( c_stringOp, c_literalOp_Two );
+    Operand trueResult2 = m_generator->LogicalOr( c_varOp, c_literalOp_Two );
     BOOST_REQUIRE( std::holds_alternative< Literal >( trueResult2 ) );
     BOOST_CHECK_EQUAL( c_trueLiteral, std::get< Literal >( trueResult2 ) );
 
 
     // Cases where the literal is 0
 
-    Operand op2Return = m_generator->LogicalOr( c_zeroOperand, c_stringOp );
+    Operand op2Return = m_generator->LogicalOr( c_zeroOperand, c_varOp );
     // Expect it to return operand 2 in this case.
-    BOOST_REQUIRE( std::holds_alternative< std::string >( op2Return ) );
-    BOOST_CHECK_EQUAL( std::get< std::string >( c_stringOp ), std::get< std::string >( op2Return ) );
+    BOOST_REQUIRE( std::holds_alternative< VarId >( op2Return ) );
+    BOOST_CHECK( std::get< VarId >( c_varOp ) == std::get< VarId >( op2Return ) );
 
-    Operand op1Return = m_generator->LogicalOr( c_stringOp, c_zeroOperand );
+    Operand op1Return = m_generator->LogicalOr( c_varOp, c_zeroOperand );
     // Expect it to return operand 2 in this case.
-    BOOST_REQUIRE( std::holds_alternative< std::string >( op1Return ) );
-    BOOST_CHECK_EQUAL( std::get< std::string >( c_stringOp ), std::get< std::string >( op1Return ) );
+    BOOST_REQUIRE( std::holds_alternative< VarId >( op1Return ) );
+    BOOST_CHECK( std::get< VarId >( c_varOp ) == std::get< VarId >( op1Return ) );
 }
 
 /**
@@ -957,24 +980,24 @@ BOOST_AUTO_TEST_CASE( LogicalOr_OneLiteral )
 BOOST_AUTO_TEST_CASE( LogicalOr_TwoIdentifiers )
 {
     const Opcode expectedBranchOpcode{ BRLT };
-    const Operand operand1{ c_stringOp };
-    const Operand operand2{ c_stringOp2 };
+    const Operand operand1{ c_varOp };
+    const Operand operand2{ c_varOp2 };
     const Literal valueIfBranchTrue{ c_trueLiteral };
 
     mock::sequence sequence;
 
 
-    const std::string resultId{ "result" };
+    const VarId resultId{ 28u };
     uint8_t initialValue{ valueIfBranchTrue };
     CheckNewTempVarCalls( resultId, initialValue, sequence );
 
-    ExpectAddInstruction( TacInstructionFactory::PLACEHOLDER, expectedBranchOpcode, c_zeroOperand, operand1, sequence );
-    ThreeAddrInstruction::Ptr dummyInstr1 = std::make_shared< ThreeAddrInstruction >( "target", Opcode::OR, "var1", "var2" );
-    MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstruction ).once().in( sequence ).returns( dummyInstr1 );
+    ExpectAddBranchInstruction( TacInstructionFactory::PLACEHOLDER, expectedBranchOpcode, c_zeroOperand, operand1, sequence );
+    size_t dummyIndex1 = MakeDummyUniqueInstrIndex();
+    MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstructionIndex ).once().in( sequence ).returns( dummyIndex1 );
 
-    ExpectAddInstruction( TacInstructionFactory::PLACEHOLDER, expectedBranchOpcode, c_zeroOperand, operand2, sequence );
-    ThreeAddrInstruction::Ptr dummyInstr2 = std::make_shared< ThreeAddrInstruction >( "target", Opcode::OR, "var1", "var2" );
-    MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstruction ).once().in( sequence ).returns( dummyInstr2 );
+    ExpectAddBranchInstruction( TacInstructionFactory::PLACEHOLDER, expectedBranchOpcode, c_zeroOperand, operand2, sequence );
+    size_t dummyIndex2 = MakeDummyUniqueInstrIndex();
+    MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstructionIndex ).once().in( sequence ).returns( dummyIndex2 );
 
     uint8_t nonBranchValue{ static_cast< bool >( !valueIfBranchTrue ) };
     ExpectAddAssignmentInstruction( resultId, nonBranchValue, sequence );
@@ -982,18 +1005,18 @@ BOOST_AUTO_TEST_CASE( LogicalOr_TwoIdentifiers )
     MOCK_EXPECT( m_instructionFactoryMock->SetInstructionBranchToNextLabel )
         .once()
         .in( sequence )
-        .with( dummyInstr1, mock::any );
+        .with( dummyIndex1, mock::any );
     MOCK_EXPECT( m_instructionFactoryMock->SetInstructionBranchToNextLabel )
         .once()
         .in( sequence )
-        .with( dummyInstr2, mock::any );
+        .with( dummyIndex2, mock::any );
 
 
     Operand result = m_generator->LogicalOr( operand1, operand2 );
 
-    // Check the returned operand is pointing to the result id string
-    BOOST_REQUIRE( std::holds_alternative< std::string >( result ) );
-    BOOST_CHECK_EQUAL( resultId, std::get< std::string >( result ) );
+    // Check the returned operand is pointing to the result id
+    BOOST_REQUIRE( std::holds_alternative< VarId >( result ) );
+    BOOST_CHECK( resultId == std::get< VarId >( result ) );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // LogicalOrTests
@@ -1005,8 +1028,8 @@ BOOST_AUTO_TEST_SUITE( LogicalAndTests )
  */
 BOOST_AUTO_TEST_CASE( LogicalAnd_InvalidOperands )
 {
-    BOOST_CHECK_THROW( m_generator->LogicalAnd( c_emptyOp, c_stringOp ), std::invalid_argument );
-    BOOST_CHECK_THROW( m_generator->LogicalAnd( c_stringOp, c_emptyOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->LogicalAnd( c_emptyOp, c_varOp ), std::invalid_argument );
+    BOOST_CHECK_THROW( m_generator->LogicalAnd( c_varOp, c_emptyOp ), std::invalid_argument );
     BOOST_CHECK_THROW( m_generator->LogicalAnd( c_emptyOp, c_emptyOp ), std::invalid_argument );
 }
 
@@ -1042,26 +1065,26 @@ BOOST_AUTO_TEST_CASE( LogicalAnd_OneLiteral )
 {
     // False cases - the literal is 0
 
-    Operand falseResult1 = m_generator->LogicalAnd( c_zeroOperand, c_stringOp );
+    Operand falseResult1 = m_generator->LogicalAnd( c_zeroOperand, c_varOp );
     BOOST_REQUIRE( std::holds_alternative< Literal >( falseResult1 ) );
     BOOST_CHECK_EQUAL( c_falseLiteral, std::get< Literal >( falseResult1 ) );
 
-    Operand falseResult2 = m_generator->LogicalAnd( c_stringOp, c_zeroOperand );
+    Operand falseResult2 = m_generator->LogicalAnd( c_varOp, c_zeroOperand );
     BOOST_REQUIRE( std::holds_alternative< Literal >( falseResult2 ) );
     BOOST_CHECK_EQUAL( c_falseLiteral, std::get< Literal >( falseResult2 ) );
 
 
     // Cases where the literal is >0
 
-    Operand op2Return = m_generator->LogicalAnd( c_literalOp_Two, c_stringOp );
+    Operand op2Return = m_generator->LogicalAnd( c_literalOp_Two, c_varOp );
     // Expect it to return operand 2 in this case.
-    BOOST_REQUIRE( std::holds_alternative< std::string >( op2Return ) );
-    BOOST_CHECK_EQUAL( std::get< std::string >( c_stringOp ), std::get< std::string >( op2Return ) );
+    BOOST_REQUIRE( std::holds_alternative< VarId >( op2Return ) );
+    BOOST_CHECK( std::get< VarId >( c_varOp ) == std::get< VarId >( op2Return ) );
 
-    Operand op1Return = m_generator->LogicalAnd( c_stringOp, c_literalOp_Two );
+    Operand op1Return = m_generator->LogicalAnd( c_varOp, c_literalOp_Two );
     // Expect it to return operand 1 in this case.
-    BOOST_REQUIRE( std::holds_alternative< std::string >( op1Return ) );
-    BOOST_CHECK_EQUAL( std::get< std::string >( c_stringOp ), std::get< std::string >( op1Return ) );
+    BOOST_REQUIRE( std::holds_alternative< VarId >( op1Return ) );
+    BOOST_CHECK( std::get< VarId >( c_varOp ) == std::get< VarId >( op1Return ) );
 }
 
 /**
@@ -1071,24 +1094,24 @@ BOOST_AUTO_TEST_CASE( LogicalAnd_OneLiteral )
 BOOST_AUTO_TEST_CASE( LogicalAnd_TwoIdentifiers )
 {
     const Opcode expectedBranchOpcode{ BRLT };
-    const Operand operand1{ c_stringOp };
-    const Operand operand2{ c_stringOp2 };
+    const Operand operand1{ c_varOp };
+    const Operand operand2{ c_varOp2 };
     const Literal valueIfBranchTrue{ c_falseLiteral };
 
     mock::sequence sequence;
 
 
-    const std::string resultId{ "result" };
+    const VarId resultId{ 29u };
     uint8_t initialValue{ valueIfBranchTrue };
     CheckNewTempVarCalls( resultId, initialValue, sequence );
 
-    ExpectAddInstruction( TacInstructionFactory::PLACEHOLDER, expectedBranchOpcode, c_zeroOperand, operand1, sequence );
-    ThreeAddrInstruction::Ptr dummyInstr1 = std::make_shared< ThreeAddrInstruction >( "target", Opcode::OR, "var1", "var2" );
-    MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstruction ).once().in( sequence ).returns( dummyInstr1 );
+    ExpectAddBranchInstruction( TacInstructionFactory::PLACEHOLDER, expectedBranchOpcode, c_zeroOperand, operand1, sequence );
+    size_t dummyIndex1 = MakeDummyUniqueInstrIndex();
+    MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstructionIndex ).once().in( sequence ).returns( dummyIndex1 );
 
-    ExpectAddInstruction( TacInstructionFactory::PLACEHOLDER, expectedBranchOpcode, c_zeroOperand, operand2, sequence );
-    ThreeAddrInstruction::Ptr dummyInstr2 = std::make_shared< ThreeAddrInstruction >( "target", Opcode::OR, "var1", "var2" );
-    MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstruction ).once().in( sequence ).returns( dummyInstr2 );
+    ExpectAddBranchInstruction( TacInstructionFactory::PLACEHOLDER, expectedBranchOpcode, c_zeroOperand, operand2, sequence );
+    size_t dummyIndex2 = MakeDummyUniqueInstrIndex();
+    MOCK_EXPECT( m_instructionFactoryMock->GetLatestInstructionIndex ).once().in( sequence ).returns( dummyIndex2 );
 
     uint8_t nonBranchValue{ static_cast< bool >( !valueIfBranchTrue ) };
     ExpectAddAssignmentInstruction( resultId, nonBranchValue, sequence );
@@ -1096,18 +1119,18 @@ BOOST_AUTO_TEST_CASE( LogicalAnd_TwoIdentifiers )
     MOCK_EXPECT( m_instructionFactoryMock->SetInstructionBranchToNextLabel )
         .once()
         .in( sequence )
-        .with( dummyInstr1, mock::any );
+        .with( dummyIndex1, mock::any );
     MOCK_EXPECT( m_instructionFactoryMock->SetInstructionBranchToNextLabel )
         .once()
         .in( sequence )
-        .with( dummyInstr2, mock::any );
+        .with( dummyIndex2, mock::any );
 
 
     Operand result = m_generator->LogicalAnd( operand1, operand2 );
 
-    // Check the returned operand is pointing to the result id string
-    BOOST_REQUIRE( std::holds_alternative< std::string >( result ) );
-    BOOST_CHECK_EQUAL( resultId, std::get< std::string >( result ) );
+    // Check the returned operand is pointing to the result id
+    BOOST_REQUIRE( std::holds_alternative< VarId >( result ) );
+    BOOST_CHECK( resultId == std::get< VarId >( result ) );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // LogicalAndTests
@@ -9,17 +9,18 @@ MOCK_BASE_CLASS( TacInstructionFactoryMock, TacInstructionFactory )
 {
     using Ptr = std::shared_ptr< TacInstructionFactoryMock >;
 
-    MOCK_METHOD( GetNewTempVar, 1, std::string( std::string ) );
-    MOCK_METHOD( GetNewLabel, 1, std::string( std::string ) );
+    MOCK_METHOD( GetNewTempVar, 1, VarId( std::string ) );
+    MOCK_METHOD( GetNewLabel, 1, LabelId( std::string ) );
 
-    MOCK_METHOD( SetNextInstructionLabel, 1, void( const std::string& ) );
+    MOCK_METHOD( SetNextInstructionLabel, 1, void( LabelId ) );
 
-    MOCK_METHOD( AddInstruction, 4, void( std::string, Opcode, Operand, Operand ) );
-    MOCK_METHOD( AddSingleOperandInstruction, 3, void( std::string, Opcode, Operand ) );
-    MOCK_METHOD( AddAssignmentInstruction, 2, void( std::string, Operand ) );
+    MOCK_METHOD( AddInstruction, 4, void( VarId, Opcode, Operand, Operand ) );
+    MOCK_METHOD( AddBranchInstruction, 4, void( LabelId, Opcode, Operand, Operand ) );
+    MOCK_METHOD( AddSingleOperandInstruction, 3, void( VarId, Opcode, Operand ) );
+    MOCK_METHOD( AddAssignmentInstruction, 2, void( VarId, Operand ) );
 
-    MOCK_METHOD( SetInstructionBranchToNextLabel, 2, void( ThreeAddrInstruction::Ptr, std::string ) );
+    MOCK_METHOD( SetInstructionBranchToNextLabel, 2, void( size_t, std::string ) );
 
-    MOCK_METHOD( GetLatestInstruction, 0, ThreeAddrInstruction::Ptr( void ) );
-    MOCK_METHOD( GetInstructions, 0, TacInstructionFactory::Instructions( void ) );
+    MOCK_METHOD( GetLatestInstructionIndex, 0, size_t( void ) );
+    MOCK_METHOD( GetInstructions, 0, const TacInstructionFactory::Instructions&( void ) );
 };
\ No newline at end of file
@@ -16,23 +16,64 @@ class TacInstrFactoryTestsFixture
 {
 public:
     TacInstrFactoryTestsFixture()
-    : m_instructionFactory( std::make_shared< InstructionFactory_Test >() )
+    : m_instructionFactory( std::make_shared< InstructionFactory_Test >() ),
+      m_target( AddTestVariable( "target" ) ),
+      m_op1( AddTestVariable( "op1" ) ),
+      m_op2( AddTestVariable( "op2" ) )
     {};
 
+    // Adds a variable to the factory's variable table, to use in test instructions.
+    VarId AddTestVariable( const std::string& name )
+    {
+        return m_instructionFactory->GetVariableTable()->AddVariable( name );
+    }
+
     InstructionFactory_Test::Ptr m_instructionFactory;
+
+    // Test variables, used as instruction targets and operands.
+    VarId m_target;
+    VarId m_op1;
+    VarId m_op2;
 };
 
 BOOST_FIXTURE_TEST_SUITE( TacInstructionFactoryTests, TacInstrFactoryTestsFixture )
 
 /**
- * Tests that the method for getting a new temp variable will start at 0, and increment 1 at a time.
+ * Tests that the method for getting a new temp variable will add it to the variable table, continuing on from the IDs
+ * already allocated and incrementing 1 at a time.
  */
 BOOST_AUTO_TEST_CASE( GetNewTempVar )
 {
-    BOOST_CHECK_EQUAL( "0temp", m_instructionFactory->GetNewTempVar() );
+    const VariableTable::Ptr& variableTable = m_instructionFactory->GetVariableTable();
+    BOOST_REQUIRE_EQUAL( 3u, variableTable->GetNumVariables() );
+
+    const VarId temp0 = m_instructionFactory->GetNewTempVar();
     const std::string tempName = "testName";
-    BOOST_CHECK_EQUAL( "1" + tempName, m_instructionFactory->GetNewTempVar( tempName ) );
-    BOOST_CHECK_EQUAL( "2temp", m_instructionFactory->GetNewTempVar() );
+    const VarId temp1 = m_instructionFactory->GetNewTempVar( tempName );
+    const VarId temp2 = m_instructionFactory->GetNewTempVar();
+
+    BOOST_CHECK_EQUAL( 3u, static_cast< uint32_t >( temp0 ) );
+    BOOST_CHECK_EQUAL( 4u, static_cast< uint32_t >( temp1 ) );
+    BOOST_CHECK_EQUAL( 5u, static_cast< uint32_t >( temp2 ) );
+    BOOST_CHECK_EQUAL( "temp", variableTable->GetName( temp0 ) );
+    BOOST_CHECK_EQUAL( tempName, variableTable->GetName( temp1 ) );
+    BOOST_CHECK_EQUAL( "temp", variableTable->GetName( temp2 ) );
+}
+
+/**
+ * Tests that the factory adds temporary variables to a variable table passed on construction.
+ */
+BOOST_AUTO_TEST_CASE( GetNewTempVar_SharedTable )
+{
+    VariableTable::Ptr variableTable = std::make_shared< VariableTable >();
+    const VarId existingVar = variableTable->AddVariable( "existing" );
+    InstructionFactory_Test factory( variableTable );
+
+    BOOST_CHECK( variableTable == factory.GetVariableTable() );
+    const VarId temp = factory.GetNewTempVar();
+    BOOST_CHECK( existingVar != temp );
+    BOOST_CHECK_EQUAL( 2u, variableTable->GetNumVariables() );
+    BOOST_CHECK_EQUAL( "temp", variableTable->GetName( temp ) );
 }
 
 /**
@@ -40,21 +81,37 @@ BOOST_AUTO_TEST_CASE( GetNewTempVar )
  */
 BOOST_AUTO_TEST_CASE( GetNewLabel )
 {
-    BOOST_CHECK_EQUAL( "0label", m_instructionFactory->GetNewLabel() );
-    BOOST_CHECK_EQUAL( "1label", m_instructionFactory->GetNewLabel() );
+    const LabelId label0 = m_instructionFactory->GetNewLabel();
+    const LabelId label1 = m_instructionFactory->GetNewLabel();
     const std::string tempLabel = "testLabel";
-    BOOST_CHECK_EQUAL( "2" + tempLabel, m_instructionFactory->GetNewLabel( tempLabel ) );
+    const LabelId label2 = m_instructionFactory->GetNewLabel( tempLabel );
+
+    BOOST_CHECK_EQUAL( 0u, static_cast< uint32_t >( label0 ) );
+    BOOST_CHECK_EQUAL( 1u, static_cast< uint32_t >( label1 ) );
+    BOOST_CHECK_EQUAL( 2u, static_cast< uint32_t >( label2 ) );
+    BOOST_CHECK_EQUAL( "label", m_instructionFactory->GetLabelName( label0 ) );
+    BOOST_CHECK_EQUAL( tempLabel, m_instructionFactory->GetLabelName( label2 ) );
 }
 
 /**
- * Tests that the method for getting the next instruction label returns an empty string if one has not been set.
+ * Tests that the method for getting a label's name throws if the label wasn't created by the factory.
+ */
+BOOST_AUTO_TEST_CASE( GetLabelName_UnknownLabel )
+{
+    m_instructionFactory->GetNewLabel();
+    BOOST_CHECK_THROW( m_instructionFactory->GetLabelName( LabelId{ 1u } ), std::out_of_range );
+    BOOST_CHECK_THROW( m_instructionFactory->GetLabelName( g_invalidLabelId ), std::out_of_range );
+}
+
+/**
+ * Tests that the next instruction label is invalid until one has been set.
  */
 BOOST_AUTO_TEST_CASE( SetNextLabel )
 {
-    BOOST_CHECK_EQUAL( "", m_instructionFactory->m_nextInstrLabel );
-    const std::string testLabel = "testLabel";
+    BOOST_CHECK( g_invalidLabelId == m_instructionFactory->m_nextInstrLabel );
+    const LabelId testLabel = m_instructionFactory->GetNewLabel( "testLabel" );
     m_instructionFactory->SetNextInstructionLabel( testLabel );
-    BOOST_CHECK_EQUAL( testLabel, m_instructionFactory->m_nextInstrLabel );
+    BOOST_CHECK( testLabel == m_instructionFactory->m_nextInstrLabel );
 }
 
 /**
@@ -62,8 +119,8 @@ BOOST_AUTO_TEST_CASE( SetNextLabel )
  */
 BOOST_AUTO_TEST_CASE( SetNextLabel_AlreadyExists )
 {
-    BOOST_CHECK_EQUAL( "", m_instructionFactory->m_nextInstrLabel );
-    const std::string testLabel = "testLabel";
+    BOOST_CHECK( g_invalidLabelId == m_instructionFactory->m_nextInstrLabel );
+    const LabelId testLabel = m_instructionFactory->GetNewLabel( "testLabel" );
     m_instructionFactory->SetNextInstructionLabel( testLabel );
     BOOST_CHECK_THROW( m_instructionFactory->SetNextInstructionLabel( testLabel ), std::runtime_error );
 }
@@ -78,27 +135,23 @@ BOOST_AUTO_TEST_CASE( AddInstruction_Identifiers )
 {
     BOOST_CHECK_EQUAL( 0u, m_instructionFactory->m_instructions.size() );
 
-    const std::string target{ "target" };
     constexpr Opcode opcode{ ADD };
-    const std::string op1String{ "op1" };
-    const Operand operand1{ op1String };
-    const std::string op2String{ "op2" };
-    const Operand operand2{ op2String };
+    const Operand operand1{ m_op1 };
+    const Operand operand2{ m_op2 };
 
-    m_instructionFactory->AddInstruction( target, opcode, operand1, operand2 );
+    m_instructionFactory->AddInstruction( m_target, opcode, operand1, operand2 );
 
     BOOST_REQUIRE_EQUAL( 1u, m_instructionFactory->m_instructions.size() );
-    ThreeAddrInstruction::Ptr instruction = m_instructionFactory->m_instructions[0];
+    const ThreeAddrInstruction& instruction = m_instructionFactory->m_instructions[0];
 
-    BOOST_CHECK_EQUAL( target, instruction->m_target );
+    BOOST_CHECK( m_target == instruction.m_target );
 
-    BOOST_REQUIRE( instruction->IsOperation() );
-    Operation::Ptr rhsOperation = instruction->GetOperation();
-    BOOST_CHECK_EQUAL( opcode, rhsOperation->opcode );
-    BOOST_CHECK_EQUAL( op1String, rhsOperation->operand1 );
-    BOOST_CHECK_EQUAL( op2String, rhsOperation->operand2 );
+    BOOST_REQUIRE( instruction.IsOperation() );
+    BOOST_CHECK_EQUAL( opcode, instruction.m_opcode );
+    BOOST_CHECK( m_op1 == instruction.m_operand1 );
+    BOOST_CHECK( m_op2 == instruction.m_operand2 );
 
-    BOOST_CHECK_EQUAL( "", instruction->m_label );
+    BOOST_CHECK( g_invalidLabelId == instruction.m_label );
 }
 
 /**
@@ -109,66 +162,60 @@ BOOST_AUTO_TEST_CASE( AddInstruction_NonZeroLiteralOperand )
 {
     BOOST_CHECK_EQUAL( 0u, m_instructionFactory->m_instructions.size() );
 
-    const std::string target{ "target" };
     constexpr Opcode opcode{ ADD };
     constexpr Literal literalValue{ 5u };
     const Operand operand1{ literalValue };
-    const std::string op2String{ "op2" };
-    const Operand operand2{ op2String };
+    const Operand operand2{ m_op2 };
 
-    m_instructionFactory->AddInstruction( target, opcode, operand1, operand2 );
+    m_instructionFactory->AddInstruction( m_target, opcode, operand1, operand2 );
 
     // Expect 2 instructions to have been added - one assignment before the actual instruction.
     BOOST_REQUIRE_EQUAL( 2u, m_instructionFactory->m_instructions.size() );
 
-    ThreeAddrInstruction::Ptr assignmentInstr = m_instructionFactory->m_instructions[0];
-    std::string tempVar = assignmentInstr->m_target;
-    BOOST_REQUIRE( !assignmentInstr->IsOperation() );
-    Operand rhsOperand = std::get< Operand >( assignmentInstr->m_rhs );
+    const ThreeAddrInstruction& assignmentInstr = m_instructionFactory->m_instructions[0];
+    VarId tempVar = assignmentInstr.m_target;
+    BOOST_REQUIRE( !assignmentInstr.IsOperation() );
+    Operand rhsOperand = assignmentInstr.GetAssignedValue();
     BOOST_REQUIRE( std::holds_alternative< Literal >( rhsOperand ) );
     BOOST_CHECK_EQUAL( literalValue, std::get< Literal >( rhsOperand ) );
 
 
-    ThreeAddrInstruction::Ptr instruction = m_instructionFactory->m_instructions[1];
-    BOOST_CHECK_EQUAL( target, instruction->m_target );
+    const ThreeAddrInstruction& instruction = m_instructionFactory->m_instructions[1];
+    BOOST_CHECK( m_target == instruction.m_target );
 
-    BOOST_REQUIRE( instruction->IsOperation() );
-    Operation::Ptr rhsOperation = instruction->GetOperation();
-    BOOST_CHECK_EQUAL( opcode, rhsOperation->opcode );
-    BOOST_CHECK_EQUAL( tempVar, rhsOperation->operand1 );
-    BOOST_CHECK_EQUAL( op2String, rhsOperation->operand2 );
+    BOOST_REQUIRE( instruction.IsOperation() );
+    BOOST_CHECK_EQUAL( opcode, instruction.m_opcode );
+    BOOST_CHECK( tempVar == instruction.m_operand1 );
+    BOOST_CHECK( m_op2 == instruction.m_operand2 );
 
-    BOOST_CHECK_EQUAL( "", instruction->m_label );
+    BOOST_CHECK( g_invalidLabelId == instruction.m_label );
 }
 
 /**
- * Tests that the method for adding an instruction will swap any zero literal operands for an empty string when
+ * Tests that the method for adding an instruction will swap any zero literal operands for an empty operand when
  * creating the instruction.
  */
 BOOST_AUTO_TEST_CASE( AddInstruction_ZeroLiteralOperand )
 {
     BOOST_CHECK_EQUAL( 0u, m_instructionFactory->m_instructions.size() );
 
-    const std::string target{ "target" };
     constexpr Opcode opcode{ ADD };
-    const std::string op1String{ "op1" };
-    const Operand operand1{ op1String };
-    const Operand operand2{ 0u };
+    const Operand operand1{ m_op1 };
+    const Operand operand2{ Literal{ 0u } };
 
-    m_instructionFactory->AddInstruction( target, opcode, operand1, operand2 );
+    m_instructionFactory->AddInstruction( m_target, opcode, operand1, operand2 );
 
     BOOST_REQUIRE_EQUAL( 1u, m_instructionFactory->m_instructions.size() );
-    ThreeAddrInstruction::Ptr instruction = m_instructionFactory->m_instructions[0];
+    const ThreeAddrInstruction& instruction = m_instructionFactory->m_instructions[0];
 
-    BOOST_CHECK_EQUAL( target, instruction->m_target );
+    BOOST_CHECK( m_target == instruction.m_target );
 
-    BOOST_REQUIRE( instruction->IsOperation() );
-    Operation::Ptr rhsOperation = instruction->GetOperation();
-    BOOST_CHECK_EQUAL( opcode, rhsOperation->opcode );
-    BOOST_CHECK_EQUAL( op1String, rhsOperation->operand1 );
-    BOOST_CHECK( ThreeAddrInstruction::IsOperandEmpty( rhsOperation->operand2 ) );
+    BOOST_REQUIRE( instruction.IsOperation() );
+    BOOST_CHECK_EQUAL( opcode, instruction.m_opcode );
+    BOOST_CHECK( m_op1 == instruction.m_operand1 );
+    BOOST_CHECK( g_invalidVarId == instruction.m_operand2 );
 
-    BOOST_CHECK_EQUAL( "", instruction->m_label );
+    BOOST_CHECK( g_invalidLabelId == instruction.m_label );
 }
 
 /**
@@ -179,30 +226,62 @@ BOOST_AUTO_TEST_CASE( AddInstruction_PreSetLabel )
 {
     BOOST_CHECK_EQUAL( 0u, m_instructionFactory->m_instructions.size() );
 
-    const std::string label{ "label" };
+    const LabelId label = m_instructionFactory->GetNewLabel();
     m_instructionFactory->SetNextInstructionLabel( label );
 
-    const std::string target{ "target" };
     constexpr Opcode opcode{ ADD };
-    const std::string op1String{ "op1" };
-    const Operand operand1{ op1String };
-    const std::string op2String{ "op2" };
-    const Operand operand2{ op2String };
+    const Operand operand1{ m_op1 };
+    const Operand operand2{ m_op2 };
+
+    m_instructionFactory->AddInstruction( m_target, opcode, operand1, operand2 );
+
+    BOOST_REQUIRE_EQUAL( 1u, m_instructionFactory->m_instructions.size() );
+    const ThreeAddrInstruction& instruction = m_instructionFactory->m_instructions[0];
 
-    m_instructionFactory->AddInstruction( target, opcode, operand1, operand2 );
+    BOOST_CHECK( m_target == instruction.m_target );
+
+    BOOST_REQUIRE( instruction.IsOperation() );
+    BOOST_CHECK_EQUAL( opcode, instruction.m_opcode );
+    BOOST_CHECK( m_op1 == instruction.m_operand1 );
+    BOOST_CHECK( m_op2 == instruction.m_operand2 );
+
+    BOOST_CHECK( label == instruction.m_label );
+}
+
+/**
+ * Tests that the method for adding a branch instruction successfully creates one targeting the given label, and adds
+ * it to the instructions storage.
+ */
+BOOST_AUTO_TEST_CASE( AddBranchInstruction )
+{
+    BOOST_CHECK_EQUAL( 0u, m_instructionFactory->m_instructions.size() );
+
+    const LabelId branchTarget = m_instructionFactory->GetNewLabel();
+    constexpr Opcode opcode{ BRE };
+    m_instructionFactory->AddBranchInstruction( branchTarget, opcode, m_op1, m_op2 );
 
     BOOST_REQUIRE_EQUAL( 1u, m_instructionFactory->m_instructions.size() );
-    ThreeAddrInstruction::Ptr instruction = m_instructionFactory->m_instructions[0];
+    const ThreeAddrInstruction& instruction = m_instructionFactory->m_instructions[0];
+    BOOST_CHECK( branchTarget == instruction.m_branchTarget );
+    BOOST_CHECK( g_invalidVarId == instruction.m_target );
 
-    BOOST_CHECK_EQUAL( target, instruction->m_target );
+    BOOST_REQUIRE( instruction.IsOperation() );
+    BOOST_CHECK_EQUAL( opcode, instruction.m_opcode );
+    BOOST_CHECK( m_op1 == instruction.m_operand1 );
+    BOOST_CHECK( m_op2 == instruction.m_operand2 );
 
-    BOOST_REQUIRE( instruction->IsOperation() );
-    Operation::Ptr rhsOperation = instruction->GetOperation();
-    BOOST_CHECK_EQUAL( opcode, rhsOperation->opcode );
-    BOOST_CHECK_EQUAL( op1String, rhsOperation->operand1 );
-    BOOST_CHECK_EQUAL( op2String, rhsOperation->operand2 );
+    BOOST_CHECK( g_invalidLabelId == instruction.m_label );
+}
 
-    BOOST_CHECK_EQUAL( label, instruction->m_label );
+/**
+ * Tests that the method for adding a branch instruction throws if given a non-branch opcode.
+ */
+BOOST_AUTO_TEST_CASE( AddBranchInstruction_NonBranchOpcode )
+{
+    const LabelId branchTarget = m_instructionFactory->GetNewLabel();
+    BOOST_CHECK_THROW( m_instructionFactory->AddBranchInstruction( branchTarget, ADD, m_op1, m_op2 ),
+                       std::invalid_argument );
+    BOOST_CHECK_EQUAL( 0u, m_instructionFactory->m_instructions.size() );
 }
 
 /**
@@ -213,23 +292,20 @@ BOOST_AUTO_TEST_CASE( AddSingleOperandInstruction )
 {
     BOOST_CHECK_EQUAL( 0u, m_instructionFactory->m_instructions.size() );
 
-    const std::string target{ "target" };
     constexpr Opcode opcode{ ADD };
-    const std::string operandString{ "op1" };
-    const Operand operand{ operandString };
-    m_instructionFactory->AddSingleOperandInstruction( target, opcode, operand );
+    const Operand operand{ m_op1 };
+    m_instructionFactory->AddSingleOperandInstruction( m_target, opcode, operand );
 
     BOOST_REQUIRE_EQUAL( 1u, m_instructionFactory->m_instructions.size() );
-    ThreeAddrInstruction::Ptr instruction = m_instructionFactory->m_instructions[0];
-    BOOST_CHECK_EQUAL( target, instruction->m_target );
+    const ThreeAddrInstruction& instruction = m_instructionFactory->m_instructions[0];
+    BOOST_CHECK( m_target == instruction.m_target );
 
-    BOOST_CHECK( instruction->IsOperation() );
-    Operation::Ptr rhsOperation = instruction->GetOperation();
-    BOOST_CHECK_EQUAL( opcode, rhsOperation->opcode );
-    BOOST_CHECK_EQUAL( operandString, rhsOperation->operand1 );
-    BOOST_CHECK( ThreeAddrInstruction::IsOperandEmpty( rhsOperation->operand2 ) );
+    BOOST_CHECK( instruction.IsOperation() );
+    BOOST_CHECK_EQUAL( opcode, instruction.m_opcode );
+    BOOST_CHECK( m_op1 == instruction.m_operand1 );
+    BOOST_CHECK( g_invalidVarId == instruction.m_operand2 );
 
-    BOOST_CHECK_EQUAL( "", instruction->m_label );
+    BOOST_CHECK( g_invalidLabelId == instruction.m_label );
 }
 
 /**
@@ -240,29 +316,83 @@ BOOST_AUTO_TEST_CASE( AddAssignmentInstruction )
 {
     BOOST_CHECK_EQUAL( 0u, m_instructionFactory->m_instructions.size() );
 
-    const std::string target{ "target" };
-    const Operand operand{ "op1" };
-    m_instructionFactory->AddAssignmentInstruction( target, operand );
+    const Operand operand{ m_op1 };
+    m_instructionFactory->AddAssignmentInstruction( m_target, operand );
+
+    BOOST_REQUIRE_EQUAL( 1u, m_instructionFactory->m_instructions.size() );
+    const ThreeAddrInstruction& instruction = m_instructionFactory->m_instructions[0];
+    BOOST_CHECK( m_target == instruction.m_target );
+
+    BOOST_CHECK( !instruction.IsOperation() );
+    BOOST_CHECK( operand == instruction.GetAssignedValue() );
+
+    BOOST_CHECK( g_invalidLabelId == instruction.m_label );
+}
+
+/**
+ * Tests that the method for adding an assignment instruction stores a literal value in the instruction itself.
+ */
+BOOST_AUTO_TEST_CASE( AddAssignmentInstruction_Literal )
+{
+    constexpr Literal literalValue{ 5u };
+    m_instructionFactory->AddAssignmentInstruction( m_target, Operand{ literalValue } );
 
     BOOST_REQUIRE_EQUAL( 1u, m_instructionFactory->m_instructions.size() );
-    ThreeAddrInstruction::Ptr instruction = m_instructionFactory->m_instructions[0];
-    BOOST_CHECK_EQUAL( target, instruction->m_target );
+    const ThreeAddrInstruction& instruction = m_instructionFactory->m_instructions[0];
+    BOOST_CHECK( m_target == instruction.m_target );
 
-    BOOST_CHECK( !instruction->IsOperation() );
-    Operand rhs = std::get< Operand >( instruction->m_rhs );
-    BOOST_CHECK( operand == rhs );
+    BOOST_CHECK( !instruction.IsOperation() );
+    BOOST_CHECK( instruction.m_flags & ThreeAddrInstruction::FLAG_LITERAL_RHS );
+    BOOST_CHECK_EQUAL( literalValue, instruction.m_literal );
+    BOOST_CHECK( g_invalidVarId == instruction.m_operand1 );
+
+    Operand rhsOperand = instruction.GetAssignedValue();
+    BOOST_REQUIRE( std::holds_alternative< Literal >( rhsOperand ) );
+    BOOST_CHECK_EQUAL( literalValue, std::get< Literal >( rhsOperand ) );
+}
+
+/**
+ * Tests that getting the assigned value of an operation instruction throws an exception.
+ */
+BOOST_AUTO_TEST_CASE( GetAssignedValue_Operation )
+{
+    m_instructionFactory->AddInstruction( m_target, ADD, m_op1, m_op2 );
 
-    BOOST_CHECK_EQUAL( "", instruction->m_label );
+    BOOST_REQUIRE_EQUAL( 1u, m_instructionFactory->m_instructions.size() );
+    BOOST_CHECK_THROW( m_instructionFactory->m_instructions[0].GetAssignedValue(), std::invalid_argument );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // AddInstructionTests
 
 /**
- * Tests that the method for pointing a branch instruction to the end will throw if given a nullptr instruction.
+ * Tests that the method for getting the latest instruction returns the index of the last instruction added.
  */
-BOOST_AUTO_TEST_CASE( SetInstructionBranchToEndLabel_NullptrInstr )
+BOOST_AUTO_TEST_CASE( GetLatestInstructionIndex )
 {
-    BOOST_CHECK_THROW( m_instructionFactory->SetInstructionBranchToNextLabel( nullptr, "" ), std::invalid_argument );
+    m_instructionFactory->AddAssignmentInstruction( m_target, m_op1 );
+    BOOST_CHECK_EQUAL( 0u, m_instructionFactory->GetLatestInstructionIndex() );
+    m_instructionFactory->AddAssignmentInstruction( m_target, m_op2 );
+    BOOST_CHECK_EQUAL( 1u, m_instructionFactory->GetLatestInstructionIndex() );
+}
+
+/**
+ * Tests that the method for getting the latest instruction throws if no instructions have been added.
+ */
+BOOST_AUTO_TEST_CASE( GetLatestInstructionIndex_NoInstructions )
+{
+    BOOST_CHECK_THROW( m_instructionFactory->GetLatestInstructionIndex(), std::runtime_error );
+}
+
+/**
+ * Tests that the method for pointing a branch instruction to the end will throw if given an index past the end of the
+ * instructions.
+ */
+BOOST_AUTO_TEST_CASE( SetInstructionBranchToEndLabel_IndexOutOfRange )
+{
+    BOOST_CHECK_THROW( m_instructionFactory->SetInstructionBranchToNextLabel( 0u, "" ), std::invalid_argument );
+
+    m_instructionFactory->AddBranchInstruction( TacInstructionFactory::PLACEHOLDER, BRE, m_op1, m_op1 );
+    BOOST_CHECK_THROW( m_instructionFactory->SetInstructionBranchToNextLabel( 1u, "" ), std::invalid_argument );
 }
 
 /**
@@ -270,12 +400,11 @@ BOOST_AUTO_TEST_CASE( SetInstructionBranchToEndLabel_NullptrInstr )
  */
 BOOST_AUTO_TEST_CASE( SetInstructionBranchToEndLabel_NonBranchInstr )
 {
-    const std::string target{ "target" };
     constexpr Opcode opcode{ LS }; // Non-branch opcode
-    const std::string operand{ "value" };
 
-    ThreeAddrInstruction::Ptr instr = std::make_shared< ThreeAddrInstruction >( target, opcode, operand, operand );
-    BOOST_CHECK_THROW( m_instructionFactory->SetInstructionBranchToNextLabel( instr, "" ), std::invalid_argument );
+    m_instructionFactory->AddInstruction( m_target, opcode, m_op1, m_op1 );
+    const size_t instrIndex = m_instructionFactory->GetLatestInstructionIndex();
+    BOOST_CHECK_THROW( m_instructionFactory->SetInstructionBranchToNextLabel( instrIndex, "" ), std::invalid_argument );
 }
 
 /**
@@ -284,20 +413,21 @@ BOOST_AUTO_TEST_CASE( SetInstructionBranchToEndLabel_NonBranchInstr )
  */
 BOOST_AUTO_TEST_CASE( SetInstructionBranchToEndLabel_CreatesNewEndLabel )
 {
-    const std::string placeholderTarget{ TacInstructionFactory::PLACEHOLDER };
+    constexpr LabelId placeholderTarget{ TacInstructionFactory::PLACEHOLDER };
     constexpr Opcode opcode{ BRE };
-    const std::string operand{ "value" }; // Operands don't matter for this test
-
-    ThreeAddrInstruction::Ptr instr
-        = std::make_shared< ThreeAddrInstruction >( placeholderTarget, opcode, operand, operand );
-
-    BOOST_REQUIRE_EQUAL( "", m_instructionFactory->m_nextInstrLabel );
-    BOOST_REQUIRE_EQUAL( placeholderTarget, instr->m_target );
-    m_instructionFactory->SetInstructionBranchToNextLabel( instr, "end" );
-
-    std::string endLabel = m_instructionFactory->m_nextInstrLabel;
-    BOOST_CHECK_NE( "", endLabel );
-    BOOST_CHECK_EQUAL( endLabel, instr->m_target );
+    // Operands don't matter for this test
+    m_instructionFactory->AddBranchInstruction( placeholderTarget, opcode, m_op1, m_op1 );
+    const size_t instrIndex = m_instructionFactory->GetLatestInstructionIndex();
+    const ThreeAddrInstruction& instr = m_instructionFactory->m_instructions[instrIndex];
+
+    BOOST_REQUIRE( g_invalidLabelId == m_instructionFactory->m_nextInstrLabel );
+    BOOST_REQUIRE( placeholderTarget == instr.m_branchTarget );
+    m_instructionFactory->SetInstructionBranchToNextLabel( instrIndex, "end" );
+
+    LabelId endLabel = m_instructionFactory->m_nextInstrLabel;
+    BOOST_CHECK( g_invalidLabelId != endLabel );
+    BOOST_CHECK_EQUAL( "end", m_instructionFactory->GetLabelName( endLabel ) );
+    BOOST_CHECK( endLabel == instr.m_branchTarget );
 }
 
 /**
@@ -306,23 +436,23 @@ BOOST_AUTO_TEST_CASE( SetInstructionBranchToEndLabel_CreatesNewEndLabel )
  */
 BOOST_AUTO_TEST_CASE( SetInstructionBranchToEndLabel_ExistingEndLabel )
 {
-    const std::string placeholderTarget{ TacInstructionFactory::PLACEHOLDER };
+    constexpr LabelId placeholderTarget{ TacInstructionFactory::PLACEHOLDER };
     constexpr Opcode opcode{ BRE };
-    const std::string operand{ "value" }; // Operands don't matter for this test
+    // Operands don't matter for this test
+    m_instructionFactory->AddBranchInstruction( placeholderTarget, opcode, m_op1, m_op1 );
+    const size_t instrIndex = m_instructionFactory->GetLatestInstructionIndex();
+    const ThreeAddrInstruction& instr = m_instructionFactory->m_instructions[instrIndex];
+    BOOST_REQUIRE( placeholderTarget == instr.m_branchTarget );
 
-    ThreeAddrInstruction::Ptr instr
-        = std::make_shared< ThreeAddrInstruction >( placeholderTarget, opcode, operand, operand );
-    BOOST_REQUIRE_EQUAL( placeholderTarget, instr->m_target );
-
-    const std::string predefinedEndLabel{ "endLabel" };
+    const LabelId predefinedEndLabel = m_instructionFactory->GetNewLabel( "endLabel" );
     m_instructionFactory->SetNextInstructionLabel( predefinedEndLabel );
-    BOOST_REQUIRE_EQUAL( predefinedEndLabel, m_instructionFactory->m_nextInstrLabel );
+    BOOST_REQUIRE( predefinedEndLabel == m_instructionFactory->m_nextInstrLabel );
 
-    m_instructionFactory->SetInstructionBranchToNextLabel( instr, "end" );
+    m_instructionFactory->SetInstructionBranchToNextLabel( instrIndex, "end" );
 
     // Check the 'next label' has not been changed since it was already set to a value.
-    BOOST_CHECK_EQUAL( predefinedEndLabel, m_instructionFactory->m_nextInstrLabel );
-    BOOST_CHECK_EQUAL( predefinedEndLabel, instr->m_target );
+    BOOST_CHECK( predefinedEndLabel == m_instructionFactory->m_nextInstrLabel );
+    BOOST_CHECK( predefinedEndLabel == instr.m_branchTarget );
 }
 
 /**
@@ -331,19 +461,17 @@ BOOST_AUTO_TEST_CASE( SetInstructionBranchToEndLabel_ExistingEndLabel )
 BOOST_AUTO_TEST_CASE( GetInstructions )
 {
     // Populate with some instructions
-    const std::string target{ "target" };
-    const Operand operand{ "op1" };
-    m_instructionFactory->AddAssignmentInstruction( target, operand );
-    m_instructionFactory->AddAssignmentInstruction( target, operand );
-    const std::string target2{ "target2" };
-    const Operand operand2{ "op2" };
+    const Operand operand{ m_op1 };
+    m_instructionFactory->AddAssignmentInstruction( m_target, operand );
+    m_instructionFactory->AddAssignmentInstruction( m_target, operand );
+    const VarId target2 = AddTestVariable( "target2" );
+    const Operand operand2{ m_op2 };
     m_instructionFactory->AddAssignmentInstruction( target2, operand2 );
 
-    TacInstructionFactory::Instructions instructions = m_instructionFactory->GetInstructions();
-    BOOST_CHECK_EQUAL_COLLECTIONS( instructions.begin(),
-                                   instructions.end(),
-                                   m_instructionFactory->m_instructions.begin(),
-                                   m_instructionFactory->m_instructions.end() );
+    // The instructions are returned by reference, rather than copied out of the factory.
+    const TacInstructionFactory::Instructions& instructions = m_instructionFactory->GetInstructions();
+    BOOST_CHECK( &m_instructionFactory->m_instructions == &instructions );
+    BOOST_CHECK_EQUAL( 3u, instructions.size() );
 }
 
 /**
@@ -352,27 +480,22 @@ BOOST_AUTO_TEST_CASE( GetInstructions )
  */
 BOOST_AUTO_TEST_CASE( GetInstructions_AddsInstrOnEnd )
 {
-    const std::string target{ "target" };
-    const Operand operand{ "op1" };
-    m_instructionFactory->AddAssignmentInstruction( target, operand );
+    const Operand operand{ m_op1 };
+    m_instructionFactory->AddAssignmentInstruction( m_target, operand );
 
-    const std::string label{ "label" };
+    const LabelId label = m_instructionFactory->GetNewLabel();
     m_instructionFactory->SetNextInstructionLabel( label );
 
     BOOST_CHECK_EQUAL( 1u, m_instructionFactory->m_instructions.size() );
-    TacInstructionFactory::Instructions instructions = m_instructionFactory->GetInstructions();
+    const TacInstructionFactory::Instructions& instructions = m_instructionFactory->GetInstructions();
     BOOST_CHECK_EQUAL( 2u, m_instructionFactory->m_instructions.size() );
+    BOOST_CHECK( &m_instructionFactory->m_instructions == &instructions );
 
-    BOOST_CHECK_EQUAL_COLLECTIONS( instructions.begin(),
-                                   instructions.end(),
-                                   m_instructionFactory->m_instructions.begin(),
-                                   m_instructionFactory->m_instructions.end() );
-
-    ThreeAddrInstruction::Ptr fillerInstr = instructions[1];
+    const ThreeAddrInstruction& fillerInstr = instructions[1];
     // Expect assignment to 0, with the correct label.
-    BOOST_CHECK_EQUAL( label, fillerInstr->m_label );
-    BOOST_REQUIRE( !fillerInstr->IsOperation() );
-    Operand rhsOperand = std::get< Operand >( fillerInstr->m_rhs );
+    BOOST_CHECK( label == fillerInstr.m_label );
+    BOOST_REQUIRE( !fillerInstr.IsOperation() );
+    Operand rhsOperand = fillerInstr.GetAssignedValue();
     BOOST_REQUIRE( std::holds_alternative< Literal >( rhsOperand ) );
     const Literal expectedValue{ 0u };
     BOOST_CHECK_EQUAL( expectedValue, std::get< Literal >( rhsOperand ) );
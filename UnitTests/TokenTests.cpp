@@ -9,13 +9,26 @@ BOOST_AUTO_TEST_CASE( EqualTokens )
     std::string tokenStringValue = "hello";
 
     // Create 2 tokens using the same initialising values
-    TokenValue::Ptr tokenValue1 = std::make_shared<TokenValue>( tokenStringValue );
-    Token::Ptr token1 = std::make_shared<Token>( tokenType, tokenValue1 );
+    TokenValue tokenValue1 = TokenValue( tokenStringValue );
+    Token token1 = Token( tokenType, tokenValue1 );
 
-    TokenValue::Ptr tokenValue2 = std::make_shared<TokenValue>( tokenStringValue );
-    Token::Ptr token2 = std::make_shared<Token>( tokenType, tokenValue2 );
+    TokenValue tokenValue2 = TokenValue( tokenStringValue );
+    Token token2 = Token( tokenType, tokenValue2 );
 
-    BOOST_CHECK( *token1.get() == *token2.get() );
+    BOOST_CHECK( token1 == token2 );
+}
+
+// String values are interned, so tokens created from different source strings with the same contents are equal.
+BOOST_AUTO_TEST_CASE( EqualTokensDifferentSourceStrings )
+{
+    TokenType tokenType{ IDENTIFIER };
+    std::string sourceString1 = "hello";
+    std::string sourceString2 = "say hello";
+
+    Token token1 = Token( tokenType, std::string_view( sourceString1 ) );
+    Token token2 = Token( tokenType, std::string_view( sourceString2 ).substr( 4u ) );
+
+    BOOST_CHECK( token1 == token2 );
 }
 
 BOOST_AUTO_TEST_CASE( EqualTokensUnusedValue )
@@ -23,10 +36,10 @@ BOOST_AUTO_TEST_CASE( EqualTokensUnusedValue )
     TokenType tokenType{ IF };
 
     // Create 2 tokens using the same types and empty values
-    Token::Ptr token1 = std::make_shared<Token>( tokenType, std::make_shared<TokenValue>() );
-    Token::Ptr token2 = std::make_shared<Token>( tokenType, std::make_shared<TokenValue>() );
+    Token token1 = Token( tokenType, TokenValue() );
+    Token token2 = Token( tokenType, TokenValue() );
 
-    BOOST_CHECK( *token1.get() == *token2.get() );
+    BOOST_CHECK( token1 == token2 );
 }
 
 BOOST_AUTO_TEST_CASE( UnequalValues )
@@ -34,13 +47,13 @@ BOOST_AUTO_TEST_CASE( UnequalValues )
     TokenType tokenType{ IDENTIFIER };
 
     // Create 2 tokens using the unequal values
-    TokenValue::Ptr tokenValue1 = std::make_shared<TokenValue>( "hello");
-    Token::Ptr token1 = std::make_shared<Token>( tokenType, tokenValue1 );
+    TokenValue tokenValue1 = TokenValue( "hello");
+    Token token1 = Token( tokenType, tokenValue1 );
 
-    TokenValue::Ptr tokenValue2 = std::make_shared<TokenValue>( "goodbye" );
-    Token::Ptr token2 = std::make_shared<Token>( tokenType, tokenValue2 );
+    TokenValue tokenValue2 = TokenValue( "goodbye" );
+    Token token2 = Token( tokenType, tokenValue2 );
 
-    BOOST_CHECK_EQUAL( false, *token1.get() == *token2.get() );
+    BOOST_CHECK_EQUAL( false, token1 == token2 );
 }
 
 // If token values are unequal but value type is unused, they should still pass the equality check.
@@ -49,17 +62,17 @@ BOOST_AUTO_TEST_CASE( UnequalValuesButUnused )
     TokenType tokenType{ FOR };
 
     // Create 2 tokens using unequal values but value types unused.
-    TokenValue::Ptr tokenValue1 = std::make_shared<TokenValue>();
-    tokenValue1->m_valueType = UNUSED;
-    tokenValue1->m_value.numericValue = 0x00;
-    Token::Ptr token1 = std::make_shared<Token>( tokenType, tokenValue1 );
+    TokenValue tokenValue1 = TokenValue();
+    tokenValue1.m_valueType = UNUSED;
+    tokenValue1.m_value.numericValue = 0x00;
+    Token token1 = Token( tokenType, tokenValue1 );
 
-    TokenValue::Ptr tokenValue2 = std::make_shared<TokenValue>();
-    tokenValue2->m_valueType = UNUSED;
-    tokenValue2->m_value.numericValue = 0xFF;
-    Token::Ptr token2 = std::make_shared<Token>( tokenType, tokenValue2 );
+    TokenValue tokenValue2 = TokenValue();
+    tokenValue2.m_valueType = UNUSED;
+    tokenValue2.m_value.numericValue = 0xFF;
+    Token token2 = Token( tokenType, tokenValue2 );
 
-    BOOST_CHECK( *token1.get() == *token2.get() );
+    BOOST_CHECK( token1 == token2 );
 }
 
 BOOST_AUTO_TEST_CASE( UnequalValueTypes )
@@ -67,25 +80,25 @@ BOOST_AUTO_TEST_CASE( UnequalValueTypes )
     TokenType tokenType{ FOR };
 
     // Create 2 tokens using unequal value types
-    TokenValue::Ptr tokenValue1 = std::make_shared<TokenValue>();
-    tokenValue1->m_valueType = NUMERIC;
-    Token::Ptr token1 = std::make_shared<Token>( tokenType, tokenValue1 );
+    TokenValue tokenValue1 = TokenValue();
+    tokenValue1.m_valueType = NUMERIC;
+    Token token1 = Token( tokenType, tokenValue1 );
 
-    TokenValue::Ptr tokenValue2 = std::make_shared<TokenValue>();
-    tokenValue2->m_valueType = STRING;
-    Token::Ptr token2 = std::make_shared<Token>( tokenType, tokenValue2 );
+    TokenValue tokenValue2 = TokenValue();
+    tokenValue2.m_valueType = STRING;
+    Token token2 = Token( tokenType, tokenValue2 );
 
-    BOOST_CHECK_EQUAL( false, *token1.get() == *token2.get() );
+    BOOST_CHECK_EQUAL( false, token1 == token2 );
 }
 
 BOOST_AUTO_TEST_CASE( UnequalTokenTypes )
 {
     // Create 2 tokens using unequal token types
-    Token::Ptr token1 = std::make_shared<Token>( IF, std::make_shared<TokenValue>() );
+    Token token1 = Token( IF, TokenValue() );
 
-    Token::Ptr token2 = std::make_shared<Token>( FOR, std::make_shared<TokenValue>() );
+    Token token2 = Token( FOR, TokenValue() );
 
-    BOOST_CHECK_EQUAL( false, *token1.get() == *token2.get() );
+    BOOST_CHECK_EQUAL( false, token1 == token2 );
 }
 
 BOOST_AUTO_TEST_SUITE_END() // TokenEqualityOperatorTests
\ No newline at end of file
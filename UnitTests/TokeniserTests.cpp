@@ -13,10 +13,10 @@ public:
 
         for ( size_t index = 0u; index < expectedTokens.size(); ++index )
         {
-            Token::Ptr expectedToken = expectedTokens[index];
-            Token::Ptr receivedToken = receivedTokens[index];
+            Token expectedToken = expectedTokens[index];
+            Token receivedToken = receivedTokens[index];
 
-            BOOST_CHECK( *expectedToken.get() == *receivedToken.get() );
+            BOOST_CHECK( expectedToken == receivedToken );
         }
     }
 };
@@ -91,7 +91,7 @@ BOOST_AUTO_TEST_CASE( ConvertExactMatchSingleToken )
     Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
     Tokens outputTokens = tokeniser->ConvertStringToTokens( stringToConvert );
 
-    Token::Ptr expectedToken = std::make_shared<Token>( FOR, std::make_shared<TokenValue>() );
+    Token expectedToken = Token( FOR, TokenValue() );
     Tokens expectedTokens{ expectedToken };
     CheckTokensAgainstExpected( expectedTokens, outputTokens );
 }
@@ -108,7 +108,7 @@ BOOST_AUTO_TEST_CASE( ConvertPatternMatchSingleToken )
     Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
     Tokens outputTokens = tokeniser->ConvertStringToTokens( stringToConvert );
 
-    Token::Ptr expectedToken = std::make_shared<Token>( expectedTokenType, std::make_shared<TokenValue>( stringToConvert ) );
+    Token expectedToken = Token( expectedTokenType, TokenValue( stringToConvert ) );
     Tokens expectedTokens{ expectedToken };
     CheckTokensAgainstExpected( expectedTokens, outputTokens );
 }
@@ -124,7 +124,7 @@ BOOST_AUTO_TEST_CASE( ConvertIdentifier_UnderscoreInMiddle )
     Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
     Tokens outputTokens = tokeniser->ConvertStringToTokens( stringToConvert );
 
-    Token::Ptr expectedToken = std::make_shared<Token>( expectedTokenType, std::make_shared<TokenValue>( stringToConvert ) );
+    Token expectedToken = Token( expectedTokenType, TokenValue( stringToConvert ) );
     Tokens expectedTokens{ expectedToken };
     CheckTokensAgainstExpected( expectedTokens, outputTokens );
 }
@@ -141,7 +141,7 @@ BOOST_AUTO_TEST_CASE( ConvertTokenThenComment )
     Tokens outputTokens = tokeniser->ConvertStringToTokens( stringToConvert );
 
     TokenType expectedTokenType{ IDENTIFIER };
-    Token::Ptr expectedToken = std::make_shared<Token>( expectedTokenType, std::make_shared<TokenValue>( varName ));
+    Token expectedToken = Token( expectedTokenType, TokenValue( varName ));
     Tokens expectedTokens{ expectedToken };
     CheckTokensAgainstExpected( expectedTokens, outputTokens );
 
@@ -164,22 +164,62 @@ BOOST_AUTO_TEST_CASE( ConvertMultipleTokensLine )
     Tokens outputTokens = tokeniser->ConvertStringToTokens( stringToConvert );
 
     Tokens expectedTokens = {
-        std::make_shared<Token>( DATA_TYPE, std::make_shared<TokenValue>( DataType::DT_BYTE ) ),
-        std::make_shared<Token>( IDENTIFIER, std::make_shared<TokenValue>( "myNumber" ) ),
-        std::make_shared<Token>( ASSIGN, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( PAREN_OPEN, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 3u ) ),
-        std::make_shared<Token>( PLUS, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 4u ) ),
-        std::make_shared<Token>( PAREN_CLOSE, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( MULTIPLY, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 2u ) ),
-        std::make_shared<Token>( SEMICOLON, std::make_shared<TokenValue>() )
+        Token( DATA_TYPE, TokenValue( DataType::DT_BYTE ) ),
+        Token( IDENTIFIER, TokenValue( "myNumber" ) ),
+        Token( ASSIGN, TokenValue() ),
+        Token( PAREN_OPEN, TokenValue() ),
+        Token( BYTE, TokenValue( 3u ) ),
+        Token( PLUS, TokenValue() ),
+        Token( BYTE, TokenValue( 4u ) ),
+        Token( PAREN_CLOSE, TokenValue() ),
+        Token( MULTIPLY, TokenValue() ),
+        Token( BYTE, TokenValue( 2u ) ),
+        Token( SEMICOLON, TokenValue() )
     };
 
     CheckTokensAgainstExpected( expectedTokens, outputTokens );
 }
 
+/**
+ * Tests that ConvertStringToTokens() always takes the longest matching token, including where a shorter token is a
+ * prefix of a longer one, and where keywords are a prefix of an identifier.
+ */
+BOOST_AUTO_TEST_CASE( ConvertMultipleTokensLine_LongestMatch )
+{
+    std::string stringToConvert = "<<=<= <|||&&&!==forx";
+
+    Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
+    Tokens outputTokens = tokeniser->ConvertStringToTokens( stringToConvert );
+
+    Tokens expectedTokens = {
+        Token( LSHIFT, TokenValue() ),
+        Token( ASSIGN, TokenValue() ),
+        Token( LEQ, TokenValue() ),
+        Token( LT, TokenValue() ),
+        Token( BITWISE_OR, TokenValue() ),
+        Token( T::OR, TokenValue() ),
+        Token( BITWISE_AND, TokenValue() ),
+        Token( T::AND, TokenValue() ),
+        Token( NEQ, TokenValue() ),
+        Token( ASSIGN, TokenValue() ),
+        Token( IDENTIFIER, TokenValue( "forx" ) )
+    };
+
+    CheckTokensAgainstExpected( expectedTokens, outputTokens );
+}
+
+/**
+ * Tests that when ConvertStringToTokens() is called on a line containing an unrecognised symbol after valid tokens,
+ * it throws an error.
+ */
+BOOST_AUTO_TEST_CASE( PartialNoMatchLine_UnrecognisedSymbol )
+{
+    std::string stringToConvert = "a = b ^ c;";
+
+    Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
+    BOOST_CHECK_THROW( tokeniser->ConvertStringToTokens( stringToConvert ), std::invalid_argument );
+}
+
 /**
  * Tests that when ConvertStringToTokens() is called on a line that doesn't match any valid tokens, it throws an error.
  */
@@ -218,17 +258,17 @@ BOOST_AUTO_TEST_SUITE( ConvertMultipleLinesTests )
     Tokens outputTokens = tokeniser->ConvertStringToTokens( stringToConvert );
 
     Tokens expectedLineTokens = {
-        std::make_shared<Token>( DATA_TYPE, std::make_shared<TokenValue>( DataType::DT_BYTE ) ),
-        std::make_shared<Token>( IDENTIFIER, std::make_shared<TokenValue>( "myNumber" ) ),
-        std::make_shared<Token>( ASSIGN, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( PAREN_OPEN, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 3u ) ),
-        std::make_shared<Token>( PLUS, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 4u ) ),
-        std::make_shared<Token>( PAREN_CLOSE, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( MULTIPLY, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 2u ) ),
-        std::make_shared<Token>( SEMICOLON, std::make_shared<TokenValue>() )
+        Token( DATA_TYPE, TokenValue( DataType::DT_BYTE ) ),
+        Token( IDENTIFIER, TokenValue( "myNumber" ) ),
+        Token( ASSIGN, TokenValue() ),
+        Token( PAREN_OPEN, TokenValue() ),
+        Token( BYTE, TokenValue( 3u ) ),
+        Token( PLUS, TokenValue() ),
+        Token( BYTE, TokenValue( 4u ) ),
+        Token( PAREN_CLOSE, TokenValue() ),
+        Token( MULTIPLY, TokenValue() ),
+        Token( BYTE, TokenValue( 2u ) ),
+        Token( SEMICOLON, TokenValue() )
     };
 
     Tokens expectedTokens;
@@ -252,17 +292,17 @@ BOOST_AUTO_TEST_CASE( ConvertMultipleLines_FirstCommented )
     Tokens outputTokens = tokeniser->ConvertStringToTokens( stringToConvert );
 
     Tokens expectedTokens = {
-        std::make_shared<Token>( DATA_TYPE, std::make_shared<TokenValue>( DataType::DT_BYTE ) ),
-        std::make_shared<Token>( IDENTIFIER, std::make_shared<TokenValue>( "myNumber" ) ),
-        std::make_shared<Token>( ASSIGN, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( PAREN_OPEN, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 3u ) ),
-        std::make_shared<Token>( PLUS, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 4u ) ),
-        std::make_shared<Token>( PAREN_CLOSE, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( MULTIPLY, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 2u ) ),
-        std::make_shared<Token>( SEMICOLON, std::make_shared<TokenValue>() )
+        Token( DATA_TYPE, TokenValue( DataType::DT_BYTE ) ),
+        Token( IDENTIFIER, TokenValue( "myNumber" ) ),
+        Token( ASSIGN, TokenValue() ),
+        Token( PAREN_OPEN, TokenValue() ),
+        Token( BYTE, TokenValue( 3u ) ),
+        Token( PLUS, TokenValue() ),
+        Token( BYTE, TokenValue( 4u ) ),
+        Token( PAREN_CLOSE, TokenValue() ),
+        Token( MULTIPLY, TokenValue() ),
+        Token( BYTE, TokenValue( 2u ) ),
+        Token( SEMICOLON, TokenValue() )
     };
 
     CheckTokensAgainstExpected( expectedTokens, outputTokens );
@@ -280,17 +320,17 @@ BOOST_AUTO_TEST_CASE( ConvertMultipleLines_MiddleCommented )
     Tokens outputTokens = tokeniser->ConvertStringToTokens( stringToConvert );
 
     Tokens expectedLineTokens = {
-        std::make_shared<Token>( DATA_TYPE, std::make_shared<TokenValue>( DataType::DT_BYTE ) ),
-        std::make_shared<Token>( IDENTIFIER, std::make_shared<TokenValue>( "myNumber" ) ),
-        std::make_shared<Token>( ASSIGN, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( PAREN_OPEN, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 3u ) ),
-        std::make_shared<Token>( PLUS, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 4u ) ),
-        std::make_shared<Token>( PAREN_CLOSE, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( MULTIPLY, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 2u ) ),
-        std::make_shared<Token>( SEMICOLON, std::make_shared<TokenValue>() )
+        Token( DATA_TYPE, TokenValue( DataType::DT_BYTE ) ),
+        Token( IDENTIFIER, TokenValue( "myNumber" ) ),
+        Token( ASSIGN, TokenValue() ),
+        Token( PAREN_OPEN, TokenValue() ),
+        Token( BYTE, TokenValue( 3u ) ),
+        Token( PLUS, TokenValue() ),
+        Token( BYTE, TokenValue( 4u ) ),
+        Token( PAREN_CLOSE, TokenValue() ),
+        Token( MULTIPLY, TokenValue() ),
+        Token( BYTE, TokenValue( 2u ) ),
+        Token( SEMICOLON, TokenValue() )
     };
 
     Tokens expectedTokens;
@@ -313,17 +353,17 @@ BOOST_AUTO_TEST_CASE( ConvertMultipleLines_OneWhitespace )
     Tokens outputTokens = tokeniser->ConvertStringToTokens( stringToConvert );
 
     Tokens expectedLineTokens = {
-        std::make_shared<Token>( DATA_TYPE, std::make_shared<TokenValue>( DataType::DT_BYTE ) ),
-        std::make_shared<Token>( IDENTIFIER, std::make_shared<TokenValue>( "myNumber" ) ),
-        std::make_shared<Token>( ASSIGN, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( PAREN_OPEN, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 3u ) ),
-        std::make_shared<Token>( PLUS, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 4u ) ),
-        std::make_shared<Token>( PAREN_CLOSE, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( MULTIPLY, std::make_shared<TokenValue>() ),
-        std::make_shared<Token>( BYTE, std::make_shared<TokenValue>( 2u ) ),
-        std::make_shared<Token>( SEMICOLON, std::make_shared<TokenValue>() )
+        Token( DATA_TYPE, TokenValue( DataType::DT_BYTE ) ),
+        Token( IDENTIFIER, TokenValue( "myNumber" ) ),
+        Token( ASSIGN, TokenValue() ),
+        Token( PAREN_OPEN, TokenValue() ),
+        Token( BYTE, TokenValue( 3u ) ),
+        Token( PLUS, TokenValue() ),
+        Token( BYTE, TokenValue( 4u ) ),
+        Token( PAREN_CLOSE, TokenValue() ),
+        Token( MULTIPLY, TokenValue() ),
+        Token( BYTE, TokenValue( 2u ) ),
+        Token( SEMICOLON, TokenValue() )
     };
 
     Tokens expectedTokens;
@@ -346,6 +386,278 @@ BOOST_AUTO_TEST_CASE( ConvertMultipleLines_OneNonMatch )
     BOOST_CHECK_THROW( tokeniser->ConvertStringToTokens( stringToConvert ), std::invalid_argument );
 }
 
+/**
+ * Tests that when ConvertStringToTokens() is called on lines with Windows line endings, including an empty line, the
+ * carriage returns are treated as whitespace.
+ */
+BOOST_AUTO_TEST_CASE( ConvertMultipleLines_CarriageReturns )
+{
+    std::string stringToConvert = "byte a = 1;\r\n\r\na = a+1; // comment\r\n";
+
+    Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
+    Tokens outputTokens = tokeniser->ConvertStringToTokens( stringToConvert );
+
+    Tokens expectedTokens = {
+        Token( DATA_TYPE, TokenValue( DataType::DT_BYTE ) ),
+        Token( IDENTIFIER, TokenValue( "a" ) ),
+        Token( ASSIGN, TokenValue() ),
+        Token( BYTE, TokenValue( 1u ) ),
+        Token( SEMICOLON, TokenValue() ),
+        Token( IDENTIFIER, TokenValue( "a" ) ),
+        Token( ASSIGN, TokenValue() ),
+        Token( IDENTIFIER, TokenValue( "a" ) ),
+        Token( PLUS, TokenValue() ),
+        Token( BYTE, TokenValue( 1u ) ),
+        Token( SEMICOLON, TokenValue() )
+    };
+
+    CheckTokensAgainstExpected( expectedTokens, outputTokens );
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ConvertMultipleLinesTests
 
+BOOST_AUTO_TEST_SUITE( ConvertParallelTests )
+
+/**
+ * Tests that converting a multi-line string in parallel produces the same tokens, and allocates the same identifier
+ * IDs in the same order, as converting it serially.
+ */
+BOOST_AUTO_TEST_CASE( ConvertParallel_MatchesSerial )
+{
+    std::string stringToConvert;
+    for ( size_t line = 0u; line < 50u; ++line )
+    {
+        std::string lineNum = std::to_string( line );
+        stringToConvert += "byte var" + lineNum + " = (x" + lineNum + " + 4) * common; // comment\n";
+        stringToConvert += line % 3u == 0u ? "\n" : "if (common <= var" + lineNum + ") { common = 1; }\n";
+    }
+
+    IdentifierTable::Ptr serialTable = std::make_shared< IdentifierTable >();
+    Tokeniser::Ptr serialTokeniser = std::make_shared< Tokeniser >( serialTable );
+    Tokens serialTokens = serialTokeniser->ConvertStringToTokens( stringToConvert );
+
+    IdentifierTable::Ptr parallelTable = std::make_shared< IdentifierTable >();
+    Tokeniser::Ptr parallelTokeniser = std::make_shared< Tokeniser >( parallelTable );
+    constexpr size_t numThreads{ 7u };
+    constexpr size_t minChunkSize{ 1u };
+    Tokens parallelTokens = parallelTokeniser->ConvertStringToTokensParallel( stringToConvert, numThreads, minChunkSize );
+
+    BOOST_REQUIRE_EQUAL( serialTokens.size(), parallelTokens.size() );
+    for ( size_t index = 0u; index < serialTokens.size(); ++index )
+    {
+        BOOST_CHECK_EQUAL( serialTokens[index].m_type, parallelTokens[index].m_type );
+        BOOST_CHECK( serialTokens[index].m_value.m_valueType == parallelTokens[index].m_value.m_valueType );
+        BOOST_CHECK( serialTokens[index].m_value.GetIdentifierId() == parallelTokens[index].m_value.GetIdentifierId() );
+    }
+
+    BOOST_REQUIRE_EQUAL( serialTable->GetNumIdentifiers(), parallelTable->GetNumIdentifiers() );
+    for ( uint32_t id = 0u; id < serialTable->GetNumIdentifiers(); ++id )
+    {
+        BOOST_CHECK_EQUAL( serialTable->GetName( IdentifierId{ id } ), parallelTable->GetName( IdentifierId{ id } ) );
+    }
+}
+
+/**
+ * Tests that converting in parallel falls back to a serial conversion if the input is smaller than the minimum chunk
+ * size.
+ */
+BOOST_AUTO_TEST_CASE( ConvertParallel_SmallInput )
+{
+    std::string stringToConvert = "byte a = 1;\na = a+1;";
+
+    Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
+    Tokens expectedTokens = tokeniser->ConvertStringToTokens( stringToConvert );
+    Tokens outputTokens = tokeniser->ConvertStringToTokensParallel( stringToConvert, 4u );
+
+    CheckTokensAgainstExpected( expectedTokens, outputTokens );
+}
+
+/**
+ * Tests that when converting in parallel, a line that doesn't match in any chunk causes an exception to be thrown.
+ */
+BOOST_AUTO_TEST_CASE( ConvertParallel_OneNonMatch )
+{
+    std::string stringToConvert;
+    for ( size_t line = 0u; line < 20u; ++line )
+    {
+        stringToConvert += line == 15u ? " 1invalid\n" : "byte myNumber = (3+4)*2;\n";
+    }
+
+    Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
+    constexpr size_t numThreads{ 4u };
+    constexpr size_t minChunkSize{ 1u };
+    BOOST_CHECK_THROW( tokeniser->ConvertStringToTokensParallel( stringToConvert, numThreads, minChunkSize ),
+                       std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // ConvertParallelTests
+
+BOOST_AUTO_TEST_SUITE( RetokeniseLinesTests )
+
+/**
+ * Tests that converting a string with a line token index records the first token of each line, including lines with
+ * no tokens, followed by the total number of tokens.
+ */
+BOOST_AUTO_TEST_CASE( ConvertWithLineTokenIndex )
+{
+    std::string stringToConvert = "byte a = 1;\n// comment\n\na = a+1;";
+
+    Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
+    LineTokenIndex lineTokenIndex;
+    Tokens outputTokens = tokeniser->ConvertStringToTokens( stringToConvert, lineTokenIndex );
+
+    LineTokenIndex expectedIndex{ 0u, 5u, 5u, 5u, 11u };
+    BOOST_CHECK_EQUAL_COLLECTIONS( expectedIndex.begin(), expectedIndex.end(),
+                                   lineTokenIndex.begin(), lineTokenIndex.end() );
+    BOOST_CHECK_EQUAL( 11u, outputTokens.size() );
+}
+
+/**
+ * Tests that replacing, inserting and deleting lines gives the same tokens and line token index as converting the
+ * whole edited string.
+ */
+BOOST_AUTO_TEST_CASE( RetokeniseLines_MatchesFullConversion )
+{
+    const std::vector< std::string > originalLines{
+        "byte a = 1;", "byte b = 2;", "// comment", "if (a < b) {", "  a = a + b;", "}", "b = a;"
+    };
+    // First line, number of replaced lines, number of replacement lines, replacement text.
+    const std::vector< std::tuple< size_t, size_t, size_t, std::string > > edits{
+        { 1u, 1u, 1u, "byte b = (3+4)*2;" },        // Replace one line
+        { 2u, 0u, 2u, "byte c = b;\nc = c | a;" }, // Insert lines
+        { 5u, 3u, 0u, "" },                         // Delete lines
+        { 0u, 1u, 0u, "" },                         // Delete first line
+        { 5u, 0u, 1u, "b = 5;" },                   // Append at end
+        { 1u, 1u, 1u, "" },                         // Blank a line
+        { 3u, 1u, 1u, "b = 6;" },                   // Replace a line after the blank one
+    };
+
+    Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
+
+    std::vector< std::string > currentLines = originalLines;
+    auto joinLines = []( const std::vector< std::string >& lines ) {
+        std::string joined;
+        for ( size_t i = 0u; i < lines.size(); ++i )
+        {
+            joined += ( 0u == i ? "" : "\n" ) + lines[i];
+        }
+        return joined;
+    };
+
+    LineTokenIndex lineTokenIndex;
+    Tokens tokens = tokeniser->ConvertStringToTokens( joinLines( currentLines ), lineTokenIndex );
+
+    for ( const auto& edit : edits )
+    {
+        const size_t firstLine = std::get< 0 >( edit );
+        const size_t numReplacedLines = std::get< 1 >( edit );
+        const size_t numReplacementLines = std::get< 2 >( edit );
+        const std::string& replacement = std::get< 3 >( edit );
+
+        tokeniser->RetokeniseLines( replacement, numReplacementLines, firstLine, numReplacedLines, tokens,
+                                    lineTokenIndex );
+
+        // Apply the same edit to the lines, and convert them from scratch for comparison.
+        std::vector< std::string > replacementLines;
+        if ( 0u != numReplacementLines )
+        {
+            size_t start = 0u;
+            size_t newLinePos;
+            while ( std::string::npos != ( newLinePos = replacement.find( '\n', start ) ) )
+            {
+                replacementLines.push_back( replacement.substr( start, newLinePos - start ) );
+                start = newLinePos + 1u;
+            }
+            replacementLines.push_back( replacement.substr( start ) );
+        }
+        currentLines.erase( currentLines.begin() + firstLine, currentLines.begin() + firstLine + numReplacedLines );
+        currentLines.insert( currentLines.begin() + firstLine, replacementLines.begin(), replacementLines.end() );
+
+        LineTokenIndex expectedIndex;
+        Tokens expectedTokens = tokeniser->ConvertStringToTokens( joinLines( currentLines ), expectedIndex );
+
+        CheckTokensAgainstExpected( expectedTokens, tokens );
+        BOOST_CHECK_EQUAL_COLLECTIONS( expectedIndex.begin(), expectedIndex.end(),
+                                       lineTokenIndex.begin(), lineTokenIndex.end() );
+    }
+}
+
+/**
+ * Tests that if the replacement lines can't be converted, an exception is thrown and the tokens are left unchanged.
+ */
+BOOST_AUTO_TEST_CASE( RetokeniseLines_NonMatchLeavesTokens )
+{
+    Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
+    LineTokenIndex lineTokenIndex;
+    Tokens tokens = tokeniser->ConvertStringToTokens( "byte a = 1;\na = 2;", lineTokenIndex );
+
+    Tokens originalTokens = tokens;
+    LineTokenIndex originalIndex = lineTokenIndex;
+    BOOST_CHECK_THROW( tokeniser->RetokeniseLines( " 1invalid", 1u, 1u, 1u, tokens, lineTokenIndex ),
+                       std::invalid_argument );
+
+    CheckTokensAgainstExpected( originalTokens, tokens );
+    BOOST_CHECK_EQUAL_COLLECTIONS( originalIndex.begin(), originalIndex.end(),
+                                   lineTokenIndex.begin(), lineTokenIndex.end() );
+}
+
+/**
+ * Tests that an exception is thrown if the edited lines are outside the range of lines in the index.
+ */
+BOOST_AUTO_TEST_CASE( RetokeniseLines_OutOfRange )
+{
+    Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
+    LineTokenIndex lineTokenIndex;
+    Tokens tokens = tokeniser->ConvertStringToTokens( "byte a = 1;\na = 2;", lineTokenIndex );
+
+    BOOST_CHECK_THROW( tokeniser->RetokeniseLines( "a = 3;", 1u, 1u, 2u, tokens, lineTokenIndex ),
+                       std::out_of_range );
+    BOOST_CHECK_THROW( tokeniser->RetokeniseLines( "a = 3;", 1u, 3u, 0u, tokens, lineTokenIndex ),
+                       std::out_of_range );
+}
+
+/**
+ * Tests that blanking a line keeps an empty entry for it in the line token index, so that the lines after it can still
+ * be re-tokenised by their line numbers.
+ */
+BOOST_AUTO_TEST_CASE( RetokeniseLines_BlankLine )
+{
+    Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
+    LineTokenIndex lineTokenIndex;
+    Tokens tokens = tokeniser->ConvertStringToTokens( "byte a = 1;\na = 2;\na = 3;", lineTokenIndex );
+
+    tokeniser->RetokeniseLines( "", 1u, 1u, 1u, tokens, lineTokenIndex );
+    LineTokenIndex expectedIndex{ 0u, 5u, 5u, 9u };
+    BOOST_CHECK_EQUAL_COLLECTIONS( expectedIndex.begin(), expectedIndex.end(),
+                                   lineTokenIndex.begin(), lineTokenIndex.end() );
+
+    tokeniser->RetokeniseLines( "a = 4 + a;", 1u, 2u, 1u, tokens, lineTokenIndex );
+    LineTokenIndex expectedFinalIndex;
+    Tokens expectedTokens = tokeniser->ConvertStringToTokens( "byte a = 1;\n\na = 4 + a;", expectedFinalIndex );
+    CheckTokensAgainstExpected( expectedTokens, tokens );
+    BOOST_CHECK_EQUAL_COLLECTIONS( expectedFinalIndex.begin(), expectedFinalIndex.end(),
+                                   lineTokenIndex.begin(), lineTokenIndex.end() );
+}
+
+/**
+ * Tests that an exception is thrown, and the tokens left unchanged, if the number of replacement lines doesn't match
+ * the replacement text.
+ */
+BOOST_AUTO_TEST_CASE( RetokeniseLines_WrongNumberOfLines )
+{
+    Tokeniser::Ptr tokeniser = std::make_shared<Tokeniser>();
+    LineTokenIndex lineTokenIndex;
+    Tokens tokens = tokeniser->ConvertStringToTokens( "byte a = 1;\na = 2;", lineTokenIndex );
+    LineTokenIndex originalIndex = lineTokenIndex;
+
+    BOOST_CHECK_THROW( tokeniser->RetokeniseLines( "a = 3;", 0u, 1u, 1u, tokens, lineTokenIndex ),
+                       std::invalid_argument );
+    BOOST_CHECK_THROW( tokeniser->RetokeniseLines( "a = 3;\na = 4;", 1u, 1u, 1u, tokens, lineTokenIndex ),
+                       std::invalid_argument );
+    BOOST_CHECK_EQUAL_COLLECTIONS( originalIndex.begin(), originalIndex.end(),
+                                   lineTokenIndex.begin(), lineTokenIndex.end() );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // RetokeniseLinesTests
+
 BOOST_AUTO_TEST_SUITE_END() // TokeniserTests
\ No newline at end of file
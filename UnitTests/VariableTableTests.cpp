@@ -0,0 +1,49 @@
+#include <boost/test/unit_test.hpp>
+#include "VariableTable.h"
+
+BOOST_AUTO_TEST_SUITE( VariableTableTests )
+
+/**
+ * Tests that variables are given dense IDs in the order they are added, even if they share a name.
+ */
+BOOST_AUTO_TEST_CASE( AddVariable_DenseIds )
+{
+    VariableTable table{};
+
+    VarId idA = table.AddVariable( "a" );
+    VarId idB = table.AddVariable( "b" );
+    VarId idAgain = table.AddVariable( "a" );
+
+    BOOST_CHECK_EQUAL( 0u, static_cast< uint32_t >( idA ) );
+    BOOST_CHECK_EQUAL( 1u, static_cast< uint32_t >( idB ) );
+    BOOST_CHECK_EQUAL( 2u, static_cast< uint32_t >( idAgain ) );
+    BOOST_CHECK_EQUAL( 3u, table.GetNumVariables() );
+}
+
+/**
+ * Tests that the name and debug name of a variable can be retrieved from its ID.
+ */
+BOOST_AUTO_TEST_CASE( GetName_Success )
+{
+    VariableTable table{};
+    table.AddVariable( "a" );
+    VarId id = table.AddVariable( "b" );
+
+    BOOST_CHECK_EQUAL( "b", table.GetName( id ) );
+    BOOST_CHECK_EQUAL( "b#1", table.GetDebugName( id ) );
+}
+
+/**
+ * Tests that getting the name of an ID not allocated by the table throws an exception.
+ */
+BOOST_AUTO_TEST_CASE( GetName_UnknownId )
+{
+    VariableTable table{};
+    table.AddVariable( "a" );
+
+    BOOST_CHECK_THROW( table.GetName( VarId{ 1u } ), std::out_of_range );
+    BOOST_CHECK_THROW( table.GetName( g_invalidVarId ), std::out_of_range );
+    BOOST_CHECK_THROW( table.GetDebugName( g_invalidVarId ), std::out_of_range );
+}
+
+BOOST_AUTO_TEST_SUITE_END()